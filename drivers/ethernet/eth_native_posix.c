@@ -190,6 +190,22 @@ static int eth_send(const struct device *dev, struct net_pkt *pkt)
 	return ret < 0 ? ret : 0;
 }
 
+static int eth_send_burst(const struct device *dev, struct net_pkt **pkts,
+			  size_t count)
+{
+	size_t i;
+	int ret;
+
+	for (i = 0; i < count; i++) {
+		ret = eth_send(dev, pkts[i]);
+		if (ret < 0) {
+			return i > 0 ? (int)i : ret;
+		}
+	}
+
+	return count;
+}
+
 static struct net_linkaddr *eth_get_mac(struct eth_context *ctx)
 {
 	ctx->ll_addr.addr = ctx->mac_addr;
@@ -223,24 +239,73 @@ static struct net_pkt *prepare_pkt(struct eth_context *ctx,
 	return pkt;
 }
 
-static int read_data(struct eth_context *ctx, int fd)
+static struct net_pkt *read_pkt(struct eth_context *ctx, int fd, int *status)
 {
-	struct net_if *iface = ctx->iface;
-	struct net_pkt *pkt = NULL;
-	int status;
+	struct net_pkt *pkt;
 	int count;
 
 	count = nsi_host_read(fd, ctx->recv, sizeof(ctx->recv));
 	if (count <= 0) {
-		return 0;
+		*status = 0;
+		return NULL;
 	}
 
-	pkt = prepare_pkt(ctx, count, &status);
+	pkt = prepare_pkt(ctx, count, status);
 	if (!pkt) {
+		return NULL;
+	}
+
+	update_gptp(ctx->iface, pkt, false);
+
+	return pkt;
+}
+
+#if CONFIG_ETH_NATIVE_POSIX_RX_BURST > 1
+/* Read the frames that are already available and pass them to the
+ * network stack in one go.
+ */
+static int read_data_burst(struct eth_context *ctx, int fd)
+{
+	struct net_pkt *pkts[CONFIG_ETH_NATIVE_POSIX_RX_BURST];
+	size_t count = 0;
+	int status = 0;
+	int taken;
+
+	do {
+		pkts[count] = read_pkt(ctx, fd, &status);
+		if (!pkts[count]) {
+			break;
+		}
+
+		count++;
+	} while (count < ARRAY_SIZE(pkts) && !eth_wait_data(fd));
+
+	if (count == 0) {
 		return status;
 	}
 
-	update_gptp(iface, pkt, false);
+	taken = net_recv_data_burst(ctx->iface, pkts, count);
+	if (taken < 0) {
+		taken = 0;
+	}
+
+	for (size_t i = taken; i < count; i++) {
+		net_pkt_unref(pkts[i]);
+	}
+
+	return status;
+}
+#else
+static int read_data(struct eth_context *ctx, int fd)
+{
+	struct net_if *iface = ctx->iface;
+	struct net_pkt *pkt;
+	int status;
+
+	pkt = read_pkt(ctx, fd, &status);
+	if (!pkt) {
+		return status;
+	}
 
 	if (net_recv_data(iface, pkt) < 0) {
 		net_pkt_unref(pkt);
@@ -248,6 +313,7 @@ static int read_data(struct eth_context *ctx, int fd)
 
 	return 0;
 }
+#endif
 
 static void eth_rx(void *p1, void *p2, void *p3)
 {
@@ -260,7 +326,11 @@ static void eth_rx(void *p1, void *p2, void *p3)
 	while (1) {
 		if (net_if_is_up(ctx->iface)) {
 			while (!eth_wait_data(ctx->dev_fd)) {
+#if CONFIG_ETH_NATIVE_POSIX_RX_BURST > 1
+				read_data_burst(ctx, ctx->dev_fd);
+#else
 				read_data(ctx, ctx->dev_fd);
+#endif
 				k_yield();
 			}
 		}
@@ -464,6 +534,7 @@ static const struct ethernet_api eth_if_api = {
 	.get_capabilities = eth_posix_native_get_capabilities,
 	.set_config = set_config,
 	.send = eth_send,
+	.send_burst = eth_send_burst,
 
 #if defined(CONFIG_NET_VLAN)
 	.vlan_setup = vlan_setup,
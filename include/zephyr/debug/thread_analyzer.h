@@ -10,6 +10,10 @@
 #include <stddef.h>
 #include <zephyr/kernel/thread.h>
 
+#ifdef CONFIG_THREAD_ANALYZER_AUTO_ZBUS
+#include <zephyr/zbus/zbus.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -49,6 +53,31 @@ struct thread_analyzer_info {
 #endif
 };
 
+#if defined(CONFIG_THREAD_ANALYZER_AUTO_ZBUS) || defined(__DOXYGEN__)
+/** @brief Maximum length of a thread name in a zbus message, including the
+ *  terminating null character.
+ */
+#define THREAD_ANALYZER_ZBUS_NAME_LEN 32
+
+/** @brief Message published on @c thread_analyzer_chan for each thread by the
+ *  periodic analysis.
+ */
+struct thread_analyzer_zbus_msg {
+	/** The name of the thread or stringified address of the thread handle
+	 * if name is not set, truncated if needed.
+	 */
+	char name[THREAD_ANALYZER_ZBUS_NAME_LEN];
+	/** The total size of the stack */
+	size_t stack_size;
+	/** Stack size in used */
+	size_t stack_used;
+	/** CPU utilization in percent */
+	unsigned int utilization;
+};
+
+ZBUS_CHAN_DECLARE(thread_analyzer_chan);
+#endif
+
 /** @brief Thread analyzer stack size callback function
  *
  *  Callback function with thread analysis information.
@@ -64,6 +93,9 @@ typedef void (*thread_analyzer_cb)(struct thread_analyzer_info *info);
  *  option THREAD_ANALYZER_AUTO_SEPARATE_CORES is set, the function analyzes
  *  only the threads running on the specified cpu.
  *
+ *  With THREAD_ANALYZER_INCREMENTAL, the CPU utilization is the one since the
+ *  previous call.
+ *
  *  @param cb The callback function handler
  *  @param cpu cpu to analyze, ignored if THREAD_ANALYZER_AUTO_SEPARATE_CORES=n
  */
@@ -117,6 +117,25 @@ struct k_obj_type {
 #endif /* CONFIG_OBJ_CORE_STATS */
 };
 
+#ifdef CONFIG_OBJ_CORE_CONTENTION
+/** Thread that waited on a kernel object */
+struct k_obj_core_waiter {
+	struct k_thread *thread;   /**< Waiting thread */
+	uint32_t         count;    /**< Number of waits (estimated) */
+};
+
+/** Contention statistics of a kernel object */
+struct k_obj_core_contention {
+	uint32_t uncontended;   /**< Acquisitions without waiting */
+	uint32_t contended;     /**< Acquisitions after waiting */
+	uint32_t timeouts;      /**< Waits that did not acquire the object */
+	uint64_t total_wait;    /**< Total wait time (in cycles) */
+	uint32_t max_wait;      /**< Longest wait time (in cycles) */
+	/** Threads that waited most often */
+	struct k_obj_core_waiter waiters[CONFIG_OBJ_CORE_CONTENTION_WAITERS];
+};
+#endif /* CONFIG_OBJ_CORE_CONTENTION */
+
 /** Object core structure */
 struct k_obj_core {
 	sys_snode_t        node;   /**< Object node within object type's list */
@@ -124,6 +143,10 @@ struct k_obj_core {
 #ifdef CONFIG_OBJ_CORE_STATS
 	void  *stats;              /**< Pointer to kernel object's stats */
 #endif /* CONFIG_OBJ_CORE_STATS */
+#ifdef CONFIG_OBJ_CORE_CONTENTION
+	/** Kernel object's contention statistics */
+	struct k_obj_core_contention contention;
+#endif /* CONFIG_OBJ_CORE_CONTENTION */
 };
 
 /**
@@ -390,5 +413,79 @@ int k_obj_core_stats_disable(struct k_obj_core *obj_core);
  */
 int k_obj_core_stats_enable(struct k_obj_core *obj_core);
 
+#ifdef CONFIG_OBJ_CORE_CONTENTION
+/**
+ * @brief Retrieve the contention statistics of a kernel object
+ *
+ * Mutexes and semaphores record how they are acquired. Waits are measured
+ * with the 32-bit cycle counter, so a single wait longer than its wrap
+ * period is misreported.
+ *
+ * @param obj_core Pointer to kernel object core
+ * @param stats Pointer to the buffer the statistics are copied to
+ */
+void k_obj_core_contention_get(struct k_obj_core *obj_core,
+			       struct k_obj_core_contention *stats);
+
+/**
+ * @brief Reset the contention statistics of a kernel object
+ *
+ * @param obj_core Pointer to kernel object core
+ */
+void k_obj_core_contention_reset(struct k_obj_core *obj_core);
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+/* Called with the lock of the object held */
+static inline void z_obj_core_contention_acquired(struct k_obj_core *obj_core)
+{
+	obj_core->contention.uncontended++;
+}
+
+void z_obj_core_contention_record(struct k_obj_core *obj_core,
+				  struct k_thread *thread,
+				  uint32_t cycles, bool acquired);
+
+/**
+ * @endcond
+ */
+#endif /* CONFIG_OBJ_CORE_CONTENTION */
+
+#ifdef CONFIG_OBJ_CORE_CONTENTION_SPINLOCK
+/** Contention statistics of a spinlock */
+struct k_spin_contention {
+	const struct k_spinlock *lock;   /**< Spinlock */
+	uint32_t contended;              /**< Acquisitions after spinning */
+	uint64_t total_wait;             /**< Total spin time (in cycles) */
+	uint32_t max_wait;               /**< Longest spin time (in cycles) */
+};
+
+/**
+ * @brief Walk the contention statistics of all contended spinlocks
+ *
+ * @param func Function to call for each spinlock
+ * @param data Pointer to data to pass to @a func
+ *
+ * @retval 0 if all spinlocks were walked
+ * @retval value returned by @a func if it stopped the walk
+ */
+int k_spin_contention_walk(int (*func)(const struct k_spin_contention *stats, void *data),
+			   void *data);
+
+/**
+ * @brief Get the number of contended spinlocks that could not be tracked
+ *
+ * @return Number of contended acquisitions of untracked spinlocks
+ */
+uint32_t k_spin_contention_dropped_get(void);
+
+/**
+ * @brief Reset the contention statistics of all spinlocks
+ */
+void k_spin_contention_reset(void);
+#endif /* CONFIG_OBJ_CORE_CONTENTION_SPINLOCK */
+
 /** @} */
 #endif /* __KERNEL_OBJ_CORE_H__ */
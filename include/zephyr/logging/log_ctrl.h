@@ -187,6 +187,27 @@ __syscall uint32_t log_filter_set(struct log_backend const *const backend,
 				  uint32_t domain_id, int16_t source_id,
 				  uint32_t level);
 
+/**
+ * @brief Set filter on all sources whose names match a pattern.
+ *
+ * Convenient for configuring groups of modules at once, e.g. "net_*" for
+ * the whole network stack. Calling it once per pattern instead of
+ * filtering each message keeps disabled sources cheap, as the level check
+ * at the call site happens before the message is created.
+ *
+ * @param backend	Backend instance. NULL for all backends (and frontend).
+ * @param domain_id	ID of the domain.
+ * @param pattern	Source name pattern. '*' matches any sequence of
+ *			characters and '?' matches any single character.
+ * @param level		Severity level.
+ *
+ * @return Number of sources matching the pattern, or -ENOTSUP if runtime
+ *	   filtering is disabled or source names are not available.
+ */
+int log_filter_set_by_pattern(struct log_backend const *const backend,
+			      uint32_t domain_id, const char *pattern,
+			      uint32_t level);
+
 /**
  * @brief Get source filter for the frontend.
  *
@@ -295,6 +316,19 @@ int log_mem_get_usage(uint32_t *buf_size, uint32_t *usage);
  */
 int log_mem_get_max_usage(uint32_t *max);
 
+/**
+ * @brief Get number of messages dropped from the buffer of a CPU.
+ *
+ * Messages are accounted to the CPU whose buffer they were allocated from.
+ * Without CONFIG_LOG_PER_CPU_BUFFERS, all messages use the buffer of CPU 0.
+ * The counter is not cleared when drops are reported to the backends.
+ *
+ * @param cpu CPU index.
+ *
+ * @return Number of dropped messages, 0 if @p cpu is out of range.
+ */
+uint32_t log_cpu_dropped_get(unsigned int cpu);
+
 #if defined(CONFIG_LOG) && !defined(CONFIG_LOG_MODE_MINIMAL)
 #define LOG_CORE_INIT() log_core_init()
 #define LOG_PANIC() log_panic()
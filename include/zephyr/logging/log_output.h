@@ -90,6 +90,12 @@ struct log_output_control_block {
 	atomic_t offset;
 	void *ctx;
 	const char *hostname;
+#ifdef CONFIG_LOG_DICTIONARY_COMPACT
+	/* Timestamp of the previous compact dictionary message */
+	log_timestamp_t timestamp;
+	/* Messages left until the next absolute timestamp */
+	uint32_t sync_cnt;
+#endif
 };
 
 /** @brief Log_output instance structure. */
@@ -23,8 +23,33 @@ extern "C" {
 enum log_dict_output_msg_type {
 	MSG_NORMAL = 0,
 	MSG_DROPPED_MSG = 1,
+	MSG_NORMAL_COMPACT = 2,
+	MSG_NORMAL_COMPACT_SYNC = 3,
 };
 
+/**
+ * Compact dictionary based log message (CONFIG_LOG_DICTIONARY_COMPACT).
+ *
+ * The first byte holds the message type in bits 0-2, the log level in
+ * bits 3-5 and the @ref LOG_DICT_COMPACT_HAS_DATA and
+ * @ref LOG_DICT_COMPACT_HAS_DOMAIN flags. It is followed by:
+ *
+ * - domain ID (one byte, only if @ref LOG_DICT_COMPACT_HAS_DOMAIN is set),
+ * - source ID,
+ * - timestamp, relative to the previous message for
+ *   @ref MSG_NORMAL_COMPACT and absolute for @ref MSG_NORMAL_COMPACT_SYNC,
+ * - package length,
+ * - data length (only if @ref LOG_DICT_COMPACT_HAS_DATA is set),
+ * - package and data.
+ *
+ * Integers are encoded as unsigned LEB128, 7 bits per byte with the most
+ * significant bit set on all but the last byte.
+ */
+#define LOG_DICT_COMPACT_TYPE_MASK	0x07
+#define LOG_DICT_COMPACT_LEVEL_SHIFT	3
+#define LOG_DICT_COMPACT_HAS_DATA	BIT(6)
+#define LOG_DICT_COMPACT_HAS_DOMAIN	BIT(7)
+
 /**
  * Output header for one dictionary based log message.
  */
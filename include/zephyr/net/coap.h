@@ -1251,6 +1251,19 @@ void coap_replies_clear(struct coap_reply *replies, size_t len);
  */
 int coap_resource_notify(struct coap_resource *resource);
 
+/**
+ * @brief Indicates that this resource was updated and returns the new
+ * age, to be used as the Observe option value of the notifications.
+ *
+ * This is useful when the notifications are not sent from the @a notify
+ * callback, but built once for all the observers.
+ *
+ * @param resource Resource that was updated
+ *
+ * @return The new age of the resource.
+ */
+int coap_resource_next_age(struct coap_resource *resource);
+
 /**
  * @brief Returns if this request is enabling observing a resource.
  *
@@ -14,6 +14,7 @@
 #define ZEPHYR_INCLUDE_NET_COAP_SERVICE_H_
 
 #include <zephyr/net/coap.h>
+#include <zephyr/sys/dlist.h>
 #include <zephyr/sys/iterable_sections.h>
 
 #ifdef __cplusplus
@@ -46,6 +47,9 @@ struct coap_service_data {
 	int sock_fd;
 	struct coap_observer observers[CONFIG_COAP_SERVICE_OBSERVERS];
 	struct coap_pending pending[CONFIG_COAP_SERVICE_PENDING_MESSAGES];
+	/* Pending messages ordered by their next retransmission time */
+	sys_dlist_t pending_queue;
+	sys_dnode_t pending_nodes[CONFIG_COAP_SERVICE_PENDING_MESSAGES];
 };
 
 struct coap_service {
@@ -61,6 +65,8 @@ struct coap_service {
 #define __z_coap_service_define(_name, _host, _port, _flags, _res_begin, _res_end)		\
 	static struct coap_service_data _CONCAT(coap_service_data_, _name) = {			\
 		.sock_fd = -1,									\
+		.pending_queue = SYS_DLIST_STATIC_INIT(						\
+			&_CONCAT(coap_service_data_, _name).pending_queue),			\
 	};											\
 	const STRUCT_SECTION_ITERABLE(coap_service, _name) = {					\
 		.name = STRINGIFY(_name),							\
@@ -260,6 +266,25 @@ int coap_resource_send(const struct coap_resource *resource, const struct coap_p
 		       const struct sockaddr *addr, socklen_t addr_len,
 		       const struct coap_transmission_parameters *params);
 
+/**
+ * @brief Send a notification to all observers of the provided @p resource .
+ *
+ * @note This function is suitable for a @p resource defined with @ref COAP_RESOURCE_DEFINE.
+ *
+ * The notification is encoded once by the caller, the token and message ID of @p cpkt are
+ * replaced for each observer while the options and the payload are shared by all of them.
+ * The Observe option should be set to the value returned by @ref coap_resource_next_age.
+ * Confirmable notifications are retransmitted until acknowledged like any other message sent
+ * by the service.
+ *
+ * @param resource Pointer to CoAP resource
+ * @param cpkt CoAP notification of type CON or NON to send, with any token and message ID
+ * @param params Pointer to transmission parameters structure or NULL to use default values.
+ * @return the number of notified observers in case of success or negative in case of error.
+ */
+int coap_resource_notify_observers(struct coap_resource *resource, const struct coap_packet *cpkt,
+				   const struct coap_transmission_parameters *params);
+
 /**
  * @brief Parse a CoAP observe request for the provided @p resource .
  *
@@ -592,6 +592,14 @@ struct ethernet_api {
 
 	/** Send a network packet */
 	int (*send)(const struct device *dev, struct net_pkt *pkt);
+
+	/** Send several network packets at once (optional). Returns the
+	 * number of packets, counted from the start of the array, that
+	 * were sent, or a negative error code if none was sent. The
+	 * packets that were not sent are retried one by one with send().
+	 */
+	int (*send_burst)(const struct device *dev, struct net_pkt **pkts,
+			  size_t count);
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -60,6 +60,15 @@ enum http2_frame_type {
 #define HTTP2_HEADERS_FRAME_PRIORITY_LEN 5
 #define HTTP2_PRIORITY_FRAME_LEN 5
 #define HTTP2_RST_STREAM_FRAME_LEN 4
+#define HTTP2_WINDOW_UPDATE_FRAME_LEN 4
+#define HTTP2_SETTINGS_FIELD_LEN 6
+
+#define HTTP2_DEFAULT_WINDOW_SIZE 65535
+#define HTTP2_MAX_WINDOW_SIZE 0x7FFFFFFF
+#define HTTP2_DEFAULT_MAX_FRAME_SIZE 16384
+#define HTTP2_MAX_FRAME_SIZE 16777215
+#define HTTP2_DEFAULT_HEADER_TABLE_SIZE 4096
+#define HTTP2_DEFAULT_WEIGHT 16
 
 /** @endcond */
 
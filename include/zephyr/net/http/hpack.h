@@ -12,6 +12,7 @@
 #ifndef ZEPHYR_INCLUDE_NET_HTTP_SERVER_HPACK_H_
 #define ZEPHYR_INCLUDE_NET_HTTP_SERVER_HPACK_H_
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -127,6 +128,29 @@ struct http_hpack_header_buf {
 	size_t datalen;
 };
 
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE) || defined(__DOXYGEN__)
+/** HPACK encoder dynamic table, kept per connection. */
+struct http_hpack_encoder_table {
+	/** Table entries, newest first. */
+	uint8_t data[CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE];
+
+	/** Number of bytes used in the data buffer. */
+	uint16_t used;
+
+	/** Table size, as defined in RFC 7541 ch. 4.1. */
+	uint16_t size;
+
+	/** Maximum table size. */
+	uint16_t max_size;
+
+	/** Number of entries in the table. */
+	uint16_t count;
+
+	/** Dynamic table size update needs to be signaled to the peer. */
+	bool size_update;
+};
+#endif
+
 /** @cond INTERNAL_HIDDEN */
 
 int http_hpack_huffman_decode(const uint8_t *encoded_buf, size_t encoded_len,
@@ -138,6 +162,15 @@ int http_hpack_decode_header(const uint8_t *buf, size_t datalen,
 int http_hpack_encode_header(uint8_t *buf, size_t buflen,
 			     struct http_hpack_header_buf *header);
 
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+void http_hpack_encoder_table_init(struct http_hpack_encoder_table *table);
+void http_hpack_encoder_table_set_max_size(struct http_hpack_encoder_table *table,
+					   uint32_t max_size);
+int http_hpack_encode_header_table(uint8_t *buf, size_t buflen,
+				   struct http_hpack_header_buf *header,
+				   struct http_hpack_encoder_table *table);
+#endif
+
 /** @endcond */
 
 #ifdef __cplusplus
@@ -23,6 +23,7 @@
 #include <stdint.h>
 
 #include <zephyr/kernel.h>
+#include <zephyr/fs/fs.h>
 #include <zephyr/net/http/parser.h>
 #include <zephyr/net/http/hpack.h>
 #include <zephyr/net/http/status.h>
@@ -351,6 +352,31 @@ struct http2_stream_ctx {
 
 	/** Flag indicating that END_STREAM flag was sent. */
 	bool end_stream_sent : 1;
+
+	/** @cond INTERNAL_HIDDEN */
+
+	/** Stream-level window for sending, granted by the peer. */
+	int32_t send_window;
+
+	/** Stream weight from the priority information (1-256). */
+	uint16_t weight;
+
+	/** Response body data queued for sending. */
+	const uint8_t *tx_data;
+
+	/** Number of response body bytes left to send. */
+	size_t tx_remaining;
+
+	/** File the queued response body is read from. */
+	struct fs_file_t tx_file;
+
+	/** Flag indicating that the queued response is read from tx_file. */
+	bool tx_file_open : 1;
+
+	/** Flag indicating that a response body is waiting to be sent. */
+	bool tx_pending : 1;
+
+	/** @endcond */
 };
 
 /** @brief HTTP/2 frame representation. */
@@ -415,6 +441,20 @@ struct http_client_ctx {
 	/** Connection-level window size. */
 	int window_size;
 
+	/** Connection-level window for sending, granted by the peer. */
+	int32_t send_window;
+
+	/** Initial stream-level window for sending, from the peer settings. */
+	int32_t peer_initial_window;
+
+	/** Maximum frame payload size accepted by the peer. */
+	uint32_t peer_max_frame_size;
+
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+	/** HPACK encoder dynamic table for the response headers. */
+	struct http_hpack_encoder_table hpack_table;
+#endif
+
 	/** Server state for the associated client. */
 	enum http_server_state server_state;
 
@@ -457,6 +497,9 @@ struct http_client_ctx {
 	/** Request method. */
 	enum http_method method;
 
+	/** ETag from the If-None-Match request header (HTTP/1 only). */
+	uint32_t if_none_match;
+
 	/** HTTP/1 parser state. */
 	enum http1_parser_state parser_state;
 
@@ -493,6 +536,12 @@ struct http_client_ctx {
 	/** Flag indicating Websocket key is being processed. */
 	bool websocket_sec_key_next : 1;
 
+	/** Flag indicating If-None-Match header is being processed. */
+	bool if_none_match_next : 1;
+
+	/** Flag indicating that if_none_match holds a valid ETag. */
+	bool has_if_none_match : 1;
+
 	/** The next frame on the stream is expectd to be a continuation frame. */
 	bool expect_continuation : 1;
 };
@@ -526,6 +575,14 @@ int http_server_start(void);
  */
 int http_server_stop(void);
 
+/** @brief Drop all the files from the static file system resource cache.
+ *
+ * Applications that modify files served as static file system resources
+ * should call this so that the new content is served right away. Requires
+ * @kconfig{CONFIG_HTTP_SERVER_STATIC_FS_CACHE}.
+ */
+void http_server_static_fs_cache_flush(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -467,6 +467,68 @@ struct mqtt_transport {
 #endif
 };
 
+#if defined(CONFIG_MQTT_SESSION) || defined(__DOXYGEN__)
+struct zms_fs;
+
+/** @brief Outgoing message stored by the managed session. */
+struct mqtt_session_msg {
+	/** Time of the last transmission, in milliseconds. */
+	uint32_t sent_at;
+
+	/** Length of the encoded packet. */
+	uint16_t len;
+
+	/** Message identifier, 0 for QoS 0 publishes. */
+	uint16_t message_id;
+
+	/** Quality of service of the publish. */
+	uint8_t qos;
+
+	/** Acknowledgement the message waits for. */
+	uint8_t state;
+
+	/** Encoded packet. */
+	uint8_t data[CONFIG_MQTT_SESSION_MSG_SIZE];
+};
+
+/**
+ * @brief Managed publish session.
+ *
+ * The structure is owned by the application but shall only be accessed
+ * through the mqtt_session_* API.
+ */
+struct mqtt_session {
+	/** Publishes waiting for an acknowledgement. */
+	struct mqtt_session_msg inflight[CONFIG_MQTT_SESSION_WINDOW];
+
+	/** Publishes waiting to be sent, oldest first from queue_head. */
+	struct mqtt_session_msg queue[CONFIG_MQTT_SESSION_QUEUE_SIZE];
+
+	/** Index of the oldest queued publish. */
+	uint16_t queue_head;
+
+	/** Number of queued publishes. */
+	uint16_t queue_len;
+
+	/** Number of publishes in flight. */
+	uint16_t inflight_len;
+
+	/** Last message identifier assigned by the session. */
+	uint16_t last_message_id;
+
+#if defined(CONFIG_MQTT_SESSION_ZMS) || defined(__DOXYGEN__)
+	/** File system holding the publishes that did not fit the queue. */
+	struct zms_fs *fs;
+
+	/** Sequence number of the oldest publish stored in flash. */
+	uint32_t fs_head;
+
+	/** Sequence number of the next publish stored in flash. */
+	uint32_t fs_tail;
+#endif
+};
+#endif /* CONFIG_MQTT_SESSION */
+
 /** @brief MQTT internal state. */
 struct mqtt_internal {
 	/** Internal. Mutex to protect access to the client instance. */
@@ -563,6 +625,11 @@ struct mqtt_client {
 
 	/** User specific opaque data */
 	void *user_data;
+
+#if defined(CONFIG_MQTT_SESSION) || defined(__DOXYGEN__)
+	/** Managed publish session, NULL if not used. */
+	struct mqtt_session *session;
+#endif
 };
 
 /**
@@ -834,6 +901,81 @@ int mqtt_read_publish_payload_blocking(struct mqtt_client *client, void *buffer,
 int mqtt_readall_publish_payload(struct mqtt_client *client, uint8_t *buffer,
 				 size_t length);
 
+#if defined(CONFIG_MQTT_SESSION) || defined(__DOXYGEN__)
+/**
+ * @brief Attach a managed publish session to the client.
+ *
+ * Publishes made with @ref mqtt_session_publish are queued in the session
+ * and sent while the client is connected, keeping up to
+ * @kconfig{CONFIG_MQTT_SESSION_WINDOW} QoS 1 and QoS 2 messages in flight.
+ * The session handles PUBACK, PUBREC and PUBCOMP of its messages itself,
+ * including sending PUBREL, and retransmits unacknowledged messages after a
+ * reconnect and from @ref mqtt_live. The acknowledgements are still
+ * reported to the application, which shall not answer PUBREC of session
+ * messages.
+ *
+ * @param[in] client Client instance for which the procedure is requested.
+ *                   Shall not be NULL.
+ * @param[in] session Session storage. It is cleared and shall stay valid as
+ *                    long as the client is used.
+ *
+ * @return 0 or a negative error code (errno.h) indicating reason of failure.
+ */
+int mqtt_session_init(struct mqtt_client *client, struct mqtt_session *session);
+
+/**
+ * @brief Queue a publish in the managed session.
+ *
+ * The message, including its topic and payload, is copied so the caller's
+ * buffers can be reused as soon as the function returns. The message is
+ * sent right away if the client is connected and the in-flight window has
+ * room, otherwise it is sent later. The publish may be called while the
+ * client is disconnected.
+ *
+ * @param[in] client Client instance for which the procedure is requested.
+ *                   Shall not be NULL and shall have a session attached.
+ * @param[in] param Parameters to be used for the publish message. A zero
+ *                  message_id is replaced by one assigned by the session.
+ *
+ * @retval 0 on success.
+ * @retval -EMSGSIZE if the message does not fit @kconfig{CONFIG_MQTT_SESSION_MSG_SIZE}.
+ * @retval -ENOMEM if the queue is full.
+ * @return Other negative error codes (errno.h) if sending failed, the
+ *         message stays queued in that case.
+ */
+int mqtt_session_publish(struct mqtt_client *client,
+			 const struct mqtt_publish_param *param);
+
+/**
+ * @brief Get the number of messages the session has not completed yet.
+ *
+ * @param[in] client Client instance for which the procedure is requested.
+ *                   Shall not be NULL and shall have a session attached.
+ *
+ * @return Number of queued and in-flight messages, or a negative error code
+ *         (errno.h) indicating reason of failure.
+ */
+int mqtt_session_pending(struct mqtt_client *client);
+
+#if defined(CONFIG_MQTT_SESSION_ZMS) || defined(__DOXYGEN__)
+/**
+ * @brief Store the publishes that do not fit the session queue in flash.
+ *
+ * Messages left in flash by a previous run are restored and sent once the
+ * client is connected.
+ *
+ * @param[in] client Client instance for which the procedure is requested.
+ *                   Shall not be NULL and shall have a session attached.
+ * @param[in] fs Mounted ZMS file system, the IDs starting at
+ *               @kconfig{CONFIG_MQTT_SESSION_ZMS_ID_BASE} are reserved for
+ *               the session.
+ *
+ * @return 0 or a negative error code (errno.h) indicating reason of failure.
+ */
+int mqtt_session_storage_set(struct mqtt_client *client, struct zms_fs *fs);
+#endif /* CONFIG_MQTT_SESSION_ZMS */
+#endif /* CONFIG_MQTT_SESSION */
+
 #ifdef __cplusplus
 }
 #endif
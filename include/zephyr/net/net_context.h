@@ -288,6 +288,11 @@ __net_socket struct net_context {
 		/** Mutex used by condition variable */
 		struct k_mutex *lock;
 	} cond;
+
+#if defined(CONFIG_ZVFS_EPOLL)
+	/** Readiness notifiers attached by epoll instances */
+	sys_slist_t poll_notifiers;
+#endif /* CONFIG_ZVFS_EPOLL */
 #endif /* CONFIG_NET_SOCKETS */
 
 #if defined(CONFIG_NET_OFFLOAD)
@@ -1238,6 +1243,38 @@ int net_context_sendmsg(struct net_context *context,
 			k_timeout_t timeout,
 			void *user_data);
 
+/**
+ * @brief Send a chain of network buffers without copying the data.
+ *
+ * @details The buffers are attached to the outgoing packet (UDP) or
+ * to the send queue (TCP) as they are. On success the network stack
+ * owns the buffers and unrefs them when it no longer needs the data,
+ * i.e. after the packet has been transmitted or, for TCP, after the
+ * data has been acknowledged. The caller can track this with the
+ * destroy callback of the buffer pool. On error the buffers still
+ * belong to the caller. The buffers must not be shared with anybody
+ * else as the stack can modify them. Only UDP and TCP contexts that
+ * are not offloaded are supported.
+ *
+ * @param context The network context to use.
+ * @param buf The buffer chain to send
+ * @param dst_addr Destination address. If NULL, the address set by
+ *        net_context_connect() is used.
+ * @param addrlen Length of the address.
+ * @param cb Caller-supplied callback function.
+ * @param timeout Currently this value is not used.
+ * @param user_data Caller-supplied user data.
+ *
+ * @return numbers of bytes sent on success, a negative errno otherwise
+ */
+int net_context_sendto_buf(struct net_context *context,
+			   struct net_buf *buf,
+			   const struct sockaddr *dst_addr,
+			   socklen_t addrlen,
+			   net_context_send_cb_t cb,
+			   k_timeout_t timeout,
+			   void *user_data);
+
 /**
  * @brief Receive network data from a peer specified by context.
  *
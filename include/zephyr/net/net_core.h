@@ -123,6 +123,24 @@ enum net_verdict {
  */
 int net_recv_data(struct net_if *iface, struct net_pkt *pkt);
 
+/**
+ * @brief Called by network device driver when several network packets
+ * have been received. This is the same as calling net_recv_data() for each
+ * packet, but the packets are queued to the RX traffic class threads with
+ * one queue operation per traffic class, so the cost of locking and waking
+ * up the RX threads is shared by the whole batch.
+ *
+ * @param iface Network interface where the packets were received.
+ * @param pkts Array of received network packets.
+ * @param count Number of packets in the array.
+ *
+ * @return Number of packets, counted from the start of the array, that were
+ * taken by the network stack. The caller still owns the remaining ones.
+ * <0 if error and no packet was taken.
+ */
+int net_recv_data_burst(struct net_if *iface, struct net_pkt **pkts,
+			size_t count);
+
 /**
  * @brief Send data to network.
  *
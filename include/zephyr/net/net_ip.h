@@ -1721,6 +1721,71 @@ static inline bool net_tcp_seq_greater(uint32_t seq1, uint32_t seq2)
 	return net_tcp_seq_cmp(seq1, seq2) > 0;
 }
 
+/**
+ * @brief Update an Internet checksum after a 16-bit field was changed.
+ *
+ * @details The checksum is updated incrementally as described in RFC 1624,
+ *          instead of summing the whole header or packet again. The values
+ *          must have the same byte order as the checksum, typically the
+ *          network byte order they have in the header.
+ *
+ * @param chksum Checksum covering the old value of the field
+ * @param old_val Old value of the field
+ * @param new_val New value of the field
+ *
+ * @return Checksum covering the new value of the field
+ */
+static inline uint16_t net_chksum_update16(uint16_t chksum, uint16_t old_val,
+					   uint16_t new_val)
+{
+	/* RFC 1624, eqn. 3: HC' = ~(~HC + ~m + m') */
+	uint32_t sum = (uint16_t)~chksum + (uint16_t)~old_val + (uint32_t)new_val;
+
+	sum = (sum & 0xffff) + (sum >> 16);
+	sum = (sum & 0xffff) + (sum >> 16);
+
+	return (uint16_t)~sum;
+}
+
+/**
+ * @brief Update an Internet checksum after a 32-bit field was changed.
+ *
+ * @details See net_chksum_update16(). Typically used when rewriting an
+ *          IPv4 address.
+ *
+ * @param chksum Checksum covering the old value of the field
+ * @param old_val Old value of the field
+ * @param new_val New value of the field
+ *
+ * @return Checksum covering the new value of the field
+ */
+static inline uint16_t net_chksum_update32(uint16_t chksum, uint32_t old_val,
+					   uint32_t new_val)
+{
+	chksum = net_chksum_update16(chksum, (uint16_t)(old_val >> 16),
+				     (uint16_t)(new_val >> 16));
+
+	return net_chksum_update16(chksum, (uint16_t)old_val, (uint16_t)new_val);
+}
+
+/**
+ * @brief Update an Internet checksum after a field of any size was changed.
+ *
+ * @details See net_chksum_update16(). Typically used when rewriting an
+ *          IPv6 address. The field must start at an even offset of the
+ *          data covered by the checksum, and have an even length.
+ *
+ * @param chksum Checksum covering the old value of the field, in network
+ *        byte order
+ * @param old_data Old value of the field
+ * @param new_data New value of the field
+ * @param len Length of the field
+ *
+ * @return Checksum covering the new value of the field, in network byte order
+ */
+uint16_t net_chksum_update(uint16_t chksum, const void *old_data,
+			   const void *new_data, size_t len);
+
 /**
  * @brief Convert a string of hex values to array of bytes.
  *
@@ -87,6 +87,15 @@ struct net_l2 {
 	int (*alloc)(struct net_if *iface, struct net_pkt *pkt,
 		     size_t size, enum net_ip_protocol proto,
 		     k_timeout_t timeout);
+
+	/**
+	 * Optional function for pushing several packets to lower layer at
+	 * once. For each packet, the status array gets the value the send()
+	 * function would have returned for it, and the packet ownership is
+	 * handled the same way as in send().
+	 */
+	void (*send_burst)(struct net_if *iface, struct net_pkt **pkts,
+			   size_t count, int *status);
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -139,6 +148,7 @@ NET_L2_DECLARE_PUBLIC(CUSTOM_IEEE802154_L2);
 		.alloc = COND_CODE_0(NUM_VA_ARGS_LESS_1(LIST_DROP_EMPTY(__VA_ARGS__, _)), \
 				     (NULL),				\
 				     (GET_ARG_N(1, __VA_ARGS__))),	\
+		.send_burst = GET_ARG_N(2, __VA_ARGS__, NULL, NULL),	\
 	}
 
 #define NET_L2_GET_DATA(name, sfx) _net_l2_data_##name##sfx
@@ -22,6 +22,15 @@
 #include <zephyr/sys/iterable_sections.h>
 #include <zephyr/net/prometheus/metric.h>
 
+/** @cond INTERNAL_HIDDEN */
+
+struct prometheus_counter_cell {
+	atomic_t seq;
+	uint64_t value;
+};
+
+/** @endcond */
+
 /**
  * @brief Type used to represent a Prometheus counter metric.
  *
@@ -31,8 +40,8 @@
 struct prometheus_counter {
 	/** Base of the Prometheus counter metric */
 	struct prometheus_metric base;
-	/** Value of the Prometheus counter metric */
-	uint64_t value;
+	/** Per-CPU parts of the counter value, use prometheus_counter_get() to read it */
+	struct prometheus_counter_cell cells[PROMETHEUS_CELL_COUNT];
 	/** User data */
 	void *user_data;
 };
@@ -65,7 +74,6 @@ struct prometheus_counter {
 		.base.labels[0] = __DEBRACKET _label,			\
 		.base.num_labels = 1,					\
 		.base.collector = _collector,				\
-		.value = 0ULL,						\
 		.user_data = COND_CODE_0(				\
 			NUM_VA_ARGS_LESS_1(LIST_DROP_EMPTY(__VA_ARGS__, _)), \
 			(NULL),						\
@@ -75,6 +83,8 @@ struct prometheus_counter {
 /**
  * @brief Increment the value of a Prometheus counter metric
  * Increments the value of the specified counter metric by arbitrary amount.
+ * The increment only touches the calling CPU's part of the counter, so it
+ * can be used from ISRs and hot paths.
  * @param counter Pointer to the counter metric to increment.
  * @param value Amount to increment the counter by.
  * @return 0 on success, negative errno on error.
@@ -97,13 +107,21 @@ static inline int prometheus_counter_inc(struct prometheus_counter *counter)
  * The new value must be higher than the current value. This function can be used
  * if we cannot add individual increments to the counter but need to periodically
  * update the counter value. This function will add the difference between the
- * new value and the old value to the counter.
+ * new value and the old value to the counter. It must not race with other
+ * updates of the same counter.
  * @param counter Pointer to the counter metric to increment.
  * @param value New value of the counter.
  * @return 0 on success, negative errno on error.
  */
 int prometheus_counter_set(struct prometheus_counter *counter, uint64_t value);
 
+/**
+ * @brief Get the value of a Prometheus counter metric
+ * @param counter Pointer to the counter metric to read.
+ * @return Current value of the counter.
+ */
+uint64_t prometheus_counter_get(const struct prometheus_counter *counter);
+
 /**
  * @}
  */
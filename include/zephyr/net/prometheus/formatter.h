@@ -17,6 +17,7 @@
  */
 
 #include <zephyr/net/prometheus/collector.h>
+#include <zephyr/net/http/server.h>
 
 /**
  * @brief Format exposition data for Prometheus
@@ -49,6 +50,121 @@ int prometheus_format_exposition(struct prometheus_collector *collector, char *b
 int prometheus_format_one_metric(struct prometheus_metric *metric, char *buffer,
 				 size_t buffer_size, int *written);
 
+/**
+ * @brief State of a streamed exposition, see prometheus_format_stream().
+ */
+struct prometheus_format_stream {
+	/** @cond INTERNAL_HIDDEN */
+	struct prometheus_collector *collector;
+	struct prometheus_metric *metric;
+	int line;
+	bool scraped : 1;
+	bool started : 1;
+	/** @endcond */
+};
+
+/**
+ * @brief Start a streamed exposition of a collector
+ *
+ * @param stream Pointer to the stream state to initialize.
+ * @param collector Pointer to the collector to format.
+ *
+ * @return 0 on success, negative errno on error.
+ */
+int prometheus_format_stream_init(struct prometheus_format_stream *stream,
+				  struct prometheus_collector *collector);
+
+/**
+ * @brief Format the next chunk of a streamed exposition
+ *
+ * Fills the buffer with as many complete lines of the exposition as fit, so
+ * that the metrics of a collector can be sent in chunks of any size that
+ * holds the longest line. The collector is only locked while a chunk is
+ * formatted. Metrics registered while a collector is being streamed may be
+ * missed or repeated.
+ *
+ * @param stream Pointer to the stream state.
+ * @param buffer Pointer to the buffer for the chunk. It is NUL terminated.
+ * @param buffer_size Size of the buffer.
+ * @param len Length of the chunk, not including the NUL terminator.
+ *
+ * @retval 0 The last chunk was formatted.
+ * @retval -EAGAIN A chunk was formatted and there is more to come.
+ * @retval -ENOMEM A single line does not fit into the buffer.
+ * @retval <0 Other negative errno on error.
+ */
+int prometheus_format_stream(struct prometheus_format_stream *stream, char *buffer,
+			     size_t buffer_size, size_t *len);
+
+/**
+ * @brief Context for exposing a collector as an HTTP resource
+ *
+ * Pass it as user data of a dynamic HTTP resource that uses
+ * prometheus_http_handler() as its callback.
+ */
+struct prometheus_http_context {
+	/** Collector to expose */
+	struct prometheus_collector *collector;
+	/** Buffer for one chunk of the response */
+	char *buffer;
+	/** Size of the chunk buffer */
+	size_t buffer_size;
+	/** @cond INTERNAL_HIDDEN */
+	struct prometheus_format_stream stream;
+	bool streaming;
+	/** @endcond */
+};
+
+/**
+ * @brief Define a context for exposing a collector as an HTTP resource
+ *
+ * @param _name Name of the context.
+ * @param _collector Pointer to the collector to expose. Can be set to NULL
+ *        and assigned at runtime.
+ * @param _buffer_size Size of the chunk buffer, must hold the longest line.
+ *
+ * Example usage:
+ * @code{.c}
+ *
+ * PROMETHEUS_HTTP_CONTEXT_DEFINE(metrics_ctx, &my_collector, 256);
+ *
+ * struct http_resource_detail_dynamic metrics_resource_detail = {
+ *	.common = {
+ *		.type = HTTP_RESOURCE_TYPE_DYNAMIC,
+ *		.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+ *		.content_type = "text/plain",
+ *	},
+ *	.cb = prometheus_http_handler,
+ *	.user_data = &metrics_ctx,
+ * };
+ * @endcode
+ */
+#define PROMETHEUS_HTTP_CONTEXT_DEFINE(_name, _collector, _buffer_size)	\
+	static char _name##_buffer[_buffer_size];			\
+	struct prometheus_http_context _name = {			\
+		.collector = _collector,				\
+		.buffer = _name##_buffer,				\
+		.buffer_size = sizeof(_name##_buffer),			\
+	}
+
+/**
+ * @brief HTTP dynamic resource callback streaming a collector
+ *
+ * Formats the metrics of the collector in @ref prometheus_http_context given
+ * as user data straight into the HTTP response, one chunk at a time.
+ *
+ * @param client HTTP context information for this client connection.
+ * @param status HTTP data status.
+ * @param request_ctx Request context.
+ * @param response_ctx Response context to populate.
+ * @param user_data Pointer to a @ref prometheus_http_context.
+ *
+ * @return 0 on success, negative errno on error.
+ */
+int prometheus_http_handler(struct http_client_ctx *client, enum http_data_status status,
+			    const struct http_request_ctx *request_ctx,
+			    struct http_response_ctx *response_ctx, void *user_data);
+
 /**
  * @}
  */
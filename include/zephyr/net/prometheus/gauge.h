@@ -17,6 +17,7 @@
  * @{
  */
 
+#include <zephyr/spinlock.h>
 #include <zephyr/sys/iterable_sections.h>
 #include <zephyr/net/prometheus/metric.h>
 
@@ -31,6 +32,8 @@ struct prometheus_gauge {
 	struct prometheus_metric base;
 	/** Value of the Prometheus gauge metric */
 	double value;
+	/** Protects the value, which may not be written atomically */
+	struct k_spinlock lock;
 	/** User data */
 	void *user_data;
 };
@@ -83,6 +86,15 @@ struct prometheus_gauge {
  */
 int prometheus_gauge_set(struct prometheus_gauge *gauge, double value);
 
+/**
+ * @brief Get the value of a Prometheus gauge metric
+ *
+ * @param gauge Pointer to the gauge metric to read.
+ *
+ * @return Current value of the gauge.
+ */
+double prometheus_gauge_get(const struct prometheus_gauge *gauge);
+
 /**
  * @}
  */
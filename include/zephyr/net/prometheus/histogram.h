@@ -25,15 +25,29 @@
 /**
  * @brief Prometheus histogram bucket definition.
  *
- * This structure defines a Prometheus histogram bucket.
+ * This structure defines a Prometheus histogram bucket. Buckets must be
+ * sorted by their upper bound.
  */
 struct prometheus_histogram_bucket {
 	/** Upper bound value of bucket */
 	double upper_bound;
-	/** Cumulative count of observations in the bucket */
+	/** Per-CPU count of observations that fell into this bucket and not
+	 * into a lower one. Use prometheus_histogram_get_bucket() to get the
+	 * cumulative count.
+	 */
+	unsigned long cells[PROMETHEUS_CELL_COUNT];
+};
+
+/** @cond INTERNAL_HIDDEN */
+
+struct prometheus_histogram_cell {
+	atomic_t seq;
 	unsigned long count;
+	double sum;
 };
 
+/** @endcond */
+
 /**
  * @brief Type used to represent a Prometheus histogram metric.
  *
@@ -47,10 +61,11 @@ struct prometheus_histogram {
 	struct prometheus_histogram_bucket *buckets;
 	/** Number of buckets in the histogram */
 	size_t num_buckets;
-	/** Sum of all observed values in the histogram */
-	double sum;
-	/** Total count of observations in the histogram */
-	unsigned long count;
+	/** Per-CPU sum and count of the observations, use
+	 * prometheus_histogram_get_sum() and prometheus_histogram_get_count()
+	 * to read them.
+	 */
+	struct prometheus_histogram_cell cells[PROMETHEUS_CELL_COUNT];
 	/** User data */
 	void *user_data;
 };
@@ -86,8 +101,6 @@ struct prometheus_histogram {
 		.base.collector = _collector,				\
 		.buckets = NULL,					\
 		.num_buckets = 0,					\
-		.sum = 0.0,						\
-		.count = 0U,						\
 		.user_data = COND_CODE_0(				\
 			NUM_VA_ARGS_LESS_1(LIST_DROP_EMPTY(__VA_ARGS__, _)), \
 			(NULL),						\
@@ -97,7 +110,9 @@ struct prometheus_histogram {
 /**
  * @brief Observe a value in a Prometheus histogram metric
  *
- * Observes the specified value in the given histogram metric.
+ * Observes the specified value in the given histogram metric. Only the
+ * calling CPU's part of the histogram is updated, so this can be used from
+ * ISRs and hot paths.
  *
  * @param histogram Pointer to the histogram metric to observe.
  * @param value Value to observe in the histogram metric.
@@ -105,6 +120,33 @@ struct prometheus_histogram {
  */
 int prometheus_histogram_observe(struct prometheus_histogram *histogram, double value);
 
+/**
+ * @brief Get the sum of the values observed by a Prometheus histogram metric
+ *
+ * @param histogram Pointer to the histogram metric to read.
+ * @return Sum of the observed values.
+ */
+double prometheus_histogram_get_sum(const struct prometheus_histogram *histogram);
+
+/**
+ * @brief Get the number of values observed by a Prometheus histogram metric
+ *
+ * @param histogram Pointer to the histogram metric to read.
+ * @return Number of observed values.
+ */
+unsigned long prometheus_histogram_get_count(const struct prometheus_histogram *histogram);
+
+/**
+ * @brief Get the cumulative count of a Prometheus histogram bucket
+ *
+ * @param histogram Pointer to the histogram metric to read.
+ * @param bucket Index of the bucket.
+ * @return Number of observed values less than or equal to the upper bound
+ *         of the bucket.
+ */
+unsigned long prometheus_histogram_get_bucket(const struct prometheus_histogram *histogram,
+					      size_t bucket);
+
 /**
  * @}
  */
@@ -17,10 +17,24 @@
  * @{
  */
 
+#include <zephyr/sys/atomic.h>
 #include <zephyr/sys/iterable_sections.h>
 #include <zephyr/sys/slist.h>
 #include <zephyr/net/prometheus/label.h>
 
+/** @cond INTERNAL_HIDDEN */
+
+/* Metric values are split into one cell per CPU, so that updates never
+ * contend with other CPUs. The cells are summed when the metric is read.
+ */
+#if defined(CONFIG_SMP)
+#define PROMETHEUS_CELL_COUNT CONFIG_MP_MAX_NUM_CPUS
+#else
+#define PROMETHEUS_CELL_COUNT 1
+#endif
+
+/** @endcond */
+
 /**
  * @brief Prometheus metric types.
  *
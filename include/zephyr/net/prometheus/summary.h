@@ -36,6 +36,16 @@ struct prometheus_summary_quantile {
 	void *user_data;
 };
 
+/** @cond INTERNAL_HIDDEN */
+
+struct prometheus_summary_cell {
+	atomic_t seq;
+	unsigned long count;
+	double sum;
+};
+
+/** @endcond */
+
 /**
  * @brief Type used to represent a Prometheus summary metric.
  *
@@ -49,10 +59,11 @@ struct prometheus_summary {
 	struct prometheus_summary_quantile *quantiles;
 	/** Number of quantiles associated with the Prometheus summary metric */
 	size_t num_quantiles;
-	/** Sum of all observed values in the summary metric */
-	double sum;
-	/** Total count of observations in the summary metric */
-	unsigned long count;
+	/** Per-CPU sum and count of the observations, use
+	 * prometheus_summary_get_sum() and prometheus_summary_get_count()
+	 * to read them.
+	 */
+	struct prometheus_summary_cell cells[PROMETHEUS_CELL_COUNT];
 	/** User data */
 	void *user_data;
 };
@@ -90,8 +101,6 @@ struct prometheus_summary {
 		.base.collector = _collector,				\
 		.quantiles = NULL,					\
 		.num_quantiles = 0,					\
-		.sum = 0.0,						\
-		.count = 0U,						\
 		.user_data = COND_CODE_0(				\
 			NUM_VA_ARGS_LESS_1(LIST_DROP_EMPTY(__VA_ARGS__, _)), \
 			(NULL),						\
@@ -101,7 +110,9 @@ struct prometheus_summary {
 /**
  * @brief Observes a value in a Prometheus summary metric
  *
- * Observes the specified value in the given summary metric.
+ * Observes the specified value in the given summary metric. Only the
+ * calling CPU's part of the summary is updated, so this can be used from
+ * ISRs and hot paths.
  *
  * @param summary Pointer to the summary metric to observe.
  * @param value Value to observe in the summary metric.
@@ -114,7 +125,8 @@ int prometheus_summary_observe(struct prometheus_summary *summary, double value)
  * The new value must be higher than the current value. This function can be used
  * if we cannot add individual increments to the summary but need to periodically
  * update the counter value. This function will add the difference between the
- * new value and the old value to the summary fields.
+ * new value and the old value to the summary fields. It must not race with
+ * other updates of the same summary.
  * @param summary Pointer to the summary metric to increment.
  * @param value New value of the summary.
  * @param count New counter value of the summary.
@@ -123,6 +135,22 @@ int prometheus_summary_observe(struct prometheus_summary *summary, double value)
 int prometheus_summary_observe_set(struct prometheus_summary *summary,
 				   double value, unsigned long count);
 
+/**
+ * @brief Get the sum of the values observed by a Prometheus summary metric
+ *
+ * @param summary Pointer to the summary metric to read.
+ * @return Sum of the observed values.
+ */
+double prometheus_summary_get_sum(const struct prometheus_summary *summary);
+
+/**
+ * @brief Get the number of values observed by a Prometheus summary metric
+ *
+ * @param summary Pointer to the summary metric to read.
+ * @return Number of observed values.
+ */
+unsigned long prometheus_summary_get_count(const struct prometheus_summary *summary);
+
 /**
  * @}
  */
@@ -31,6 +31,7 @@
 #include <zephyr/net/net_ip.h>
 #include <zephyr/net/socket_select.h>
 #include <zephyr/net/socket_poll.h>
+#include <zephyr/net/socket_epoll.h>
 #include <zephyr/sys/iterable_sections.h>
 #include <zephyr/sys/fdtable.h>
 #include <zephyr/net/dns_resolve.h>
@@ -236,6 +237,11 @@ extern "C" {
  *  will take place in consecutive send()/recv() call.
  */
 #define TLS_DTLS_HANDSHAKE_ON_CONNECT 18
+/** Read-only socket option to get the TLS session resumption statistics.
+ *  The option accepts a pointer to a @ref tls_session_cache_stats structure,
+ *  filled with the counters shared by all TLS/DTLS sockets.
+ */
+#define TLS_SESSION_CACHE_STATS 19
 
 /* Valid values for @ref TLS_PEER_VERIFY option */
 #define TLS_PEER_VERIFY_NONE 0     /**< Peer verification disabled. */
@@ -264,6 +270,15 @@ extern "C" {
 #define TLS_DTLS_CID_STATUS_DOWNLINK		1 /**< CID is in use by us */
 #define TLS_DTLS_CID_STATUS_UPLINK		2 /**< CID is in use by peer */
 #define TLS_DTLS_CID_STATUS_BIDIRECTIONAL	3 /**< CID is in use by us and peer */
+
+/** Session resumption counters returned by @ref TLS_SESSION_CACHE_STATS */
+struct tls_session_cache_stats {
+	uint32_t hits;          /**< Sessions resumed from the session cache */
+	uint32_t misses;        /**< Session cache lookups that failed */
+	uint32_t ticket_hits;   /**< Sessions resumed from a session ticket */
+	uint32_t ticket_misses; /**< Session tickets that were rejected */
+	uint32_t evictions;     /**< Cached sessions dropped to make room */
+};
 /** @} */ /* for @name */
 /** @} */ /* for @defgroup */
 
@@ -516,6 +531,105 @@ static inline ssize_t zsock_recv(int sock, void *buf, size_t max_len,
 	return zsock_recvfrom(sock, buf, max_len, flags, NULL, NULL);
 }
 
+struct net_buf;
+
+/**
+ * @brief Send a chain of network buffers without copying the data
+ *
+ * @details
+ * Zephyr-specific zero-copy variant of zsock_sendto(). The buffers are
+ * handed over to the network stack as they are: on success the stack
+ * owns them and unrefs them once the data is no longer needed, i.e. after
+ * the datagram has been transmitted or, for a stream socket, after the
+ * peer has acknowledged the data. Applications that need a completion
+ * notification can allocate the buffers from a pool having a destroy
+ * callback. On error the buffers still belong to the caller.
+ *
+ * The buffers must have a single reference and must not be touched by
+ * the application after a successful call. A datagram socket sends the
+ * whole chain as one datagram, and a stream socket queues the whole chain
+ * once it fits in the free send window. A chain larger than the send
+ * buffer of a stream socket fails with EMSGSIZE. Only native UDP and TCP
+ * sockets support this, other sockets fail with EOPNOTSUPP.
+ *
+ * This function is not a system call and can only be used from supervisor
+ * threads. It is available if @kconfig{CONFIG_NET_SOCKETS_ZEROCOPY} is
+ * enabled.
+ *
+ * @param sock Socket descriptor.
+ * @param buf Buffer chain to send.
+ * @param flags Send flags, only ZSOCK_MSG_DONTWAIT is used.
+ * @param dest_addr Destination address, NULL for a connected socket.
+ * @param addrlen Length of the destination address.
+ *
+ * @return Number of bytes sent on success, -1 and errno set on error.
+ */
+ssize_t zsock_sendto_buf(int sock, struct net_buf *buf, int flags,
+			 const struct sockaddr *dest_addr, socklen_t addrlen);
+
+/**
+ * @brief Receive data as a chain of network buffers without copying it
+ *
+ * @details
+ * Zephyr-specific zero-copy variant of zsock_recvfrom(). Instead of
+ * copying the data to an application buffer, the network buffers holding
+ * the payload of the next received packet are detached from it and
+ * returned. The application owns the returned chain and must release it
+ * with net_buf_unref() when done. Buffers held by the application are not
+ * available to the network stack, so they should be released promptly.
+ *
+ * A datagram socket returns one whole datagram per call, a stream socket
+ * returns the data of the next queued TCP segment. ZSOCK_MSG_PEEK is not
+ * supported. The function is not a system call and can only be used from
+ * supervisor threads. It is available if
+ * @kconfig{CONFIG_NET_SOCKETS_ZEROCOPY} is enabled.
+ *
+ * @param sock Socket descriptor.
+ * @param buf Set to the received buffer chain, or NULL if no data.
+ * @param flags Receive flags, only ZSOCK_MSG_DONTWAIT is used.
+ * @param src_addr Source address of a datagram, can be NULL.
+ * @param addrlen Length of the source address, can be NULL.
+ *
+ * @return Number of bytes received, 0 on end of stream, -1 and errno
+ *         set on error.
+ */
+ssize_t zsock_recvfrom_buf(int sock, struct net_buf **buf, int flags,
+			   struct sockaddr *src_addr, socklen_t *addrlen);
+
+struct fs_file_t;
+
+/**
+ * @brief Send data from a file to a socket
+ *
+ * @details
+ * Zephyr-specific equivalent of the Linux sendfile() call. Up to @p count
+ * bytes of the file are sent to the socket. If
+ * @kconfig{CONFIG_NET_SOCKETS_ZEROCOPY} is enabled and the socket supports
+ * zsock_sendto_buf(), the file is read straight into network buffers that
+ * are handed over to the stack, so the data is copied only once. Otherwise
+ * the file is sent in chunks through an intermediate buffer.
+ *
+ * If @p offset is not NULL, the file is read from that offset, which is
+ * updated to follow the last byte sent, and the file position is left
+ * unchanged. If @p offset is NULL, the file is read from, and the file
+ * position is advanced past, the bytes sent.
+ *
+ * The function is not a system call and can only be used from supervisor
+ * threads. It is available if @kconfig{CONFIG_NET_SOCKETS_SENDFILE} is
+ * enabled.
+ *
+ * @param out_sock Socket descriptor.
+ * @param file Opened file to read from.
+ * @param offset File offset to read from, or NULL to use the file position.
+ * @param count Number of bytes to send.
+ *
+ * @return Number of bytes sent on success, which is less than @p count if
+ *         the end of the file was reached or the socket would block, -1 and
+ *         errno set on error.
+ */
+ssize_t zsock_sendfile(int out_sock, struct fs_file_t *file, off_t *offset,
+		       size_t count);
+
 /**
  * @brief Control blocking/non-blocking mode of a socket
  *
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_
+#define ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_
+
+#include <zephyr/zvfs/epoll.h>
+
+/**
+ * @brief BSD Sockets compatible API
+ * @defgroup bsd_sockets BSD Sockets compatible API
+ * @ingroup networking
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name Options for epoll()
+ * @{
+ */
+/** zsock_epoll: Socket is readable */
+#define ZSOCK_EPOLLIN ZVFS_EPOLLIN
+/** zsock_epoll: Exceptional condition */
+#define ZSOCK_EPOLLPRI ZVFS_EPOLLPRI
+/** zsock_epoll: Socket is writable */
+#define ZSOCK_EPOLLOUT ZVFS_EPOLLOUT
+/** zsock_epoll: Error condition, always reported */
+#define ZSOCK_EPOLLERR ZVFS_EPOLLERR
+/** zsock_epoll: Connection closed, always reported */
+#define ZSOCK_EPOLLHUP ZVFS_EPOLLHUP
+/** zsock_epoll: Report once, then disable until re-armed */
+#define ZSOCK_EPOLLONESHOT ZVFS_EPOLLONESHOT
+/** zsock_epoll: Edge triggered mode */
+#define ZSOCK_EPOLLET ZVFS_EPOLLET
+
+/** zsock_epoll_ctl: Add a socket */
+#define ZSOCK_EPOLL_CTL_ADD ZVFS_EPOLL_CTL_ADD
+/** zsock_epoll_ctl: Remove a socket */
+#define ZSOCK_EPOLL_CTL_DEL ZVFS_EPOLL_CTL_DEL
+/** zsock_epoll_ctl: Change the events of a socket */
+#define ZSOCK_EPOLL_CTL_MOD ZVFS_EPOLL_CTL_MOD
+/** @} */
+
+#ifdef __DOXYGEN__
+/**
+ * @brief Events of a socket watched by an epoll instance.
+ */
+struct zsock_epoll_event {
+	uint32_t events;         /**< Requested or returned events */
+	zvfs_epoll_data_t data;  /**< User data */
+};
+#else
+#define zsock_epoll_event zvfs_epoll_event
+#endif
+
+/**
+ * @brief Create an epoll instance to watch sockets
+ *
+ * @details
+ * Unlike zsock_poll(), the set of watched sockets is kept by the
+ * instance, and the sockets notify it when they become ready. The cost
+ * of zsock_epoll_wait() is thus proportional to the number of ready
+ * sockets. Requires @kconfig{CONFIG_ZVFS_EPOLL}.
+ */
+static inline int zsock_epoll_create(int flags)
+{
+	return zvfs_epoll_create(flags);
+}
+
+/**
+ * @brief Add, modify or remove a socket watched by an epoll instance
+ */
+static inline int zsock_epoll_ctl(int epfd, int op, int sock,
+				  struct zsock_epoll_event *event)
+{
+	return zvfs_epoll_ctl(epfd, op, sock, event);
+}
+
+/**
+ * @brief Wait for events on the sockets watched by an epoll instance
+ */
+static inline int zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+				   int maxevents, int timeout)
+{
+	return zvfs_epoll_wait(epfd, events, maxevents, timeout);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_NET_SOCKET_EPOLL_H_ */
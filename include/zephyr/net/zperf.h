@@ -46,6 +46,8 @@ struct zperf_upload_params {
 		int tcp_nodelay;
 		int priority;
 		uint32_t report_interval_ms;
+		uint8_t num_streams;
+		uint16_t bidir_port;
 	} options;
 };
 
@@ -57,6 +59,9 @@ struct zperf_download_params {
 
 /** @endcond */
 
+/** Number of buckets in the send latency histogram */
+#define ZPERF_LATENCY_HIST_BUCKETS 16
+
 /** Performance results */
 struct zperf_results {
 	uint32_t nb_packets_sent;     /**< Number of packets sent */
@@ -69,6 +74,14 @@ struct zperf_results {
 	uint64_t client_time_in_us;   /**< Client connection time in microseconds */
 	uint32_t packet_size;         /**< Packet size */
 	uint32_t nb_packets_errors;   /**< Number of packet errors */
+	uint32_t num_streams;         /**< Number of parallel streams */
+	uint32_t send_jitter_in_us;   /**< Send latency jitter in microseconds */
+	uint64_t cpu_cycles;          /**< Non-idle CPU cycles spent, summed over all CPUs */
+	/**
+	 * Send latency histogram, bucket N counts the send calls that took
+	 * less than 2^N microseconds. The last bucket counts the remaining ones.
+	 */
+	uint32_t send_latency_hist[ZPERF_LATENCY_HIST_BUCKETS];
 };
 
 /**
@@ -86,6 +99,9 @@ typedef void (*zperf_callback)(enum zperf_status status,
  * @brief Synchronous UDP upload operation. The function blocks until the upload
  *        is complete.
  *
+ * If @p param requests more than one stream, each stream uses its own socket
+ * and thread and the results are aggregated. The rate applies to each stream.
+ *
  * @param param Upload parameters.
  * @param result Session results.
  *
@@ -98,6 +114,9 @@ int zperf_udp_upload(const struct zperf_upload_params *param,
  * @brief Synchronous TCP upload operation. The function blocks until the upload
  *        is complete.
  *
+ * If @p param requests more than one stream, each stream uses its own
+ * connection and thread and the results are aggregated.
+ *
  * @param param Upload parameters.
  * @param result Session results.
  *
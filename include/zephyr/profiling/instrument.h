@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_PROFILING_INSTRUMENT_H_
+#define ZEPHYR_INCLUDE_PROFILING_INSTRUMENT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Function instrumentation
+ * @defgroup profiling_instrument Function instrumentation
+ * @ingroup os_services
+ * @{
+ */
+
+/** Statistics of one instrumented function */
+struct instrument_func_stats {
+	/** Function address */
+	uintptr_t addr;
+	/** Number of calls */
+	uint32_t calls;
+	/** Cycles spent in the function, including the functions it called */
+	uint64_t inclusive;
+	/** Cycles spent in the function itself */
+	uint64_t exclusive;
+};
+
+/**
+ * @brief Callback writing a piece of an export.
+ *
+ * @param data Data to write.
+ * @param len Length of @p data.
+ * @param ctx User context.
+ *
+ * @return 0 on success, negative error code otherwise.
+ */
+typedef int (*instrument_write_t)(const char *data, size_t len, void *ctx);
+
+/**
+ * @brief Enable or disable recording.
+ *
+ * Recording is enabled at boot.
+ *
+ * @param enable True to record calls of instrumented functions.
+ */
+void instrument_enable(bool enable);
+
+/**
+ * @brief Clear the function statistics and the recorded trace.
+ */
+void instrument_reset(void);
+
+/**
+ * @brief Call @p cb for the statistics of each called function.
+ *
+ * @param cb Callback, returning non-zero stops the iteration.
+ * @param data User data passed to @p cb.
+ *
+ * @return Number of calls that were not counted in the statistics as the
+ *         function table was full.
+ */
+uint32_t instrument_func_stats_foreach(int (*cb)(const struct instrument_func_stats *stats,
+						 void *data),
+				       void *data);
+
+/**
+ * @brief Export the recorded calls in the Chrome trace event format.
+ *
+ * The output is a JSON object that Perfetto and chrome://tracing load. Each
+ * call is a complete ("X") event of the thread it ran on. Recording is
+ * paused during the export.
+ *
+ * @param write Callback writing the output.
+ * @param ctx User context passed to @p write.
+ *
+ * @retval 0 on success.
+ * @retval -ENOTSUP if no trace is recorded.
+ * @retval Error returned by @p write.
+ */
+int instrument_chrome_trace_export(instrument_write_t write, void *ctx);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_PROFILING_INSTRUMENT_H_ */
@@ -16,6 +16,7 @@
 #include <zephyr/logging/log_instance.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/sys/iterable_sections.h>
+#include <zephyr/sys/ring_buffer.h>
 #include <zephyr/sys/util.h>
 
 #if defined CONFIG_SHELL_GETOPT
@@ -894,6 +895,17 @@ struct shell_ctx {
 	struct k_mutex wr_mtx;
 	k_tid_t tid;
 	int ret_val;
+
+#if defined(CONFIG_SHELL_TX_BUFFER)
+	/** Output waiting to be written to the transport. */
+	struct ring_buf tx_ringbuf;
+	struct k_mutex tx_mtx;
+	/** Signaled each time output was written to the transport. */
+	struct k_condvar tx_done;
+	/** Output thread or thread writing directly that uses the transport. */
+	k_tid_t tx_writer;
+	uint8_t tx_buf[CONFIG_SHELL_TX_BUFFER_SIZE];
+#endif
 };
 
 extern const struct log_backend_api log_backend_shell_api;
@@ -935,6 +947,11 @@ struct shell {
 extern void z_shell_print_stream(const void *user_ctx, const char *data,
 				 size_t data_len);
 
+/** @internal @brief Wait until the output buffer of the instance is written
+ * to the transport. Does nothing without @kconfig{CONFIG_SHELL_TX_BUFFER}.
+ */
+void z_shell_tx_buffer_flush(const struct shell *sh);
+
 /** @brief Internal macro for defining a shell instance.
  *
  * As it does not create the default shell logging backend it allows to use
@@ -1088,6 +1105,20 @@ void __printf_like(3, 4) shell_fprintf_impl(const struct shell *sh, enum shell_v
 void shell_vfprintf(const struct shell *sh, enum shell_vt100_color color,
 		   const char *fmt, va_list args);
 
+/**
+ * @brief Write data to the shell without formatting.
+ *
+ * Faster than printing the data with shell_fprintf() and "%.*s" as the data is
+ * written in one go instead of character by character. Line feeds are mapped
+ * the same way. This function can be used from the command handler or from
+ * threads, but not from an interrupt context.
+ *
+ * @param[in] sh	Pointer to the shell instance.
+ * @param[in] data	Data to write.
+ * @param[in] length	Length of the data.
+ */
+void shell_write(const struct shell *sh, const void *data, size_t length);
+
 /**
  * @brief Print a line of data in hexadecimal format.
  *
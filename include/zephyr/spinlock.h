@@ -116,6 +116,17 @@ bool z_spin_lock_mem_coherent(struct k_spinlock *l);
 
 #endif /* CONFIG_SPIN_VALIDATE */
 
+/* Contended acquisitions spin out of line when the contention profiler
+ * records them.
+ */
+#ifdef CONFIG_OBJ_CORE_CONTENTION_SPINLOCK
+#ifdef CONFIG_TICKET_SPINLOCKS
+void z_spin_lock_contended(struct k_spinlock *l, atomic_val_t ticket);
+#else
+void z_spin_lock_contended(struct k_spinlock *l);
+#endif /* CONFIG_TICKET_SPINLOCKS */
+#endif /* CONFIG_OBJ_CORE_CONTENTION_SPINLOCK */
+
 /**
  * @brief Spinlock key type
  *
@@ -198,14 +209,26 @@ static ALWAYS_INLINE k_spinlock_key_t k_spin_lock(struct k_spinlock *l)
 	 * receiving a ticket
 	 */
 	atomic_val_t ticket = atomic_inc(&l->tail);
+#ifdef CONFIG_OBJ_CORE_CONTENTION_SPINLOCK
+	if (atomic_get(&l->owner) != ticket) {
+		z_spin_lock_contended(l, ticket);
+	}
+#else
 	/* Spin until our ticket is served */
 	while (atomic_get(&l->owner) != ticket) {
 		arch_spin_relax();
 	}
+#endif /* CONFIG_OBJ_CORE_CONTENTION_SPINLOCK */
+#else
+#ifdef CONFIG_OBJ_CORE_CONTENTION_SPINLOCK
+	if (!atomic_cas(&l->locked, 0, 1)) {
+		z_spin_lock_contended(l);
+	}
 #else
 	while (!atomic_cas(&l->locked, 0, 1)) {
 		arch_spin_relax();
 	}
+#endif /* CONFIG_OBJ_CORE_CONTENTION_SPINLOCK */
 #endif /* CONFIG_TICKET_SPINLOCKS */
 #endif /* CONFIG_SMP */
 	z_spinlock_validate_post(l);
@@ -244,6 +244,61 @@ struct zvfs_pollfd {
 
 __syscall int zvfs_poll(struct zvfs_pollfd *fds, int nfds, int poll_timeout);
 
+struct zvfs_poll_notifier;
+
+/**
+ * @brief Readiness notification callback
+ *
+ * Called with ZVFS_POLL* event bits that may have become ready. The
+ * callback runs with a spinlock held and possibly from the context of
+ * the network stack, so it must not block.
+ *
+ * @param notifier Notifier registered to the object
+ * @param events Events that may be ready, ZVFS_POLLNVAL if the object is
+ *        being closed. In the latter case the notifier has been detached
+ *        already.
+ */
+typedef void (*zvfs_poll_notifier_cb_t)(struct zvfs_poll_notifier *notifier, short events);
+
+/**
+ * @brief Readiness notifier attached to a file descriptor object
+ *
+ * Objects that support persistent readiness notification keep a list of
+ * these, attached with ZFD_IOCTL_POLL_NOTIFIER_ADD and detached with
+ * ZFD_IOCTL_POLL_NOTIFIER_REMOVE. Such objects also answer
+ * ZFD_IOCTL_POLL_STATUS with their current readiness, and must call
+ * zvfs_poll_notify() with ZVFS_POLLNVAL when they are closed.
+ */
+struct zvfs_poll_notifier {
+	sys_snode_t node;
+	zvfs_poll_notifier_cb_t cb;
+};
+
+/**
+ * @brief Attach a notifier to the notifier list of an object
+ *
+ * @param notifiers Notifier list of the object
+ * @param notifier Notifier to attach
+ */
+void zvfs_poll_notifier_add(sys_slist_t *notifiers, struct zvfs_poll_notifier *notifier);
+
+/**
+ * @brief Detach a notifier from the notifier list of an object
+ *
+ * @param notifiers Notifier list of the object
+ * @param notifier Notifier to detach
+ */
+void zvfs_poll_notifier_remove(sys_slist_t *notifiers, struct zvfs_poll_notifier *notifier);
+
+/**
+ * @brief Notify the readiness change of an object to all its notifiers
+ *
+ * @param notifiers Notifier list of the object
+ * @param events Events that may have become ready. If ZVFS_POLLNVAL is
+ *        set, all the notifiers are detached as well.
+ */
+void zvfs_poll_notify(sys_slist_t *notifiers, short events);
+
 struct zvfs_fd_set {
 	uint32_t bitset[(CONFIG_ZVFS_OPEN_MAX + 31) / 32];
 };
@@ -280,6 +335,11 @@ enum {
 	ZFD_IOCTL_STAT,
 	ZFD_IOCTL_TRUNCATE,
 	ZFD_IOCTL_MMAP,
+	ZFD_IOCTL_SENDTO_BUF,
+	ZFD_IOCTL_RECVFROM_BUF,
+	ZFD_IOCTL_POLL_NOTIFIER_ADD,
+	ZFD_IOCTL_POLL_NOTIFIER_REMOVE,
+	ZFD_IOCTL_POLL_STATUS,
 
 	/* Codes above 0x5400 and below 0x5500 are reserved for termios, FIO, etc */
 	ZFD_IOCTL_FIONREAD = 0x541B,
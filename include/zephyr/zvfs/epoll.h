@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZEPHYR_ZVFS_EPOLL_H_
+#define ZEPHYR_INCLUDE_ZEPHYR_ZVFS_EPOLL_H_
+
+#include <stdint.h>
+
+#include <zephyr/sys/fdtable.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ZVFS_EPOLLIN  ZVFS_POLLIN
+#define ZVFS_EPOLLPRI ZVFS_POLLPRI
+#define ZVFS_EPOLLOUT ZVFS_POLLOUT
+#define ZVFS_EPOLLERR ZVFS_POLLERR
+#define ZVFS_EPOLLHUP ZVFS_POLLHUP
+
+/** Report the descriptor once, then disable it until re-armed with ZVFS_EPOLL_CTL_MOD */
+#define ZVFS_EPOLLONESHOT BIT(30)
+/** Edge triggered: report only changes of the readiness state */
+#define ZVFS_EPOLLET BIT(31)
+
+#define ZVFS_EPOLL_CTL_ADD 1
+#define ZVFS_EPOLL_CTL_DEL 2
+#define ZVFS_EPOLL_CTL_MOD 3
+
+typedef union zvfs_epoll_data {
+	void *ptr;
+	int fd;
+	uint32_t u32;
+	uint64_t u64;
+} zvfs_epoll_data_t;
+
+struct zvfs_epoll_event {
+	/** Requested events when registering, returned events when waiting */
+	uint32_t events;
+	/** User data returned with the events */
+	zvfs_epoll_data_t data;
+};
+
+/**
+ * @brief Create a ZVFS epoll instance
+ *
+ * An epoll instance keeps a persistent set of watched file descriptors.
+ * The watched objects notify the instance when their readiness changes,
+ * so waiting for events costs time proportional to the number of ready
+ * descriptors rather than to the number of watched ones.
+ *
+ * A file descriptor can only be watched if its object supports readiness
+ * notifications, which are currently native network sockets.
+ *
+ * @param flags Must be 0.
+ *
+ * @return New epoll file descriptor on success, -1 on error
+ */
+int zvfs_epoll_create(int flags);
+
+/**
+ * @brief Add, modify or remove a file descriptor of an epoll instance
+ *
+ * @param epfd Epoll file descriptor
+ * @param op ZVFS_EPOLL_CTL_ADD, ZVFS_EPOLL_CTL_MOD or ZVFS_EPOLL_CTL_DEL
+ * @param fd Watched file descriptor
+ * @param event Requested events and user data, ignored for
+ *        ZVFS_EPOLL_CTL_DEL
+ *
+ * @return 0 on success, -1 on error
+ */
+int zvfs_epoll_ctl(int epfd, int op, int fd, struct zvfs_epoll_event *event);
+
+/**
+ * @brief Wait for events on an epoll instance
+ *
+ * Level triggered descriptors are reported as long as they are ready,
+ * edge triggered (ZVFS_EPOLLET) ones only once after each notification.
+ * ZVFS_EPOLLERR and ZVFS_EPOLLHUP are always reported. Descriptors that
+ * have been closed are removed from the instance automatically.
+ *
+ * @param epfd Epoll file descriptor
+ * @param events Array receiving the events
+ * @param maxevents Size of the events array
+ * @param timeout Timeout in milliseconds, -1 to wait forever
+ *
+ * @return Number of descriptors ready, 0 on timeout, -1 on error
+ */
+int zvfs_epoll_wait(int epfd, struct zvfs_epoll_event *events, int maxevents, int timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZEPHYR_ZVFS_EPOLL_H_ */
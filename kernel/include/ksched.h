@@ -347,4 +347,30 @@ static inline void z_sched_usage_switch(struct k_thread *thread)
 #endif /* CONFIG_SCHED_THREAD_USAGE */
 }
 
+/*
+ * Pend the current thread on a wait queue of the kernel object owning
+ * @a obj_core, recording the wait in the object's contention statistics.
+ * @a obj_core is NULL for objects that are not object cores.
+ */
+static inline int z_pend_curr_obj(struct k_obj_core *obj_core,
+				  struct k_spinlock *lock, k_spinlock_key_t key,
+				  _wait_q_t *wait_q, k_timeout_t timeout)
+{
+#ifdef CONFIG_OBJ_CORE_CONTENTION
+	if (obj_core != NULL) {
+		uint32_t start = k_cycle_get_32();
+		int ret = z_pend_curr(lock, key, wait_q, timeout);
+
+		z_obj_core_contention_record(obj_core, _current,
+					     k_cycle_get_32() - start, ret == 0);
+
+		return ret;
+	}
+#else
+	ARG_UNUSED(obj_core);
+#endif /* CONFIG_OBJ_CORE_CONTENTION */
+
+	return z_pend_curr(lock, key, wait_q, timeout);
+}
+
 #endif /* ZEPHYR_KERNEL_INCLUDE_KSCHED_H_ */
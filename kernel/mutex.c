@@ -52,6 +52,12 @@ static struct k_spinlock lock;
 static struct k_obj_type obj_type_mutex;
 #endif /* CONFIG_OBJ_CORE_MUTEX */
 
+#if defined(CONFIG_OBJ_CORE_CONTENTION) && defined(CONFIG_OBJ_CORE_MUTEX)
+#define MUTEX_CONTENTION_OBJ_CORE(mutex) K_OBJ_CORE(mutex)
+#else
+#define MUTEX_CONTENTION_OBJ_CORE(mutex) NULL
+#endif /* CONFIG_OBJ_CORE_CONTENTION && CONFIG_OBJ_CORE_MUTEX */
+
 int z_impl_k_mutex_init(struct k_mutex *mutex)
 {
 	mutex->owner = NULL;
@@ -123,6 +129,10 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		mutex->lock_count++;
 		mutex->owner = _current;
 
+#if defined(CONFIG_OBJ_CORE_CONTENTION) && defined(CONFIG_OBJ_CORE_MUTEX)
+		z_obj_core_contention_acquired(K_OBJ_CORE(mutex));
+#endif /* CONFIG_OBJ_CORE_CONTENTION && CONFIG_OBJ_CORE_MUTEX */
+
 		LOG_DBG("%p took mutex %p, count: %d, orig prio: %d",
 			_current, mutex, mutex->lock_count,
 			mutex->owner_orig_prio);
@@ -153,7 +163,8 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		resched = adjust_owner_prio(mutex, new_prio);
 	}
 
-	int got_mutex = z_pend_curr(&lock, key, &mutex->wait_q, timeout);
+	int got_mutex = z_pend_curr_obj(MUTEX_CONTENTION_OBJ_CORE(mutex), &lock, key,
+					&mutex->wait_q, timeout);
 
 	LOG_DBG("on mutex %p got_mutex value: %d", mutex, got_mutex);
 
@@ -4,8 +4,10 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
 #include <zephyr/kernel.h>
 #include <zephyr/kernel/obj_core.h>
+#include <zephyr/drivers/timer/system_timer.h>
 
 static struct k_spinlock  lock;
 
@@ -29,6 +31,9 @@ void k_obj_core_init(struct k_obj_core *obj_core, struct k_obj_type *type)
 #ifdef CONFIG_OBJ_CORE_STATS
 	obj_core->stats = NULL;
 #endif /* CONFIG_OBJ_CORE_STATS */
+#ifdef CONFIG_OBJ_CORE_CONTENTION
+	memset(&obj_core->contention, 0, sizeof(obj_core->contention));
+#endif /* CONFIG_OBJ_CORE_CONTENTION */
 }
 
 void k_obj_core_link(struct k_obj_core *obj_core)
@@ -285,3 +290,178 @@ int k_obj_core_stats_enable(struct k_obj_core *obj_core)
 	return rv;
 }
 #endif /* CONFIG_OBJ_CORE_STATS */
+
+#ifdef CONFIG_OBJ_CORE_CONTENTION
+static struct k_spinlock contention_lock;
+
+/*
+ * The threads that waited most often are estimated: a thread that is not
+ * tracked yet replaces the least frequent waiter and inherits its count.
+ */
+static void contention_waiter_add(struct k_obj_core_contention *stats,
+				  struct k_thread *thread)
+{
+	struct k_obj_core_waiter *min = &stats->waiters[0];
+
+	for (size_t i = 0; i < ARRAY_SIZE(stats->waiters); i++) {
+		struct k_obj_core_waiter *waiter = &stats->waiters[i];
+
+		if (waiter->thread == thread) {
+			waiter->count++;
+			return;
+		}
+
+		if (waiter->count < min->count) {
+			min = waiter;
+		}
+	}
+
+	min->thread = thread;
+	min->count++;
+}
+
+void z_obj_core_contention_record(struct k_obj_core *obj_core,
+				  struct k_thread *thread,
+				  uint32_t cycles, bool acquired)
+{
+	struct k_obj_core_contention *stats = &obj_core->contention;
+	k_spinlock_key_t key = k_spin_lock(&contention_lock);
+
+	if (acquired) {
+		stats->contended++;
+	} else {
+		stats->timeouts++;
+	}
+
+	stats->total_wait += cycles;
+	stats->max_wait = MAX(stats->max_wait, cycles);
+	contention_waiter_add(stats, thread);
+
+	k_spin_unlock(&contention_lock, key);
+}
+
+void k_obj_core_contention_get(struct k_obj_core *obj_core,
+			       struct k_obj_core_contention *stats)
+{
+	k_spinlock_key_t key = k_spin_lock(&contention_lock);
+
+	*stats = obj_core->contention;
+
+	k_spin_unlock(&contention_lock, key);
+}
+
+void k_obj_core_contention_reset(struct k_obj_core *obj_core)
+{
+	k_spinlock_key_t key = k_spin_lock(&contention_lock);
+
+	memset(&obj_core->contention, 0, sizeof(obj_core->contention));
+
+	k_spin_unlock(&contention_lock, key);
+}
+#endif /* CONFIG_OBJ_CORE_CONTENTION */
+
+#ifdef CONFIG_OBJ_CORE_CONTENTION_SPINLOCK
+struct spin_contention_slot {
+	atomic_ptr_t lock;
+	uint32_t contended;
+	uint64_t total_wait;
+	uint32_t max_wait;
+};
+
+static struct spin_contention_slot
+	spin_contention[CONFIG_OBJ_CORE_CONTENTION_SPINLOCK_SLOTS];
+static atomic_t spin_contention_dropped;
+
+/*
+ * Called with @a l held, which serializes the updates of its slot. Slots
+ * are claimed lock-free as the profiler can't take a spinlock itself.
+ */
+static void spin_contention_record(struct k_spinlock *l, uint32_t cycles)
+{
+	size_t idx = ((uintptr_t)l / sizeof(void *)) % ARRAY_SIZE(spin_contention);
+
+	for (size_t i = 0; i < ARRAY_SIZE(spin_contention); i++) {
+		struct spin_contention_slot *slot = &spin_contention[idx];
+
+		if ((atomic_ptr_get(&slot->lock) == l) ||
+		    atomic_ptr_cas(&slot->lock, NULL, l)) {
+			slot->contended++;
+			slot->total_wait += cycles;
+			slot->max_wait = MAX(slot->max_wait, cycles);
+			return;
+		}
+
+		idx = (idx + 1) % ARRAY_SIZE(spin_contention);
+	}
+
+	atomic_inc(&spin_contention_dropped);
+}
+
+#ifdef CONFIG_TICKET_SPINLOCKS
+void z_spin_lock_contended(struct k_spinlock *l, atomic_val_t ticket)
+{
+	uint32_t start = sys_clock_cycle_get_32();
+
+	while (atomic_get(&l->owner) != ticket) {
+		arch_spin_relax();
+	}
+
+	spin_contention_record(l, sys_clock_cycle_get_32() - start);
+}
+#else
+void z_spin_lock_contended(struct k_spinlock *l)
+{
+	uint32_t start = sys_clock_cycle_get_32();
+
+	while (!atomic_cas(&l->locked, 0, 1)) {
+		arch_spin_relax();
+	}
+
+	spin_contention_record(l, sys_clock_cycle_get_32() - start);
+}
+#endif /* CONFIG_TICKET_SPINLOCKS */
+
+int k_spin_contention_walk(int (*func)(const struct k_spin_contention *stats, void *data),
+			   void *data)
+{
+	struct k_spin_contention stats;
+	int status = 0;
+
+	for (size_t i = 0; i < ARRAY_SIZE(spin_contention); i++) {
+		struct spin_contention_slot *slot = &spin_contention[i];
+
+		stats.lock = atomic_ptr_get(&slot->lock);
+		if (stats.lock == NULL) {
+			continue;
+		}
+
+		stats.contended = slot->contended;
+		stats.total_wait = slot->total_wait;
+		stats.max_wait = slot->max_wait;
+
+		status = func(&stats, data);
+		if (status != 0) {
+			break;
+		}
+	}
+
+	return status;
+}
+
+uint32_t k_spin_contention_dropped_get(void)
+{
+	return (uint32_t)atomic_get(&spin_contention_dropped);
+}
+
+/* Slots stay assigned to their spinlock, only the statistics are cleared */
+void k_spin_contention_reset(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(spin_contention); i++) {
+		spin_contention[i].contended = 0;
+		spin_contention[i].total_wait = 0;
+		spin_contention[i].max_wait = 0;
+	}
+
+	atomic_set(&spin_contention_dropped, 0);
+}
+#endif /* CONFIG_OBJ_CORE_CONTENTION_SPINLOCK */
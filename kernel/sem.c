@@ -42,6 +42,12 @@ static struct k_spinlock lock;
 static struct k_obj_type obj_type_sem;
 #endif /* CONFIG_OBJ_CORE_SEM */
 
+#if defined(CONFIG_OBJ_CORE_CONTENTION) && defined(CONFIG_OBJ_CORE_SEM)
+#define SEM_CONTENTION_OBJ_CORE(sem) K_OBJ_CORE(sem)
+#else
+#define SEM_CONTENTION_OBJ_CORE(sem) NULL
+#endif /* CONFIG_OBJ_CORE_CONTENTION && CONFIG_OBJ_CORE_SEM */
+
 int z_impl_k_sem_init(struct k_sem *sem, unsigned int initial_count,
 		      unsigned int limit)
 {
@@ -142,6 +148,9 @@ int z_impl_k_sem_take(struct k_sem *sem, k_timeout_t timeout)
 
 	if (likely(sem->count > 0U)) {
 		sem->count--;
+#if defined(CONFIG_OBJ_CORE_CONTENTION) && defined(CONFIG_OBJ_CORE_SEM)
+		z_obj_core_contention_acquired(K_OBJ_CORE(sem));
+#endif /* CONFIG_OBJ_CORE_CONTENTION && CONFIG_OBJ_CORE_SEM */
 		k_spin_unlock(&lock, key);
 		ret = 0;
 		goto out;
@@ -155,7 +164,8 @@ int z_impl_k_sem_take(struct k_sem *sem, k_timeout_t timeout)
 
 	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_sem, take, sem, timeout);
 
-	ret = z_pend_curr(&lock, key, &sem->wait_q, timeout);
+	ret = z_pend_curr_obj(SEM_CONTENTION_OBJ_CORE(sem), &lock, key,
+			      &sem->wait_q, timeout);
 
 out:
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_sem, take, sem, timeout, ret);
@@ -0,0 +1,539 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdarg.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/bitarray.h>
+#include <zephyr/sys/dlist.h>
+#include <zephyr/sys/fdtable.h>
+#include <zephyr/sys/slist.h>
+#include <zephyr/zvfs/epoll.h>
+
+#define ZVFS_EPOLL_ALWAYS (ZVFS_EPOLLERR | ZVFS_EPOLLHUP)
+#define ZVFS_EPOLL_EVENTS                                                                          \
+	(ZVFS_EPOLLIN | ZVFS_EPOLLPRI | ZVFS_EPOLLOUT | ZVFS_EPOLL_ALWAYS | ZVFS_EPOLLET |         \
+	 ZVFS_EPOLLONESHOT)
+
+struct zvfs_epoll;
+
+struct zvfs_epoll_item {
+	/* Attached to the watched object */
+	struct zvfs_poll_notifier notifier;
+	/* Node in the interest list of the instance */
+	sys_dnode_t node;
+	/* Node in the ready list of the instance */
+	sys_dnode_t ready_node;
+	struct zvfs_epoll *ep;
+	/* Watched object, used to detect that the fd was reused */
+	void *obj;
+	int fd;
+	uint32_t events;
+	zvfs_epoll_data_t data;
+	/* The fields below are protected by the spinlock of the instance */
+	bool queued;
+	bool disabled;
+	bool closed;
+};
+
+struct zvfs_epoll {
+	/* Interest list, protected by the mutex */
+	sys_dlist_t items;
+	/* Items that may be ready, protected by the spinlock */
+	sys_dlist_t ready;
+	struct k_spinlock lock;
+	struct k_mutex mutex;
+	/* Given when an item is queued to the ready list */
+	struct k_sem sem;
+};
+
+SYS_BITARRAY_DEFINE_STATIC(epolls_bitarray, CONFIG_ZVFS_EPOLL_MAX);
+static struct zvfs_epoll epolls[CONFIG_ZVFS_EPOLL_MAX];
+static const struct fd_op_vtable zvfs_epoll_fd_vtable;
+
+K_MEM_SLAB_DEFINE_STATIC(epoll_items, sizeof(struct zvfs_epoll_item),
+			 CONFIG_ZVFS_EPOLL_MAX_ITEMS, sizeof(void *));
+
+/* Protects the notifier lists of all the watched objects */
+static struct k_spinlock notifier_lock;
+
+void zvfs_poll_notifier_add(sys_slist_t *notifiers, struct zvfs_poll_notifier *notifier)
+{
+	k_spinlock_key_t key = k_spin_lock(&notifier_lock);
+
+	sys_slist_append(notifiers, &notifier->node);
+
+	k_spin_unlock(&notifier_lock, key);
+}
+
+void zvfs_poll_notifier_remove(sys_slist_t *notifiers, struct zvfs_poll_notifier *notifier)
+{
+	k_spinlock_key_t key = k_spin_lock(&notifier_lock);
+
+	(void)sys_slist_find_and_remove(notifiers, &notifier->node);
+
+	k_spin_unlock(&notifier_lock, key);
+}
+
+void zvfs_poll_notify(sys_slist_t *notifiers, short events)
+{
+	struct zvfs_poll_notifier *notifier, *next;
+	k_spinlock_key_t key = k_spin_lock(&notifier_lock);
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(notifiers, notifier, next, node) {
+		if (events & ZVFS_POLLNVAL) {
+			(void)sys_slist_find_and_remove(notifiers, &notifier->node);
+		}
+
+		notifier->cb(notifier, events);
+	}
+
+	k_spin_unlock(&notifier_lock, key);
+}
+
+static void epoll_item_queue(struct zvfs_epoll_item *item)
+{
+	if (!item->queued) {
+		sys_dlist_append(&item->ep->ready, &item->ready_node);
+		item->queued = true;
+	}
+}
+
+static void epoll_item_notify(struct zvfs_poll_notifier *notifier, short events)
+{
+	struct zvfs_epoll_item *item = CONTAINER_OF(notifier, struct zvfs_epoll_item, notifier);
+	struct zvfs_epoll *ep = item->ep;
+	k_spinlock_key_t key = k_spin_lock(&ep->lock);
+
+	if (events & ZVFS_POLLNVAL) {
+		/* Let the waiter free the item */
+		item->closed = true;
+	} else if (item->disabled || (events & (item->events | ZVFS_EPOLL_ALWAYS)) == 0) {
+		k_spin_unlock(&ep->lock, key);
+		return;
+	}
+
+	epoll_item_queue(item);
+
+	k_spin_unlock(&ep->lock, key);
+
+	k_sem_give(&ep->sem);
+}
+
+/* Call an ioctl on the watched object, if the fd still refers to it */
+static int epoll_item_ioctl(struct zvfs_epoll_item *item, unsigned long request, ...)
+{
+	const struct fd_op_vtable *vtable;
+	struct k_mutex *lock;
+	va_list args;
+	void *obj;
+	int ret;
+
+	obj = zvfs_get_fd_obj_and_vtable(item->fd, &vtable, &lock);
+	if (obj == NULL || obj != item->obj) {
+		errno = EBADF;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	/* The fd may have been closed while waiting for the lock */
+	if (zvfs_get_fd_obj_and_vtable(item->fd, &vtable, NULL) != obj) {
+		k_mutex_unlock(lock);
+		errno = EBADF;
+		return -1;
+	}
+
+	va_start(args, request);
+	ret = vtable->ioctl(obj, request, args);
+	va_end(args);
+
+	k_mutex_unlock(lock);
+
+	return ret;
+}
+
+static int epoll_item_status(struct zvfs_epoll_item *item)
+{
+	return epoll_item_ioctl(item, ZFD_IOCTL_POLL_STATUS,
+				(int)(item->events & ZVFS_EPOLL_EVENTS & ~(ZVFS_EPOLLET |
+									   ZVFS_EPOLLONESHOT)));
+}
+
+static void epoll_item_free(struct zvfs_epoll *ep, struct zvfs_epoll_item *item)
+{
+	k_spinlock_key_t key;
+	bool closed;
+
+	key = k_spin_lock(&ep->lock);
+	closed = item->closed;
+	/* Do not let notifications queue the item anymore */
+	item->disabled = true;
+	k_spin_unlock(&ep->lock, key);
+
+	if (!closed) {
+		(void)epoll_item_ioctl(item, ZFD_IOCTL_POLL_NOTIFIER_REMOVE, &item->notifier);
+	}
+
+	key = k_spin_lock(&ep->lock);
+	if (item->queued) {
+		sys_dlist_remove(&item->ready_node);
+	}
+	k_spin_unlock(&ep->lock, key);
+
+	sys_dlist_remove(&item->node);
+	k_mem_slab_free(&epoll_items, item);
+}
+
+static struct zvfs_epoll_item *epoll_item_find(struct zvfs_epoll *ep, int fd)
+{
+	struct zvfs_epoll_item *item;
+	k_spinlock_key_t key;
+	bool closed;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&ep->items, item, node) {
+		if (item->fd != fd) {
+			continue;
+		}
+
+		key = k_spin_lock(&ep->lock);
+		closed = item->closed;
+		k_spin_unlock(&ep->lock, key);
+
+		if (!closed) {
+			return item;
+		}
+	}
+
+	return NULL;
+}
+
+/* Queue the item if it is ready already, as no notification would come */
+static void epoll_item_arm(struct zvfs_epoll *ep, struct zvfs_epoll_item *item)
+{
+	k_spinlock_key_t key;
+	int revents;
+
+	revents = epoll_item_status(item);
+	if (revents <= 0) {
+		return;
+	}
+
+	key = k_spin_lock(&ep->lock);
+	epoll_item_queue(item);
+	k_spin_unlock(&ep->lock, key);
+
+	k_sem_give(&ep->sem);
+}
+
+static int epoll_ctl_add(struct zvfs_epoll *ep, int fd, struct zvfs_epoll_event *event)
+{
+	const struct fd_op_vtable *vtable;
+	struct zvfs_epoll_item *item;
+	void *obj;
+	int ret;
+
+	if (epoll_item_find(ep, fd) != NULL) {
+		errno = EEXIST;
+		return -1;
+	}
+
+	obj = zvfs_get_fd_obj_and_vtable(fd, &vtable, NULL);
+	if (obj == NULL) {
+		return -1;
+	}
+
+	if (obj == ep) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (k_mem_slab_alloc(&epoll_items, (void **)&item, K_NO_WAIT) < 0) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	*item = (struct zvfs_epoll_item){
+		.notifier.cb = epoll_item_notify,
+		.ep = ep,
+		.obj = obj,
+		.fd = fd,
+		.events = event->events,
+		.data = event->data,
+	};
+
+	ret = epoll_item_ioctl(item, ZFD_IOCTL_POLL_NOTIFIER_ADD, &item->notifier);
+	if (ret < 0) {
+		/* The object cannot notify its readiness */
+		k_mem_slab_free(&epoll_items, item);
+		errno = EPERM;
+		return -1;
+	}
+
+	sys_dlist_append(&ep->items, &item->node);
+
+	epoll_item_arm(ep, item);
+
+	return 0;
+}
+
+static int epoll_ctl_mod(struct zvfs_epoll *ep, int fd, struct zvfs_epoll_event *event)
+{
+	struct zvfs_epoll_item *item;
+	k_spinlock_key_t key;
+
+	item = epoll_item_find(ep, fd);
+	if (item == NULL) {
+		errno = ENOENT;
+		return -1;
+	}
+
+	key = k_spin_lock(&ep->lock);
+	item->events = event->events;
+	item->data = event->data;
+	item->disabled = false;
+	k_spin_unlock(&ep->lock, key);
+
+	epoll_item_arm(ep, item);
+
+	return 0;
+}
+
+static int epoll_ctl_del(struct zvfs_epoll *ep, int fd)
+{
+	struct zvfs_epoll_item *item;
+
+	item = epoll_item_find(ep, fd);
+	if (item == NULL) {
+		errno = ENOENT;
+		return -1;
+	}
+
+	epoll_item_free(ep, item);
+
+	return 0;
+}
+
+/* Report the items queued to the ready list. Only the items that were
+ * queued when starting are examined, so that the level triggered ones
+ * put back to the list are not reported twice.
+ */
+static int epoll_collect(struct zvfs_epoll *ep, struct zvfs_epoll_event *events, int maxevents)
+{
+	struct zvfs_epoll_item *item;
+	sys_dnode_t *last, *node;
+	k_spinlock_key_t key;
+	bool done = false;
+	int revents;
+	int count = 0;
+
+	key = k_spin_lock(&ep->lock);
+	last = sys_dlist_peek_tail(&ep->ready);
+	k_spin_unlock(&ep->lock, key);
+
+	while (!done && last != NULL && count < maxevents) {
+		key = k_spin_lock(&ep->lock);
+
+		node = sys_dlist_get(&ep->ready);
+		if (node == NULL) {
+			k_spin_unlock(&ep->lock, key);
+			break;
+		}
+
+		done = (node == last);
+
+		item = CONTAINER_OF(node, struct zvfs_epoll_item, ready_node);
+		item->queued = false;
+
+		if (item->closed) {
+			k_spin_unlock(&ep->lock, key);
+			epoll_item_free(ep, item);
+			continue;
+		}
+
+		k_spin_unlock(&ep->lock, key);
+
+		revents = epoll_item_status(item);
+		if (revents < 0) {
+			/* The fd was closed or reused behind our back */
+			epoll_item_free(ep, item);
+			continue;
+		}
+
+		if (revents == 0) {
+			/* Not ready anymore, wait for the next notification */
+			continue;
+		}
+
+		events[count].events = revents;
+		events[count].data = item->data;
+		count++;
+
+		key = k_spin_lock(&ep->lock);
+
+		if (item->events & ZVFS_EPOLLONESHOT) {
+			item->disabled = true;
+		} else if ((item->events & ZVFS_EPOLLET) == 0) {
+			/* Level triggered, check it again on the next call */
+			epoll_item_queue(item);
+		}
+
+		k_spin_unlock(&ep->lock, key);
+	}
+
+	return count;
+}
+
+static int zvfs_epoll_close_op(void *obj)
+{
+	struct zvfs_epoll *ep = obj;
+	struct zvfs_epoll_item *item, *next;
+	int err;
+
+	(void)k_mutex_lock(&ep->mutex, K_FOREVER);
+
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&ep->items, item, next, node) {
+		epoll_item_free(ep, item);
+	}
+
+	k_mutex_unlock(&ep->mutex);
+
+	/* Wake up the waiters, they will notice the fd is gone */
+	k_sem_give(&ep->sem);
+
+	err = sys_bitarray_free(&epolls_bitarray, 1, ep - epolls);
+	__ASSERT(err == 0, "sys_bitarray_free() failed: %d", err);
+
+	return 0;
+}
+
+static int zvfs_epoll_ioctl_op(void *obj, unsigned int request, va_list args)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(args);
+
+	switch (request) {
+	case ZFD_IOCTL_SET_LOCK:
+		return 0;
+
+	default:
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+}
+
+static const struct fd_op_vtable zvfs_epoll_fd_vtable = {
+	.close = zvfs_epoll_close_op,
+	.ioctl = zvfs_epoll_ioctl_op,
+};
+
+/*
+ * Public-facing API
+ */
+
+int zvfs_epoll_create(int flags)
+{
+	struct zvfs_epoll *ep;
+	size_t offset;
+	int fd;
+
+	if (flags != 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (sys_bitarray_alloc(&epolls_bitarray, 1, &offset) < 0) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	ep = &epolls[offset];
+
+	fd = zvfs_reserve_fd();
+	if (fd < 0) {
+		sys_bitarray_free(&epolls_bitarray, 1, offset);
+		return -1;
+	}
+
+	sys_dlist_init(&ep->items);
+	sys_dlist_init(&ep->ready);
+	k_mutex_init(&ep->mutex);
+	k_sem_init(&ep->sem, 0, 1);
+
+	zvfs_finalize_fd(fd, ep, &zvfs_epoll_fd_vtable);
+
+	return fd;
+}
+
+int zvfs_epoll_ctl(int epfd, int op, int fd, struct zvfs_epoll_event *event)
+{
+	struct zvfs_epoll *ep;
+	int ret;
+
+	ep = zvfs_get_fd_obj(epfd, &zvfs_epoll_fd_vtable, EBADF);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (op != ZVFS_EPOLL_CTL_DEL && (event == NULL || (event->events & ~ZVFS_EPOLL_EVENTS))) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	(void)k_mutex_lock(&ep->mutex, K_FOREVER);
+
+	switch (op) {
+	case ZVFS_EPOLL_CTL_ADD:
+		ret = epoll_ctl_add(ep, fd, event);
+		break;
+	case ZVFS_EPOLL_CTL_MOD:
+		ret = epoll_ctl_mod(ep, fd, event);
+		break;
+	case ZVFS_EPOLL_CTL_DEL:
+		ret = epoll_ctl_del(ep, fd);
+		break;
+	default:
+		errno = EINVAL;
+		ret = -1;
+		break;
+	}
+
+	k_mutex_unlock(&ep->mutex);
+
+	return ret;
+}
+
+int zvfs_epoll_wait(int epfd, struct zvfs_epoll_event *events, int maxevents, int timeout)
+{
+	struct zvfs_epoll *ep;
+	k_timepoint_t end;
+	int ret;
+
+	if (events == NULL || maxevents <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	end = sys_timepoint_calc(timeout < 0 ? K_FOREVER : K_MSEC(timeout));
+
+	do {
+		ep = zvfs_get_fd_obj(epfd, &zvfs_epoll_fd_vtable, EBADF);
+		if (ep == NULL) {
+			return -1;
+		}
+
+		(void)k_mutex_lock(&ep->mutex, K_FOREVER);
+		ret = epoll_collect(ep, events, maxevents);
+		k_mutex_unlock(&ep->mutex);
+
+		if (ret > 0) {
+			break;
+		}
+	} while (k_sem_take(&ep->sem, sys_timepoint_timeout(end)) == 0);
+
+	return ret;
+}
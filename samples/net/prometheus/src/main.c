@@ -27,7 +27,7 @@
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(main, LOG_LEVEL_DBG);
 
-extern int init_stats(struct prometheus_counter *counter);
+extern int init_stats(void);
 
 struct app_context {
 
@@ -163,7 +163,7 @@ int main(void)
 	prometheus_collector_register_metric(prom_context.collector, &prom_context.counter->base);
 
 #if defined(CONFIG_NET_STATISTICS_VIA_PROMETHEUS)
-	(void)init_stats(prom_context.counter);
+	(void)init_stats();
 #endif
 
 	setup_tls();
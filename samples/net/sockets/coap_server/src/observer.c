@@ -17,30 +17,15 @@ static int obs_counter;
 static void update_counter(struct k_work *work);
 K_WORK_DELAYABLE_DEFINE(obs_work, update_counter);
 
-static int send_notification_packet(struct coap_resource *resource,
-				    const struct sockaddr *addr,
-				    socklen_t addr_len,
-				    uint16_t age, uint16_t id,
-				    const uint8_t *token, uint8_t tkl,
-				    bool is_response)
+static int build_counter_packet(struct coap_packet *response,
+				uint8_t *data, size_t data_len,
+				uint8_t type, uint16_t age, uint16_t id,
+				const uint8_t *token, uint8_t tkl)
 {
-	uint8_t data[CONFIG_COAP_SERVER_MESSAGE_SIZE];
-	struct coap_packet response;
 	char payload[14];
-	uint8_t type;
 	int r;
 
-	if (is_response) {
-		type = COAP_TYPE_ACK;
-	} else {
-		type = COAP_TYPE_CON;
-	}
-
-	if (!is_response) {
-		id = coap_next_id();
-	}
-
-	r = coap_packet_init(&response, data, sizeof(data),
+	r = coap_packet_init(response, data, data_len,
 			     COAP_VERSION_1, type, tkl, token,
 			     COAP_RESPONSE_CODE_CONTENT, id);
 	if (r < 0) {
@@ -48,19 +33,19 @@ static int send_notification_packet(struct coap_resource *resource,
 	}
 
 	if (age >= 2U) {
-		r = coap_append_option_int(&response, COAP_OPTION_OBSERVE, age);
+		r = coap_append_option_int(response, COAP_OPTION_OBSERVE, age);
 		if (r < 0) {
 			return r;
 		}
 	}
 
-	r = coap_append_option_int(&response, COAP_OPTION_CONTENT_FORMAT,
+	r = coap_append_option_int(response, COAP_OPTION_CONTENT_FORMAT,
 				   COAP_CONTENT_FORMAT_TEXT_PLAIN);
 	if (r < 0) {
 		return r;
 	}
 
-	r = coap_packet_append_payload_marker(&response);
+	r = coap_packet_append_payload_marker(response);
 	if (r < 0) {
 		return r;
 	}
@@ -72,23 +57,16 @@ static int send_notification_packet(struct coap_resource *resource,
 		return r;
 	}
 
-	r = coap_packet_append_payload(&response, (uint8_t *)payload,
-				       strlen(payload));
-	if (r < 0) {
-		return r;
-	}
-
-	k_work_reschedule(&obs_work, K_SECONDS(5));
-
-	r = coap_resource_send(resource, &response, addr, addr_len, NULL);
-
-	return r;
+	return coap_packet_append_payload(response, (uint8_t *)payload,
+					  strlen(payload));
 }
 
 static int obs_get(struct coap_resource *resource,
 		   struct coap_packet *request,
 		   struct sockaddr *addr, socklen_t addr_len)
 {
+	uint8_t data[CONFIG_COAP_SERVER_MESSAGE_SIZE];
+	struct coap_packet response;
 	uint8_t token[COAP_TOKEN_MAX_LEN];
 	uint16_t id;
 	uint8_t code;
@@ -107,19 +85,15 @@ static int obs_get(struct coap_resource *resource,
 	LOG_INF("type: %u code %u id %u", type, code, id);
 	LOG_INF("*******");
 
-	return send_notification_packet(resource, addr, addr_len,
-					r == 0 ? resource->age : 0,
-					id, token, tkl, true);
-}
+	r = build_counter_packet(&response, data, sizeof(data), COAP_TYPE_ACK,
+				 r == 0 ? resource->age : 0, id, token, tkl);
+	if (r < 0) {
+		return r;
+	}
 
-static void obs_notify(struct coap_resource *resource,
-		       struct coap_observer *observer)
-{
-	send_notification_packet(resource,
-				 &observer->addr,
-				 sizeof(observer->addr),
-				 resource->age, 0,
-				 observer->token, observer->tkl, false);
+	k_work_reschedule(&obs_work, K_SECONDS(5));
+
+	return coap_resource_send(resource, &response, addr, addr_len, NULL);
 }
 
 static const char * const obs_path[] = { "obs", NULL };
@@ -127,14 +101,30 @@ COAP_RESOURCE_DEFINE(obs, coap_server,
 {
 	.get = obs_get,
 	.path = obs_path,
-	.notify = obs_notify,
 });
 
 static void update_counter(struct k_work *work)
 {
-	obs_counter++;
+	uint8_t data[CONFIG_COAP_SERVER_MESSAGE_SIZE];
+	struct coap_packet notification;
+	int r;
 
-	coap_resource_notify(&obs);
+	obs_counter++;
 
 	k_work_reschedule(&obs_work, K_SECONDS(5));
+
+	/* The notification is encoded once, the token and message ID are
+	 * filled in for each observer when it is sent.
+	 */
+	r = build_counter_packet(&notification, data, sizeof(data), COAP_TYPE_CON,
+				 coap_resource_next_age(&obs), 0, NULL, 0);
+	if (r < 0) {
+		LOG_ERR("Failed to build notification (%d)", r);
+		return;
+	}
+
+	r = coap_resource_notify_observers(&obs, &notification, NULL);
+	if (r < 0) {
+		LOG_ERR("Failed to notify observers (%d)", r);
+	}
 }
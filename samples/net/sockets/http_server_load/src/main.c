@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/http/server.h>
+#include <zephyr/net/http/service.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/sys/atomic.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_http_server_load, LOG_LEVEL_INF);
+
+#define SERVER_ADDR "127.0.0.1"
+#define NUM_CLIENTS CONFIG_NET_SAMPLE_LOAD_CLIENTS
+
+static uint16_t load_service_port;
+HTTP_SERVICE_DEFINE(load_service, SERVER_ADDR, &load_service_port,
+		    NUM_CLIENTS, NUM_CLIENTS, NULL, NULL);
+
+static const char load_payload[] =
+	"<html><body><h1>Zephyr HTTP server load test</h1></body></html>\n";
+
+static struct http_resource_detail_static load_resource_detail = {
+	.common = {
+			.type = HTTP_RESOURCE_TYPE_STATIC,
+			.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+			.content_type = "text/html",
+		},
+	.static_data = load_payload,
+	.static_data_len = sizeof(load_payload) - 1,
+};
+
+HTTP_RESOURCE_DEFINE(load_resource, load_service, "/load", &load_resource_detail);
+
+static const char request[] =
+	"GET /load HTTP/1.1\r\n"
+	"Host: " SERVER_ADDR "\r\n"
+	"\r\n";
+
+static atomic_t requests;
+static atomic_t failures;
+static volatile bool running = true;
+
+static K_THREAD_STACK_ARRAY_DEFINE(client_stacks, NUM_CLIENTS,
+				   CONFIG_NET_SAMPLE_LOAD_CLIENT_STACK_SIZE);
+static struct k_thread client_threads[NUM_CLIENTS];
+
+static int connect_to_server(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(load_service_port),
+	};
+	int sock;
+
+	zsock_inet_pton(AF_INET, SERVER_ADDR, &addr.sin_addr);
+
+	sock = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (sock < 0) {
+		return -errno;
+	}
+
+	if (zsock_connect(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		int ret = -errno;
+
+		zsock_close(sock);
+		return ret;
+	}
+
+	return sock;
+}
+
+/* Read one full response, using its Content-Length to find the end */
+static int read_response(int sock, char *buf, size_t buf_size)
+{
+	size_t received = 0;
+	size_t expected = 0;
+	char *body = NULL;
+	ssize_t len;
+
+	while (body == NULL || received < expected) {
+		if (received >= buf_size - 1) {
+			return -ENOMEM;
+		}
+
+		len = zsock_recv(sock, buf + received, buf_size - 1 - received, 0);
+		if (len <= 0) {
+			return len == 0 ? -ECONNRESET : -errno;
+		}
+
+		received += len;
+		buf[received] = '\0';
+
+		if (body == NULL) {
+			char *cl;
+
+			body = strstr(buf, "\r\n\r\n");
+			if (body == NULL) {
+				continue;
+			}
+
+			body += 4;
+
+			if (strncmp(buf, "HTTP/1.1 200", sizeof("HTTP/1.1 200") - 1) != 0) {
+				return -EPROTO;
+			}
+
+			cl = strstr(buf, "Content-Length: ");
+			if (cl == NULL || cl > body) {
+				return -EPROTO;
+			}
+
+			expected = (body - buf) + strtoul(cl + sizeof("Content-Length: ") - 1,
+							  NULL, 10);
+		}
+	}
+
+	return 0;
+}
+
+static void client_thread(void *p1, void *p2, void *p3)
+{
+	int id = POINTER_TO_INT(p1);
+	char buf[256];
+	int sock;
+	int ret;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	sock = connect_to_server();
+	if (sock < 0) {
+		LOG_ERR("Client %d: cannot connect (%d)", id, sock);
+		atomic_inc(&failures);
+		return;
+	}
+
+	while (running) {
+		if (zsock_send(sock, request, sizeof(request) - 1, 0) < 0) {
+			ret = -errno;
+		} else {
+			ret = read_response(sock, buf, sizeof(buf));
+		}
+
+		if (ret < 0) {
+			LOG_ERR("Client %d: request failed (%d)", id, ret);
+			atomic_inc(&failures);
+			break;
+		}
+
+		atomic_inc(&requests);
+	}
+
+	zsock_close(sock);
+}
+
+int main(void)
+{
+	int64_t start, elapsed;
+	atomic_val_t prev = 0;
+	atomic_val_t total;
+
+	http_server_start();
+
+	/* Let the server bind its port */
+	k_msleep(100);
+
+	LOG_INF("%d clients, %d seconds, %s", NUM_CLIENTS, CONFIG_NET_SAMPLE_LOAD_DURATION,
+		IS_ENABLED(CONFIG_HTTP_SERVER_WORKER_POOL) ? "worker pool" : "single thread");
+
+	start = k_uptime_get();
+
+	for (int i = 0; i < NUM_CLIENTS; i++) {
+		k_thread_create(&client_threads[i], client_stacks[i],
+				K_THREAD_STACK_SIZEOF(client_stacks[i]),
+				client_thread, INT_TO_POINTER(i), NULL, NULL,
+				K_PRIO_PREEMPT(8), 0, K_NO_WAIT);
+	}
+
+	for (int sec = 0; sec < CONFIG_NET_SAMPLE_LOAD_DURATION; sec++) {
+		k_sleep(K_SECONDS(1));
+
+		total = atomic_get(&requests);
+		LOG_INF("%ld requests/s", (long)(total - prev));
+		prev = total;
+	}
+
+	running = false;
+
+	for (int i = 0; i < NUM_CLIENTS; i++) {
+		k_thread_join(&client_threads[i], K_FOREVER);
+	}
+
+	elapsed = k_uptime_get() - start;
+	total = atomic_get(&requests);
+
+	printf("Total: %lld requests/s (%ld requests in %lld ms, %ld failures)\n",
+	       (long long)(total * 1000LL / MAX(elapsed, 1)), (long)total,
+	       (long long)elapsed, (long)atomic_get(&failures));
+
+	http_server_stop();
+
+	return 0;
+}
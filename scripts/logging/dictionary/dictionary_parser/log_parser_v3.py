@@ -46,6 +46,11 @@ FMT_MSG_HDR_64 = "BHHQ"
 # Message type
 # 0: normal message
 # 1: number of dropped messages
+# 2: compact message, timestamp relative to the previous message
+# 3: compact message with absolute timestamp
+#
+# For compact messages, the upper bits of the type byte carry
+# the log level and the presence of the domain and hexdump data.
 FMT_MSG_TYPE = "B"
 
 # Depends on CONFIG_LOG_TIMESTAMP_64BIT
@@ -55,6 +60,14 @@ FMT_MSG_TIMESTAMP_64 = "Q"
 # Keep message types in sync with include/logging/log_output_dict.h
 MSG_TYPE_NORMAL = 0
 MSG_TYPE_DROPPED = 1
+MSG_TYPE_COMPACT = 2
+MSG_TYPE_COMPACT_SYNC = 3
+
+MSG_TYPE_MASK = 0x07
+MSG_COMPACT_LEVEL_SHIFT = 3
+MSG_COMPACT_LEVEL_MASK = 0x07
+MSG_COMPACT_HAS_DATA = 0x40
+MSG_COMPACT_HAS_DOMAIN = 0x80
 
 # Number of dropped messages
 FMT_DROPPED_CNT = "H"
@@ -88,6 +101,10 @@ class LogParserV3(LogParser):
         else:
             self.fmt_msg_timestamp = endian + FMT_MSG_TIMESTAMP_32
 
+        self.timestamp_mask = (1 << (struct.calcsize(self.fmt_msg_timestamp) * 8)) - 1
+
+        # Timestamp of the previous compact message, deltas are relative to it.
+        self.compact_timestamp = 0
 
     def __get_string(self, arg, arg_offset, string_tbl):
         one_str = self.database.find_string(arg)
@@ -264,6 +281,23 @@ class LogParserV3(LogParser):
                   hex_vals, hex_padding, chr_vals))
 
 
+    @staticmethod
+    def decode_varint(logdata, offset):
+        """Decode one LEB128 encoded unsigned integer, return value and new offset"""
+        value = 0
+        shift = 0
+
+        while True:
+            byte = logdata[offset]
+            offset += 1
+
+            value |= (byte & 0x7F) << shift
+            shift += 7
+
+            if (byte & 0x80) == 0:
+                return value, offset
+
+
     def parse_one_normal_msg(self, logdata, offset):
         """Parse one normal log message and print the encoded message"""
         # Parse log message header
@@ -282,6 +316,40 @@ class LogParserV3(LogParser):
             domain_id = domain_lvl & 0x0F
             level = (domain_lvl >> 4) & 0x0F
 
+        return self.print_one_msg(logdata, offset, level, domain_id, source_id,
+                                  timestamp, pkg_len, data_len)
+
+
+    def parse_one_compact_msg(self, logdata, offset, msg_type_byte):
+        """Parse one compact log message and print the encoded message"""
+        level = (msg_type_byte >> MSG_COMPACT_LEVEL_SHIFT) & MSG_COMPACT_LEVEL_MASK
+
+        domain_id = 0
+        if msg_type_byte & MSG_COMPACT_HAS_DOMAIN:
+            domain_id = logdata[offset]
+            offset += 1
+
+        source_id, offset = self.decode_varint(logdata, offset)
+        timestamp, offset = self.decode_varint(logdata, offset)
+        pkg_len, offset = self.decode_varint(logdata, offset)
+
+        data_len = 0
+        if msg_type_byte & MSG_COMPACT_HAS_DATA:
+            data_len, offset = self.decode_varint(logdata, offset)
+
+        if (msg_type_byte & MSG_TYPE_MASK) == MSG_TYPE_COMPACT:
+            # Delta to the previous message, wrapping like the target counter
+            timestamp = (self.compact_timestamp + timestamp) & self.timestamp_mask
+
+        self.compact_timestamp = timestamp
+
+        return self.print_one_msg(logdata, offset, level, domain_id, source_id,
+                                  timestamp, pkg_len, data_len)
+
+
+    def print_one_msg(self, logdata, offset, level, domain_id, source_id,
+                      timestamp, pkg_len, data_len):
+        """Decode the package of one log message and print it"""
         level_str, color = get_log_level_str_color(level)
         source_id_str = self.database.get_log_source_string(domain_id, source_id)
 
@@ -360,8 +428,9 @@ class LogParserV3(LogParser):
 
         while offset < len(logdata):
             # Get message type
-            msg_type = struct.unpack_from(self.fmt_msg_type, logdata, offset)[0]
+            msg_type_byte = struct.unpack_from(self.fmt_msg_type, logdata, offset)[0]
             offset += struct.calcsize(self.fmt_msg_type)
+            msg_type = msg_type_byte & MSG_TYPE_MASK
 
             if msg_type == MSG_TYPE_DROPPED:
                 num_dropped = struct.unpack_from(self.fmt_dropped_cnt, logdata, offset)
@@ -376,6 +445,13 @@ class LogParserV3(LogParser):
 
                 offset = ret
 
+            elif msg_type in (MSG_TYPE_COMPACT, MSG_TYPE_COMPACT_SYNC):
+                ret = self.parse_one_compact_msg(logdata, offset, msg_type_byte)
+                if ret is None:
+                    return False
+
+                offset = ret
+
             else:
                 logger.error("------ Unknown message type: %s", msg_type)
                 return False
@@ -0,0 +1,92 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2024 The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+"""
+Script to split CTF data captured with CONFIG_TRACING_PER_CPU_BUFFERS into
+one data stream file per CPU.
+
+The packets of all CPUs are interleaved in the captured trace and each CPU is
+a stream instance of its own. Babeltrace expects each data stream in its own
+file, timestamps are then only required to be monotonic within a CPU and the
+events of all CPUs are merged by timestamp:
+
+    ./scripts/tracing/split_ctf_cpu_streams.py -i build/channel0_0 \\
+      -m build/zephyr/ctf/metadata -o ctf
+    ./scripts/tracing/parse_ctf.py -t ctf
+"""
+
+import argparse
+import os
+import shutil
+import struct
+import sys
+
+CTF_MAGIC = 0xC1FC1FC1
+# magic, stream_instance_id, packet_size, content_size
+PACKET_HEADER = struct.Struct("<IIII")
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+            description=__doc__,
+            formatter_class=argparse.RawDescriptionHelpFormatter, allow_abbrev=False)
+    parser.add_argument("-i", "--input", default='channel0_0',
+            help="captured tracing data")
+    parser.add_argument("-m", "--metadata",
+            help="metadata generated in the build directory, copied to the output")
+    parser.add_argument("-o", "--output", required=True,
+            help="output directory")
+    args = parser.parse_args()
+    return args
+
+def split(data, output):
+    streams = {}
+    offset = 0
+    skipped = 0
+
+    while offset + PACKET_HEADER.size <= len(data):
+        magic, cpu, packet_size, _ = PACKET_HEADER.unpack_from(data, offset)
+        length = packet_size // 8
+
+        if magic != CTF_MAGIC or length < PACKET_HEADER.size or \
+           offset + length > len(data):
+            # Resynchronize on the next packet, e.g. after the capture
+            # started in the middle of a packet.
+            next_offset = data.find(struct.pack("<I", CTF_MAGIC), offset + 1)
+            if next_offset < 0:
+                break
+            skipped += next_offset - offset
+            offset = next_offset
+            continue
+
+        if cpu not in streams:
+            streams[cpu] = open(os.path.join(output, f"channel0_0_cpu{cpu}"), "wb")
+        streams[cpu].write(data[offset:offset + length])
+        offset += length
+
+    for stream in streams.values():
+        stream.close()
+
+    return sorted(streams), skipped + len(data) - offset
+
+def main():
+    args = parse_args()
+
+    try:
+        with open(args.input, "rb") as f:
+            data = f.read()
+    except OSError as e:
+        sys.exit("{}".format(e))
+
+    os.makedirs(args.output, exist_ok=True)
+    if args.metadata:
+        shutil.copy(args.metadata, os.path.join(args.output, "metadata"))
+
+    cpus, skipped = split(data, args.output)
+    print("streams of CPUs {} written to {}".format(cpus, args.output))
+    if skipped:
+        print("{} bytes not part of a complete packet skipped".format(skipped))
+
+if __name__ == "__main__":
+    main()
@@ -15,6 +15,7 @@
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 #include <stdio.h>
+#include <string.h>
 
 LOG_MODULE_REGISTER(thread_analyzer, CONFIG_THREAD_ANALYZER_LOG_LEVEL);
 
@@ -87,8 +88,151 @@ static void thread_print_cb(struct thread_analyzer_info *info)
 struct ta_cb_user_data {
 	thread_analyzer_cb cb;
 	unsigned int cpu;
+#ifdef CONFIG_THREAD_ANALYZER_INCREMENTAL
+	uint32_t run;
+	/* Cycles executed since the previous run */
+	uint64_t cycles;
+#endif
+};
+
+#ifdef CONFIG_THREAD_ANALYZER_INCREMENTAL
+/* State of a thread kept between runs */
+struct ta_thread_state {
+	const struct k_thread *thread;
+	/* Run in which the thread was last found */
+	uint32_t run;
+	bool stack_valid;
+	/* Unused stack bytes found in the previous run */
+	size_t stack_unused;
+	/* Execution cycles of the thread at the previous run */
+	uint64_t cycles;
 };
 
+static struct ta_thread_state ta_states[CONFIG_THREAD_ANALYZER_INCREMENTAL_THREADS];
+static struct k_spinlock ta_states_lock;
+static atomic_t ta_run;
+static uint64_t ta_cycles[CONFIG_MP_MAX_NUM_CPUS];
+
+static struct ta_thread_state *ta_state_get(const struct k_thread *thread, uint32_t run)
+{
+	struct ta_thread_state *state = NULL;
+	struct ta_thread_state *reuse = NULL;
+	k_spinlock_key_t key = k_spin_lock(&ta_states_lock);
+
+	for (size_t i = 0; i < ARRAY_SIZE(ta_states); i++) {
+		struct ta_thread_state *s = &ta_states[i];
+
+		if (s->thread == thread) {
+			state = s;
+			break;
+		}
+
+		/* The state of a thread missing from the last runs (one run
+		 * per core) is reused, the thread is likely gone.
+		 */
+		if ((s->thread == NULL) || ((run - s->run) > CONFIG_MP_MAX_NUM_CPUS)) {
+			if ((reuse == NULL) || ((run - s->run) > (run - reuse->run))) {
+				reuse = s;
+			}
+		}
+	}
+
+	if ((state == NULL) && (reuse != NULL)) {
+		*reuse = (struct ta_thread_state){ .thread = thread };
+		state = reuse;
+	}
+
+	if (state != NULL) {
+		state->run = run;
+	}
+
+	k_spin_unlock(&ta_states_lock, key);
+
+	return state;
+}
+
+/* Stack usage only grows, so the unused part at the start of the stack can
+ * only shrink. The byte at the previous high-water mark is used unless the
+ * thread object was reused by another thread, and the window below it is
+ * checked for growth. Only when the window was used the stack is scanned
+ * again, up to the previous high-water mark.
+ */
+static int ta_stack_unused_get(struct k_thread *thread, struct ta_thread_state *state,
+			       size_t *unused)
+{
+	const uint8_t *start = (const uint8_t *)thread->stack_info.start;
+	size_t size = thread->stack_info.size;
+	size_t prev, i;
+	int err;
+
+	if ((state == NULL) || !state->stack_valid ||
+	    (IS_ENABLED(CONFIG_NO_UNUSED_STACK_INSPECTION) && (thread == k_current_get()))) {
+		goto scan;
+	}
+
+	if (IS_ENABLED(CONFIG_STACK_SENTINEL)) {
+		/* Skipped as in k_thread_stack_space_get() */
+		start += 4;
+		size -= 4;
+	}
+
+	prev = state->stack_unused;
+	if ((prev >= size) || (start[prev] == 0xaaU)) {
+		goto scan;
+	}
+
+	for (i = prev - MIN(prev, CONFIG_THREAD_ANALYZER_INCREMENTAL_GUARD); i < prev; i++) {
+		if (start[i] != 0xaaU) {
+			break;
+		}
+	}
+
+	if (i < prev) {
+		for (i = 0; (i < prev) && (start[i] == 0xaaU); i++) {
+		}
+
+		state->stack_unused = i;
+	}
+
+	*unused = state->stack_unused;
+
+	return 0;
+
+scan:
+	err = k_thread_stack_space_get(thread, unused);
+	if (state != NULL) {
+		state->stack_valid = (err == 0);
+		state->stack_unused = *unused;
+	}
+
+	return err;
+}
+
+static uint64_t ta_cycles_delta(unsigned int cpu)
+{
+	k_thread_runtime_stats_t rt_stats_all;
+	unsigned int idx = 0;
+	uint64_t delta;
+	int ret;
+
+	if (IS_ENABLED(CONFIG_THREAD_ANALYZER_AUTO_SEPARATE_CORES)) {
+		ret = k_thread_runtime_stats_cpu_get(cpu, &rt_stats_all);
+		idx = cpu;
+	} else {
+		ret = k_thread_runtime_stats_all_get(&rt_stats_all);
+	}
+
+	if (ret != 0) {
+		return 0;
+	}
+
+	delta = rt_stats_all.execution_cycles - ta_cycles[idx];
+	ta_cycles[idx] = rt_stats_all.execution_cycles;
+
+	return delta;
+}
+#endif /* CONFIG_THREAD_ANALYZER_INCREMENTAL */
+
 static void thread_analyze_cb(const struct k_thread *cthread, void *user_data)
 {
 	struct k_thread *thread = (struct k_thread *)cthread;
@@ -105,8 +249,9 @@ static void thread_analyze_cb(const struct k_thread *cthread, void *user_data)
 	size_t unused;
 	int err;
 	int ret;
-
-
+#ifdef CONFIG_THREAD_ANALYZER_INCREMENTAL
+	struct ta_thread_state *state = ta_state_get(thread, ud->run);
+#endif
 
 	name = k_thread_name_get((k_tid_t)thread);
 	if (!name || name[0] == '\0') {
@@ -114,7 +259,11 @@ static void thread_analyze_cb(const struct k_thread *cthread, void *user_data)
 		snprintk(hexname, sizeof(hexname), "%p", (void *)thread);
 	}
 
+#ifdef CONFIG_THREAD_ANALYZER_INCREMENTAL
+	err = ta_stack_unused_get(thread, state, &unused);
+#else
 	err = k_thread_stack_space_get(thread, &unused);
+#endif
 	if (err) {
 		THREAD_ANALYZER_PRINT(
 			THREAD_ANALYZER_FMT(
@@ -145,6 +294,20 @@ static void thread_analyze_cb(const struct k_thread *cthread, void *user_data)
 		ret++;
 	}
 
+#ifdef CONFIG_THREAD_ANALYZER_INCREMENTAL
+	if ((ret == 0) && (state != NULL)) {
+		/* Utilization since the previous run */
+		uint64_t cycles = info.usage.execution_cycles - state->cycles;
+
+		state->cycles = info.usage.execution_cycles;
+		info.utilization = (ud->cycles == 0U) ? 0U :
+			(unsigned int)MIN((cycles * 100U) / ud->cycles, 100U);
+
+		cb(&info);
+		return;
+	}
+#endif
+
 	if (IS_ENABLED(CONFIG_THREAD_ANALYZER_AUTO_SEPARATE_CORES)) {
 		if (k_thread_runtime_stats_cpu_get(cpu, &rt_stats_all) != 0) {
 			ret++;
@@ -199,6 +362,11 @@ void thread_analyzer_run(thread_analyzer_cb cb, unsigned int cpu)
 {
 	struct ta_cb_user_data ud = { .cb = cb, .cpu = cpu };
 
+#ifdef CONFIG_THREAD_ANALYZER_INCREMENTAL
+	ud.run = (uint32_t)atomic_inc(&ta_run) + 1U;
+	ud.cycles = ta_cycles_delta(cpu);
+#endif
+
 	if (IS_ENABLED(CONFIG_THREAD_ANALYZER_RUN_UNLOCKED)) {
 		if (IS_ENABLED(CONFIG_THREAD_ANALYZER_AUTO_SEPARATE_CORES)) {
 			k_thread_foreach_unlocked_filter_by_cpu(cpu, thread_analyze_cb, &ud);
@@ -235,13 +403,39 @@ void thread_analyzer_print(unsigned int cpu)
 
 #if defined(CONFIG_THREAD_ANALYZER_AUTO)
 
+#if defined(CONFIG_THREAD_ANALYZER_AUTO_ZBUS)
+ZBUS_CHAN_DEFINE(thread_analyzer_chan, struct thread_analyzer_zbus_msg, NULL, NULL,
+		 ZBUS_OBSERVERS_EMPTY, ZBUS_MSG_INIT(0));
+
+static void thread_publish_cb(struct thread_analyzer_info *info)
+{
+	struct thread_analyzer_zbus_msg msg = {
+		.stack_size = info->stack_size,
+		.stack_used = info->stack_used,
+		.utilization = info->utilization,
+	};
+	int err;
+
+	strncpy(msg.name, info->name, sizeof(msg.name) - 1);
+
+	err = zbus_chan_pub(&thread_analyzer_chan, &msg, K_FOREVER);
+	if (err) {
+		LOG_WRN("Failed to publish %s (%d)", info->name, err);
+	}
+}
+#endif
+
 void thread_analyzer_auto(void *a, void *b, void *c)
 {
 	unsigned int cpu = IS_ENABLED(CONFIG_THREAD_ANALYZER_AUTO_SEPARATE_CORES) ?
 		(unsigned int)(uintptr_t) a : 0;
 
 	for (;;) {
+#if defined(CONFIG_THREAD_ANALYZER_AUTO_ZBUS)
+		thread_analyzer_run(thread_publish_cb, cpu);
+#else
 		thread_analyzer_print(cpu);
+#endif
 		k_sleep(K_SECONDS(CONFIG_THREAD_ANALYZER_AUTO_INTERVAL));
 	}
 }
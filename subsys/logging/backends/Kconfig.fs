@@ -66,4 +66,65 @@ config LOG_BACKEND_FS_FILES_LIMIT
 	  Limit of number of files with logs. It is also limited by
 	  size of file system partition.
 
+config LOG_BACKEND_FS_WRITE_BEHIND
+	bool "Write-behind buffering"
+	select RING_BUFFER
+	help
+	  When enabled, formatted messages are collected in a RAM buffer and
+	  written to the file by a dedicated work queue in chunks ending at
+	  block boundaries of the file. The file is synced according to
+	  LOG_BACKEND_FS_SYNC_INTERVAL and LOG_BACKEND_FS_SYNC_SIZE instead of
+	  after every message, and file rotation happens on the work queue
+	  as well. This greatly reduces flash wear and the time the logging
+	  thread spends in the file system, at the cost of losing the data
+	  not yet synced on a power loss or reset.
+
+if LOG_BACKEND_FS_WRITE_BEHIND
+
+config LOG_BACKEND_FS_WRITE_BEHIND_BUF_SIZE
+	int "Write-behind buffer size"
+	default 2048
+	help
+	  Size of the RAM buffer holding data not yet written to the file.
+	  Must be at least LOG_BACKEND_FS_WRITE_BEHIND_BLOCK_SIZE. When the
+	  buffer is full, the logging thread writes out data itself.
+
+config LOG_BACKEND_FS_WRITE_BEHIND_BLOCK_SIZE
+	int "Write block size"
+	default 512
+	range 1 65536
+	help
+	  Data is written to the file in chunks ending at multiples of this
+	  size, which should match the block or program size of the
+	  underlying file system (e.g. the LittleFS cache size).
+	  LOG_BACKEND_FS_FILE_SIZE should be a multiple of it.
+
+config LOG_BACKEND_FS_SYNC_INTERVAL
+	int "Maximum time before buffered data is synced [ms]"
+	default 1000
+	help
+	  Buffered data, including a trailing partial block, is written and
+	  the file synced at the latest this long after it was logged.
+
+config LOG_BACKEND_FS_SYNC_SIZE
+	int "Bytes written between syncs"
+	default 4096
+	help
+	  The file is additionally synced whenever this many bytes were
+	  written to it since the last sync.
+
+config LOG_BACKEND_FS_WRITE_BEHIND_STACK_SIZE
+	int "Write-behind work queue stack size"
+	default 2048
+
+config LOG_BACKEND_FS_WRITE_BEHIND_PRIORITY
+	int "Write-behind work queue priority"
+	default 14
+	help
+	  Priority of the thread writing the log data to the file system.
+	  It should normally be lower than the priority of the threads
+	  generating logs.
+
+endif # LOG_BACKEND_FS_WRITE_BEHIND
+
 endif # LOG_BACKEND_FS
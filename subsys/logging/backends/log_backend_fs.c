@@ -11,6 +11,7 @@
 #include <zephyr/logging/log_backend_std.h>
 #include <assert.h>
 #include <zephyr/fs/fs.h>
+#include <zephyr/sys/ring_buffer.h>
 
 #define MAX_PATH_LEN 256
 #define MAX_FLASH_WRITE_SIZE 256
@@ -211,10 +212,13 @@ int write_log_to_file(uint8_t *data, size_t length, void *ctx)
 			length = 0;
 		}
 
-		rc = fs_sync(f);
-		if (rc < 0) {
-			/* Something is wrong */
-			goto on_error;
+		/* The write-behind work syncs according to its own policy */
+		if (!IS_ENABLED(CONFIG_LOG_BACKEND_FS_WRITE_BEHIND)) {
+			rc = fs_sync(f);
+			if (rc < 0) {
+				/* Something is wrong */
+				goto on_error;
+			}
 		}
 	}
 
@@ -450,10 +454,200 @@ static int del_oldest_log(void)
 BUILD_ASSERT(!IS_ENABLED(CONFIG_LOG_MODE_IMMEDIATE),
 	     "Immediate logging is not supported by LOG FS backend.");
 
+#ifdef CONFIG_LOG_BACKEND_FS_WRITE_BEHIND
+#define WB_BLOCK_SIZE CONFIG_LOG_BACKEND_FS_WRITE_BEHIND_BLOCK_SIZE
+
+BUILD_ASSERT(CONFIG_LOG_BACKEND_FS_WRITE_BEHIND_BUF_SIZE >= WB_BLOCK_SIZE,
+	     "Write-behind buffer must hold at least one block");
+
+RING_BUF_DECLARE(wb_ring, CONFIG_LOG_BACKEND_FS_WRITE_BEHIND_BUF_SIZE);
+/* Protects the ring buffer, held only for copying */
+static struct k_spinlock wb_ring_lock;
+/* Serializes file system access between the work queue and the logging
+ * thread when the latter has to write out data itself.
+ */
+static K_MUTEX_DEFINE(wb_lock);
+static K_KERNEL_STACK_DEFINE(wb_stack, CONFIG_LOG_BACKEND_FS_WRITE_BEHIND_STACK_SIZE);
+static struct k_work_q wb_work_q;
+static struct k_work wb_block_work;
+static struct k_work_delayable wb_sync_work;
+static uint8_t __aligned(4) wb_block[WB_BLOCK_SIZE];
+static size_t wb_unsynced;
+static bool wb_started;
+static bool wb_panic;
+
+static uint32_t wb_ring_size(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&wb_ring_lock);
+	uint32_t size = ring_buf_size_get(&wb_ring);
+
+	k_spin_unlock(&wb_ring_lock, key);
+
+	return size;
+}
+
+/* Write buffered data to the file in chunks ending at block boundaries of
+ * the file. A trailing partial block is only written when flushing, that is
+ * when the sync interval expired. Must be called with wb_lock held.
+ */
+static void wb_drain(bool flush)
+{
+	uint32_t avail = wb_ring_size();
+
+	while (avail > 0U) {
+		off_t pos = (backend_state == BACKEND_FS_OK) ? fs_tell(&fs_file) : 0;
+		uint32_t chunk = WB_BLOCK_SIZE - (MAX(pos, 0) % WB_BLOCK_SIZE);
+		k_spinlock_key_t key;
+
+		if (avail < chunk) {
+			if (!flush) {
+				break;
+			}
+
+			chunk = avail;
+		}
+
+		key = k_spin_lock(&wb_ring_lock);
+		chunk = ring_buf_get(&wb_ring, wb_block, chunk);
+		k_spin_unlock(&wb_ring_lock, key);
+
+		log_output_write(write_log_to_file, wb_block, chunk, NULL);
+		wb_unsynced += chunk;
+		avail -= chunk;
+	}
+
+	if ((backend_state == BACKEND_FS_OK) && (wb_unsynced > 0U) &&
+	    (flush || (wb_unsynced >= CONFIG_LOG_BACKEND_FS_SYNC_SIZE))) {
+		if (fs_sync(&fs_file) < 0) {
+			backend_state = BACKEND_FS_CORRUPTED;
+		}
+
+		wb_unsynced = 0U;
+	}
+}
+
+static void wb_block_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&wb_lock, K_FOREVER);
+	wb_drain(false);
+	k_mutex_unlock(&wb_lock);
+}
+
+static void wb_sync_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&wb_lock, K_FOREVER);
+	wb_drain(true);
+	k_mutex_unlock(&wb_lock);
+}
+
+static void wb_start(void)
+{
+	const struct k_work_queue_config cfg = {
+		.name = "log_fs_wb",
+	};
+
+	k_work_init(&wb_block_work, wb_block_handler);
+	k_work_init_delayable(&wb_sync_work, wb_sync_handler);
+	k_work_queue_start(&wb_work_q, wb_stack, K_KERNEL_STACK_SIZEOF(wb_stack),
+			   CONFIG_LOG_BACKEND_FS_WRITE_BEHIND_PRIORITY, &cfg);
+	wb_started = true;
+}
+
+/* In panic mode the work queue no longer runs and blocking is not allowed,
+ * so data is written to the file directly. It is dropped if the file system
+ * is in use by the interrupted work queue.
+ */
+static int wb_panic_out(uint8_t *data, size_t length)
+{
+	int rc;
+
+	if (k_mutex_lock(&wb_lock, K_NO_WAIT) != 0) {
+		return length;
+	}
+
+	wb_drain(true);
+
+	rc = write_log_to_file(data, length, NULL);
+	if ((backend_state == BACKEND_FS_OK) && (fs_sync(&fs_file) < 0)) {
+		backend_state = BACKEND_FS_CORRUPTED;
+	}
+
+	k_mutex_unlock(&wb_lock);
+
+	return rc;
+}
+
+int write_log_behind(uint8_t *data, size_t length, void *ctx)
+{
+	k_spinlock_key_t key;
+	uint32_t len;
+
+	ARG_UNUSED(ctx);
+
+	if (wb_panic) {
+		return wb_panic_out(data, length);
+	}
+
+	if (!wb_started) {
+		wb_start();
+	}
+
+	key = k_spin_lock(&wb_ring_lock);
+	len = ring_buf_put(&wb_ring, data, length);
+	k_spin_unlock(&wb_ring_lock, key);
+
+	if (len < length) {
+		/* The work queue fell behind, write out whole blocks here rather
+		 * than dropping data. The caller retries with the remainder.
+		 */
+		k_mutex_lock(&wb_lock, K_FOREVER);
+		wb_drain(false);
+		k_mutex_unlock(&wb_lock);
+	} else if (wb_ring_size() >= WB_BLOCK_SIZE) {
+		(void)k_work_submit_to_queue(&wb_work_q, &wb_block_work);
+	}
+
+	/* Does not move an already pending deadline, which bounds the time
+	 * data stays in RAM.
+	 */
+	(void)k_work_schedule_for_queue(&wb_work_q, &wb_sync_work,
+					K_MSEC(CONFIG_LOG_BACKEND_FS_SYNC_INTERVAL));
+
+	return len;
+}
+
+/* Switch to writing directly and flush the buffered data, if possible.
+ * Never blocks.
+ */
+void panic_log_behind(void)
+{
+	wb_panic = true;
+
+	if (!wb_started) {
+		return;
+	}
+
+	(void)k_work_cancel_delayable(&wb_sync_work);
+	(void)k_work_cancel(&wb_block_work);
+
+	if (k_mutex_lock(&wb_lock, K_NO_WAIT) == 0) {
+		wb_drain(true);
+		k_mutex_unlock(&wb_lock);
+	}
+}
+#endif /* CONFIG_LOG_BACKEND_FS_WRITE_BEHIND */
+
 #ifndef CONFIG_LOG_BACKEND_FS_TESTSUITE
 
 static uint8_t __aligned(4) buf[MAX_FLASH_WRITE_SIZE];
-LOG_OUTPUT_DEFINE(log_output, write_log_to_file, buf, MAX_FLASH_WRITE_SIZE);
+LOG_OUTPUT_DEFINE(log_output,
+		  COND_CODE_1(CONFIG_LOG_BACKEND_FS_WRITE_BEHIND,
+			      (write_log_behind), (write_log_to_file)),
+		  buf, MAX_FLASH_WRITE_SIZE);
 
 static void log_backend_fs_init(const struct log_backend *const backend)
 {
@@ -461,6 +655,16 @@ static void log_backend_fs_init(const struct log_backend *const backend)
 
 static void panic(struct log_backend const *const backend)
 {
+#ifdef CONFIG_LOG_BACKEND_FS_WRITE_BEHIND
+	if (!k_is_in_isr()) {
+		/* Keep the messages that led to the panic, the buffered data
+		 * goes first.
+		 */
+		panic_log_behind();
+		log_output_flush(&log_output);
+	}
+#endif
+
 	/* In case of panic deinitialize backend. It is better to keep
 	 * current data rather than log new and risk of failure.
 	 */
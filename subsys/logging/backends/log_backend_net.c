@@ -11,6 +11,7 @@ LOG_MODULE_REGISTER(log_backend_net, CONFIG_LOG_DEFAULT_LEVEL);
 #include <zephyr/logging/log_backend.h>
 #include <zephyr/logging/log_core.h>
 #include <zephyr/logging/log_output.h>
+#include <zephyr/logging/log_output_dict.h>
 #include <zephyr/logging/log_backend_net.h>
 #include <zephyr/net/hostname.h>
 #include <zephyr/net/net_if.h>
@@ -216,6 +217,20 @@ static void process(const struct log_backend *const backend,
 	log_output_func(&log_output_net, &msg->log, flags);
 }
 
+static void dropped(const struct log_backend *const backend, uint32_t cnt)
+{
+	ARG_UNUSED(backend);
+
+	/* Syslog servers only expect RFC 5424 framed messages, so drops are
+	 * only reported in the dictionary format where the host parser
+	 * understands them.
+	 */
+	if (IS_ENABLED(CONFIG_LOG_DICTIONARY_SUPPORT) && !panic_mode && net_init_done &&
+	    log_format_current == LOG_OUTPUT_DICT) {
+		log_dict_output_dropped_process(&log_output_net, cnt);
+	}
+}
+
 static int format_set(const struct log_backend *const backend, uint32_t log_type)
 {
 	log_format_current = log_type;
@@ -341,6 +356,7 @@ const struct log_backend_api log_backend_net_api = {
 	.panic = panic,
 	.init = init_net,
 	.process = process,
+	.dropped = dropped,
 	.format_set = format_set,
 };
 
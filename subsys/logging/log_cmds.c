@@ -182,6 +182,17 @@ static void filters_set(const struct shell *sh,
 	}
 
 	for (i = 0; i < cnt; i++) {
+		if (!all && (strpbrk(argv[i], "*?") != NULL)) {
+			if (IS_ENABLED(CONFIG_LOG_FRONTEND) && !backend) {
+				shell_error(sh, "%s: patterns not supported for frontend.",
+					    argv[i]);
+			} else if (log_filter_set_by_pattern(backend, Z_LOG_LOCAL_DOMAIN_ID,
+							     argv[i], level) <= 0) {
+				shell_error(sh, "%s: no matching source.", argv[i]);
+			}
+			continue;
+		}
+
 		id = all ? i : module_id_get(argv[i]);
 		if (id >= 0) {
 			uint32_t set_lvl;
@@ -406,6 +417,13 @@ static int cmd_log_mem(const struct shell *sh, size_t argc, char **argv)
 	shell_print(sh, "\tCapacity: %u bytes", size);
 	shell_print(sh, "\tCurrently in use: %u bytes", used);
 
+	if (IS_ENABLED(CONFIG_LOG_PER_CPU_BUFFERS)) {
+		for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+			shell_print(sh, "\tCPU %u dropped: %u messages", cpu,
+				    log_cpu_dropped_get(cpu));
+		}
+	}
+
 	err = log_mem_get_max_usage(&max);
 	if (err < 0) {
 		shell_print(sh, "Enable CONFIG_LOG_MEM_UTILIZATION to get maximum usage");
@@ -425,7 +443,7 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_log_backend,
 	SHELL_CMD_ARG(enable, &dsub_severity_lvl,
 		  "'log enable <level> <module_0> ...  <module_n>' enables logs"
 		  " up to given level in specified modules (all if no modules "
-		  "specified).",
+		  "specified). Module names may contain '*' and '?' wildcards.",
 		  cmd_log_backend_enable, 2, 255),
 	SHELL_CMD(go, NULL, "Resume logging", cmd_log_backend_go),
 	SHELL_CMD(halt, NULL, "Halt logging", cmd_log_backend_halt),
@@ -467,7 +485,8 @@ SHELL_STATIC_SUBCMD_SET_CREATE(
 			   cmd_log_self_disable, 1, 255),
 	SHELL_COND_CMD_ARG(CONFIG_SHELL_LOG_BACKEND, enable, &dsub_severity_lvl,
 			   "'log enable <level> <module_0> ...  <module_n>' enables logs up to"
-			   " given level in specified modules (all if no modules specified).",
+			   " given level in specified modules (all if no modules specified)."
+			   " Module names may contain '*' and '?' wildcards.",
 			   cmd_log_self_enable, 2, 255),
 	SHELL_COND_CMD(CONFIG_SHELL_LOG_BACKEND, go, NULL, "Resume logging", cmd_log_self_go),
 	SHELL_COND_CMD(CONFIG_SHELL_LOG_BACKEND, halt, NULL, "Halt logging", cmd_log_self_halt),
@@ -120,17 +120,44 @@ static STRUCT_SECTION_ITERABLE(log_msg_ptr, log_msg_ptr);
 static STRUCT_SECTION_ITERABLE_ALTERNATE(log_mpsc_pbuf, mpsc_pbuf_buffer, log_buffer);
 static struct mpsc_pbuf_buffer *curr_log_buffer;
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+#define LOG_CPU_BUFFERS CONFIG_MP_MAX_NUM_CPUS
+#else
+#define LOG_CPU_BUFFERS 1
+#endif
+
+/* Messages dropped from the buffer of each CPU, never cleared */
+static atomic_t cpu_dropped_cnt[LOG_CPU_BUFFERS];
+
+#if LOG_CPU_BUFFERS > 1
+#define CPU_BUF_WLEN ROUND_UP(CONFIG_LOG_BUFFER_SIZE / sizeof(int), \
+			      Z_LOG_MSG_ALIGNMENT / sizeof(int))
+
+/* CPU 0 uses log_buffer, which also holds messages from links without a
+ * dedicated buffer. Every other CPU allocates messages from its own buffer,
+ * so that CPUs logging at the same time do not contend on one buffer lock.
+ */
+static uint32_t __aligned(Z_LOG_MSG_ALIGNMENT)
+	cpu_buf32[LOG_CPU_BUFFERS - 1][CPU_BUF_WLEN];
+static struct mpsc_pbuf_buffer cpu_log_buffer[LOG_CPU_BUFFERS - 1];
+
+/* Message claimed from each CPU buffer which is not processed yet because
+ * an older one was found in another buffer.
+ */
+static union log_msg_generic *cpu_log_msg[LOG_CPU_BUFFERS - 1];
+#endif
+
 #ifdef CONFIG_MPSC_PBUF
 static uint32_t __aligned(Z_LOG_MSG_ALIGNMENT)
 	buf32[CONFIG_LOG_BUFFER_SIZE / sizeof(int)];
 
-static void z_log_notify_drop(const struct mpsc_pbuf_buffer *buffer,
-			      const union mpsc_pbuf_generic *item);
+static void cpu_notify_drop(const struct mpsc_pbuf_buffer *buffer,
+			    const union mpsc_pbuf_generic *item);
 
 static const struct mpsc_pbuf_buffer_config mpsc_config = {
 	.buf = (uint32_t *)buf32,
 	.size = ARRAY_SIZE(buf32),
-	.notify_drop = z_log_notify_drop,
+	.notify_drop = cpu_notify_drop,
 	.get_wlen = log_msg_generic_get_wlen,
 	.flags = (IS_ENABLED(CONFIG_LOG_MODE_OVERFLOW) ?
 		  MPSC_PBUF_MODE_OVERWRITE : 0) |
@@ -635,12 +662,93 @@ bool z_log_dropped_pending(void)
 	return dropped_cnt > 0;
 }
 
+static inline int curr_cpu_get(void)
+{
+#if LOG_CPU_BUFFERS > 1
+	/* Migrating right after reading the CPU only means that the message
+	 * is allocated from the buffer of another CPU, which is still safe.
+	 */
+	return arch_curr_cpu()->id;
+#else
+	return 0;
+#endif
+}
+
+static struct mpsc_pbuf_buffer *cpu_buffer_get(int cpu)
+{
+#if LOG_CPU_BUFFERS > 1
+	if (cpu > 0) {
+		return &cpu_log_buffer[cpu - 1];
+	}
+#endif
+
+	return &log_buffer;
+}
+
+/* A thread may migrate between allocating and committing a message, so the
+ * buffer is found from the message address rather than the current CPU.
+ */
+static int msg_cpu_get(const struct log_msg *msg)
+{
+#if LOG_CPU_BUFFERS > 1
+	uintptr_t offset = (uintptr_t)msg - (uintptr_t)cpu_buf32;
+
+	if ((uintptr_t)msg >= (uintptr_t)cpu_buf32 && offset < sizeof(cpu_buf32)) {
+		return offset / sizeof(cpu_buf32[0]) + 1;
+	}
+#endif
+
+	return 0;
+}
+
+#ifdef CONFIG_MPSC_PBUF
+static int buffer_cpu_get(const struct mpsc_pbuf_buffer *buffer)
+{
+#if LOG_CPU_BUFFERS > 1
+	if (buffer >= cpu_log_buffer && buffer < &cpu_log_buffer[LOG_CPU_BUFFERS - 1]) {
+		return buffer - cpu_log_buffer + 1;
+	}
+#endif
+
+	return 0;
+}
+
+static void cpu_notify_drop(const struct mpsc_pbuf_buffer *buffer,
+			    const union mpsc_pbuf_generic *item)
+{
+	ARG_UNUSED(item);
+
+	atomic_inc(&cpu_dropped_cnt[buffer_cpu_get(buffer)]);
+	z_log_dropped(true);
+}
+#endif /* CONFIG_MPSC_PBUF */
+
+uint32_t log_cpu_dropped_get(unsigned int cpu)
+{
+	if (cpu >= LOG_CPU_BUFFERS) {
+		return 0;
+	}
+
+	return atomic_get(&cpu_dropped_cnt[cpu]);
+}
+
 void z_log_msg_init(void)
 {
 #ifdef CONFIG_MPSC_PBUF
 	mpsc_pbuf_init(&log_buffer, &mpsc_config);
 	curr_log_buffer = &log_buffer;
 #endif
+
+#if LOG_CPU_BUFFERS > 1
+	for (int i = 0; i < LOG_CPU_BUFFERS - 1; i++) {
+		struct mpsc_pbuf_buffer_config config = mpsc_config;
+
+		config.buf = cpu_buf32[i];
+		config.size = ARRAY_SIZE(cpu_buf32[i]);
+		mpsc_pbuf_init(&cpu_log_buffer[i], &config);
+		cpu_log_msg[i] = NULL;
+	}
+#endif
 }
 
 static struct log_msg *msg_alloc(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
@@ -658,7 +766,14 @@ static struct log_msg *msg_alloc(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
 
 struct log_msg *z_log_msg_alloc(uint32_t wlen)
 {
-	return msg_alloc(&log_buffer, wlen);
+	int cpu = curr_cpu_get();
+	struct log_msg *msg = msg_alloc(cpu_buffer_get(cpu), wlen);
+
+	if (msg == NULL && IS_ENABLED(CONFIG_LOG_MODE_DEFERRED)) {
+		atomic_inc(&cpu_dropped_cnt[cpu]);
+	}
+
+	return msg;
 }
 
 static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
@@ -690,7 +805,7 @@ static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
 void z_log_msg_commit(struct log_msg *msg)
 {
 	msg->hdr.timestamp = timestamp_func();
-	msg_commit(&log_buffer, msg);
+	msg_commit(cpu_buffer_get(msg_cpu_get(msg)), msg);
 }
 
 union log_msg_generic *z_log_msg_local_claim(void)
@@ -703,11 +818,39 @@ union log_msg_generic *z_log_msg_local_claim(void)
 
 }
 
-/* If there are buffers dedicated for each link, claim the oldest message (lowest timestamp). */
+/* Claim the next message of the buffer unless one is already waiting in the
+ * slot and check whether it is older than the oldest message found so far.
+ */
+static bool msg_oldest_check(union log_msg_generic **slot,
+			     struct mpsc_pbuf_buffer *buffer,
+			     log_timestamp_t *t_min)
+{
+#ifdef CONFIG_MPSC_PBUF
+	if (*slot == NULL) {
+		*slot = (union log_msg_generic *)mpsc_pbuf_claim(buffer);
+	}
+#endif
+
+	if (*slot != NULL) {
+		log_timestamp_t t = log_msg_get_timestamp(&(*slot)->log);
+
+		if (t < *t_min) {
+			*t_min = t;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* If there are buffers dedicated for each link or CPU, claim the oldest
+ * message (lowest timestamp).
+ */
 union log_msg_generic *z_log_msg_claim_oldest(k_timeout_t *backoff)
 {
 	union log_msg_generic *msg = NULL;
-	struct log_msg_ptr *chosen = NULL;
+	union log_msg_generic **chosen = NULL;
+	struct mpsc_pbuf_buffer *chosen_buffer = NULL;
 	log_timestamp_t t_min = sizeof(log_timestamp_t) > sizeof(uint32_t) ?
 				UINT64_MAX : UINT32_MAX;
 	int i = 0;
@@ -718,49 +861,52 @@ union log_msg_generic *z_log_msg_claim_oldest(k_timeout_t *backoff)
 
 		STRUCT_SECTION_GET(log_mpsc_pbuf, i, &buf);
 
-#ifdef CONFIG_MPSC_PBUF
-		if (msg_ptr->msg == NULL) {
-			msg_ptr->msg = (union log_msg_generic *)mpsc_pbuf_claim(&buf->buf);
+		if (msg_oldest_check(&msg_ptr->msg, &buf->buf, &t_min)) {
+			chosen = &msg_ptr->msg;
+			chosen_buffer = &buf->buf;
 		}
-#endif
-
-		if (msg_ptr->msg) {
-			log_timestamp_t t = log_msg_get_timestamp(&msg_ptr->msg->log);
+		i++;
+	}
 
-			if (t < t_min) {
-				t_min = t;
-				msg = msg_ptr->msg;
-				chosen = msg_ptr;
-				curr_log_buffer = &buf->buf;
-			}
+#if LOG_CPU_BUFFERS > 1
+	for (int cpu = 1; cpu < LOG_CPU_BUFFERS; cpu++) {
+		if (msg_oldest_check(&cpu_log_msg[cpu - 1], &cpu_log_buffer[cpu - 1],
+				     &t_min)) {
+			chosen = &cpu_log_msg[cpu - 1];
+			chosen_buffer = &cpu_log_buffer[cpu - 1];
 		}
-		i++;
 	}
+#endif
 
-	if (msg) {
-		if (CONFIG_LOG_PROCESSING_LATENCY_US > 0) {
-			int32_t diff = t_min - (timestamp_func() - proc_latency);
-
-			if (diff > 0) {
-			       /* Entry is too new. Back off for sometime to allow new
-				* remote messages to arrive which may have been captured
-				* earlier (but on other platform). Calculate for how
-				* long processing shall back off.
-				*/
-				if (timestamp_freq == sys_clock_hw_cycles_per_sec()) {
-					*backoff = K_TICKS(diff);
-				} else {
-					*backoff = K_TICKS((diff * sys_clock_hw_cycles_per_sec()) /
-							timestamp_freq);
-				}
-
-				return NULL;
+	if (chosen == NULL) {
+		return NULL;
+	}
+
+	msg = *chosen;
+
+	if (CONFIG_LOG_PROCESSING_LATENCY_US > 0) {
+		int32_t diff = t_min - (timestamp_func() - proc_latency);
+
+		if (diff > 0) {
+		       /* Entry is too new. Back off for sometime to allow new
+			* remote messages to arrive which may have been captured
+			* earlier (but on other platform). Calculate for how
+			* long processing shall back off.
+			*/
+			if (timestamp_freq == sys_clock_hw_cycles_per_sec()) {
+				*backoff = K_TICKS(diff);
+			} else {
+				*backoff = K_TICKS((diff * sys_clock_hw_cycles_per_sec()) /
+						timestamp_freq);
 			}
-		}
 
-		(*chosen).msg = NULL;
+			return NULL;
+		}
 	}
 
+	*chosen = NULL;
+	curr_log_buffer = chosen_buffer;
+
 	if (t_min < prev_timestamp) {
 		atomic_inc(&unordered_cnt);
 	}
@@ -777,7 +923,7 @@ union log_msg_generic *z_log_msg_claim(k_timeout_t *backoff)
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
 
 	/* Use only one buffer if others are not registered. */
-	if (IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) && len > 1) {
+	if ((IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) && len > 1) || LOG_CPU_BUFFERS > 1) {
 		return z_log_msg_claim_oldest(backoff);
 	}
 
@@ -812,10 +958,18 @@ bool z_log_msg_pending(void)
 
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
 
-	if (!IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) || (len == 1)) {
+	if ((!IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) || (len == 1)) && LOG_CPU_BUFFERS == 1) {
 		return msg_pending(&log_buffer);
 	}
 
+#if LOG_CPU_BUFFERS > 1
+	for (int cpu = 1; cpu < LOG_CPU_BUFFERS; cpu++) {
+		if (cpu_log_msg[cpu - 1] || msg_pending(&cpu_log_buffer[cpu - 1])) {
+			return true;
+		}
+	}
+#endif
+
 	STRUCT_SECTION_FOREACH(log_msg_ptr, msg_ptr) {
 		struct log_mpsc_pbuf *buf;
 
@@ -894,6 +1048,17 @@ int log_mem_get_usage(uint32_t *buf_size, uint32_t *usage)
 
 	mpsc_pbuf_get_utilization(&log_buffer, buf_size, usage);
 
+#if LOG_CPU_BUFFERS > 1
+	for (int i = 0; i < LOG_CPU_BUFFERS - 1; i++) {
+		uint32_t cpu_size;
+		uint32_t cpu_usage;
+
+		mpsc_pbuf_get_utilization(&cpu_log_buffer[i], &cpu_size, &cpu_usage);
+		*buf_size += cpu_size;
+		*usage += cpu_usage;
+	}
+#endif
+
 	return 0;
 }
 
@@ -905,7 +1070,21 @@ int log_mem_get_max_usage(uint32_t *max)
 		return -EINVAL;
 	}
 
+#if LOG_CPU_BUFFERS > 1
+	int err = mpsc_pbuf_get_max_utilization(&log_buffer, max);
+
+	/* Sum of the peaks of all CPU buffers, an upper bound of the peak */
+	for (int i = 0; (err == 0) && (i < LOG_CPU_BUFFERS - 1); i++) {
+		uint32_t cpu_max;
+
+		err = mpsc_pbuf_get_max_utilization(&cpu_log_buffer[i], &cpu_max);
+		*max += cpu_max;
+	}
+
+	return err;
+#else
 	return mpsc_pbuf_get_max_utilization(&log_buffer, max);
+#endif
 }
 
 static void log_backend_notify_all(enum log_backend_evt event,
@@ -508,6 +508,59 @@ uint32_t z_vrfy_log_filter_set(struct log_backend const *const backend,
 #include <zephyr/syscalls/log_filter_set_mrsh.c>
 #endif
 
+/* Iterative wildcard matching: on mismatch, retry from the most recent '*'
+ * with the name advanced by one character.
+ */
+static bool name_match(const char *pattern, const char *name)
+{
+	const char *star = NULL;
+	const char *backtrack = NULL;
+
+	while (*name != '\0') {
+		if (*pattern == '*') {
+			star = ++pattern;
+			backtrack = name;
+		} else if ((*pattern == '?') || (*pattern == *name)) {
+			pattern++;
+			name++;
+		} else if (star != NULL) {
+			pattern = star;
+			name = ++backtrack;
+		} else {
+			return false;
+		}
+	}
+
+	while (*pattern == '*') {
+		pattern++;
+	}
+
+	return *pattern == '\0';
+}
+
+int log_filter_set_by_pattern(struct log_backend const *const backend,
+			      uint32_t domain_id, const char *pattern,
+			      uint32_t level)
+{
+	int cnt = 0;
+
+	if (!IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ||
+	    IS_ENABLED(CONFIG_LOG_FMT_SECTION_STRIP)) {
+		return -ENOTSUP;
+	}
+
+	for (uint32_t s = 0; s < log_src_cnt_get(domain_id); s++) {
+		const char *name = log_source_name_get(domain_id, s);
+
+		if ((name != NULL) && name_match(pattern, name)) {
+			(void)log_filter_set(backend, domain_id, s, level);
+			cnt++;
+		}
+	}
+
+	return cnt;
+}
+
 static void link_filter_set(const struct log_link *link,
 			    struct log_backend const *const backend,
 			    uint32_t level)
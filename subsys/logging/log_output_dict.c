@@ -11,10 +11,100 @@
 #include <zephyr/logging/log_output_dict.h>
 #include <zephyr/sys/__assert.h>
 #include <zephyr/sys/util.h>
+#include <string.h>
+
+#ifdef CONFIG_LOG_DICTIONARY_COMPACT
+/* Type byte, domain and up to four LEB128 encoded integers */
+#define COMPACT_HDR_MAX_LEN (2 + 4 * DIV_ROUND_UP(sizeof(uint64_t) * 8, 7))
+
+static size_t varint_encode(uint8_t *buf, uint64_t value)
+{
+	size_t len = 0;
+
+	do {
+		buf[len] = value & 0x7F;
+		value >>= 7;
+		if (value != 0U) {
+			buf[len] |= 0x80;
+		}
+		len++;
+	} while (value != 0U);
+
+	return len;
+}
+
+/* Stage the message in the output buffer so that it is typically handed
+ * to the backend in a single call, e.g. one datagram for the network backend.
+ */
+static void compact_write(const struct log_output *output, const uint8_t *data, size_t len)
+{
+	struct log_output_control_block *cb = output->control_block;
+
+	while (len > 0U) {
+		size_t chunk = MIN(len, output->size - cb->offset);
+
+		memcpy(&output->buf[cb->offset], data, chunk);
+		cb->offset += chunk;
+		data += chunk;
+		len -= chunk;
+
+		if (cb->offset == output->size) {
+			log_output_flush(output);
+		}
+	}
+}
+
+static void compact_msg_process(const struct log_output *output, struct log_msg *msg)
+{
+	struct log_output_control_block *cb = output->control_block;
+	uint8_t hdr[COMPACT_HDR_MAX_LEN];
+	uint8_t *data;
+	void *source = (void *)log_msg_get_source(msg);
+	log_timestamp_t timestamp = msg->hdr.timestamp;
+	uint8_t domain = msg->hdr.desc.domain;
+	size_t data_len = msg->hdr.desc.data_len;
+	/* Unsigned subtraction keeps the delta correct across a counter wrap */
+	log_timestamp_t delta = timestamp - cb->timestamp;
+	bool sync = cb->sync_cnt == 0U;
+	size_t len = 1;
+
+	hdr[0] = (sync ? MSG_NORMAL_COMPACT_SYNC : MSG_NORMAL_COMPACT) |
+		 (msg->hdr.desc.level << LOG_DICT_COMPACT_LEVEL_SHIFT) |
+		 ((data_len > 0U) ? LOG_DICT_COMPACT_HAS_DATA : 0) |
+		 ((domain != 0U) ? LOG_DICT_COMPACT_HAS_DOMAIN : 0);
+
+	if (domain != 0U) {
+		hdr[len++] = domain;
+	}
+
+	len += varint_encode(&hdr[len], (source != NULL) ? log_source_id(source) : 0U);
+	len += varint_encode(&hdr[len], sync ? timestamp : delta);
+	len += varint_encode(&hdr[len], msg->hdr.desc.package_len);
+	if (data_len > 0U) {
+		len += varint_encode(&hdr[len], data_len);
+	}
+
+	cb->timestamp = timestamp;
+	cb->sync_cnt = (sync ? CONFIG_LOG_DICTIONARY_COMPACT_SYNC_INTERVAL : cb->sync_cnt) - 1U;
+
+	compact_write(output, hdr, len);
+
+	data = log_msg_get_package(msg, &len);
+	compact_write(output, data, len);
+
+	data = log_msg_get_data(msg, &len);
+	compact_write(output, data, len);
+
+	log_output_flush(output);
+}
+#endif /* CONFIG_LOG_DICTIONARY_COMPACT */
 
 void log_dict_output_msg_process(const struct log_output *output,
 				 struct log_msg *msg, uint32_t flags)
 {
+#ifdef CONFIG_LOG_DICTIONARY_COMPACT
+	compact_msg_process(output, msg);
+#else
 	struct log_dict_output_normal_msg_hdr_t output_hdr;
 	void *source = (void *)log_msg_get_source(msg);
 
@@ -44,6 +134,7 @@ void log_dict_output_msg_process(const struct log_output *output,
 	}
 
 	log_output_flush(output);
+#endif
 }
 
 void log_dict_output_dropped_process(const struct log_output *output, uint32_t cnt)
@@ -2070,6 +2070,7 @@ static int context_setup_udp_packet(struct net_context *context,
 				    struct net_pkt *pkt,
 				    const void *buf,
 				    size_t len,
+				    struct net_buf *frags,
 				    const struct msghdr *msg,
 				    const struct sockaddr *dst_addr,
 				    socklen_t addrlen)
@@ -2110,9 +2111,14 @@ static int context_setup_udp_packet(struct net_context *context,
 		return ret;
 	}
 
-	ret = context_write_data(pkt, buf, len, msg);
-	if (ret) {
-		return ret;
+	if (frags) {
+		/* Link the caller's buffers after the headers */
+		net_pkt_append_buffer(pkt, frags);
+	} else {
+		ret = context_write_data(pkt, buf, len, msg);
+		if (ret) {
+			return ret;
+		}
 	}
 
 #if defined(CONFIG_NET_CONTEXT_TIMESTAMPING)
@@ -2199,9 +2205,28 @@ static void set_pkt_txtime(struct net_pkt *pkt, const struct msghdr *msghdr)
 	}
 }
 
+/* Give the caller's buffers back if the packet could not be sent */
+static void context_detach_frags(struct net_pkt *pkt, struct net_buf *frags)
+{
+	struct net_buf *buf;
+
+	if (pkt->buffer == frags) {
+		pkt->buffer = NULL;
+		return;
+	}
+
+	for (buf = pkt->buffer; buf; buf = buf->frags) {
+		if (buf->frags == frags) {
+			buf->frags = NULL;
+			break;
+		}
+	}
+}
+
 static int context_sendto(struct net_context *context,
 			  const void *buf,
 			  size_t len,
+			  struct net_buf *frags,
 			  const struct sockaddr *dst_addr,
 			  socklen_t addrlen,
 			  net_context_send_cb_t cb,
@@ -2468,6 +2493,16 @@ static int context_sendto(struct net_context *context,
 		return -ENETDOWN;
 	}
 
+	if (frags) {
+		if (net_if_is_ip_offloaded(iface) ||
+		    (net_context_get_proto(context) != IPPROTO_UDP &&
+		     net_context_get_proto(context) != IPPROTO_TCP)) {
+			return -EOPNOTSUPP;
+		}
+
+		len = net_buf_frags_len(frags);
+	}
+
 	context->send_cb = cb;
 	context->user_data = user_data;
 
@@ -2477,7 +2512,8 @@ static int context_sendto(struct net_context *context,
 		goto skip_alloc;
 	}
 
-	pkt = context_alloc_pkt(context, family, len, PKT_WAIT_TIME);
+	/* For the zero-copy case only the headers need a buffer */
+	pkt = context_alloc_pkt(context, family, frags ? 0 : len, PKT_WAIT_TIME);
 	if (!pkt) {
 		NET_ERR("Failed to allocate net_pkt");
 		return -ENOBUFS;
@@ -2485,7 +2521,7 @@ static int context_sendto(struct net_context *context,
 
 	tmp_len = net_pkt_available_payload_buffer(
 				pkt, net_context_get_proto(context));
-	if (tmp_len < len) {
+	if (frags == NULL && tmp_len < len) {
 		if (net_context_get_type(context) == SOCK_DGRAM) {
 			NET_ERR("Available payload buffer (%zu) is not enough for requested DGRAM (%zu)",
 				tmp_len, len);
@@ -2536,8 +2572,8 @@ skip_alloc:
 		}
 	} else if (IS_ENABLED(CONFIG_NET_UDP) &&
 	    net_context_get_proto(context) == IPPROTO_UDP) {
-		ret = context_setup_udp_packet(context, family, pkt, buf, len, msghdr,
-					       dst_addr, addrlen);
+		ret = context_setup_udp_packet(context, family, pkt, buf, len,
+					       frags, msghdr, dst_addr, addrlen);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -2548,7 +2584,12 @@ skip_alloc:
 	} else if (IS_ENABLED(CONFIG_NET_TCP) &&
 		   net_context_get_proto(context) == IPPROTO_TCP) {
 
-		ret = net_tcp_queue(context, buf, len, msghdr);
+		if (frags) {
+			ret = net_tcp_queue_buf(context, frags);
+		} else {
+			ret = net_tcp_queue(context, buf, len, msghdr);
+		}
+
 		if (ret < 0) {
 			goto fail;
 		}
@@ -2634,6 +2675,10 @@ skip_alloc:
 	return len;
 fail:
 	if (pkt != NULL) {
+		if (frags) {
+			context_detach_frags(pkt, frags);
+		}
+
 		net_pkt_unref(pkt);
 	}
 
@@ -2675,7 +2720,7 @@ int net_context_send(struct net_context *context,
 		addrlen = 0;
 	}
 
-	ret = context_sendto(context, buf, len, &context->remote,
+	ret = context_sendto(context, buf, len, NULL, &context->remote,
 			     addrlen, cb, timeout, user_data, false);
 unlock:
 	k_mutex_unlock(&context->lock);
@@ -2694,7 +2739,7 @@ int net_context_sendmsg(struct net_context *context,
 
 	k_mutex_lock(&context->lock, K_FOREVER);
 
-	ret = context_sendto(context, msghdr, 0, NULL, 0,
+	ret = context_sendto(context, msghdr, 0, NULL, NULL, 0,
 			     cb, timeout, user_data, true);
 
 	k_mutex_unlock(&context->lock);
@@ -2715,7 +2760,7 @@ int net_context_sendto(struct net_context *context,
 
 	k_mutex_lock(&context->lock, K_FOREVER);
 
-	ret = context_sendto(context, buf, len, dst_addr, addrlen,
+	ret = context_sendto(context, buf, len, NULL, dst_addr, addrlen,
 			     cb, timeout, user_data, true);
 
 	k_mutex_unlock(&context->lock);
@@ -2723,6 +2768,47 @@ int net_context_sendto(struct net_context *context,
 	return ret;
 }
 
+int net_context_sendto_buf(struct net_context *context,
+			   struct net_buf *buf,
+			   const struct sockaddr *dst_addr,
+			   socklen_t addrlen,
+			   net_context_send_cb_t cb,
+			   k_timeout_t timeout,
+			   void *user_data)
+{
+	int ret;
+
+	if (buf == NULL) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&context->lock, K_FOREVER);
+
+	if (dst_addr == NULL) {
+		if (!(context->flags & NET_CONTEXT_REMOTE_ADDR_SET) ||
+		    !net_sin(&context->remote)->sin_port) {
+			ret = -EDESTADDRREQ;
+			goto unlock;
+		}
+
+		dst_addr = &context->remote;
+
+		if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		    net_context_get_family(context) == AF_INET6) {
+			addrlen = sizeof(struct sockaddr_in6);
+		} else {
+			addrlen = sizeof(struct sockaddr_in);
+		}
+	}
+
+	ret = context_sendto(context, NULL, 0, buf, dst_addr, addrlen,
+			     cb, timeout, user_data, false);
+unlock:
+	k_mutex_unlock(&context->lock);
+
+	return ret;
+}
+
 enum net_verdict net_context_packet_received(struct net_conn *conn,
 					     struct net_pkt *pkt,
 					     union net_ip_header *ip_hdr,
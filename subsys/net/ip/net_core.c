@@ -494,26 +494,18 @@ drop:
 	return;
 }
 
-/* Called by driver when a packet has been received */
-int net_recv_data(struct net_if *iface, struct net_pkt *pkt)
+static int net_recv_data_prepare(struct net_if *iface, struct net_pkt *pkt)
 {
-	int ret;
-
-	SYS_PORT_TRACING_FUNC_ENTER(net, recv_data, iface, pkt);
-
 	if (!pkt || !iface) {
-		ret = -EINVAL;
-		goto err;
+		return -EINVAL;
 	}
 
 	if (net_pkt_is_empty(pkt)) {
-		ret = -ENODATA;
-		goto err;
+		return -ENODATA;
 	}
 
 	if (!net_if_flag_is_set(iface, NET_IF_UP)) {
-		ret = -ENETDOWN;
-		goto err;
+		return -ENETDOWN;
 	}
 
 	net_pkt_set_overwrite(pkt, true);
@@ -528,6 +520,21 @@ int net_recv_data(struct net_if *iface, struct net_pkt *pkt)
 
 	net_pkt_set_iface(pkt, iface);
 
+	return 0;
+}
+
+/* Called by driver when a packet has been received */
+int net_recv_data(struct net_if *iface, struct net_pkt *pkt)
+{
+	int ret;
+
+	SYS_PORT_TRACING_FUNC_ENTER(net, recv_data, iface, pkt);
+
+	ret = net_recv_data_prepare(iface, pkt);
+	if (ret < 0) {
+		goto err;
+	}
+
 	if (!net_pkt_filter_recv_ok(pkt)) {
 		/* silently drop the packet */
 		net_pkt_unref(pkt);
@@ -535,14 +542,105 @@ int net_recv_data(struct net_if *iface, struct net_pkt *pkt)
 		net_queue_rx(iface, pkt);
 	}
 
-	ret = 0;
-
 err:
 	SYS_PORT_TRACING_FUNC_EXIT(net, recv_data, iface, pkt, ret);
 
 	return ret;
 }
 
+/* How many packets are queued at once by net_recv_data_burst(). The
+ * statistics are collected before queueing as the RX thread owns the
+ * packets after that.
+ */
+#define RX_BURST_CHUNK 16
+
+/* Queue a run of packets that map to the same RX traffic class */
+static void net_queue_rx_burst(struct net_if *iface, uint8_t tc,
+			       struct net_pkt **pkts, size_t count)
+{
+	size_t len[RX_BURST_CHUNK];
+	uint8_t prio[RX_BURST_CHUNK];
+	size_t chunk, queued, i;
+
+	for (; count > 0; pkts += chunk, count -= chunk) {
+		chunk = MIN(count, RX_BURST_CHUNK);
+
+		for (i = 0; i < chunk; i++) {
+			len[i] = net_pkt_get_len(pkts[i]);
+			prio[i] = net_pkt_priority(pkts[i]);
+		}
+
+		queued = net_tc_submit_burst_to_rx_queue(tc, pkts, chunk);
+
+		for (i = 0; i < chunk; i++) {
+			if (i >= queued) {
+				net_pkt_unref(pkts[i]);
+				net_stats_update_tc_recv_dropped(iface, tc);
+				continue;
+			}
+
+			net_stats_update_tc_recv_pkt(iface, tc);
+			net_stats_update_tc_recv_bytes(iface, tc, len[i]);
+			net_stats_update_tc_recv_priority(iface, tc, prio[i]);
+		}
+	}
+}
+
+/* Called by driver when several packets have been received */
+int net_recv_data_burst(struct net_if *iface, struct net_pkt **pkts,
+			size_t count)
+{
+	size_t taken, accepted = 0, start, i;
+	uint8_t tc;
+	int ret = 0;
+
+	for (taken = 0; taken < count; taken++) {
+		ret = net_recv_data_prepare(iface, pkts[taken]);
+		if (ret < 0) {
+			break;
+		}
+	}
+
+	if (taken == 0) {
+		return count == 0 ? 0 : ret;
+	}
+
+	/* Compact the accepted packets in front of the array, the caller
+	 * does not own them anymore.
+	 */
+	for (i = 0; i < taken; i++) {
+		if (!net_pkt_filter_recv_ok(pkts[i])) {
+			/* silently drop the packet */
+			net_pkt_unref(pkts[i]);
+			continue;
+		}
+
+		pkts[accepted++] = pkts[i];
+	}
+
+	if (NET_TC_RX_COUNT == 0) {
+		for (i = 0; i < accepted; i++) {
+			net_queue_rx(iface, pkts[i]);
+		}
+
+		return taken;
+	}
+
+	for (start = 0; start < accepted; start = i) {
+		tc = net_rx_priority2tc(net_pkt_priority(pkts[start]));
+
+		for (i = start + 1; i < accepted; i++) {
+			if (net_rx_priority2tc(net_pkt_priority(pkts[i])) != tc) {
+				break;
+			}
+		}
+
+		net_queue_rx_burst(iface, tc, &pkts[start], i - start);
+	}
+
+	return taken;
+}
+
 static inline void l3_init(void)
 {
 	net_pmtu_init();
@@ -562,6 +660,7 @@ static inline void l3_init(void)
 
 	net_tcp_init();
 
+	net_route_lpm_init();
 	net_route_init();
 
 	NET_DBG("Network L3 init done");
@@ -582,6 +681,15 @@ int net_recv_data(struct net_if *iface, struct net_pkt *pkt)
 
 	return -ENOTSUP;
 }
+int net_recv_data_burst(struct net_if *iface, struct net_pkt **pkts,
+			size_t count)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(pkts);
+	ARG_UNUSED(count);
+
+	return -ENOTSUP;
+}
 #endif /* CONFIG_NET_NATIVE */
 
 static void init_rx_queues(void)
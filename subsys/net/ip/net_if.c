@@ -213,11 +213,52 @@ static void update_txtime_stats_detail(struct net_pkt *pkt,
 	}
 }
 
+/* If there're any link callbacks, with such a callback receiving
+ * a destination address, copy that address out of packet, just in
+ * case packet is freed before callback is called.
+ */
+static void net_if_tx_save_ll_dst(struct net_pkt *pkt,
+				  struct net_linkaddr_storage *ll_dst_storage,
+				  struct net_linkaddr *ll_dst)
+{
+	ll_dst->addr = NULL;
+
+	if (!sys_slist_is_empty(&link_callbacks)) {
+		if (net_linkaddr_set(ll_dst_storage,
+				     net_pkt_lladdr_dst(pkt)->addr,
+				     net_pkt_lladdr_dst(pkt)->len) == 0) {
+			ll_dst->addr = ll_dst_storage->addr;
+			ll_dst->len = ll_dst_storage->len;
+			ll_dst->type = net_pkt_lladdr_dst(pkt)->type;
+		}
+	}
+}
+
+static void net_if_tx_done(struct net_if *iface, struct net_pkt *pkt,
+			   struct net_context *context,
+			   struct net_linkaddr *ll_dst, int status)
+{
+	if (status < 0) {
+		net_pkt_unref(pkt);
+	} else {
+		net_stats_update_bytes_sent(iface, status);
+	}
+
+	if (context) {
+		NET_DBG("Calling context send cb %p status %d",
+			context, status);
+
+		net_context_send_cb(context, status);
+	}
+
+	if (ll_dst->addr) {
+		net_if_call_link_cb(iface, ll_dst, status);
+	}
+}
+
 static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 {
-	struct net_linkaddr ll_dst = {
-		.addr = NULL
-	};
+	struct net_linkaddr ll_dst;
 	struct net_linkaddr_storage ll_dst_storage;
 	struct net_context *context;
 	uint32_t create_time;
@@ -234,19 +275,7 @@ static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 
 	debug_check_packet(pkt);
 
-	/* If there're any link callbacks, with such a callback receiving
-	 * a destination address, copy that address out of packet, just in
-	 * case packet is freed before callback is called.
-	 */
-	if (!sys_slist_is_empty(&link_callbacks)) {
-		if (net_linkaddr_set(&ll_dst_storage,
-				     net_pkt_lladdr_dst(pkt)->addr,
-				     net_pkt_lladdr_dst(pkt)->len) == 0) {
-			ll_dst.addr = ll_dst_storage.addr;
-			ll_dst.len = ll_dst_storage.len;
-			ll_dst.type = net_pkt_lladdr_dst(pkt)->type;
-		}
-	}
+	net_if_tx_save_ll_dst(pkt, &ll_dst_storage, &ll_dst);
 
 	context = net_pkt_context(pkt);
 
@@ -307,22 +336,7 @@ static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 		status = -ENETDOWN;
 	}
 
-	if (status < 0) {
-		net_pkt_unref(pkt);
-	} else {
-		net_stats_update_bytes_sent(iface, status);
-	}
-
-	if (context) {
-		NET_DBG("Calling context send cb %p status %d",
-			context, status);
-
-		net_context_send_cb(context, status);
-	}
-
-	if (ll_dst.addr) {
-		net_if_call_link_cb(iface, &ll_dst, status);
-	}
+	net_if_tx_done(iface, pkt, context, &ll_dst, status);
 
 	return true;
 }
@@ -342,6 +356,86 @@ void net_process_tx_packet(struct net_pkt *pkt)
 #endif
 }
 
+#if defined(CONFIG_NET_TC_TX_BURST) && CONFIG_NET_TC_TX_BURST > 1
+/* Send packets that all go to the same interface with one L2 call,
+ * the interface Tx lock is taken only once for the whole burst.
+ */
+static void net_if_tx_burst(struct net_if *iface, struct net_pkt **pkts,
+			    size_t count)
+{
+	struct net_linkaddr_storage ll_dst_storage[CONFIG_NET_TC_TX_BURST];
+	struct net_linkaddr ll_dst[CONFIG_NET_TC_TX_BURST];
+	struct net_context *context[CONFIG_NET_TC_TX_BURST];
+	int status[CONFIG_NET_TC_TX_BURST];
+	size_t i;
+
+	for (i = 0; i < count; i++) {
+		debug_check_packet(pkts[i]);
+
+		net_if_tx_save_ll_dst(pkts[i], &ll_dst_storage[i], &ll_dst[i]);
+		context[i] = net_pkt_context(pkts[i]);
+	}
+
+	if (net_if_flag_is_set(iface, NET_IF_LOWER_UP)) {
+		net_if_tx_lock(iface);
+		net_if_l2(iface)->send_burst(iface, pkts, count, status);
+		net_if_tx_unlock(iface);
+	} else {
+		NET_WARN("iface %p is down", iface);
+
+		for (i = 0; i < count; i++) {
+			status[i] = -ENETDOWN;
+		}
+	}
+
+	for (i = 0; i < count; i++) {
+		net_if_tx_done(iface, pkts[i], context[i], &ll_dst[i], status[i]);
+
+#if defined(CONFIG_NET_POWER_MANAGEMENT)
+		iface->tx_pending--;
+#endif
+	}
+}
+
+void net_process_tx_packets(struct net_pkt **pkts, size_t count)
+{
+	struct net_if *iface;
+	size_t start = 0, end;
+
+	while (start < count) {
+		iface = net_pkt_iface(pkts[start]);
+
+		/* Per packet Tx time statistics are collected only in the
+		 * single packet path.
+		 */
+		if (IS_ENABLED(CONFIG_NET_PKT_TXTIME_STATS) ||
+		    IS_ENABLED(CONFIG_TRACING_NET_CORE) ||
+		    net_if_l2(iface) == NULL ||
+		    net_if_l2(iface)->send_burst == NULL) {
+			net_process_tx_packet(pkts[start++]);
+			continue;
+		}
+
+		for (end = start + 1; end < count; end++) {
+			if (net_pkt_iface(pkts[end]) != iface) {
+				break;
+			}
+		}
+
+		net_if_tx_burst(iface, &pkts[start], end - start);
+
+		start = end;
+	}
+}
+#else
+void net_process_tx_packets(struct net_pkt **pkts, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		net_process_tx_packet(pkts[i]);
+	}
+}
+#endif /* CONFIG_NET_TC_TX_BURST > 1 */
+
 void net_if_queue_tx(struct net_if *iface, struct net_pkt *pkt)
 {
 	if (!net_pkt_filter_send_ok(pkt)) {
@@ -61,6 +61,7 @@ extern void net_if_stats_reset(struct net_if *iface);
 extern void net_if_stats_reset_all(void);
 extern void net_process_rx_packet(struct net_pkt *pkt);
 extern void net_process_tx_packet(struct net_pkt *pkt);
+extern void net_process_tx_packets(struct net_pkt **pkts, size_t count);
 
 extern struct net_if_addr *net_if_ipv4_addr_get_first_by_index(int ifindex);
 
@@ -186,6 +187,8 @@ static inline void net_tc_rx_init(void) { }
 #endif
 extern enum net_verdict net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt);
 extern enum net_verdict net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt);
+extern size_t net_tc_submit_burst_to_rx_queue(uint8_t tc, struct net_pkt **pkts,
+					      size_t count);
 extern enum net_verdict net_promisc_mode_input(struct net_pkt *pkt);
 
 char *net_sprint_addr(sa_family_t af, const void *addr);
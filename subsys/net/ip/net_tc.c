@@ -99,6 +99,44 @@ enum net_verdict net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt)
 #endif
 }
 
+size_t net_tc_submit_burst_to_rx_queue(uint8_t tc, struct net_pkt **pkts,
+				       size_t count)
+{
+#if NET_TC_RX_COUNT > 0
+	uint32_t tick = k_cycle_get_32();
+	sys_slist_t list;
+	size_t i;
+
+	sys_slist_init(&list);
+
+	for (i = 0; i < count; i++) {
+#if NET_TC_RX_COUNT > 1
+		if (k_sem_take(&rx_classes[tc].fifo_slot, K_NO_WAIT) != 0) {
+			break;
+		}
+#endif
+
+		net_pkt_set_rx_stats_tick(pkts[i], tick);
+
+		/* The fifo field is the first word of the packet, so the
+		 * packets can be chained like slist nodes.
+		 */
+		sys_slist_append(&list, (sys_snode_t *)&pkts[i]->fifo);
+	}
+
+	if (i > 0) {
+		(void)k_fifo_put_slist(&rx_classes[tc].fifo, &list);
+	}
+
+	return i;
+#else
+	ARG_UNUSED(tc);
+	ARG_UNUSED(pkts);
+	ARG_UNUSED(count);
+	return 0;
+#endif
+}
+
 int net_tx_priority2tc(enum net_priority prio)
 {
 #if NET_TC_TX_COUNT > 0
@@ -306,6 +344,10 @@ static void tc_tx_handler(void *p1, void *p2, void *p3)
 	ARG_UNUSED(p2);
 #endif
 	struct net_pkt *pkt;
+#if CONFIG_NET_TC_TX_BURST > 1
+	struct net_pkt *pkts[CONFIG_NET_TC_TX_BURST];
+	size_t count;
+#endif
 
 	while (1) {
 		pkt = k_fifo_get(fifo, K_FOREVER);
@@ -317,7 +359,29 @@ static void tc_tx_handler(void *p1, void *p2, void *p3)
 		k_sem_give(fifo_slot);
 #endif
 
+#if CONFIG_NET_TC_TX_BURST > 1
+		/* Take whatever else is already queued so that the driver
+		 * can be fed with one call.
+		 */
+		pkts[0] = pkt;
+		count = 1;
+
+		while (count < ARRAY_SIZE(pkts)) {
+			pkt = k_fifo_get(fifo, K_NO_WAIT);
+			if (pkt == NULL) {
+				break;
+			}
+
+#if NET_TC_TX_EFFECTIVE_COUNT > 1
+			k_sem_give(fifo_slot);
+#endif
+			pkts[count++] = pkt;
+		}
+
+		net_process_tx_packets(pkts, count);
+#else
 		net_process_tx_packet(pkt);
+#endif
 	}
 }
 #endif
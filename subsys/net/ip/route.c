@@ -270,7 +270,18 @@ static inline void update_route_access(struct net_route_entry *route)
 struct net_route_entry *net_route_lookup(struct net_if *iface,
 					 struct in6_addr *dst)
 {
-	struct net_route_entry *route, *found = NULL;
+	struct net_route_entry *found = NULL;
+#if defined(CONFIG_NET_ROUTE_LPM)
+	struct net_route_lpm_entry *entry;
+
+	net_ipv6_nbr_lock();
+
+	entry = net_route_lpm_lookup(AF_INET6, iface, dst->s6_addr);
+	if (entry) {
+		found = CONTAINER_OF(entry, struct net_route_entry, lpm);
+	}
+#else
+	struct net_route_entry *route;
 	uint8_t longest_match = 0U;
 	int i;
 
@@ -297,6 +308,7 @@ struct net_route_entry *net_route_lookup(struct net_if *iface,
 			longest_match = route->prefix_len;
 		}
 	}
+#endif /* CONFIG_NET_ROUTE_LPM */
 
 	if (found) {
 		net_route_info("Found", found, dst);
@@ -429,9 +441,22 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 		}
 	}
 
+#if defined(CONFIG_NET_ROUTE_LPM)
+	if (net_route_lpm_insert(AF_INET6, &net_route_data(nbr)->lpm,
+				 addr->s6_addr, prefix_len, iface) < 0) {
+		NET_ERR("No route trie node available!");
+		nbr_free(nbr);
+		route = NULL;
+		goto exit;
+	}
+#endif
+
 	tmp = get_nexthop_route();
 	if (!tmp) {
 		NET_ERR("No nexthop route available!");
+#if defined(CONFIG_NET_ROUTE_LPM)
+		(void)net_route_lpm_remove(&net_route_data(nbr)->lpm);
+#endif
 		route = NULL;
 		goto exit;
 	}
@@ -588,6 +613,10 @@ int net_route_del(struct net_route_entry *route)
 
 	sys_slist_find_and_remove(&routes, &route->node);
 
+#if defined(CONFIG_NET_ROUTE_LPM)
+	(void)net_route_lpm_remove(&route->lpm);
+#endif
+
 	nbr = net_route_get_nbr(route);
 	if (!nbr) {
 		net_ipv6_nbr_unlock();
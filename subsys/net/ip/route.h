@@ -20,6 +20,7 @@
 #include <zephyr/net/net_timeout.h>
 
 #include "nbr.h"
+#include "route_lpm.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -68,6 +69,11 @@ struct net_route_entry {
 
 	/** Is the route valid forever */
 	uint8_t is_infinite : 1;
+
+#if defined(CONFIG_NET_ROUTE_LPM)
+	/** Longest-prefix-match trie entry used for lookups. */
+	struct net_route_lpm_entry lpm;
+#endif
 };
 
 /* Route preference values, as defined in RFC 4191 */
@@ -328,6 +334,120 @@ int net_route_packet(struct net_pkt *pkt, struct in6_addr *nexthop);
  */
 int net_route_packet_if(struct net_pkt *pkt, struct net_if *iface);
 
+/**
+ * @brief IPv4 route entry.
+ */
+struct net_route_entry_ipv4 {
+	/** Longest-prefix-match trie entry used for lookups. */
+	struct net_route_lpm_entry lpm;
+
+	/** Network interface for the route. */
+	struct net_if *iface;
+
+	/** IPv4 address/prefix of the route. */
+	struct in_addr addr;
+
+	/** IPv4 address of the gateway, unspecified if on-link. */
+	struct in_addr gw;
+
+	/** IPv4 address/prefix length. */
+	uint8_t prefix_len;
+
+	/** Is this entry in use or not */
+	bool is_used;
+};
+
+typedef void (*net_route_ipv4_cb_t)(struct net_route_entry_ipv4 *entry,
+				    void *user_data);
+
+#if defined(CONFIG_NET_ROUTE_IPV4)
+/**
+ * @brief Add an IPv4 route to routing table.
+ *
+ * If a route with the same prefix already exists for the interface,
+ * its gateway is updated.
+ *
+ * @param iface Network interface that this route is tied to.
+ * @param addr IPv4 address/prefix.
+ * @param prefix_len Length of the IPv4 prefix.
+ * @param gw IPv4 address of the gateway, NULL if the prefix is on-link.
+ *
+ * @return Return created route entry, NULL if could not be created.
+ */
+struct net_route_entry_ipv4 *net_route_ipv4_add(struct net_if *iface,
+						struct in_addr *addr,
+						uint8_t prefix_len,
+						struct in_addr *gw);
+
+/**
+ * @brief Delete an IPv4 route from routing table.
+ *
+ * @param route Existing route entry.
+ *
+ * @return 0 if ok, <0 if error
+ */
+int net_route_ipv4_del(struct net_route_entry_ipv4 *route);
+
+/**
+ * @brief Lookup IPv4 route to a given destination.
+ *
+ * @param iface Network interface. If NULL, then check against all interfaces.
+ * @param dst Destination IPv4 address.
+ *
+ * The entry is not protected against a concurrent delete, use
+ * net_route_ipv4_get_gw() when only the gateway is needed.
+ *
+ * @return Return route entry with the longest prefix matching the
+ * destination, NULL if not found.
+ */
+struct net_route_entry_ipv4 *net_route_ipv4_lookup(struct net_if *iface,
+						   struct in_addr *dst);
+
+/**
+ * @brief Get the gateway of the IPv4 route to a given destination.
+ *
+ * @param iface Network interface. If NULL, then check against all interfaces.
+ * @param dst Destination IPv4 address.
+ * @param gw Gateway of the route with the longest prefix matching the
+ * destination, unspecified if the destination is on-link.
+ *
+ * @return True if a route was found, false otherwise.
+ */
+bool net_route_ipv4_get_gw(struct net_if *iface, struct in_addr *dst,
+			   struct in_addr *gw);
+
+/**
+ * @brief Go through all the IPv4 routing entries and call callback
+ * for each entry that is in use.
+ *
+ * @param cb User supplied callback function to call.
+ * @param user_data User specified data.
+ *
+ * @return Total number of IPv4 routing entries found.
+ */
+int net_route_ipv4_foreach(net_route_ipv4_cb_t cb, void *user_data);
+#else
+static inline struct net_route_entry_ipv4 *net_route_ipv4_lookup(struct net_if *iface,
+								 struct in_addr *dst)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(dst);
+
+	return NULL;
+}
+
+static inline bool net_route_ipv4_get_gw(struct net_if *iface,
+					 struct in_addr *dst,
+					 struct in_addr *gw)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(dst);
+	ARG_UNUSED(gw);
+
+	return false;
+}
+#endif /* CONFIG_NET_ROUTE_IPV4 */
+
 #if defined(CONFIG_NET_ROUTE) && defined(CONFIG_NET_NATIVE)
 void net_route_init(void);
 #else
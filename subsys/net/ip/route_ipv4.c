@@ -0,0 +1,187 @@
+/** @file
+ * @brief IPv4 route handling.
+ *
+ */
+
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_route_lpm, CONFIG_NET_ROUTE_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_ip.h>
+
+#include "net_private.h"
+#include "route.h"
+
+static struct net_route_entry_ipv4 ipv4_routes[CONFIG_NET_MAX_IPV4_ROUTES];
+
+static K_MUTEX_DEFINE(ipv4_routes_lock);
+
+static struct net_route_entry_ipv4 *route_find(struct net_if *iface,
+					       struct in_addr *addr,
+					       uint8_t prefix_len)
+{
+	ARRAY_FOR_EACH_PTR(ipv4_routes, route) {
+		if (!route->is_used) {
+			continue;
+		}
+
+		if (route->iface == iface && route->prefix_len == prefix_len &&
+		    net_ipv4_addr_cmp(&route->addr, addr)) {
+			return route;
+		}
+	}
+
+	return NULL;
+}
+
+struct net_route_entry_ipv4 *net_route_ipv4_add(struct net_if *iface,
+						struct in_addr *addr,
+						uint8_t prefix_len,
+						struct in_addr *gw)
+{
+	struct net_route_entry_ipv4 *route;
+
+	NET_ASSERT(iface);
+	NET_ASSERT(addr);
+
+	if (prefix_len > 32U) {
+		return NULL;
+	}
+
+	k_mutex_lock(&ipv4_routes_lock, K_FOREVER);
+
+	route = route_find(iface, addr, prefix_len);
+	if (route) {
+		NET_DBG("Updating route to %s/%d",
+			net_sprint_ipv4_addr(addr), prefix_len);
+		goto update;
+	}
+
+	ARRAY_FOR_EACH_PTR(ipv4_routes, entry) {
+		if (!entry->is_used) {
+			route = entry;
+			break;
+		}
+	}
+
+	if (!route) {
+		NET_DBG("No free IPv4 routes");
+		goto exit;
+	}
+
+	if (net_route_lpm_insert(AF_INET, &route->lpm, (const uint8_t *)addr,
+				 prefix_len, iface) < 0) {
+		NET_ERR("No route trie node available!");
+		route = NULL;
+		goto exit;
+	}
+
+	route->iface = iface;
+	route->prefix_len = prefix_len;
+	net_ipaddr_copy(&route->addr, addr);
+	route->is_used = true;
+
+update:
+	if (gw) {
+		net_ipaddr_copy(&route->gw, gw);
+	} else {
+		net_ipaddr_copy(&route->gw, net_ipv4_unspecified_address());
+	}
+
+	NET_DBG("Added route to %s/%d via %s (iface %p)",
+		net_sprint_ipv4_addr(addr), prefix_len,
+		net_sprint_ipv4_addr(&route->gw), iface);
+
+exit:
+	k_mutex_unlock(&ipv4_routes_lock);
+	return route;
+}
+
+int net_route_ipv4_del(struct net_route_entry_ipv4 *route)
+{
+	int ret = 0;
+
+	if (!route) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&ipv4_routes_lock, K_FOREVER);
+
+	if (!route->is_used) {
+		ret = -ENOENT;
+		goto exit;
+	}
+
+	NET_DBG("Deleted route to %s/%d",
+		net_sprint_ipv4_addr(&route->addr), route->prefix_len);
+
+	(void)net_route_lpm_remove(&route->lpm);
+	route->is_used = false;
+
+exit:
+	k_mutex_unlock(&ipv4_routes_lock);
+	return ret;
+}
+
+struct net_route_entry_ipv4 *net_route_ipv4_lookup(struct net_if *iface,
+						   struct in_addr *dst)
+{
+	struct net_route_lpm_entry *entry;
+
+	entry = net_route_lpm_lookup(AF_INET, iface, (const uint8_t *)dst);
+	if (!entry) {
+		return NULL;
+	}
+
+	return CONTAINER_OF(entry, struct net_route_entry_ipv4, lpm);
+}
+
+bool net_route_ipv4_get_gw(struct net_if *iface, struct in_addr *dst,
+			   struct in_addr *gw)
+{
+	struct net_route_entry_ipv4 *route;
+
+	NET_ASSERT(gw);
+
+	/* Routes are only deleted or updated with the table locked, so the
+	 * gateway is copied while the entry still belongs to the route.
+	 */
+	k_mutex_lock(&ipv4_routes_lock, K_FOREVER);
+
+	route = net_route_ipv4_lookup(iface, dst);
+	if (route) {
+		net_ipaddr_copy(gw, &route->gw);
+	}
+
+	k_mutex_unlock(&ipv4_routes_lock);
+
+	return route != NULL;
+}
+
+int net_route_ipv4_foreach(net_route_ipv4_cb_t cb, void *user_data)
+{
+	int ret = 0;
+
+	k_mutex_lock(&ipv4_routes_lock, K_FOREVER);
+
+	ARRAY_FOR_EACH_PTR(ipv4_routes, route) {
+		if (!route->is_used) {
+			continue;
+		}
+
+		cb(route, user_data);
+
+		ret++;
+	}
+
+	k_mutex_unlock(&ipv4_routes_lock);
+	return ret;
+}
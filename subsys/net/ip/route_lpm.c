@@ -0,0 +1,433 @@
+/** @file
+ * @brief Longest-prefix-match trie for route lookups.
+ *
+ * The routes are stored in a path-compressed binary (Patricia) trie,
+ * one per address family. Each trie node covers a prefix, nodes that
+ * have no route attached only exist in order to branch, and there are
+ * never nodes with a single child and no routes. This keeps the number
+ * of nodes below twice the number of distinct prefixes and the lookup
+ * cost proportional to the address length.
+ */
+
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_route_lpm, CONFIG_NET_ROUTE_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/slist.h>
+#include <zephyr/net/net_ip.h>
+
+#include "route_lpm.h"
+
+#define LPM_KEY_LEN sizeof(struct in6_addr)
+
+struct net_route_lpm_node {
+	/** Children, indexed by the first bit after the prefix. */
+	struct net_route_lpm_node *child[2];
+
+	/** Parent node, NULL for the root of the trie. */
+	struct net_route_lpm_node *parent;
+
+	/** Route entries having exactly this prefix. */
+	sys_slist_t entries;
+
+	/** Prefix, the bits after prefix_len are always zero. */
+	uint8_t key[LPM_KEY_LEN];
+
+	/** Prefix length in bits. */
+	uint8_t prefix_len;
+
+	/** Address family of the trie this node belongs to. */
+	uint8_t family;
+};
+
+static struct net_route_lpm_node lpm_nodes[CONFIG_NET_ROUTE_LPM_MAX_NODES];
+
+/* Unused nodes are chained through child[0]. */
+static struct net_route_lpm_node *lpm_free_list;
+static int lpm_free_count;
+
+static struct net_route_lpm_node *lpm_root_ipv4;
+static struct net_route_lpm_node *lpm_root_ipv6;
+
+static struct k_spinlock lpm_lock;
+
+static struct net_route_lpm_node **get_root(sa_family_t family)
+{
+	if (IS_ENABLED(CONFIG_NET_IPV4) && family == AF_INET) {
+		return &lpm_root_ipv4;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && family == AF_INET6) {
+		return &lpm_root_ipv6;
+	}
+
+	return NULL;
+}
+
+static inline uint8_t max_prefix_len(sa_family_t family)
+{
+	return family == AF_INET ? 32U : 128U;
+}
+
+static inline int get_bit(const uint8_t *key, uint8_t pos)
+{
+	return (key[pos / 8U] >> (7U - (pos % 8U))) & 1U;
+}
+
+/* Check that bits [from, to) of key and addr are the same. The caller
+ * has already verified that the bits before "from" match.
+ */
+static bool bits_match(const uint8_t *key, const uint8_t *addr,
+		       uint8_t from, uint8_t to)
+{
+	uint8_t byte = from / 8U;
+	uint8_t last = to / 8U;
+	uint8_t remain = to % 8U;
+
+	for (; byte < last; byte++) {
+		if (key[byte] != addr[byte]) {
+			return false;
+		}
+	}
+
+	if (remain == 0U) {
+		return true;
+	}
+
+	return ((key[last] ^ addr[last]) & (uint8_t)(0xff << (8U - remain))) == 0U;
+}
+
+static uint8_t common_prefix_len(const uint8_t *a, const uint8_t *b,
+				 uint8_t max_len)
+{
+	uint8_t len = 0U;
+	uint8_t diff;
+
+	while (len < max_len) {
+		diff = a[len / 8U] ^ b[len / 8U];
+		if (diff == 0U) {
+			len += 8U;
+			continue;
+		}
+
+		while ((diff & 0x80) == 0U) {
+			diff <<= 1;
+			len++;
+		}
+
+		break;
+	}
+
+	return MIN(len, max_len);
+}
+
+static void set_key(struct net_route_lpm_node *node, const uint8_t *prefix,
+		    uint8_t prefix_len)
+{
+	uint8_t bytes = prefix_len / 8U;
+	uint8_t remain = prefix_len % 8U;
+
+	memset(node->key, 0, sizeof(node->key));
+	memcpy(node->key, prefix, bytes);
+
+	if (remain) {
+		node->key[bytes] = prefix[bytes] & (uint8_t)(0xff << (8U - remain));
+	}
+
+	node->prefix_len = prefix_len;
+}
+
+static struct net_route_lpm_node *node_alloc(sa_family_t family,
+					     const uint8_t *prefix,
+					     uint8_t prefix_len)
+{
+	struct net_route_lpm_node *node = lpm_free_list;
+
+	if (node == NULL) {
+		return NULL;
+	}
+
+	lpm_free_list = node->child[0];
+	lpm_free_count--;
+
+	node->child[0] = NULL;
+	node->child[1] = NULL;
+	node->parent = NULL;
+	node->family = family;
+	sys_slist_init(&node->entries);
+	set_key(node, prefix, prefix_len);
+
+	return node;
+}
+
+static void node_free(struct net_route_lpm_node *node)
+{
+	node->child[0] = lpm_free_list;
+	node->child[1] = NULL;
+	node->parent = NULL;
+	lpm_free_list = node;
+	lpm_free_count++;
+}
+
+static struct net_route_lpm_node **parent_link(struct net_route_lpm_node *node)
+{
+	struct net_route_lpm_node *parent = node->parent;
+
+	if (parent == NULL) {
+		return get_root(node->family);
+	}
+
+	return &parent->child[parent->child[0] == node ? 0 : 1];
+}
+
+static void set_child(struct net_route_lpm_node *parent,
+		      struct net_route_lpm_node *child)
+{
+	parent->child[get_bit(child->key, parent->prefix_len)] = child;
+	child->parent = parent;
+}
+
+/* Find or create the node for a given prefix. At most two nodes are
+ * allocated: the node itself and a branching node if the new prefix
+ * diverges from an existing one.
+ */
+static struct net_route_lpm_node *node_get(sa_family_t family,
+					   const uint8_t *prefix,
+					   uint8_t prefix_len)
+{
+	struct net_route_lpm_node **link = get_root(family);
+	struct net_route_lpm_node *parent = NULL;
+	struct net_route_lpm_node *node, *new_node, *branch;
+	uint8_t common;
+
+	while ((node = *link) != NULL) {
+		common = common_prefix_len(node->key, prefix,
+					   MIN(node->prefix_len, prefix_len));
+
+		if (common < node->prefix_len) {
+			break;
+		}
+
+		if (node->prefix_len == prefix_len) {
+			return node;
+		}
+
+		parent = node;
+		link = &node->child[get_bit(prefix, node->prefix_len)];
+	}
+
+	if (node == NULL) {
+		new_node = node_alloc(family, prefix, prefix_len);
+		if (new_node == NULL) {
+			return NULL;
+		}
+
+		new_node->parent = parent;
+		*link = new_node;
+
+		return new_node;
+	}
+
+	if (common == prefix_len) {
+		/* The new prefix is shorter and covers the existing node */
+		new_node = node_alloc(family, prefix, prefix_len);
+		if (new_node == NULL) {
+			return NULL;
+		}
+
+		new_node->parent = parent;
+		*link = new_node;
+		set_child(new_node, node);
+
+		return new_node;
+	}
+
+	/* The prefixes diverge, so a branching node is needed */
+	if (lpm_free_count < 2) {
+		return NULL;
+	}
+
+	branch = node_alloc(family, prefix, common);
+	new_node = node_alloc(family, prefix, prefix_len);
+
+	branch->parent = parent;
+	*link = branch;
+	set_child(branch, node);
+	set_child(branch, new_node);
+
+	return new_node;
+}
+
+/* Remove nodes that do not carry any route and do not branch. */
+static void node_prune(struct net_route_lpm_node *node)
+{
+	struct net_route_lpm_node *parent, *child;
+
+	while (node != NULL && sys_slist_is_empty(&node->entries)) {
+		if (node->child[0] != NULL && node->child[1] != NULL) {
+			return;
+		}
+
+		parent = node->parent;
+		child = node->child[0] != NULL ? node->child[0] : node->child[1];
+
+		*parent_link(node) = child;
+		if (child != NULL) {
+			child->parent = parent;
+		}
+
+		node_free(node);
+
+		/* A parent without routes that lost one of its
+		 * children might not be needed anymore either.
+		 */
+		node = parent;
+	}
+}
+
+int net_route_lpm_insert(sa_family_t family,
+			 struct net_route_lpm_entry *entry,
+			 const uint8_t *prefix, uint8_t prefix_len,
+			 struct net_if *iface)
+{
+	struct net_route_lpm_node *node;
+	k_spinlock_key_t key;
+
+	if (get_root(family) == NULL || prefix_len > max_prefix_len(family)) {
+		return -EINVAL;
+	}
+
+	if (entry->trie_node != NULL) {
+		return -EALREADY;
+	}
+
+	key = k_spin_lock(&lpm_lock);
+
+	node = node_get(family, prefix, prefix_len);
+	if (node == NULL) {
+		k_spin_unlock(&lpm_lock, key);
+		NET_DBG("No free trie nodes for prefix of len %d", prefix_len);
+		return -ENOMEM;
+	}
+
+	entry->trie_node = node;
+	entry->iface = iface;
+	sys_slist_append(&node->entries, &entry->node);
+
+	k_spin_unlock(&lpm_lock, key);
+
+	return 0;
+}
+
+int net_route_lpm_remove(struct net_route_lpm_entry *entry)
+{
+	struct net_route_lpm_node *node;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&lpm_lock);
+
+	node = entry->trie_node;
+	if (node == NULL ||
+	    !sys_slist_find_and_remove(&node->entries, &entry->node)) {
+		k_spin_unlock(&lpm_lock, key);
+		return -ENOENT;
+	}
+
+	entry->trie_node = NULL;
+	node_prune(node);
+
+	k_spin_unlock(&lpm_lock, key);
+
+	return 0;
+}
+
+static struct net_route_lpm_entry *node_entry_get(struct net_route_lpm_node *node,
+						  struct net_if *iface)
+{
+	struct net_route_lpm_entry *entry;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&node->entries, entry, node) {
+		if (iface == NULL || entry->iface == iface) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+struct net_route_lpm_entry *net_route_lpm_lookup(sa_family_t family,
+						 struct net_if *iface,
+						 const uint8_t *addr)
+{
+	struct net_route_lpm_entry *found = NULL, *entry;
+	struct net_route_lpm_node **root = get_root(family);
+	struct net_route_lpm_node *node;
+	uint8_t checked = 0U;
+	k_spinlock_key_t key;
+
+	if (root == NULL) {
+		return NULL;
+	}
+
+	key = k_spin_lock(&lpm_lock);
+
+	node = *root;
+
+	while (node != NULL) {
+		if (!bits_match(node->key, addr, checked, node->prefix_len)) {
+			break;
+		}
+
+		checked = node->prefix_len;
+
+		entry = node_entry_get(node, iface);
+		if (entry != NULL) {
+			found = entry;
+		}
+
+		if (checked >= max_prefix_len(family)) {
+			break;
+		}
+
+		node = node->child[get_bit(addr, checked)];
+	}
+
+	k_spin_unlock(&lpm_lock, key);
+
+	return found;
+}
+
+uint8_t net_route_lpm_prefix_len(const struct net_route_lpm_entry *entry)
+{
+	if (entry->trie_node == NULL) {
+		return 0U;
+	}
+
+	return entry->trie_node->prefix_len;
+}
+
+int net_route_lpm_free_nodes(void)
+{
+	return lpm_free_count;
+}
+
+void net_route_lpm_init(void)
+{
+	lpm_free_list = NULL;
+	lpm_free_count = 0;
+	lpm_root_ipv4 = NULL;
+	lpm_root_ipv6 = NULL;
+
+	ARRAY_FOR_EACH_PTR(lpm_nodes, node) {
+		node_free(node);
+	}
+
+	NET_DBG("Allocated %d trie nodes (%zu bytes)",
+		CONFIG_NET_ROUTE_LPM_MAX_NODES, sizeof(lpm_nodes));
+}
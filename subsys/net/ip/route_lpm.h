@@ -0,0 +1,115 @@
+/** @file
+ * @brief Longest-prefix-match trie used by the routing tables
+ *
+ * This is not to be included by the application.
+ */
+
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __ROUTE_LPM_H
+#define __ROUTE_LPM_H
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/slist.h>
+
+#include <zephyr/net/net_ip.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct net_if;
+struct net_route_lpm_node;
+
+/**
+ * @brief Route entry stored in the longest-prefix-match trie.
+ *
+ * This is meant to be embedded in the routing table specific entry
+ * (IPv4 or IPv6 route), the owner uses CONTAINER_OF() to get back to
+ * its own data from a lookup result. Several entries can share the
+ * same prefix if they are bound to different network interfaces.
+ */
+struct net_route_lpm_entry {
+	/** Entries sharing the same trie node. */
+	sys_snode_t node;
+
+	/** Trie node this entry is attached to, NULL if not in the trie. */
+	struct net_route_lpm_node *trie_node;
+
+	/** Network interface the route is tied to. */
+	struct net_if *iface;
+};
+
+/**
+ * @brief Insert a route entry to the trie.
+ *
+ * @param family Address family, AF_INET or AF_INET6.
+ * @param entry Route entry to insert. Must not be in the trie already.
+ * @param prefix Address prefix in network byte order.
+ * @param prefix_len Length of the prefix in bits.
+ * @param iface Network interface the route is tied to.
+ *
+ * @return 0 if ok, <0 if error
+ */
+int net_route_lpm_insert(sa_family_t family,
+			 struct net_route_lpm_entry *entry,
+			 const uint8_t *prefix, uint8_t prefix_len,
+			 struct net_if *iface);
+
+/**
+ * @brief Remove a route entry from the trie.
+ *
+ * @param entry Route entry to remove.
+ *
+ * @return 0 if ok, -ENOENT if the entry was not in the trie.
+ */
+int net_route_lpm_remove(struct net_route_lpm_entry *entry);
+
+/**
+ * @brief Find the route entry with the longest prefix matching
+ * a given address.
+ *
+ * The lookup walks the trie once, so the cost is bounded by the
+ * address length and not by the number of routes.
+ *
+ * @param family Address family, AF_INET or AF_INET6.
+ * @param iface Network interface. If NULL, then check against all interfaces.
+ * @param addr Destination address in network byte order.
+ *
+ * @return Matching route entry, NULL if not found.
+ */
+struct net_route_lpm_entry *net_route_lpm_lookup(sa_family_t family,
+						 struct net_if *iface,
+						 const uint8_t *addr);
+
+/**
+ * @brief Get the prefix length of a route entry stored in the trie.
+ *
+ * @param entry Route entry.
+ *
+ * @return Prefix length in bits, or 0 if the entry is not in the trie.
+ */
+uint8_t net_route_lpm_prefix_len(const struct net_route_lpm_entry *entry);
+
+/**
+ * @brief Return the number of free trie nodes.
+ *
+ * @return Number of trie nodes that can still be allocated.
+ */
+int net_route_lpm_free_nodes(void);
+
+#if defined(CONFIG_NET_ROUTE_LPM)
+void net_route_lpm_init(void);
+#else
+#define net_route_lpm_init(...)
+#endif /* CONFIG_NET_ROUTE_LPM */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ROUTE_LPM_H */
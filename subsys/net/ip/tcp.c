@@ -19,6 +19,7 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 #include <zephyr/net/net_pkt.h>
 #include <zephyr/net/net_context.h>
 #include <zephyr/net/udp.h>
+#include <zephyr/sys/fdtable.h>
 #include "ipv4.h"
 #include "ipv6.h"
 #include "connection.h"
@@ -853,6 +854,24 @@ static int tcp_conn_unref(struct tcp *conn)
 	return ref_count;
 }
 
+/* Give the tx semaphore, and let the epoll instances watching the socket
+ * know when sending becomes possible again.
+ */
+static void tcp_tx_sem_give(struct tcp *conn)
+{
+#if defined(CONFIG_ZVFS_EPOLL)
+	bool was_full = k_sem_count_get(&conn->tx_sem) == 0;
+
+	k_sem_give(&conn->tx_sem);
+
+	if (was_full && conn->context != NULL) {
+		zvfs_poll_notify(&conn->context->poll_notifiers, ZVFS_POLLOUT);
+	}
+#else
+	k_sem_give(&conn->tx_sem);
+#endif
+}
+
 #if CONFIG_NET_TCP_LOG_LEVEL >= LOG_LEVEL_DBG
 #define tcp_conn_close(conn, status)				\
 	tcp_conn_close_debug(conn, status, __func__, __LINE__)
@@ -886,7 +905,7 @@ static int tcp_conn_close(struct tcp *conn, int status)
 				       status, conn->recv_user_data);
 	}
 
-	k_sem_give(&conn->tx_sem);
+	tcp_tx_sem_give(conn);
 
 	return tcp_conn_unref(conn);
 }
@@ -2915,7 +2934,7 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		if (tcp_window_full(conn)) {
 			(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
 		} else {
-			k_sem_give(&conn->tx_sem);
+			tcp_tx_sem_give(conn);
 		}
 	}
 
@@ -3209,7 +3228,7 @@ next_state:
 			}
 
 			if (!tcp_window_full(conn)) {
-				k_sem_give(&conn->tx_sem);
+				tcp_tx_sem_give(conn);
 			}
 
 			conn_seq(conn, + len_acked);
@@ -3312,7 +3331,7 @@ next_state:
 		if (tcp_window_full(conn)) {
 			(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
 		} else {
-			k_sem_give(&conn->tx_sem);
+			tcp_tx_sem_give(conn);
 		}
 
 		break;
@@ -3801,6 +3820,85 @@ out:
 	return ret;
 }
 
+/* Give the caller's buffers back, they are the last ones in the queue */
+static void tcp_send_data_detach(struct tcp *conn, struct net_buf *buf,
+				 size_t len)
+{
+	struct net_buf *frag;
+
+	conn->send_data_total -= len;
+
+	if (conn->send_data->buffer == buf) {
+		conn->send_data->buffer = NULL;
+		return;
+	}
+
+	for (frag = conn->send_data->buffer; frag; frag = frag->frags) {
+		if (frag->frags == buf) {
+			frag->frags = NULL;
+			break;
+		}
+	}
+}
+
+int net_tcp_queue_buf(struct net_context *context, struct net_buf *buf)
+{
+	struct tcp *conn = context->tcp;
+	size_t len = net_buf_frags_len(buf);
+	int ret;
+
+	if (!conn || conn->state != TCP_ESTABLISHED) {
+		return -ENOTCONN;
+	}
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
+	if (tcp_window_full(conn)) {
+		ret = -EAGAIN;
+		goto out;
+	}
+
+	/* The chain cannot be split without copying, so queue it only if it
+	 * fits in the TX window as a whole, like net_tcp_queue() never
+	 * queues more than the window permits. A chain larger than the
+	 * maximum window can never be queued.
+	 */
+	if (len > conn->send_win_max) {
+		ret = -EMSGSIZE;
+		goto out;
+	}
+
+	if (len > conn->send_win - conn->send_data_total) {
+		/* Make the sender wait for the peer to acknowledge data */
+		(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
+		ret = -EAGAIN;
+		goto out;
+	}
+
+	net_pkt_append_buffer(conn->send_data, buf);
+	conn->send_data_total += len;
+
+	ret = tcp_send_queued_data(conn);
+	if (ret < 0 && ret != -ENOBUFS) {
+		/* The data was copied to the segments sent so far, so the
+		 * buffers can be handed back as on the other error paths.
+		 */
+		tcp_send_data_detach(conn, buf, len);
+		tcp_conn_close(conn, ret);
+		goto out;
+	}
+
+	if (tcp_window_full(conn)) {
+		(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
+	}
+
+	ret = len;
+out:
+	k_mutex_unlock(&conn->lock);
+
+	return ret;
+}
+
 /* net context is about to send out queued data - inform caller only */
 int net_tcp_send_data(struct net_context *context, net_context_send_cb_t cb,
 		      void *user_data)
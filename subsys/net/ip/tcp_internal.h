@@ -312,6 +312,34 @@ static inline int net_tcp_queue(struct net_context *context, const void *data,
 }
 #endif
 
+/**
+ * @brief Enqueue a chain of network buffers for transmission
+ *
+ * The buffers are linked to the send queue as they are, without copying
+ * the data. On success the connection owns the buffers and releases them
+ * once all the data in them has been acknowledged by the peer. The chain
+ * is only queued as a whole, -EAGAIN is returned while it does not fit in
+ * the free TX window.
+ *
+ * @param context	Network context
+ * @param buf		Buffer chain to send
+ *
+ * @return Number of bytes queued if ok, < 0 if error. On error the caller
+ *         still owns the buffers.
+ */
+#if defined(CONFIG_NET_NATIVE_TCP)
+int net_tcp_queue_buf(struct net_context *context, struct net_buf *buf);
+#else
+static inline int net_tcp_queue_buf(struct net_context *context,
+				    struct net_buf *buf)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(buf);
+
+	return -EPROTONOSUPPORT;
+}
+#endif
+
 /**
  * @brief Update TCP receive window
  *
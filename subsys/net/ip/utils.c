@@ -559,12 +559,24 @@ static uint16_t offset_based_swap8(const uint8_t *data)
 	}
 }
 
+/* Add a 64-bit word to a one's complement sum, with end-around carry */
+static inline uint64_t chksum_add64(uint64_t sum, uint64_t val)
+{
+	sum += val;
+
+	return sum + (sum < val);
+}
+
 /* Word based checksum calculation based on:
  * https://blogs.igalia.com/dpino/2018/06/14/fast-checksum-computation/
  * It’s not necessary to add octets as 16-bit words. Due to the associative property of addition,
  * it is possible to do parallel addition using larger word sizes such as 32-bit or 64-bit words.
  * In those cases the variable that stores the accumulative sum has to be bigger too.
  * Once the sum is computed a final step folds the sum to a 16-bit word (adding carry if any).
+ *
+ * On 64-bit targets the bulk of the data is loaded as 64-bit words, and the carries are added
+ * back explicitly. The independent accumulators let the compiler keep several additions in
+ * flight, or vectorize the loop where the architecture allows it.
  */
 uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 {
@@ -594,6 +606,42 @@ uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 		sum = sum + *((uint16_t *)data);
 		data += sizeof(uint16_t);
 	}
+
+#if defined(CONFIG_64BIT)
+	if (pending >= sizeof(uint64_t) * 4) {
+		uint64_t sum_a = 0;
+		uint64_t sum_b = 0;
+		uint64_t *q;
+
+		if ((((uintptr_t)data & 0x04) != 0)) {
+			pending -= sizeof(uint32_t);
+			sum = sum + *((uint32_t *)data);
+			data += sizeof(uint32_t);
+		}
+		q = (uint64_t *)data;
+
+		while (pending >= sizeof(uint64_t) * 4) {
+			pending -= sizeof(uint64_t) * 4;
+			sum = chksum_add64(sum, q[0]);
+			sum_a = chksum_add64(sum_a, q[1]);
+			sum_b = chksum_add64(sum_b, q[2]);
+			sum = chksum_add64(sum, q[3]);
+			q += 4;
+		}
+		while (pending >= sizeof(uint64_t)) {
+			pending -= sizeof(uint64_t);
+			sum = chksum_add64(sum, *q++);
+		}
+
+		sum = chksum_add64(sum, sum_a);
+		sum = chksum_add64(sum, sum_b);
+		data = (uint8_t *)q;
+
+		/* Leave room for the remaining 32-bit additions */
+		sum = (sum & 0xffffffff) + (sum >> 32);
+	}
+#endif /* CONFIG_64BIT */
+
 	p = (uint32_t *)data;
 
 	/* Do loop unrolling for the very large data sets */
@@ -636,6 +684,24 @@ uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 	}
 }
 
+uint16_t net_chksum_update(uint16_t chksum, const void *old_data,
+			   const void *new_data, size_t len)
+{
+	uint32_t sum;
+
+	/* RFC 1624, eqn. 3: HC' = ~(~HC + ~m + m'). calc_chksum() sums
+	 * big endian words, while the checksum is in network byte order.
+	 */
+	sum = (uint16_t)~ntohs(chksum);
+	sum += (uint16_t)~calc_chksum(0U, old_data, len);
+	sum += calc_chksum(0U, new_data, len);
+
+	sum = (sum & 0xffff) + (sum >> 16);
+	sum = (sum & 0xffff) + (sum >> 16);
+
+	return htons((uint16_t)~sum);
+}
+
 static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
 {
 	struct net_pkt_cursor *cur = &pkt->cursor;
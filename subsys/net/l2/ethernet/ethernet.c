@@ -31,6 +31,12 @@ LOG_MODULE_REGISTER(net_ethernet, CONFIG_NET_L2_ETHERNET_LOG_LEVEL);
 
 #define NET_BUF_TIMEOUT K_MSEC(100)
 
+#if defined(CONFIG_NET_TC_TX_BURST)
+#define ETHERNET_TX_BURST_MAX CONFIG_NET_TC_TX_BURST
+#else
+#define ETHERNET_TX_BURST_MAX 1
+#endif
+
 static const struct net_eth_addr multicast_eth_addr __unused = {
 	{ 0x33, 0x33, 0x00, 0x00, 0x00, 0x00 } };
 
@@ -671,23 +677,37 @@ static void ethernet_update_tx_stats(struct net_if *iface, struct net_pkt *pkt)
 #define ethernet_update_tx_stats(...)
 #endif /* CONFIG_NET_STATISTICS_ETHERNET */
 
-static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
+static int ethernet_send_error(struct net_if *iface, struct net_pkt *orig_pkt,
+			       struct net_pkt *pkt, int ret)
+{
+	if (IS_ENABLED(CONFIG_NET_ARP) &&
+	    net_pkt_ll_proto_type(pkt) == NET_ETH_PTYPE_ARP) {
+		/* Original packet was added to ARP's pending Q, so, to avoid it
+		 * being freed, take a reference, the reference is dropped when we
+		 * clear the pending Q in ARP and then it will be freed by net_if.
+		 */
+		net_pkt_ref(orig_pkt);
+		if (net_arp_clear_pending(
+			    iface, (struct in_addr *)NET_IPV4_HDR(pkt)->dst)) {
+			NET_DBG("Could not find pending ARP entry");
+		}
+		/* Free the ARP request */
+		net_pkt_unref(pkt);
+	}
+
+	return ret;
+}
+
+/* Resolve the link layer destination and add the Ethernet header. The
+ * packet to pass to the driver is returned in out_pkt. It is an ARP request
+ * instead of the original packet if the destination is not known yet.
+ */
+static int ethernet_send_prepare(struct net_if *iface, struct net_pkt *pkt,
+				 struct net_pkt **out_pkt)
 {
-	const struct ethernet_api *api = net_if_get_device(iface)->api;
 	struct ethernet_context *ctx = net_if_l2_data(iface);
 	uint16_t ptype = htons(net_pkt_ll_proto_type(pkt));
 	struct net_pkt *orig_pkt = pkt;
-	int ret;
-
-	if (!api) {
-		ret = -ENOENT;
-		goto error;
-	}
-
-	if (!api->send) {
-		ret = -ENOTSUP;
-		goto error;
-	}
 
 	/* We are trying to send a packet that is from bridge interface,
 	 * so all the bits and pieces should be there (like Ethernet header etc)
@@ -704,8 +724,7 @@ static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
 
 			tmp = ethernet_ll_prepare_on_ipv4(iface, pkt);
 			if (tmp == NULL) {
-				ret = -ENOMEM;
-				goto error;
+				return -ENOMEM;
 			} else if (IS_ENABLED(CONFIG_NET_ARP) && tmp != pkt) {
 				/* Original pkt got queued and is replaced
 				 * by an ARP request packet.
@@ -727,8 +746,7 @@ static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
 	if (ptype == 0) {
 		/* Caller of this function has not set the ptype */
 		NET_ERR("No protocol set for pkt %p", pkt);
-		ret = -ENOTSUP;
-		goto error;
+		return -ENOTSUP;
 	}
 
 	/* If the ll dst addr has not been set before, let's assume
@@ -745,8 +763,7 @@ static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
 	 * is used to determine if the VLAN header is added to Ethernet frame.
 	 */
 	if (!ethernet_fill_header(ctx, iface, pkt, ptype)) {
-		ret = -ENOMEM;
-		goto arp_error;
+		return ethernet_send_error(iface, orig_pkt, pkt, -ENOMEM);
 	}
 
 	net_pkt_cursor_init(pkt);
@@ -759,8 +776,7 @@ send:
 
 		out_pkt = net_pkt_clone(pkt, K_NO_WAIT);
 		if (out_pkt == NULL) {
-			ret = -ENOMEM;
-			goto error;
+			return -ENOMEM;
 		}
 
 		net_pkt_set_l2_bridged(out_pkt, true);
@@ -774,10 +790,18 @@ send:
 		(void)net_if_queue_tx(bridge, out_pkt);
 	}
 
-	ret = net_l2_send(api->send, net_if_get_device(iface), iface, pkt);
+	*out_pkt = pkt;
+
+	return 0;
+}
+
+/* Account the driver send result of a prepared packet */
+static int ethernet_send_done(struct net_if *iface, struct net_pkt *orig_pkt,
+			      struct net_pkt *pkt, int ret)
+{
 	if (ret != 0) {
 		eth_stats_update_errors_tx(iface);
-		goto arp_error;
+		return ethernet_send_error(iface, orig_pkt, pkt, ret);
 	}
 
 	ethernet_update_tx_stats(iface, pkt);
@@ -785,25 +809,86 @@ send:
 	ret = net_pkt_get_len(pkt);
 
 	net_pkt_unref(pkt);
-error:
+
 	return ret;
+}
 
-arp_error:
-	if (IS_ENABLED(CONFIG_NET_ARP) && ptype == htons(NET_ETH_PTYPE_ARP)) {
-		/* Original packet was added to ARP's pending Q, so, to avoid it
-		 * being freed, take a reference, the reference is dropped when we
-		 * clear the pending Q in ARP and then it will be freed by net_if.
-		 */
-		net_pkt_ref(orig_pkt);
-		if (net_arp_clear_pending(
-			    iface, (struct in_addr *)NET_IPV4_HDR(pkt)->dst)) {
-			NET_DBG("Could not find pending ARP entry");
+static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	const struct ethernet_api *api = net_if_get_device(iface)->api;
+	struct net_pkt *out_pkt;
+	int ret;
+
+	if (!api) {
+		return -ENOENT;
+	}
+
+	if (!api->send) {
+		return -ENOTSUP;
+	}
+
+	ret = ethernet_send_prepare(iface, pkt, &out_pkt);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = net_l2_send(api->send, net_if_get_device(iface), iface, out_pkt);
+
+	return ethernet_send_done(iface, pkt, out_pkt, ret);
+}
+
+static void ethernet_send_burst(struct net_if *iface, struct net_pkt **pkts,
+				size_t count, int *status)
+{
+	const struct device *dev = net_if_get_device(iface);
+	const struct ethernet_api *api = dev->api;
+	struct net_pkt *out_pkts[ETHERNET_TX_BURST_MAX];
+	uint8_t idx[ETHERNET_TX_BURST_MAX];
+	size_t ready = 0, sent = 0, i;
+	int ret;
+
+	if (!api || !api->send_burst) {
+		for (i = 0; i < count; i++) {
+			status[i] = ethernet_send(iface, pkts[i]);
 		}
-		/* Free the ARP request */
-		net_pkt_unref(pkt);
+
+		return;
 	}
 
-	return ret;
+	while (count > ETHERNET_TX_BURST_MAX) {
+		ethernet_send_burst(iface, pkts, ETHERNET_TX_BURST_MAX, status);
+
+		pkts += ETHERNET_TX_BURST_MAX;
+		status += ETHERNET_TX_BURST_MAX;
+		count -= ETHERNET_TX_BURST_MAX;
+	}
+
+	for (i = 0; i < count; i++) {
+		status[i] = ethernet_send_prepare(iface, pkts[i], &out_pkts[ready]);
+		if (status[i] < 0) {
+			continue;
+		}
+
+		net_capture_pkt(iface, out_pkts[ready]);
+		idx[ready++] = i;
+	}
+
+	if (ready > 0) {
+		ret = api->send_burst(dev, out_pkts, ready);
+		if (ret > 0) {
+			sent = MIN((size_t)ret, ready);
+		}
+	}
+
+	/* Whatever the driver did not take is sent one by one, so the
+	 * packet order is kept.
+	 */
+	for (i = 0; i < ready; i++) {
+		ret = i < sent ? 0 : api->send(dev, out_pkts[i]);
+
+		status[idx[i]] = ethernet_send_done(iface, pkts[idx[i]],
+						    out_pkts[i], ret);
+	}
 }
 
 static inline int ethernet_enable(struct net_if *iface, bool state)
@@ -859,7 +944,7 @@ static int ethernet_l2_alloc(struct net_if *iface, struct net_pkt *pkt,
 #endif
 
 NET_L2_INIT(ETHERNET_L2, ethernet_recv, ethernet_send, ethernet_enable,
-	    ethernet_flags, ethernet_l2_alloc);
+	    ethernet_flags, ethernet_l2_alloc, ethernet_send_burst);
 
 static void carrier_on_off(struct k_work *work)
 {
@@ -1938,6 +1938,13 @@ int coap_resource_notify(struct coap_resource *resource)
 	return 0;
 }
 
+int coap_resource_next_age(struct coap_resource *resource)
+{
+	coap_observer_increment_age(resource);
+
+	return resource->age;
+}
+
 bool coap_request_is_observe(const struct coap_packet *request)
 {
 	return coap_get_option_int(request, COAP_OPTION_OBSERVE) == 0;
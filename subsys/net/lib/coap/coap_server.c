@@ -17,6 +17,7 @@ LOG_MODULE_DECLARE(net_coap, CONFIG_COAP_LOG_LEVEL);
 #include <zephyr/net/coap_mgmt.h>
 #include <zephyr/net/coap_service.h>
 #include <zephyr/posix/fcntl.h>
+#include <zephyr/sys/byteorder.h>
 
 #if defined(CONFIG_NET_TC_THREAD_COOPERATIVE)
 /* Lowest priority cooperative thread */
@@ -29,6 +30,8 @@ LOG_MODULE_DECLARE(net_coap, CONFIG_COAP_LOG_LEVEL);
 	(((struct sockaddr *)sock)->sa_family == AF_INET ? \
 		sizeof(struct sockaddr_in) : sizeof(struct sockaddr_in6))
 
+#define BASIC_HEADER_SIZE 4
+
 /* Shortened defines */
 #define MAX_OPTIONS    CONFIG_COAP_SERVER_MESSAGE_OPTIONS
 #define MAX_PENDINGS   CONFIG_COAP_SERVICE_PENDING_MESSAGES
@@ -81,6 +84,67 @@ static inline void coap_server_free(void *ptr)
 #endif
 }
 
+static inline int64_t coap_pending_expiry(const struct coap_pending *pending)
+{
+	return pending->t0 + pending->timeout;
+}
+
+/* (Re)insert a pending message in the retransmission queue, which is kept
+ * sorted by expiry so that the next retransmission is always at the head.
+ */
+static void coap_server_pending_schedule(const struct coap_service *service,
+					 struct coap_pending *pending)
+{
+	struct coap_service_data *data = service->data;
+	sys_dnode_t *node = &data->pending_nodes[pending - data->pending];
+	int64_t expiry = coap_pending_expiry(pending);
+	sys_dnode_t *it;
+
+	if (sys_dnode_is_linked(node)) {
+		sys_dlist_remove(node);
+	}
+
+	/* Retransmissions mostly expire last, search from the tail */
+	for (it = sys_dlist_peek_tail(&data->pending_queue); it != NULL;
+	     it = sys_dlist_peek_prev(&data->pending_queue, it)) {
+		if (coap_pending_expiry(&data->pending[it - data->pending_nodes]) <= expiry) {
+			break;
+		}
+	}
+
+	if (it == NULL) {
+		sys_dlist_prepend(&data->pending_queue, node);
+	} else if (sys_dlist_is_tail(&data->pending_queue, it)) {
+		sys_dlist_append(&data->pending_queue, node);
+	} else {
+		sys_dlist_insert(sys_dlist_peek_next_no_check(&data->pending_queue, it), node);
+	}
+}
+
+static void coap_server_pending_release(const struct coap_service *service,
+					struct coap_pending *pending)
+{
+	sys_dnode_t *node = &service->data->pending_nodes[pending - service->data->pending];
+
+	if (sys_dnode_is_linked(node)) {
+		sys_dlist_remove(node);
+	}
+
+	coap_server_free(pending->data);
+	coap_pending_clear(pending);
+}
+
+static struct coap_pending *coap_server_pending_next(const struct coap_service *service)
+{
+	sys_dnode_t *node = sys_dlist_peek_head(&service->data->pending_queue);
+
+	if (node == NULL) {
+		return NULL;
+	}
+
+	return &service->data->pending[node - service->data->pending_nodes];
+}
+
 static int coap_service_remove_observer(const struct coap_service *service,
 					struct coap_resource *resource,
 					const struct sockaddr *addr,
@@ -220,8 +284,7 @@ static int coap_server_process(int sock_fd)
 			coap_service_remove_observer(service, NULL, &client_addr, token, tkl);
 			__fallthrough;
 		case COAP_TYPE_ACK:
-			coap_server_free(pending->data);
-			coap_pending_clear(pending);
+			coap_server_pending_release(service, pending);
 			break;
 		default:
 			LOG_WRN("Unexpected pending type %d", type);
@@ -295,7 +358,6 @@ unlock:
 static void coap_server_retransmit(void)
 {
 	struct coap_pending *pending;
-	int64_t remaining;
 	int64_t now = k_uptime_get();
 	int ret;
 
@@ -306,32 +368,27 @@ static void coap_server_retransmit(void)
 			continue;
 		}
 
-		pending = coap_pending_next_to_expire(service->data->pending, MAX_PENDINGS);
-		if (pending == NULL) {
-			/* No work to be done */
-			continue;
-		}
-
-		/* Check if the pending request has expired */
-		remaining = pending->t0 + pending->timeout - now;
-		if (remaining > 0) {
-			continue;
-		}
-
-		if (coap_pending_cycle(pending)) {
-			ret = zsock_sendto(service->data->sock_fd, pending->data, pending->len, 0,
-					   &pending->addr, ADDRLEN(&pending->addr));
-			if (ret < 0) {
-				LOG_ERR("Failed to send pending retransmission for %s (%d)",
-					service->name, ret);
+		/* Handle all the expired messages, the queue is sorted by expiry */
+		while ((pending = coap_server_pending_next(service)) != NULL &&
+		       coap_pending_expiry(pending) <= now) {
+			if (coap_pending_cycle(pending)) {
+				ret = zsock_sendto(service->data->sock_fd, pending->data,
+						   pending->len, 0, &pending->addr,
+						   ADDRLEN(&pending->addr));
+				if (ret < 0) {
+					LOG_ERR("Failed to send pending retransmission for %s (%d)",
+						service->name, ret);
+				}
+				__ASSERT_NO_MSG(ret == pending->len);
+
+				coap_server_pending_schedule(service, pending);
+			} else {
+				LOG_WRN("Packet retransmission failed for %s", service->name);
+
+				coap_service_remove_observer(service, NULL, &pending->addr, NULL,
+							     0U);
+				coap_server_pending_release(service, pending);
 			}
-			__ASSERT_NO_MSG(ret == pending->len);
-		} else {
-			LOG_WRN("Packet retransmission failed for %s", service->name);
-
-			coap_service_remove_observer(service, NULL, &pending->addr, NULL, 0U);
-			coap_server_free(pending->data);
-			coap_pending_clear(pending);
 		}
 	}
 
@@ -350,12 +407,12 @@ static int coap_server_poll_timeout(void)
 			continue;
 		}
 
-		pending = coap_pending_next_to_expire(svc->data->pending, MAX_PENDINGS);
+		pending = coap_server_pending_next(svc);
 		if (pending == NULL) {
 			continue;
 		}
 
-		remaining = pending->t0 + pending->timeout - now;
+		remaining = coap_pending_expiry(pending) - now;
 		if (result > remaining) {
 			result = remaining;
 		}
@@ -605,6 +662,7 @@ int coap_service_send(const struct coap_service *service, const struct coap_pack
 		memcpy(pending->data, cpkt->data, pending->len);
 
 		coap_pending_cycle(pending);
+		coap_server_pending_schedule(service, pending);
 
 		/* Trigger event in receive loop to schedule retransmit */
 		coap_server_update_services();
@@ -637,6 +695,183 @@ int coap_resource_send(const struct coap_resource *resource, const struct coap_p
 	return -ENOENT;
 }
 
+/* Prepare the per observer part of a notification, the header and the token */
+static size_t coap_server_notification_header(uint8_t *hdr, const struct coap_packet *cpkt,
+					      const struct coap_observer *observer)
+{
+	uint16_t id = coap_next_id();
+
+	/* Version and type are kept, only the token length is replaced */
+	hdr[0] = (cpkt->data[0] & 0xF0) | observer->tkl;
+	hdr[1] = cpkt->data[1];
+	sys_put_be16(id, &hdr[2]);
+	memcpy(&hdr[BASIC_HEADER_SIZE], observer->token, observer->tkl);
+
+	return BASIC_HEADER_SIZE + observer->tkl;
+}
+
+static int coap_server_notify_con(const struct coap_service *service,
+				  const uint8_t *hdr, size_t hdr_len,
+				  const uint8_t *body, size_t body_len,
+				  const struct coap_observer *observer,
+				  const struct coap_transmission_parameters *params)
+{
+	struct coap_packet notification = { 0 };
+	struct coap_pending *pending;
+	size_t len = hdr_len + body_len;
+	uint8_t *data;
+	int ret;
+
+	pending = coap_pending_next_unused(service->data->pending, MAX_PENDINGS);
+	if (pending == NULL) {
+		LOG_WRN("No pending message available for %s", service->name);
+		return -ENOMEM;
+	}
+
+	data = coap_server_alloc(len);
+	if (data == NULL) {
+		LOG_WRN("Failed to allocate pending message data for %s", service->name);
+		return -ENOMEM;
+	}
+
+	/* Confirmable notifications are kept for retransmission, so they are
+	 * assembled in the pending buffer and sent from there.
+	 */
+	memcpy(data, hdr, hdr_len);
+	memcpy(data + hdr_len, body, body_len);
+
+	notification.data = data;
+	notification.offset = len;
+	notification.max_len = len;
+	notification.hdr_len = hdr_len;
+
+	ret = coap_pending_init(pending, &notification, &observer->addr, params);
+	if (ret < 0) {
+		coap_server_free(data);
+		return ret;
+	}
+
+	ret = zsock_sendto(service->data->sock_fd, data, len, 0, &observer->addr,
+			   ADDRLEN(&observer->addr));
+	if (ret < 0) {
+		ret = -errno;
+		LOG_ERR("Failed to send CoAP notification (%d)", ret);
+	}
+
+	/* Retransmit also when the first transmission failed */
+	coap_pending_cycle(pending);
+	coap_server_pending_schedule(service, pending);
+
+	return ret < 0 ? ret : 0;
+}
+
+static int coap_server_notify_non(const struct coap_service *service,
+				  const uint8_t *hdr, size_t hdr_len,
+				  const uint8_t *body, size_t body_len,
+				  const struct coap_observer *observer)
+{
+	struct iovec iov[] = {
+		{ .iov_base = (void *)hdr, .iov_len = hdr_len },
+		{ .iov_base = (void *)body, .iov_len = body_len },
+	};
+	struct msghdr msg = {
+		.msg_name = (void *)&observer->addr,
+		.msg_namelen = ADDRLEN(&observer->addr),
+		.msg_iov = iov,
+		.msg_iovlen = body_len > 0 ? ARRAY_SIZE(iov) : 1,
+	};
+	int ret;
+
+	/* The shared body is sent straight from the caller's buffer */
+	ret = zsock_sendmsg(service->data->sock_fd, &msg, 0);
+	if (ret < 0) {
+		ret = -errno;
+		LOG_ERR("Failed to send CoAP notification (%d)", ret);
+		return ret;
+	}
+
+	return 0;
+}
+
+int coap_resource_notify_observers(struct coap_resource *resource, const struct coap_packet *cpkt,
+				   const struct coap_transmission_parameters *params)
+{
+	const struct coap_service *service = NULL;
+	uint8_t hdr[BASIC_HEADER_SIZE + COAP_TOKEN_MAX_LEN];
+	const uint8_t *body;
+	struct coap_observer *observer;
+	size_t body_len;
+	size_t hdr_len;
+	bool con;
+	int count = 0;
+	int ret;
+
+	if (cpkt == NULL || cpkt->hdr_len < BASIC_HEADER_SIZE ||
+	    cpkt->offset < cpkt->hdr_len) {
+		return -EINVAL;
+	}
+
+	switch (coap_header_get_type(cpkt)) {
+	case COAP_TYPE_CON:
+		con = true;
+		break;
+	case COAP_TYPE_NON_CON:
+		con = false;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	/* Find owning service */
+	COAP_SERVICE_FOREACH(svc) {
+		if (COAP_SERVICE_HAS_RESOURCE(svc, resource)) {
+			service = svc;
+			break;
+		}
+	}
+
+	if (service == NULL) {
+		return -ENOENT;
+	}
+
+	/* Options and payload are the same for all the observers */
+	body = cpkt->data + cpkt->hdr_len;
+	body_len = cpkt->offset - cpkt->hdr_len;
+
+	(void)k_mutex_lock(&lock, K_FOREVER);
+
+	if (service->data->sock_fd < 0) {
+		count = -EBADF;
+		goto unlock;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&resource->observers, observer, list) {
+		hdr_len = coap_server_notification_header(hdr, cpkt, observer);
+
+		if (con) {
+			ret = coap_server_notify_con(service, hdr, hdr_len, body, body_len,
+						     observer, params);
+		} else {
+			ret = coap_server_notify_non(service, hdr, hdr_len, body, body_len,
+						     observer);
+		}
+
+		if (ret == 0) {
+			count++;
+		}
+	}
+
+	/* A single wake up schedules the retransmissions of the whole batch */
+	if (con && count > 0) {
+		coap_server_update_services();
+	}
+
+unlock:
+	(void)k_mutex_unlock(&lock);
+
+	return count;
+}
+
 int coap_resource_parse_observe(struct coap_resource *resource, const struct coap_packet *request,
 				const struct sockaddr *addr)
 {
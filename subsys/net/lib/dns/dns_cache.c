@@ -9,14 +9,236 @@
 
 LOG_MODULE_REGISTER(net_dns_cache, CONFIG_DNS_RESOLVER_LOG_LEVEL);
 
-static void dns_cache_clean(struct dns_cache const *cache);
+#define PREFETCH_HITS      CONFIG_DNS_RESOLVER_CACHE_PREFETCH_HITS
+#define PREFETCH_THRESHOLD CONFIG_DNS_RESOLVER_CACHE_PREFETCH_THRESHOLD
+
+/* Entries are linked by index + 1, 0 terminates a list */
+#define ENTRY_REF(idx) ((uint16_t)((idx) + 1))
+#define ENTRY_IDX(ref) ((size_t)(ref) - 1)
+
+static void dns_cache_clean(struct dns_cache *cache);
+
+/* FNV-1a */
+static uint32_t dns_cache_hash(const char *query)
+{
+	uint32_t hash = 2166136261U;
+
+	while (*query != '\0') {
+		hash ^= (uint8_t)*query++;
+		hash *= 16777619U;
+	}
+
+	return hash;
+}
+
+static bool dns_cache_expires_before(struct dns_cache *cache, uint16_t a, uint16_t b)
+{
+	return sys_timepoint_cmp(cache->entries[a].expiry, cache->entries[b].expiry) < 0;
+}
+
+static void dns_cache_heap_set(struct dns_cache *cache, size_t pos, uint16_t idx)
+{
+	cache->heap[pos] = idx;
+	cache->entries[idx].heap_index = pos;
+}
+
+static void dns_cache_heap_sift_up(struct dns_cache *cache, size_t pos)
+{
+	uint16_t idx = cache->heap[pos];
+
+	while (pos > 0) {
+		size_t parent = (pos - 1) / 2;
+
+		if (!dns_cache_expires_before(cache, idx, cache->heap[parent])) {
+			break;
+		}
+
+		dns_cache_heap_set(cache, pos, cache->heap[parent]);
+		pos = parent;
+	}
+
+	dns_cache_heap_set(cache, pos, idx);
+}
+
+static void dns_cache_heap_sift_down(struct dns_cache *cache, size_t pos)
+{
+	uint16_t idx = cache->heap[pos];
+
+	while (true) {
+		size_t child = 2 * pos + 1;
+
+		if (child >= cache->heap_len) {
+			break;
+		}
+
+		if (child + 1 < cache->heap_len &&
+		    dns_cache_expires_before(cache, cache->heap[child + 1], cache->heap[child])) {
+			child++;
+		}
+
+		if (!dns_cache_expires_before(cache, cache->heap[child], idx)) {
+			break;
+		}
+
+		dns_cache_heap_set(cache, pos, cache->heap[child]);
+		pos = child;
+	}
+
+	dns_cache_heap_set(cache, pos, idx);
+}
+
+static void dns_cache_heap_remove(struct dns_cache *cache, size_t pos)
+{
+	cache->heap_len--;
+
+	if (pos == cache->heap_len) {
+		return;
+	}
+
+	dns_cache_heap_set(cache, pos, cache->heap[cache->heap_len]);
+
+	if (pos > 0 && dns_cache_expires_before(cache, cache->heap[pos],
+						cache->heap[(pos - 1) / 2])) {
+		dns_cache_heap_sift_up(cache, pos);
+	} else {
+		dns_cache_heap_sift_down(cache, pos);
+	}
+}
+
+/* Returns the entry to the free list, the caller must have unlinked it
+ * from its hash bucket.
+ */
+static void dns_cache_release(struct dns_cache *cache, size_t idx)
+{
+	struct dns_cache_entry *entry = &cache->entries[idx];
+
+	dns_cache_heap_remove(cache, entry->heap_index);
+
+	entry->in_use = false;
+	entry->next = cache->free_head;
+	cache->free_head = ENTRY_REF(idx);
+}
+
+static void dns_cache_unlink(struct dns_cache *cache, size_t idx)
+{
+	uint16_t *link = &cache->buckets[cache->entries[idx].hash % cache->size];
+
+	while (*link != 0) {
+		if (ENTRY_IDX(*link) == idx) {
+			*link = cache->entries[idx].next;
+			return;
+		}
+
+		link = &cache->entries[ENTRY_IDX(*link)].next;
+	}
+}
+
+static bool dns_cache_family_matches(const struct dns_cache_entry *entry, int family)
+{
+	return family == AF_UNSPEC || entry->data.ai_family == family ||
+	       (entry->negative && entry->data.ai_family == AF_UNSPEC);
+}
+
+/* Removes the entries of the query that would be superseded by a new entry:
+ * negative entries when an answer arrives, entries waiting for a prefetch
+ * when the refreshed answer arrives, or everything of the family when
+ * stale is true.
+ */
+static void dns_cache_drop(struct dns_cache *cache, const char *query, uint32_t hash,
+			   int family, bool stale)
+{
+	uint16_t *link = &cache->buckets[hash % cache->size];
+
+	while (*link != 0) {
+		size_t idx = ENTRY_IDX(*link);
+		struct dns_cache_entry *entry = &cache->entries[idx];
+
+		if (entry->hash == hash && strcmp(entry->query, query) == 0 &&
+		    dns_cache_family_matches(entry, family) &&
+		    (stale || entry->negative || entry->prefetching)) {
+			NET_DBG("Remove \"%s\"", entry->query);
+			*link = entry->next;
+			dns_cache_release(cache, idx);
+			continue;
+		}
+
+		link = &entry->next;
+	}
+}
+
+static size_t dns_cache_alloc(struct dns_cache *cache)
+{
+	size_t idx;
+
+	if (cache->free_head != 0) {
+		idx = ENTRY_IDX(cache->free_head);
+		cache->free_head = cache->entries[idx].next;
+		return idx;
+	}
+
+	if (cache->high_water < cache->size) {
+		return cache->high_water++;
+	}
+
+	/* Full, replace the entry closest to expiry */
+	idx = cache->heap[0];
+
+	NET_DBG("Overwrite \"%s\"", cache->entries[idx].query);
+
+	dns_cache_unlink(cache, idx);
+	dns_cache_heap_remove(cache, 0);
+
+	return idx;
+}
+
+static void dns_cache_insert(struct dns_cache *cache, const char *query, uint32_t hash,
+			     struct dns_addrinfo const *addrinfo, uint32_t ttl, bool negative)
+{
+	size_t idx = dns_cache_alloc(cache);
+	struct dns_cache_entry *entry = &cache->entries[idx];
+	uint16_t *bucket = &cache->buckets[hash % cache->size];
+
+	strncpy(entry->query, query, CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1);
+	entry->query[CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1] = '\0';
+	entry->data = *addrinfo;
+	entry->expiry = sys_timepoint_calc(K_SECONDS(ttl));
+	entry->ttl = ttl;
+	entry->hash = hash;
+	entry->hits = 0;
+	entry->in_use = true;
+	entry->negative = negative;
+	entry->prefetching = false;
+
+	entry->next = *bucket;
+	*bucket = ENTRY_REF(idx);
+
+	cache->heap[cache->heap_len] = idx;
+	cache->heap_len++;
+	dns_cache_heap_sift_up(cache, cache->heap_len - 1);
+}
+
+static int dns_cache_check_query(const char *query)
+{
+	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
+		NET_WARN("Query string to big to be processed %u >= "
+			 "CONFIG_DNS_RESOLVER_MAX_QUERY_LEN",
+			 strlen(query));
+		return -EINVAL;
+	}
+
+	return 0;
+}
 
 int dns_cache_flush(struct dns_cache *cache)
 {
 	k_mutex_lock(cache->lock, K_FOREVER);
 	for (size_t i = 0; i < cache->size; i++) {
 		cache->entries[i].in_use = false;
+		cache->buckets[i] = 0;
 	}
+	cache->heap_len = 0;
+	cache->high_water = 0;
+	cache->free_head = 0;
 	k_mutex_unlock(cache->lock);
 
 	return 0;
@@ -25,47 +247,53 @@ int dns_cache_flush(struct dns_cache *cache)
 int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinfo const *addrinfo,
 		  uint32_t ttl)
 {
-	k_timepoint_t closest_to_expiry = sys_timepoint_calc(K_FOREVER);
-	size_t index_to_replace = 0;
-	bool found_empty = false;
+	uint32_t hash;
 
 	if (cache == NULL || query == NULL || addrinfo == NULL || ttl == 0) {
 		return -EINVAL;
 	}
 
-	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
-		NET_WARN("Query string to big to be processed %u >= "
-			 "CONFIG_DNS_RESOLVER_MAX_QUERY_LEN",
-			 strlen(query));
+	if (dns_cache_check_query(query) < 0) {
 		return -EINVAL;
 	}
 
+	hash = dns_cache_hash(query);
+
 	k_mutex_lock(cache->lock, K_FOREVER);
 
 	NET_DBG("Add \"%s\" with TTL %" PRIu32, query, ttl);
 
 	dns_cache_clean(cache);
+	dns_cache_drop(cache, query, hash, addrinfo->ai_family, false);
+	dns_cache_insert(cache, query, hash, addrinfo, ttl, false);
 
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
-			index_to_replace = i;
-			found_empty = true;
-			break;
-		} else if (sys_timepoint_cmp(closest_to_expiry, cache->entries[i].expiry) > 0) {
-			index_to_replace = i;
-			closest_to_expiry = cache->entries[i].expiry;
-		}
+	k_mutex_unlock(cache->lock);
+
+	return 0;
+}
+
+int dns_cache_add_negative(struct dns_cache *cache, char const *query, int family, uint32_t ttl)
+{
+	struct dns_addrinfo addrinfo = { .ai_family = family };
+	uint32_t hash;
+
+	if (cache == NULL || query == NULL || ttl == 0) {
+		return -EINVAL;
 	}
 
-	if (!found_empty) {
-		NET_DBG("Overwrite \"%s\"", cache->entries[index_to_replace].query);
+	if (dns_cache_check_query(query) < 0) {
+		return -EINVAL;
 	}
 
-	strncpy(cache->entries[index_to_replace].query, query,
-		CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1);
-	cache->entries[index_to_replace].data = *addrinfo;
-	cache->entries[index_to_replace].expiry = sys_timepoint_calc(K_SECONDS(ttl));
-	cache->entries[index_to_replace].in_use = true;
+	hash = dns_cache_hash(query);
+
+	k_mutex_lock(cache->lock, K_FOREVER);
+
+	NET_DBG("Add negative \"%s\" family %d with TTL %" PRIu32, query, family, ttl);
+
+	dns_cache_clean(cache);
+	dns_cache_drop(cache, query, hash, family, true);
+	dns_cache_insert(cache, query, hash, &addrinfo, ttl, true);
 
 	k_mutex_unlock(cache->lock);
 
@@ -75,65 +303,106 @@ int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinf
 int dns_cache_remove(struct dns_cache *cache, char const *query)
 {
 	NET_DBG("Remove all entries with query \"%s\"", query);
-	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
-		NET_WARN("Query string to big to be processed %u >= "
-			 "CONFIG_DNS_RESOLVER_MAX_QUERY_LEN",
-			 strlen(query));
+	if (dns_cache_check_query(query) < 0) {
 		return -EINVAL;
 	}
 
 	k_mutex_lock(cache->lock, K_FOREVER);
 
 	dns_cache_clean(cache);
-
-	for (size_t i = 0; i < cache->size; i++) {
-		if (cache->entries[i].in_use && strcmp(cache->entries[i].query, query) == 0) {
-			cache->entries[i].in_use = false;
-		}
-	}
+	dns_cache_drop(cache, query, dns_cache_hash(query), AF_UNSPEC, true);
 
 	k_mutex_unlock(cache->lock);
 
 	return 0;
 }
 
-int dns_cache_find(struct dns_cache const *cache, const char *query, struct dns_addrinfo *addrinfo,
-		   size_t addrinfo_array_len)
+static bool dns_cache_should_prefetch(const struct dns_cache_entry *entry)
+{
+	uint64_t remaining_ms;
+
+	if (PREFETCH_HITS == 0 || entry->prefetching || entry->hits < PREFETCH_HITS) {
+		return false;
+	}
+
+	remaining_ms = k_ticks_to_ms_floor64(sys_timepoint_timeout(entry->expiry).ticks);
+
+	return remaining_ms * 100U <= (uint64_t)entry->ttl * 1000U * PREFETCH_THRESHOLD;
+}
+
+int dns_cache_lookup(struct dns_cache *cache, const char *query, int family,
+		     struct dns_addrinfo *addrinfo, size_t addrinfo_array_len, bool *prefetch)
 {
+	bool refresh = false;
+	bool negative = false;
 	size_t found = 0;
+	uint32_t hash;
+	uint16_t ref;
 
 	NET_DBG("Find \"%s\"", query);
 	if (cache == NULL || query == NULL || addrinfo == NULL || addrinfo_array_len <= 0) {
 		return -EINVAL;
 	}
-	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
-		NET_WARN("Query string to big to be processed %u >= "
-			 "CONFIG_DNS_RESOLVER_MAX_QUERY_LEN",
-			 strlen(query));
+	if (dns_cache_check_query(query) < 0) {
 		return -EINVAL;
 	}
 
+	hash = dns_cache_hash(query);
+
 	k_mutex_lock(cache->lock, K_FOREVER);
 
 	dns_cache_clean(cache);
 
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
+	for (ref = cache->buckets[hash % cache->size]; ref != 0;
+	     ref = cache->entries[ENTRY_IDX(ref)].next) {
+		struct dns_cache_entry *entry = &cache->entries[ENTRY_IDX(ref)];
+
+		if (entry->hash != hash || strcmp(entry->query, query) != 0) {
+			continue;
+		}
+		if (!dns_cache_family_matches(entry, family)) {
 			continue;
 		}
-		if (strcmp(cache->entries[i].query, query) != 0) {
+		if (entry->negative) {
+			negative = true;
 			continue;
 		}
+
+		if (entry->hits < UINT16_MAX) {
+			entry->hits++;
+		}
+
+		refresh = refresh || dns_cache_should_prefetch(entry);
+
 		if (found >= addrinfo_array_len) {
 			NET_WARN("Found \"%s\" but not enough space in provided buffer.", query);
 			found++;
 		} else {
-			addrinfo[found] = cache->entries[i].data;
+			addrinfo[found] = entry->data;
 			found++;
 			NET_DBG("Found \"%s\"", query);
 		}
 	}
 
+	/* Refresh the whole answer set at once, the entries are replaced
+	 * together when the new answer arrives.
+	 */
+	if (refresh && prefetch != NULL) {
+		for (ref = cache->buckets[hash % cache->size]; ref != 0;
+		     ref = cache->entries[ENTRY_IDX(ref)].next) {
+			struct dns_cache_entry *entry = &cache->entries[ENTRY_IDX(ref)];
+
+			if (!entry->negative && entry->hash == hash &&
+			    strcmp(entry->query, query) == 0 &&
+			    dns_cache_family_matches(entry, family)) {
+				entry->prefetching = true;
+			}
+		}
+
+		NET_DBG("Prefetch \"%s\"", query);
+		*prefetch = true;
+	}
+
 	k_mutex_unlock(cache->lock);
 
 	if (found > addrinfo_array_len) {
@@ -141,22 +410,34 @@ int dns_cache_find(struct dns_cache const *cache, const char *query, struct dns_
 	}
 
 	if (found == 0) {
+		if (negative) {
+			NET_DBG("Negative entry for \"%s\"", query);
+			return -ENOENT;
+		}
+
 		NET_DBG("Could not find \"%s\"", query);
 	}
 	return found;
 }
 
+int dns_cache_find(struct dns_cache *cache, const char *query, struct dns_addrinfo *addrinfo,
+		   size_t addrinfo_array_len)
+{
+	return dns_cache_lookup(cache, query, AF_UNSPEC, addrinfo, addrinfo_array_len, NULL);
+}
+
 /* Needs to be called when lock is already acquired */
-static void dns_cache_clean(struct dns_cache const *cache)
+static void dns_cache_clean(struct dns_cache *cache)
 {
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
-			continue;
-		}
+	while (cache->heap_len > 0) {
+		size_t idx = cache->heap[0];
 
-		if (sys_timepoint_expired(cache->entries[i].expiry)) {
-			NET_DBG("Remove \"%s\"", cache->entries[i].query);
-			cache->entries[i].in_use = false;
+		if (!sys_timepoint_expired(cache->entries[idx].expiry)) {
+			break;
 		}
+
+		NET_DBG("Remove \"%s\"", cache->entries[idx].query);
+		dns_cache_unlink(cache, idx);
+		dns_cache_release(cache, idx);
 	}
 }
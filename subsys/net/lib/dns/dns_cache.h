@@ -22,12 +22,35 @@ struct dns_cache_entry {
 	char query[CONFIG_DNS_RESOLVER_MAX_QUERY_LEN];
 	struct dns_addrinfo data;
 	k_timepoint_t expiry;
+	/* Original TTL in seconds, used to decide when to prefetch */
+	uint32_t ttl;
+	uint32_t hash;
+	/* Next entry in the same hash bucket or in the free list, stored as
+	 * index + 1 so that 0 terminates the list.
+	 */
+	uint16_t next;
+	/* Position of the entry in the expiry heap */
+	uint16_t heap_index;
+	uint16_t hits;
 	bool in_use;
+	/* Entry records that the name or address family does not exist */
+	bool negative;
+	/* A refresh has been requested, the next answer replaces the entry */
+	bool prefetching;
 };
 
 struct dns_cache {
 	size_t size;
 	struct dns_cache_entry *entries;
+	/* Hash buckets holding the first entry of each chain (index + 1) */
+	uint16_t *buckets;
+	/* Binary min-heap of entry indices ordered by expiry */
+	uint16_t *heap;
+	size_t heap_len;
+	/* Entries at or above this index have never been used */
+	size_t high_water;
+	/* First entry of the free list (index + 1) */
+	uint16_t free_head;
 	struct k_mutex *lock;
 };
 
@@ -41,10 +64,16 @@ struct dns_cache {
  * @param name Name of the cache.
  */
 #define DNS_CACHE_DEFINE(name, cache_size)                                                         \
+	BUILD_ASSERT((cache_size) > 0 && (cache_size) < UINT16_MAX);                               \
 	static K_MUTEX_DEFINE(name##_mutex);                                                       \
 	static struct dns_cache_entry name##_entries[cache_size];                                  \
-	static struct dns_cache name = {                                                           \
-		.entries = name##_entries, .size = cache_size, .lock = &name##_mutex};
+	static uint16_t name##_buckets[cache_size];                                                \
+	static uint16_t name##_heap[cache_size];                                                   \
+	static struct dns_cache name = {.entries = name##_entries,                                 \
+					.buckets = name##_buckets,                                 \
+					.heap = name##_heap,                                       \
+					.size = cache_size,                                        \
+					.lock = &name##_mutex};
 
 /**
  * @brief Flushes the dns cache removing all its entries.
@@ -71,6 +100,21 @@ int dns_cache_flush(struct dns_cache *cache);
 int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinfo const *addrinfo,
 		  uint32_t ttl);
 
+/**
+ * @brief Adds a negative entry recording that the query has no answer.
+ *
+ * Any other entry with the same query and address family is replaced.
+ *
+ * @param cache Cache where the entry should be added.
+ * @param query Query which should be persisted in the cache.
+ * @param family Address family that has no records, or AF_UNSPEC if the
+ * name does not exist at all.
+ * @param ttl Time to live for the entry in seconds.
+ * @retval 0 on success
+ * @retval On error, a negative value is returned.
+ */
+int dns_cache_add_negative(struct dns_cache *cache, char const *query, int family, uint32_t ttl);
+
 /**
  * @brief Removes all entries with the given query
  *
@@ -93,8 +137,33 @@ int dns_cache_remove(struct dns_cache *cache, char const *query);
  * @retval On error a negative value is returned.
  * -ENOSR means there was not enough space in the addrinfo array to accommodate all cache hits the
  * array will however be filled with valid data.
+ * -ENOENT means that only a negative entry was found for the query.
  */
-int dns_cache_find(struct dns_cache const *cache, const char *query, struct dns_addrinfo *addrinfo,
+int dns_cache_find(struct dns_cache *cache, const char *query, struct dns_addrinfo *addrinfo,
 		   size_t addrinfo_array_len);
 
+/**
+ * @brief Tries to find the specified query entry of a given address family.
+ *
+ * Works like dns_cache_find() but only returns entries of the given family
+ * and reports whether a frequently used entry is about to expire, so that
+ * the caller can refresh it before the cache misses. The refresh is only
+ * requested once, the entries are replaced by the next answer added for
+ * the same query and family.
+ *
+ * @param cache Cache where the entry should be searched.
+ * @param query Query which should be searched for.
+ * @param family Address family of the entries, or AF_UNSPEC for any.
+ * @param addrinfo dns_addrinfo array which will be written if the query was found.
+ * @param addrinfo_array_len Array size of the dns_addrinfo array
+ * @param prefetch Set to true if the query should be refreshed, can be NULL.
+ * @retval on success the amount of dns_addrinfo written into the addrinfo array will be returned.
+ * A cache miss will therefore return a 0.
+ * @retval -ENOENT if a negative entry was found.
+ * @retval -ENOSR if there was not enough space in the addrinfo array.
+ * @retval On other errors a negative value is returned.
+ */
+int dns_cache_lookup(struct dns_cache *cache, const char *query, int family,
+		     struct dns_addrinfo *addrinfo, size_t addrinfo_array_len, bool *prefetch);
+
 #endif /* ZEPHYR_INCLUDE_NET_DNS_CACHE_H_ */
@@ -77,6 +77,12 @@ NET_BUF_POOL_DEFINE(dns_qname_pool, DNS_RESOLVER_BUF_CTR,
 
 #ifdef CONFIG_DNS_RESOLVER_CACHE
 DNS_CACHE_DEFINE(dns_cache, CONFIG_DNS_RESOLVER_CACHE_MAX_ENTRIES);
+
+/* Only one prefetch is run at a time, the query name must stay valid
+ * until the query is done.
+ */
+static char dns_prefetch_query[CONFIG_DNS_RESOLVER_MAX_QUERY_LEN];
+static atomic_t dns_prefetch_busy;
 #endif /* CONFIG_DNS_RESOLVER_CACHE */
 
 static int init_called;
@@ -746,6 +752,7 @@ int dns_validate_msg(struct dns_resolve_context *ctx,
 	uint32_t ttl; /* RR ttl, so far it is not passed to caller */
 	uint8_t *src, *addr;
 	char *query_name;
+	bool nxdomain;
 	int address_size;
 	/* index that points to the current answer being analyzed */
 	int answer_ptr;
@@ -786,6 +793,8 @@ int dns_validate_msg(struct dns_resolve_context *ctx,
 		goto quit;
 	}
 
+	nxdomain = (ret == DNS_HEADER_NAMEERROR);
+
 	if (dns_header_qdcount(dns_msg->msg) != 1) {
 		/* For mDNS (when dns_id == 0) the query count is 0 */
 		if (*dns_id > 0) {
@@ -988,6 +997,18 @@ query_known:
 	}
 
 	if (items == 0) {
+#ifdef CONFIG_DNS_RESOLVER_CACHE
+		/* mDNS responders might just not have answered yet, so only
+		 * remember names that the server says do not exist.
+		 */
+		if (nxdomain && *dns_id > 0 && CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_TTL > 0) {
+			dns_cache_add_negative(&dns_cache, ctx->queries[*query_idx].query,
+					       AF_UNSPEC, CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_TTL);
+		}
+#else
+		ARG_UNUSED(nxdomain);
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
 		ret = DNS_EAI_NODATA;
 	} else {
 		ret = DNS_EAI_ALLDONE;
@@ -1333,13 +1354,63 @@ static void query_timeout(struct k_work *work)
 	k_mutex_unlock(&pending_query->ctx->lock);
 }
 
-int dns_resolve_name(struct dns_resolve_context *ctx,
-		     const char *query,
-		     enum dns_query_type type,
-		     uint16_t *dns_id,
-		     dns_resolve_cb_t cb,
-		     void *user_data,
-		     int32_t timeout)
+#ifdef CONFIG_DNS_RESOLVER_CACHE
+static void dns_prefetch_cb(enum dns_resolve_status status,
+			    struct dns_addrinfo *info,
+			    void *user_data)
+{
+	ARG_UNUSED(info);
+	ARG_UNUSED(user_data);
+
+	/* The answers are added to the cache while they are parsed */
+	if (status != DNS_EAI_INPROGRESS) {
+		atomic_clear(&dns_prefetch_busy);
+	}
+}
+
+static int dns_resolve_name_internal(struct dns_resolve_context *ctx,
+				     const char *query,
+				     enum dns_query_type type,
+				     uint16_t *dns_id,
+				     dns_resolve_cb_t cb,
+				     void *user_data,
+				     int32_t timeout,
+				     bool use_cache);
+
+/* Refresh a frequently used name in the background before its cache entries
+ * expire, so that the users of the name never see a cache miss.
+ */
+static void dns_prefetch(struct dns_resolve_context *ctx, const char *query,
+			 enum dns_query_type type, int32_t timeout)
+{
+	int ret;
+
+	if (!atomic_cas(&dns_prefetch_busy, 0, 1)) {
+		return;
+	}
+
+	strncpy(dns_prefetch_query, query, sizeof(dns_prefetch_query) - 1);
+	dns_prefetch_query[sizeof(dns_prefetch_query) - 1] = '\0';
+
+	NET_DBG("Prefetch %s", dns_prefetch_query);
+
+	ret = dns_resolve_name_internal(ctx, dns_prefetch_query, type, NULL,
+					dns_prefetch_cb, NULL, timeout, false);
+	if (ret < 0) {
+		NET_DBG("Cannot prefetch %s (%d)", dns_prefetch_query, ret);
+		atomic_clear(&dns_prefetch_busy);
+	}
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
+static int dns_resolve_name_internal(struct dns_resolve_context *ctx,
+				     const char *query,
+				     enum dns_query_type type,
+				     uint16_t *dns_id,
+				     dns_resolve_cb_t cb,
+				     void *user_data,
+				     int32_t timeout,
+				     bool use_cache)
 {
 	k_timeout_t tout;
 	struct net_buf *dns_data = NULL;
@@ -1351,6 +1422,9 @@ int dns_resolve_name(struct dns_resolve_context *ctx,
 	uint8_t hop_limit;
 #ifdef CONFIG_DNS_RESOLVER_CACHE
 	struct dns_addrinfo cached_info[CONFIG_DNS_RESOLVER_AI_MAX_ENTRIES] = {0};
+	bool prefetch = false;
+#else
+	ARG_UNUSED(use_cache);
 #endif /* CONFIG_DNS_RESOLVER_CACHE */
 
 	if (!ctx || !query || !cb) {
@@ -1414,7 +1488,13 @@ int dns_resolve_name(struct dns_resolve_context *ctx,
 
 try_resolve:
 #ifdef CONFIG_DNS_RESOLVER_CACHE
-	ret = dns_cache_find(&dns_cache, query, cached_info, ARRAY_SIZE(cached_info));
+	if (!use_cache) {
+		goto skip_cache;
+	}
+
+	ret = dns_cache_lookup(&dns_cache, query,
+			       type == DNS_QUERY_TYPE_A ? AF_INET : AF_INET6,
+			       cached_info, ARRAY_SIZE(cached_info), &prefetch);
 	if (ret > 0) {
 		/* The query was cached, no
 		 * need to continue further.
@@ -1424,8 +1504,21 @@ try_resolve:
 		}
 		cb(DNS_EAI_ALLDONE, NULL, user_data);
 
+		if (prefetch) {
+			dns_prefetch(ctx, query, type, timeout);
+		}
+
+		return 0;
+	}
+
+	if (ret == -ENOENT) {
+		/* The name is known not to exist */
+		cb(DNS_EAI_NODATA, NULL, user_data);
+
 		return 0;
 	}
+
+skip_cache:
 #endif /* CONFIG_DNS_RESOLVER_CACHE */
 
 	k_mutex_lock(&ctx->lock, K_FOREVER);
@@ -1573,6 +1666,18 @@ fail:
 	return ret;
 }
 
+int dns_resolve_name(struct dns_resolve_context *ctx,
+		     const char *query,
+		     enum dns_query_type type,
+		     uint16_t *dns_id,
+		     dns_resolve_cb_t cb,
+		     void *user_data,
+		     int32_t timeout)
+{
+	return dns_resolve_name_internal(ctx, query, type, dns_id, cb,
+					 user_data, timeout, true);
+}
+
 /* Must be invoked with context lock held */
 static int dns_resolve_close_locked(struct dns_resolve_context *ctx)
 {
@@ -10,6 +10,8 @@
 
 #include <stdbool.h>
 
+#include <zephyr/sys/dlist.h>
+
 #include <zephyr/net/http/server.h>
 #include <zephyr/net/http/service.h>
 #include <zephyr/net/http/status.h>
@@ -36,6 +38,11 @@ int enter_http1_request(struct http_client_ctx *client);
 int enter_http2_request(struct http_client_ctx *client);
 int enter_http_done_state(struct http_client_ctx *client);
 
+/* HTTP2 send scheduling */
+int http2_send_pending(struct http_client_ctx *client);
+bool http2_send_ready(struct http_client_ctx *client);
+void http2_release_streams(struct http_client_ctx *client);
+
 /* Others */
 struct http_resource_detail *get_resource_detail(const struct http_service_desc *service,
 						 const char *path, int *len, bool is_ws);
@@ -44,9 +51,30 @@ void http_server_get_content_type_from_extension(char *url, char *content_type,
 						 size_t content_type_size);
 int http_server_find_file(char *fname, size_t fname_size, size_t *file_size, bool *gzipped);
 void http_client_timer_restart(struct http_client_ctx *client);
+int http_server_dynamic_resource_acquire(struct http_resource_detail_dynamic *dynamic_detail,
+					 struct http_client_ctx *client);
 bool http_response_is_final(struct http_response_ctx *rsp, enum http_data_status status);
 bool http_response_is_provided(struct http_response_ctx *rsp);
 
+struct fs_file_t;
+int http_server_sendfile(struct http_client_ctx *client, struct fs_file_t *file, size_t len);
+
+/* Static file system resource cache */
+struct http_fs_cache_entry {
+	sys_dnode_t node;
+	k_timepoint_t expiry;
+	char *fname;
+	/* Complete HTTP/1 response, headers followed by the file content */
+	uint8_t *response;
+	size_t response_len;
+	uint32_t etag;
+	uint16_t refcount;
+};
+
+int http_server_fs_cache_get(const char *fname, const char *content_type,
+			     struct http_fs_cache_entry **entry);
+void http_server_fs_cache_put(struct http_fs_cache_entry *entry);
+
 /* TODO Could be static, but currently used in tests. */
 int parse_http_frame_header(struct http_client_ctx *client, const uint8_t *buffer,
 			    size_t buflen);
@@ -535,13 +535,12 @@ static int hpack_string_encode(uint8_t *buf, size_t buflen,
 }
 
 static int hpack_encode_literal(uint8_t *buf, size_t buflen,
-				struct http_hpack_header_buf *header)
+				struct http_hpack_header_buf *header,
+				uint8_t prefix, uint8_t n)
 {
 	int ret, len = 0;
 
-	ret = hpack_integer_encode(buf, buflen, 0,
-				   HPACK_PREFIX_LITERAL_NEVER_INDEXED,
-				   HPACK_PREFIX_LEN_LITERAL_NEVER_INDEXED);
+	ret = hpack_integer_encode(buf, buflen, 0, prefix, n);
 	if (ret < 0) {
 		return ret;
 	}
@@ -570,13 +569,12 @@ static int hpack_encode_literal(uint8_t *buf, size_t buflen,
 }
 
 static int hpack_encode_literal_value(uint8_t *buf, size_t buflen, int index,
-				      struct http_hpack_header_buf *header)
+				      struct http_hpack_header_buf *header,
+				      uint8_t prefix, uint8_t n)
 {
 	int ret, len = 0;
 
-	ret = hpack_integer_encode(buf, buflen, index,
-				   HPACK_PREFIX_LITERAL_NEVER_INDEXED,
-				   HPACK_PREFIX_LEN_LITERAL_NEVER_INDEXED);
+	ret = hpack_integer_encode(buf, buflen, index, prefix, n);
 	if (ret < 0) {
 		return ret;
 	}
@@ -620,10 +618,14 @@ int http_hpack_encode_header(uint8_t *buf, size_t buflen,
 	ret = http_hpack_find_index(header, &name_only);
 	if (ret < 0) {
 		/* All literal */
-		len = hpack_encode_literal(buf, buflen, header);
+		len = hpack_encode_literal(buf, buflen, header,
+					   HPACK_PREFIX_LITERAL_NEVER_INDEXED,
+					   HPACK_PREFIX_LEN_LITERAL_NEVER_INDEXED);
 	} else if (name_only) {
 		/* Literal value */
-		len = hpack_encode_literal_value(buf, buflen, ret, header);
+		len = hpack_encode_literal_value(buf, buflen, ret, header,
+						 HPACK_PREFIX_LITERAL_NEVER_INDEXED,
+						 HPACK_PREFIX_LEN_LITERAL_NEVER_INDEXED);
 	} else {
 		/* Indexed */
 		len = hpack_encode_indexed(buf, buflen, ret);
@@ -631,3 +633,230 @@ int http_hpack_encode_header(uint8_t *buf, size_t buflen,
 
 	return len;
 }
+
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+
+/* RFC7541, ch 4.1. */
+#define HPACK_ENTRY_OVERHEAD 32
+
+/* Entries are stored newest first as [name_len][value_len][name][value].
+ * The stored form is always smaller than the entry size defined by the RFC,
+ * so a buffer of the maximum table size can hold all entries.
+ */
+#define HPACK_ENTRY_HDR_LEN 2
+#define HPACK_ENTRY_MAX_STR_LEN UINT8_MAX
+
+static size_t hpack_table_entry_len(const uint8_t *entry)
+{
+	return HPACK_ENTRY_HDR_LEN + entry[0] + entry[1];
+}
+
+static void hpack_table_evict_last(struct http_hpack_encoder_table *table)
+{
+	uint16_t offset = 0;
+	size_t entry_len;
+
+	for (int i = 0; i < table->count - 1; i++) {
+		offset += hpack_table_entry_len(&table->data[offset]);
+	}
+
+	entry_len = hpack_table_entry_len(&table->data[offset]);
+
+	table->size -= entry_len - HPACK_ENTRY_HDR_LEN + HPACK_ENTRY_OVERHEAD;
+	table->used -= entry_len;
+	table->count--;
+}
+
+static void hpack_table_evict(struct http_hpack_encoder_table *table,
+			      size_t required)
+{
+	while (table->count > 0 && table->size + required > table->max_size) {
+		hpack_table_evict_last(table);
+	}
+}
+
+static bool hpack_table_insert(struct http_hpack_encoder_table *table,
+			       struct http_hpack_header_buf *header)
+{
+	size_t entry_size = header->name_len + header->value_len +
+			    HPACK_ENTRY_OVERHEAD;
+	size_t entry_len = HPACK_ENTRY_HDR_LEN + header->name_len +
+			   header->value_len;
+	uint8_t *entry = table->data;
+
+	if (header->name_len > HPACK_ENTRY_MAX_STR_LEN ||
+	    header->value_len > HPACK_ENTRY_MAX_STR_LEN ||
+	    entry_size > table->max_size) {
+		return false;
+	}
+
+	hpack_table_evict(table, entry_size);
+
+	memmove(entry + entry_len, entry, table->used);
+	entry[0] = header->name_len;
+	entry[1] = header->value_len;
+	memcpy(entry + HPACK_ENTRY_HDR_LEN, header->name, header->name_len);
+	memcpy(entry + HPACK_ENTRY_HDR_LEN + header->name_len, header->value,
+	       header->value_len);
+
+	table->used += entry_len;
+	table->size += entry_size;
+	table->count++;
+
+	return true;
+}
+
+static int hpack_table_find_index(struct http_hpack_encoder_table *table,
+				  struct http_hpack_header_buf *header,
+				  bool *name_only)
+{
+	const uint8_t *entry = table->data;
+	int candidate = -1;
+
+	for (int i = 0; i < table->count; i++) {
+		const uint8_t *name = entry + HPACK_ENTRY_HDR_LEN;
+		const uint8_t *value = name + entry[0];
+
+		if (entry[0] == header->name_len &&
+		    memcmp(name, header->name, header->name_len) == 0) {
+			if (entry[1] == header->value_len &&
+			    memcmp(value, header->value, header->value_len) == 0) {
+				*name_only = false;
+				return HTTP_SERVER_HPACK_WWW_AUTHENTICATE + 1 + i;
+			}
+
+			if (candidate < 0) {
+				candidate = HTTP_SERVER_HPACK_WWW_AUTHENTICATE + 1 + i;
+			}
+		}
+
+		entry += hpack_table_entry_len(entry);
+	}
+
+	if (candidate > 0) {
+		*name_only = true;
+		return candidate;
+	}
+
+	return -ENOENT;
+}
+
+void http_hpack_encoder_table_init(struct http_hpack_encoder_table *table)
+{
+	memset(table, 0, sizeof(*table));
+	table->max_size = sizeof(table->data);
+
+	/* Let the peer know right away that a smaller table is used than the
+	 * default it has to assume.
+	 */
+	table->size_update = true;
+}
+
+void http_hpack_encoder_table_set_max_size(struct http_hpack_encoder_table *table,
+					   uint32_t max_size)
+{
+	max_size = MIN(max_size, sizeof(table->data));
+	if (max_size == table->max_size) {
+		return;
+	}
+
+	table->max_size = max_size;
+	table->size_update = true;
+	hpack_table_evict(table, 0);
+}
+
+int http_hpack_encode_header_table(uint8_t *buf, size_t buflen,
+				   struct http_hpack_header_buf *header,
+				   struct http_hpack_encoder_table *table)
+{
+	int ret, index, len = 0;
+	bool name_only = true;
+
+	if (table == NULL) {
+		return http_hpack_encode_header(buf, buflen, header);
+	}
+
+	if (buf == NULL || header == NULL ||
+	    header->name == NULL || header->name_len == 0 ||
+	    header->value == NULL || header->value_len == 0) {
+		return -EINVAL;
+	}
+
+	if (table->size_update) {
+		/* Size update must be at the beginning of a header block, the
+		 * first header encoded after the change is the first one in
+		 * the next block.
+		 */
+		ret = hpack_integer_encode(buf, buflen, table->max_size,
+					   HPACK_PREFIX_DYNAMIC_TABLE_SIZE_UPDATE,
+					   HPACK_PREFIX_LEN_DYNAMIC_TABLE_SIZE_UPDATE);
+		if (ret < 0) {
+			return ret;
+		}
+
+		buf += ret;
+		buflen -= ret;
+		len += ret;
+	}
+
+	index = http_hpack_find_index(header, &name_only);
+	if (index < 0 || name_only) {
+		bool dyn_name_only;
+		int dyn_index;
+
+		dyn_index = hpack_table_find_index(table, header, &dyn_name_only);
+		if (dyn_index > 0 && (!dyn_name_only || index < 0)) {
+			index = dyn_index;
+			name_only = dyn_name_only;
+		}
+	}
+
+	if (index > 0 && !name_only) {
+		ret = hpack_encode_indexed(buf, buflen, index);
+	} else if (header->name_len + header->value_len + HPACK_ENTRY_OVERHEAD >
+		   table->max_size ||
+		   header->name_len > HPACK_ENTRY_MAX_STR_LEN ||
+		   header->value_len > HPACK_ENTRY_MAX_STR_LEN) {
+		/* Would not fit into the table anyway */
+		if (index > 0) {
+			ret = hpack_encode_literal_value(
+				buf, buflen, index, header,
+				HPACK_PREFIX_LITERAL_NEVER_INDEXED,
+				HPACK_PREFIX_LEN_LITERAL_NEVER_INDEXED);
+		} else {
+			ret = hpack_encode_literal(
+				buf, buflen, header,
+				HPACK_PREFIX_LITERAL_NEVER_INDEXED,
+				HPACK_PREFIX_LEN_LITERAL_NEVER_INDEXED);
+		}
+	} else {
+		if (index > 0) {
+			ret = hpack_encode_literal_value(
+				buf, buflen, index, header,
+				HPACK_PREFIX_LITERAL_INDEXING,
+				HPACK_PREFIX_LEN_LITERAL_INDEXING);
+		} else {
+			ret = hpack_encode_literal(
+				buf, buflen, header,
+				HPACK_PREFIX_LITERAL_INDEXING,
+				HPACK_PREFIX_LEN_LITERAL_INDEXING);
+		}
+
+		/* Only update the table once the header was encoded, so that
+		 * both sides stay in sync on failure.
+		 */
+		if (ret >= 0) {
+			(void)hpack_table_insert(table, header);
+		}
+	}
+
+	if (ret < 0) {
+		return ret;
+	}
+
+	table->size_update = false;
+
+	return len + ret;
+}
+
+#endif /* CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE */
@@ -14,6 +14,7 @@
 
 #include <zephyr/fs/fs.h>
 #include <zephyr/fs/fs_interface.h>
+#include <zephyr/init.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/net/http/service.h>
@@ -40,7 +41,19 @@ LOG_MODULE_REGISTER(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
 
 #define HTTP_SERVER_MAX_SERVICES CONFIG_HTTP_SERVER_NUM_SERVICES
 #define HTTP_SERVER_MAX_CLIENTS  CONFIG_HTTP_SERVER_MAX_CLIENTS
+
+#if defined(CONFIG_HTTP_SERVER_WORKER_POOL)
+/* The accepted sockets are polled by the workers */
+#define HTTP_SERVER_SOCK_COUNT (1 + HTTP_SERVER_MAX_SERVICES)
+#define HTTP_SERVER_WORKERS CONFIG_HTTP_SERVER_NUM_WORKERS
+#define HTTP_SERVER_WORKER_MAX_CLIENTS \
+	DIV_ROUND_UP(HTTP_SERVER_MAX_CLIENTS, HTTP_SERVER_WORKERS)
+
+BUILD_ASSERT(HTTP_SERVER_WORKERS <= HTTP_SERVER_MAX_CLIENTS,
+	     "Each HTTP server worker needs at least one client slot");
+#else
 #define HTTP_SERVER_SOCK_COUNT (1 + HTTP_SERVER_MAX_SERVICES + HTTP_SERVER_MAX_CLIENTS)
+#endif
 
 struct http_server_ctx {
 	int num_clients;
@@ -55,6 +68,47 @@ struct http_server_ctx {
 };
 
 static struct http_server_ctx server_ctx;
+
+#if defined(CONFIG_HTTP_SERVER_WORKER_POOL)
+/* Accepted socket handed over to a worker */
+struct http_worker_msg {
+	const struct http_service_desc *service;
+	int fd;
+};
+
+/* Event loop thread serving its own share of the clients */
+struct http_server_worker {
+	/* First pollfd is an eventfd used to wake up the worker,
+	 * then we have the sockets of the clients of the worker.
+	 */
+	struct zsock_pollfd fds[1 + HTTP_SERVER_WORKER_MAX_CLIENTS];
+
+	/* Slice of server_ctx.clients served by this worker */
+	struct http_client_ctx *clients;
+	int max_clients;
+
+	/* Clients served or queued, read by the server thread to balance
+	 * the load between workers.
+	 */
+	atomic_t num_clients;
+
+	struct k_msgq new_clients;
+	struct http_worker_msg new_clients_buf[HTTP_SERVER_WORKER_MAX_CLIENTS];
+
+	/* Set by the server thread to close all the clients */
+	atomic_t stop;
+	struct k_sem stopped;
+
+	struct k_thread thread;
+};
+
+static struct http_server_worker workers[HTTP_SERVER_WORKERS];
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, HTTP_SERVER_WORKERS,
+				   CONFIG_HTTP_SERVER_WORKER_STACK_SIZE);
+
+/* Serializes the dynamic resource ownership checks of the workers */
+static struct k_spinlock resource_lock;
+#endif /* CONFIG_HTTP_SERVER_WORKER_POOL */
 static K_SEM_DEFINE(server_start, 0, 1);
 static bool server_running;
 
@@ -304,6 +358,17 @@ static void close_all_sockets(struct http_server_ctx *ctx)
 	HTTP_SERVICE_FOREACH(svc) {
 		*svc->fd = -1;
 	}
+
+#if defined(CONFIG_HTTP_SERVER_WORKER_POOL)
+	/* Let the workers close their clients, and wait for them so that
+	 * the client contexts can be reinitialized on restart.
+	 */
+	ARRAY_FOR_EACH_PTR(workers, worker) {
+		atomic_set(&worker->stop, 1);
+		eventfd_write(worker->fds[0].fd, 1);
+		k_sem_take(&worker->stopped, K_FOREVER);
+	}
+#endif
 }
 
 static void client_release_resources(struct http_client_ctx *client)
@@ -347,14 +412,27 @@ static void client_release_resources(struct http_client_ctx *client)
 
 void http_server_release_client(struct http_client_ctx *client)
 {
-	int i;
+	__maybe_unused int i;
 	struct k_work_sync sync;
 
 	__ASSERT_NO_MSG(IS_ARRAY_ELEMENT(server_ctx.clients, client));
 
 	k_work_cancel_delayable_sync(&client->inactivity_timer, &sync);
 	client_release_resources(client);
+	http2_release_streams(client);
+
+#if defined(CONFIG_HTTP_SERVER_WORKER_POOL)
+	ARRAY_FOR_EACH_PTR(workers, worker) {
+		if (client < worker->clients ||
+		    client >= worker->clients + worker->max_clients) {
+			continue;
+		}
 
+		atomic_dec(&worker->num_clients);
+		worker->fds[1 + (client - worker->clients)].fd = INVALID_SOCK;
+		break;
+	}
+#else
 	server_ctx.num_clients--;
 
 	for (i = server_ctx.listen_fds; i < ARRAY_SIZE(server_ctx.fds); i++) {
@@ -363,6 +441,7 @@ void http_server_release_client(struct http_client_ctx *client)
 			break;
 		}
 	}
+#endif
 
 	memset(client, 0, sizeof(struct http_client_ctx));
 	client->fd = INVALID_SOCK;
@@ -419,6 +498,13 @@ static void init_client_ctx(struct http_client_ctx *client, const struct http_se
 	client->has_upgrade_header = false;
 	client->preface_sent = false;
 	client->window_size = HTTP_SERVER_INITIAL_WINDOW_SIZE;
+	client->send_window = HTTP2_DEFAULT_WINDOW_SIZE;
+	client->peer_initial_window = HTTP2_DEFAULT_WINDOW_SIZE;
+	client->peer_max_frame_size = HTTP2_DEFAULT_MAX_FRAME_SIZE;
+
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+	http_hpack_encoder_table_init(&client->hpack_table);
+#endif
 
 	memset(client->buffer, 0, sizeof(client->buffer));
 	memset(client->url_buffer, 0, sizeof(client->url_buffer));
@@ -428,6 +514,8 @@ static void init_client_ctx(struct http_client_ctx *client, const struct http_se
 	ARRAY_FOR_EACH(client->streams, i) {
 		client->streams[i].stream_state = HTTP2_STREAM_IDLE;
 		client->streams[i].stream_id = 0;
+		client->streams[i].tx_pending = false;
+		client->streams[i].tx_file_open = false;
 	}
 
 	client->current_stream = NULL;
@@ -538,14 +626,318 @@ static int handle_http_request(struct http_client_ctx *client)
 	return 0;
 }
 
+/* Read and process the data received from a client. Returns a negative value
+ * if the connection was closed.
+ */
+static int handle_client_input(struct http_client_ctx *client)
+{
+	int ret;
+
+	ret = zsock_recv(client->fd, client->buffer + client->data_len,
+			 sizeof(client->buffer) - client->data_len, 0);
+	if (ret <= 0) {
+		if (ret == 0) {
+			LOG_DBG("Connection closed by peer for client %p", client);
+		} else {
+			ret = -errno;
+			LOG_DBG("ERROR reading from socket (%d)", ret);
+		}
+
+		close_client_connection(client);
+		return -ENOTCONN;
+	}
+
+	client->data_len += ret;
+
+	http_client_timer_restart(client);
+
+	ret = handle_http_request(client);
+	if (ret < 0 && ret != -EAGAIN) {
+		if (ret == -ENOTCONN) {
+			LOG_DBG("Client closed connection while handling request");
+		} else {
+			LOG_ERR("HTTP request handling error (%d)", ret);
+		}
+		close_client_connection(client);
+		return -ENOTCONN;
+	} else if (client->data_len == sizeof(client->buffer)) {
+		/* If the RX buffer is still full after parsing,
+		 * it means we won't be able to handle this request
+		 * with the current buffer size.
+		 */
+		LOG_ERR("RX buffer too small to handle request");
+		close_client_connection(client);
+		return -ENOTCONN;
+	}
+
+	return 0;
+}
+
+/* Handle the poll events of a client socket */
+static void handle_client_event(struct http_client_ctx *client, struct zsock_pollfd *pfd)
+{
+	int sock_error;
+	socklen_t optlen = sizeof(int);
+	int ret;
+
+	if (pfd->revents & ZSOCK_POLLHUP) {
+		LOG_DBG("Client %p has disconnected", client);
+		close_client_connection(client);
+		return;
+	}
+
+	if (pfd->revents & ZSOCK_POLLERR) {
+		(void)zsock_getsockopt(client->fd, SOL_SOCKET, SO_ERROR, &sock_error, &optlen);
+		LOG_DBG("Error on fd %d %d", client->fd, sock_error);
+
+		close_client_connection(client);
+		return;
+	}
+
+	if (pfd->revents & ZSOCK_POLLOUT) {
+		/* Next round of the HTTP/2 streams waiting to be sent */
+		ret = http2_send_pending(client);
+		if (ret < 0) {
+			LOG_DBG("Cannot send pending data (%d)", ret);
+			close_client_connection(client);
+			return;
+		}
+
+		http_client_timer_restart(client);
+	}
+
+	if ((pfd->revents & ZSOCK_POLLIN) && handle_client_input(client) < 0) {
+		return;
+	}
+
+	/* Only wait for the socket to become writable when some stream has
+	 * data queued and the peer windows allow sending it.
+	 */
+	pfd->events = ZSOCK_POLLIN | (http2_send_ready(client) ? ZSOCK_POLLOUT : 0);
+}
+
+#if defined(CONFIG_HTTP_SERVER_WORKER_POOL)
+/* Hand over an accepted socket to the least loaded worker. Workers with the
+ * same load are picked in turn, so that new connections are spread evenly.
+ */
+static int dispatch_client(const struct http_service_desc *service, int new_socket)
+{
+	static int next_worker;
+	struct http_server_worker *worker = NULL;
+	struct http_worker_msg msg = {
+		.service = service,
+		.fd = new_socket,
+	};
+
+	for (int i = 0; i < HTTP_SERVER_WORKERS; i++) {
+		struct http_server_worker *candidate =
+			&workers[(next_worker + i) % HTTP_SERVER_WORKERS];
+		atomic_val_t load = atomic_get(&candidate->num_clients);
+
+		if (load >= candidate->max_clients) {
+			continue;
+		}
+
+		if (worker == NULL || load < atomic_get(&worker->num_clients)) {
+			worker = candidate;
+		}
+	}
+
+	if (worker == NULL) {
+		return -ENOMEM;
+	}
+
+	next_worker = (ARRAY_INDEX(workers, worker) + 1) % HTTP_SERVER_WORKERS;
+
+	atomic_inc(&worker->num_clients);
+
+	if (k_msgq_put(&worker->new_clients, &msg, K_NO_WAIT) < 0) {
+		atomic_dec(&worker->num_clients);
+		return -ENOMEM;
+	}
+
+	eventfd_write(worker->fds[0].fd, 1);
+
+	return 0;
+}
+
+static void worker_add_clients(struct http_server_worker *worker)
+{
+	struct http_worker_msg msg;
+	bool found_slot;
+
+	while (k_msgq_get(&worker->new_clients, &msg, K_NO_WAIT) == 0) {
+		found_slot = false;
+
+		for (int j = 1; j <= worker->max_clients; j++) {
+			if (worker->fds[j].fd != INVALID_SOCK) {
+				continue;
+			}
+
+			worker->fds[j].fd = msg.fd;
+			worker->fds[j].events = ZSOCK_POLLIN;
+			worker->fds[j].revents = 0;
+
+			LOG_DBG("Worker %d: init client #%d", ARRAY_INDEX(workers, worker), j - 1);
+
+			init_client_ctx(&worker->clients[j - 1], msg.service, msg.fd);
+			found_slot = true;
+			break;
+		}
+
+		if (!found_slot) {
+			LOG_DBG("No free slot found.");
+			atomic_dec(&worker->num_clients);
+			zsock_close(msg.fd);
+		}
+	}
+}
+
+static void worker_close_clients(struct http_server_worker *worker)
+{
+	for (int j = 1; j <= worker->max_clients; j++) {
+		if (worker->fds[j].fd < 0) {
+			continue;
+		}
+
+		close_client_connection(&worker->clients[j - 1]);
+	}
+}
+
+static void http_server_worker_thread(void *p1, void *p2, void *p3)
+{
+	struct http_server_worker *worker = p1;
+	eventfd_t value;
+	int ret;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		ret = zsock_poll(worker->fds, 1 + worker->max_clients, -1);
+		if (ret < 0) {
+			LOG_ERR("Worker %d: poll failed (%d)", ARRAY_INDEX(workers, worker), -errno);
+			k_sleep(K_MSEC(CONFIG_HTTP_SERVER_RESTART_DELAY));
+			continue;
+		}
+
+		if (worker->fds[0].revents) {
+			eventfd_read(worker->fds[0].fd, &value);
+
+			worker_add_clients(worker);
+
+			if (atomic_cas(&worker->stop, 1, 0)) {
+				worker_close_clients(worker);
+				k_sem_give(&worker->stopped);
+				continue;
+			}
+		}
+
+		for (int j = 1; j <= worker->max_clients; j++) {
+			if (worker->fds[j].fd < 0 || worker->fds[j].revents == 0) {
+				continue;
+			}
+
+			handle_client_event(&worker->clients[j - 1], &worker->fds[j]);
+		}
+	}
+}
+
+static int http_server_workers_init(void)
+{
+	int first = 0;
+	int fd;
+
+	ARRAY_FOR_EACH(workers, i) {
+		struct http_server_worker *worker = &workers[i];
+		k_tid_t tid;
+
+		/* Share the clients as evenly as possible */
+		worker->clients = &server_ctx.clients[first];
+		worker->max_clients = HTTP_SERVER_MAX_CLIENTS / HTTP_SERVER_WORKERS +
+				      (i < HTTP_SERVER_MAX_CLIENTS % HTTP_SERVER_WORKERS ? 1 : 0);
+		first += worker->max_clients;
+
+		fd = eventfd(0, 0);
+		if (fd < 0) {
+			fd = -errno;
+			LOG_ERR("eventfd failed (%d)", fd);
+			return fd;
+		}
+
+		worker->fds[0].fd = fd;
+		worker->fds[0].events = ZSOCK_POLLIN;
+
+		for (int j = 1; j < ARRAY_SIZE(worker->fds); j++) {
+			worker->fds[j].fd = INVALID_SOCK;
+		}
+
+		atomic_set(&worker->num_clients, 0);
+		atomic_set(&worker->stop, 0);
+		k_sem_init(&worker->stopped, 0, 1);
+		k_msgq_init(&worker->new_clients, (char *)worker->new_clients_buf,
+			    sizeof(struct http_worker_msg), ARRAY_SIZE(worker->new_clients_buf));
+
+		tid = k_thread_create(&worker->thread, worker_stacks[i],
+				      K_THREAD_STACK_SIZEOF(worker_stacks[i]),
+				      http_server_worker_thread, worker, NULL, NULL,
+				      THREAD_PRIORITY, 0, K_FOREVER);
+
+		if (IS_ENABLED(CONFIG_THREAD_NAME)) {
+			char name[sizeof("http_worker_xx")];
+
+			snprintk(name, sizeof(name), "http_worker_%d", (int)i);
+			k_thread_name_set(tid, name);
+		}
+
+#if defined(CONFIG_HTTP_SERVER_WORKER_CPU_PIN)
+		(void)k_thread_cpu_pin(tid, i % arch_num_cpus());
+#endif
+
+		k_thread_start(tid);
+	}
+
+	return 0;
+}
+
+int http_server_dynamic_resource_acquire(struct http_resource_detail_dynamic *dynamic_detail,
+					 struct http_client_ctx *client)
+{
+	k_spinlock_key_t key = k_spin_lock(&resource_lock);
+	int ret = 0;
+
+	if (dynamic_detail->holder != NULL && dynamic_detail->holder != client) {
+		ret = -EBUSY;
+	} else {
+		dynamic_detail->holder = client;
+	}
+
+	k_spin_unlock(&resource_lock, key);
+
+	return ret;
+}
+#else
+int http_server_dynamic_resource_acquire(struct http_resource_detail_dynamic *dynamic_detail,
+					 struct http_client_ctx *client)
+{
+	if (dynamic_detail->holder != NULL && dynamic_detail->holder != client) {
+		return -EBUSY;
+	}
+
+	dynamic_detail->holder = client;
+
+	return 0;
+}
+#endif /* CONFIG_HTTP_SERVER_WORKER_POOL */
+
 static int http_server_run(struct http_server_ctx *ctx)
 {
-	struct http_client_ctx *client;
 	const struct http_service_desc *service;
 	eventfd_t value;
-	bool found_slot;
+	__maybe_unused bool found_slot;
 	int new_socket;
-	int ret, i, j;
+	int ret, i;
+	__maybe_unused int j;
 	int sock_error;
 	socklen_t optlen = sizeof(int);
 
@@ -576,29 +968,25 @@ static int http_server_run(struct http_server_ctx *ctx)
 				continue;
 			}
 
-			if (ctx->fds[i].revents & ZSOCK_POLLHUP) {
-				if (i >= ctx->listen_fds) {
-					LOG_DBG("Client #%d has disconnected",
-						i - ctx->listen_fds);
-
-					client = &ctx->clients[i - ctx->listen_fds];
-					close_client_connection(client);
+			/* Client sock */
+			if (i >= ctx->listen_fds) {
+				if (ctx->fds[i].revents != 0) {
+					handle_client_event(&ctx->clients[i - ctx->listen_fds],
+							    &ctx->fds[i]);
 				}
 
 				continue;
 			}
 
+			if (ctx->fds[i].revents & ZSOCK_POLLHUP) {
+				continue;
+			}
+
 			if (ctx->fds[i].revents & ZSOCK_POLLERR) {
 				(void)zsock_getsockopt(ctx->fds[i].fd, SOL_SOCKET,
 						       SO_ERROR, &sock_error, &optlen);
 				LOG_DBG("Error on fd %d %d", ctx->fds[i].fd, sock_error);
 
-				if (i >= ctx->listen_fds) {
-					client = &ctx->clients[i - ctx->listen_fds];
-					close_client_connection(client);
-					continue;
-				}
-
 				/* Listening socket error, abort. */
 				LOG_ERR("Listening socket error, aborting.");
 				ret = -sock_error;
@@ -610,85 +998,49 @@ static int http_server_run(struct http_server_ctx *ctx)
 				continue;
 			}
 
-			/* First check if we have something to accept */
-			if (i < ctx->listen_fds) {
-				new_socket = accept_new_client(ctx->fds[i].fd);
-				if (new_socket < 0) {
-					ret = -errno;
-					LOG_DBG("accept: %d", ret);
-					continue;
-				}
-
-				service = lookup_service(ctx->fds[i].fd);
-				__ASSERT(NULL != service, "fd not associated with a service");
-
-				found_slot = false;
-
-				for (j = ctx->listen_fds; j < ARRAY_SIZE(ctx->fds); j++) {
-					if (ctx->fds[j].fd != INVALID_SOCK) {
-						continue;
-					}
-
-					ctx->fds[j].fd = new_socket;
-					ctx->fds[j].events = ZSOCK_POLLIN;
-					ctx->fds[j].revents = 0;
+			/* Accept the new client */
+			new_socket = accept_new_client(ctx->fds[i].fd);
+			if (new_socket < 0) {
+				ret = -errno;
+				LOG_DBG("accept: %d", ret);
+				continue;
+			}
 
-					ctx->num_clients++;
+			service = lookup_service(ctx->fds[i].fd);
+			__ASSERT(NULL != service, "fd not associated with a service");
 
-					LOG_DBG("Init client #%d", j - ctx->listen_fds);
+#if defined(CONFIG_HTTP_SERVER_WORKER_POOL)
+			if (dispatch_client(service, new_socket) < 0) {
+				LOG_DBG("No free slot found.");
+				zsock_close(new_socket);
+			}
+#else
+			found_slot = false;
 
-					init_client_ctx(&ctx->clients[j - ctx->listen_fds], service,
-							new_socket);
-					found_slot = true;
-					break;
+			for (j = ctx->listen_fds; j < ARRAY_SIZE(ctx->fds); j++) {
+				if (ctx->fds[j].fd != INVALID_SOCK) {
+					continue;
 				}
 
-				if (!found_slot) {
-					LOG_DBG("No free slot found.");
-					zsock_close(new_socket);
-				}
+				ctx->fds[j].fd = new_socket;
+				ctx->fds[j].events = ZSOCK_POLLIN;
+				ctx->fds[j].revents = 0;
 
-				continue;
-			}
+				ctx->num_clients++;
 
-			/* Client sock */
-			client = &ctx->clients[i - ctx->listen_fds];
-
-			ret = zsock_recv(client->fd, client->buffer + client->data_len,
-					 sizeof(client->buffer) - client->data_len, 0);
-			if (ret <= 0) {
-				if (ret == 0) {
-					LOG_DBG("Connection closed by peer for client #%d",
-						i - ctx->listen_fds);
-				} else {
-					ret = -errno;
-					LOG_DBG("ERROR reading from socket (%d)", ret);
-				}
+				LOG_DBG("Init client #%d", j - ctx->listen_fds);
 
-				close_client_connection(client);
-				continue;
+				init_client_ctx(&ctx->clients[j - ctx->listen_fds], service,
+						new_socket);
+				found_slot = true;
+				break;
 			}
 
-			client->data_len += ret;
-
-			http_client_timer_restart(client);
-
-			ret = handle_http_request(client);
-			if (ret < 0 && ret != -EAGAIN) {
-				if (ret == -ENOTCONN) {
-					LOG_DBG("Client closed connection while handling request");
-				} else {
-					LOG_ERR("HTTP request handling error (%d)", ret);
-				}
-				close_client_connection(client);
-			} else if (client->data_len == sizeof(client->buffer)) {
-				/* If the RX buffer is still full after parsing,
-				 * it means we won't be able to handle this request
-				 * with the current buffer size.
-				 */
-				LOG_ERR("RX buffer too small to handle request");
-				close_client_connection(client);
+			if (!found_slot) {
+				LOG_DBG("No free slot found.");
+				zsock_close(new_socket);
 			}
+#endif /* CONFIG_HTTP_SERVER_WORKER_POOL */
 		}
 	}
 
@@ -749,9 +1101,266 @@ static bool skip_this(struct http_resource_desc *resource, bool is_websocket)
 	return false;
 }
 
-struct http_resource_detail *get_resource_detail(const struct http_service_desc *service,
-						 const char *path, int *path_len, bool is_websocket)
+#if defined(CONFIG_HTTP_SERVER_RESOURCE_TRIE)
+/* The resources of each service are routed with a trie of path segments, a segment being the
+ * characters up to the next '/', '?' or end of string. The root nodes are allocated first, in
+ * service section order, so the root of a service is found from its section index. Wildcard
+ * resources hang in a list from the node of their literal directory prefix and are only matched
+ * against paths walking through that node.
+ */
+#define ROUTE_NONE      UINT16_MAX
+#define ROUTE_WILDCARDS "*?[\\"
+
+struct http_route_node {
+	const char *seg;
+	uint16_t seg_len;
+	uint16_t child;
+	/* Next sibling, or next entry of a wildcard list */
+	uint16_t next;
+	/* First wildcard entry attached to this node */
+	uint16_t wildcard;
+	/* Lowest index of the literal resources ending at this node, for regular and websocket
+	 * resources. Wildcard entries store their resource index in res[0].
+	 */
+	uint16_t res[2];
+};
+
+STRUCT_SECTION_START_EXTERN(http_service_desc);
+
+static struct http_route_node route_nodes[CONFIG_HTTP_SERVER_RESOURCE_TRIE_NODES];
+static size_t route_node_count;
+static bool route_ready;
+
+static size_t route_seg_len(const char *str)
+{
+	size_t len;
+
+	if (*str == '\0' || *str == '?') {
+		return 0;
+	}
+
+	for (len = 1; str[len] != '\0' && str[len] != '/' && str[len] != '?'; len++) {
+	}
+
+	return len;
+}
+
+static uint16_t route_node_alloc(void)
+{
+	struct http_route_node *node;
+
+	if (route_node_count >= ARRAY_SIZE(route_nodes)) {
+		return ROUTE_NONE;
+	}
+
+	node = &route_nodes[route_node_count];
+	node->seg = NULL;
+	node->seg_len = 0;
+	node->child = ROUTE_NONE;
+	node->next = ROUTE_NONE;
+	node->wildcard = ROUTE_NONE;
+	node->res[0] = ROUTE_NONE;
+	node->res[1] = ROUTE_NONE;
+
+	return route_node_count++;
+}
+
+static uint16_t route_find_child(uint16_t parent, const char *seg, size_t len)
+{
+	uint16_t i;
+
+	for (i = route_nodes[parent].child; i != ROUTE_NONE; i = route_nodes[i].next) {
+		if (route_nodes[i].seg_len == len && memcmp(route_nodes[i].seg, seg, len) == 0) {
+			break;
+		}
+	}
+
+	return i;
+}
+
+/* Walk down the complete segments found in the first limit characters of str, adding the
+ * missing nodes. A segment is complete when it is followed by '/' or the end of the string.
+ */
+static uint16_t route_insert_path(uint16_t node, const char *str, size_t limit)
+{
+	size_t len;
+
+	while ((len = route_seg_len(str)) > 0 && len <= limit &&
+	       (str[len] == '/' || str[len] == '\0')) {
+		uint16_t child = route_find_child(node, str, len);
+
+		if (child == ROUTE_NONE) {
+			child = route_node_alloc();
+			if (child == ROUTE_NONE) {
+				return ROUTE_NONE;
+			}
+
+			route_nodes[child].seg = str;
+			route_nodes[child].seg_len = len;
+			route_nodes[child].next = route_nodes[node].child;
+			route_nodes[node].child = child;
+		}
+
+		node = child;
+		str += len;
+		limit -= len;
+	}
+
+	return node;
+}
+
+static int route_insert(uint16_t root, const struct http_resource_desc *resource, uint16_t idx)
 {
+	const struct http_resource_detail *detail = resource->detail;
+	const char *str = resource->resource;
+	bool is_websocket = (detail->type == HTTP_RESOURCE_TYPE_WEBSOCKET);
+	uint16_t node, entry, *tail;
+
+	if (!IS_ENABLED(CONFIG_HTTP_SERVER_RESOURCE_WILDCARD) ||
+	    strpbrk(str, ROUTE_WILDCARDS) == NULL) {
+		/* Without wildcards the request path is compared up to its query, so a
+		 * resource containing '?' can never match.
+		 */
+		if (strchr(str, '?') != NULL) {
+			return 0;
+		}
+
+		node = route_insert_path(root, str, strlen(str));
+		if (node == ROUTE_NONE) {
+			return -ENOMEM;
+		}
+
+		if (route_nodes[node].res[is_websocket] == ROUTE_NONE) {
+			route_nodes[node].res[is_websocket] = idx;
+		}
+
+		return 0;
+	}
+
+	node = route_insert_path(root, str, strcspn(str, ROUTE_WILDCARDS));
+	if (node == ROUTE_NONE) {
+		return -ENOMEM;
+	}
+
+	entry = route_node_alloc();
+	if (entry == ROUTE_NONE) {
+		return -ENOMEM;
+	}
+
+	route_nodes[entry].res[0] = idx;
+
+	/* Keep the list in definition order */
+	for (tail = &route_nodes[node].wildcard; *tail != ROUTE_NONE;
+	     tail = &route_nodes[*tail].next) {
+	}
+
+	*tail = entry;
+
+	return 0;
+}
+
+static int http_server_routes_init(void)
+{
+	int svc_count;
+
+	HTTP_SERVICE_COUNT(&svc_count);
+
+	for (int i = 0; i < svc_count; i++) {
+		if (route_node_alloc() == ROUTE_NONE) {
+			goto fail;
+		}
+	}
+
+	HTTP_SERVICE_FOREACH(svc) {
+		uint16_t root = svc - STRUCT_SECTION_START(http_service_desc);
+
+		HTTP_SERVICE_FOREACH_RESOURCE(svc, resource) {
+			if (route_insert(root, resource, resource - svc->res_begin) < 0) {
+				goto fail;
+			}
+		}
+	}
+
+	LOG_DBG("Resource trie uses %zu nodes", route_node_count);
+	route_ready = true;
+
+	return 0;
+
+fail:
+	LOG_WRN("Resource trie needs more than %d nodes, using linear lookup",
+		CONFIG_HTTP_SERVER_RESOURCE_TRIE_NODES);
+
+	return 0;
+}
+
+SYS_INIT(http_server_routes_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+
+static struct http_resource_desc *route_lookup(const struct http_service_desc *service,
+					       const char *path, bool is_websocket)
+{
+	uint16_t node = service - STRUCT_SECTION_START(http_service_desc);
+	uint16_t best = ROUTE_NONE;
+	const char *rest = path;
+	size_t len;
+
+	/* Resources may match in any trie node along the path, the first one defined wins */
+	while (true) {
+		const struct http_route_node *n = &route_nodes[node];
+
+		/* With wildcards enabled, a literal resource also matches the leading directory
+		 * of the path.
+		 */
+		if (n->res[is_websocket] < best &&
+		    (*rest == '\0' || *rest == '?' ||
+		     (IS_ENABLED(CONFIG_HTTP_SERVER_RESOURCE_WILDCARD) && *rest == '/'))) {
+			best = n->res[is_websocket];
+		}
+
+		for (uint16_t i = n->wildcard; i != ROUTE_NONE; i = route_nodes[i].next) {
+			struct http_resource_desc *resource;
+
+			if (route_nodes[i].res[0] >= best) {
+				break;
+			}
+
+			resource = &service->res_begin[route_nodes[i].res[0]];
+			if (skip_this(resource, is_websocket)) {
+				continue;
+			}
+
+			if (fnmatch(resource->resource, path, (FNM_PATHNAME | FNM_LEADING_DIR)) == 0 ||
+			    compare_strings(path, resource->resource) == 0) {
+				best = route_nodes[i].res[0];
+				break;
+			}
+		}
+
+		len = route_seg_len(rest);
+		if (len == 0) {
+			break;
+		}
+
+		node = route_find_child(node, rest, len);
+		if (node == ROUTE_NONE) {
+			break;
+		}
+
+		rest += len;
+	}
+
+	return best == ROUTE_NONE ? NULL : &service->res_begin[best];
+}
+#endif /* CONFIG_HTTP_SERVER_RESOURCE_TRIE */
+
+static struct http_resource_desc *find_resource(const struct http_service_desc *service,
+						const char *path, bool is_websocket)
+{
+#if defined(CONFIG_HTTP_SERVER_RESOURCE_TRIE)
+	if (route_ready) {
+		return route_lookup(service, path, is_websocket);
+	}
+#endif
+
 	HTTP_SERVICE_FOREACH_RESOURCE(service, resource) {
 		if (skip_this(resource, is_websocket)) {
 			continue;
@@ -762,19 +1371,31 @@ struct http_resource_detail *get_resource_detail(const struct http_service_desc
 
 			ret = fnmatch(resource->resource, path, (FNM_PATHNAME | FNM_LEADING_DIR));
 			if (ret == 0) {
-				*path_len = strlen(resource->resource);
-				return resource->detail;
+				return resource;
 			}
 		}
 
 		if (compare_strings(path, resource->resource) == 0) {
-			NET_DBG("Got match for %s", resource->resource);
-
-			*path_len = strlen(resource->resource);
-			return resource->detail;
+			return resource;
 		}
 	}
 
+	return NULL;
+}
+
+struct http_resource_detail *get_resource_detail(const struct http_service_desc *service,
+						 const char *path, int *path_len, bool is_websocket)
+{
+	struct http_resource_desc *resource;
+
+	resource = find_resource(service, path, is_websocket);
+	if (resource != NULL) {
+		NET_DBG("Got match for %s", resource->resource);
+
+		*path_len = strlen(resource->resource);
+		return resource->detail;
+	}
+
 	if (service->res_fallback != NULL) {
 		*path_len = path_len_without_query(path);
 		return service->res_fallback;
@@ -869,6 +1490,30 @@ bool http_response_is_provided(struct http_response_ctx *rsp)
 	return false;
 }
 
+#if defined(CONFIG_NET_SOCKETS_SENDFILE)
+int http_server_sendfile(struct http_client_ctx *client, struct fs_file_t *file, size_t len)
+{
+	while (len) {
+		ssize_t out_len = zsock_sendfile(client->fd, file, NULL, len);
+
+		if (out_len < 0) {
+			return -errno;
+		}
+
+		if (out_len == 0) {
+			/* The file was truncated */
+			return -EIO;
+		}
+
+		len -= out_len;
+
+		http_client_timer_restart(client);
+	}
+
+	return 0;
+}
+#endif /* CONFIG_NET_SOCKETS_SENDFILE */
+
 void populate_request_ctx(struct http_request_ctx *req_ctx, uint8_t *data, size_t len,
 			  struct http_header_capture_ctx *header_ctx)
 {
@@ -925,6 +1570,14 @@ static void http_server_thread(void *p1, void *p2, void *p3)
 	ARG_UNUSED(p2);
 	ARG_UNUSED(p3);
 
+#if defined(CONFIG_HTTP_SERVER_WORKER_POOL)
+	ret = http_server_workers_init();
+	if (ret < 0) {
+		LOG_ERR("Failed to start HTTP server workers (%d)", ret);
+		return;
+	}
+#endif
+
 	while (true) {
 		k_sem_take(&server_start, K_FOREVER);
 
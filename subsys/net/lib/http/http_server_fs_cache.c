@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <zephyr/fs/fs.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/net/http/server.h>
+#include <zephyr/sys/crc.h>
+#include <zephyr/sys/dlist.h>
+
+LOG_MODULE_DECLARE(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
+
+#include "headers/server_internal.h"
+
+#define CACHE_TTL CONFIG_HTTP_SERVER_STATIC_FS_CACHE_TTL
+#define CACHE_MAX_FILE_SIZE CONFIG_HTTP_SERVER_STATIC_FS_CACHE_MAX_FILE_SIZE
+
+#define RESPONSE_TEMPLATE_CACHED			\
+	"HTTP/1.1 200 OK\r\n"				\
+	"Content-Length: %zu\r\n"			\
+	"Content-Type: %s%s\r\n"			\
+	"ETag: \"%08x\"\r\n\r\n"
+#define CONTENT_ENCODING_GZIP "\r\nContent-Encoding: gzip"
+
+/* Each entry is a single heap block holding the entry, the file name and
+ * the complete response, so a cache hit is sent with a single call.
+ */
+K_HEAP_DEFINE(fs_cache_heap, CONFIG_HTTP_SERVER_STATIC_FS_CACHE_SIZE);
+static K_MUTEX_DEFINE(fs_cache_lock);
+
+/* Most recently used entry first */
+static sys_dlist_t fs_cache_list = SYS_DLIST_STATIC_INIT(&fs_cache_list);
+
+/* Entries that are still being sent are only unlinked, the last user frees
+ * them.
+ */
+static void fs_cache_remove(struct http_fs_cache_entry *entry)
+{
+	sys_dlist_remove(&entry->node);
+
+	if (entry->refcount == 0) {
+		k_heap_free(&fs_cache_heap, entry);
+	}
+}
+
+static void *fs_cache_alloc(size_t size)
+{
+	struct http_fs_cache_entry *victim;
+	sys_dnode_t *node;
+	void *mem;
+
+	while ((mem = k_heap_alloc(&fs_cache_heap, size, K_NO_WAIT)) == NULL) {
+		/* Evict the least recently used entry that is not in use */
+		victim = NULL;
+
+		for (node = sys_dlist_peek_tail(&fs_cache_list); node != NULL;
+		     node = sys_dlist_peek_prev(&fs_cache_list, node)) {
+			struct http_fs_cache_entry *entry =
+				CONTAINER_OF(node, struct http_fs_cache_entry, node);
+
+			if (entry->refcount == 0) {
+				victim = entry;
+				break;
+			}
+		}
+
+		if (victim == NULL) {
+			return NULL;
+		}
+
+		LOG_DBG("Evicting %s", victim->fname);
+		fs_cache_remove(victim);
+	}
+
+	return mem;
+}
+
+static int fs_cache_load(const char *fname, const char *content_type,
+			 struct http_fs_cache_entry **entry_out)
+{
+	struct http_fs_cache_entry *entry;
+	char path[HTTP_SERVER_MAX_URL_LENGTH];
+	char header[sizeof(RESPONSE_TEMPLATE_CACHED) + HTTP_SERVER_MAX_CONTENT_TYPE_LEN +
+		    sizeof("01234567890123456789") + sizeof(CONTENT_ENCODING_GZIP) +
+		    sizeof("01234567")];
+	struct fs_file_t file;
+	bool gzipped = false;
+	size_t fname_len;
+	size_t file_size;
+	uint8_t *body;
+	int header_len;
+	ssize_t len;
+	int ret;
+
+	strncpy(path, fname, sizeof(path) - 1);
+	path[sizeof(path) - 1] = '\0';
+
+	ret = http_server_find_file(path, sizeof(path), &file_size, &gzipped);
+	if (ret < 0) {
+		return -ENOENT;
+	}
+
+	if (file_size > CACHE_MAX_FILE_SIZE) {
+		return -EFBIG;
+	}
+
+	/* The ETag is printed with a fixed width, so the header length is
+	 * known before the content is read.
+	 */
+	header_len = snprintk(header, sizeof(header), RESPONSE_TEMPLATE_CACHED, file_size,
+			      content_type, gzipped ? CONTENT_ENCODING_GZIP : "", 0);
+	if (header_len < 0 || header_len >= (int)sizeof(header)) {
+		return -EINVAL;
+	}
+
+	fname_len = strlen(fname);
+
+	entry = fs_cache_alloc(sizeof(*entry) + fname_len + 1 + header_len + file_size);
+	if (entry == NULL) {
+		return -ENOSPC;
+	}
+
+	memset(entry, 0, sizeof(*entry));
+	entry->fname = (char *)(entry + 1);
+	entry->response = (uint8_t *)entry->fname + fname_len + 1;
+	entry->response_len = header_len + file_size;
+	memcpy(entry->fname, fname, fname_len + 1);
+	body = entry->response + header_len;
+
+	fs_file_t_init(&file);
+	ret = fs_open(&file, path, FS_O_READ);
+	if (ret < 0) {
+		LOG_ERR("fs_open %s: %d", path, ret);
+		goto fail;
+	}
+
+	for (size_t offset = 0; offset < file_size; offset += len) {
+		len = fs_read(&file, body + offset, file_size - offset);
+		if (len <= 0) {
+			LOG_ERR("Filesystem read error (%zd)", len);
+			ret = len < 0 ? len : -EIO;
+			fs_close(&file);
+			goto fail;
+		}
+	}
+
+	fs_close(&file);
+
+	entry->etag = crc32_ieee(body, file_size);
+
+	(void)snprintk(header, sizeof(header), RESPONSE_TEMPLATE_CACHED, file_size,
+		       content_type, gzipped ? CONTENT_ENCODING_GZIP : "", entry->etag);
+	memcpy(entry->response, header, header_len);
+
+	entry->expiry = sys_timepoint_calc(CACHE_TTL > 0 ? K_SECONDS(CACHE_TTL) : K_FOREVER);
+	entry->refcount = 1;
+	sys_dlist_prepend(&fs_cache_list, &entry->node);
+
+	LOG_DBG("Cached %s, %zu bytes, ETag %08x", path, file_size, entry->etag);
+
+	*entry_out = entry;
+
+	return 0;
+
+fail:
+	k_heap_free(&fs_cache_heap, entry);
+
+	return ret;
+}
+
+int http_server_fs_cache_get(const char *fname, const char *content_type,
+			     struct http_fs_cache_entry **entry)
+{
+	struct http_fs_cache_entry *it, *next;
+	int ret;
+
+	(void)k_mutex_lock(&fs_cache_lock, K_FOREVER);
+
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&fs_cache_list, it, next, node) {
+		if (strcmp(it->fname, fname) != 0) {
+			continue;
+		}
+
+		if (sys_timepoint_expired(it->expiry)) {
+			/* Reload the file in case it changed */
+			fs_cache_remove(it);
+			break;
+		}
+
+		sys_dlist_remove(&it->node);
+		sys_dlist_prepend(&fs_cache_list, &it->node);
+		it->refcount++;
+		*entry = it;
+
+		k_mutex_unlock(&fs_cache_lock);
+
+		return 0;
+	}
+
+	/* Loading the file with the lock held keeps concurrent requests for
+	 * the same file from reading it more than once.
+	 */
+	ret = fs_cache_load(fname, content_type, entry);
+
+	k_mutex_unlock(&fs_cache_lock);
+
+	return ret;
+}
+
+void http_server_fs_cache_put(struct http_fs_cache_entry *entry)
+{
+	(void)k_mutex_lock(&fs_cache_lock, K_FOREVER);
+
+	entry->refcount--;
+	if (entry->refcount == 0 && !sys_dnode_is_linked(&entry->node)) {
+		k_heap_free(&fs_cache_heap, entry);
+	}
+
+	k_mutex_unlock(&fs_cache_lock);
+}
+
+void http_server_static_fs_cache_flush(void)
+{
+	struct http_fs_cache_entry *it, *next;
+
+	(void)k_mutex_lock(&fs_cache_lock, K_FOREVER);
+
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&fs_cache_list, it, next, node) {
+		fs_cache_remove(it);
+	}
+
+	k_mutex_unlock(&fs_cache_lock);
+}
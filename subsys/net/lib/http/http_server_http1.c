@@ -465,6 +465,29 @@ static int dynamic_post_put_req(struct http_resource_detail_dynamic *dynamic_det
 
 #if defined(CONFIG_FILE_SYSTEM)
 
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS_CACHE)
+static int send_http1_cached_fs_resource(struct http_client_ctx *client,
+					 struct http_fs_cache_entry *entry)
+{
+	char http_response[sizeof("HTTP/1.1 304 Not Modified\r\nETag: \"01234567\"\r\n\r\n")];
+	int len;
+	int ret;
+
+	if (client->has_if_none_match && client->if_none_match == entry->etag) {
+		len = snprintk(http_response, sizeof(http_response),
+			       "HTTP/1.1 304 Not Modified\r\nETag: \"%08x\"\r\n\r\n",
+			       entry->etag);
+		ret = http_server_sendall(client, http_response, len);
+	} else {
+		ret = http_server_sendall(client, entry->response, entry->response_len);
+	}
+
+	client->http1_headers_sent = true;
+
+	return ret;
+}
+#endif
+
 int handle_http1_static_fs_resource(struct http_resource_detail_static_fs *static_fs_detail,
 				    struct http_client_ctx *client)
 {
@@ -476,10 +499,15 @@ int handle_http1_static_fs_resource(struct http_resource_detail_static_fs *stati
 
 	bool gzipped = false;
 	int len;
+#if !defined(CONFIG_NET_SOCKETS_SENDFILE)
 	int remaining;
+#endif
 	int ret;
 	size_t file_size;
 	struct fs_file_t file;
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS_CACHE)
+	struct http_fs_cache_entry *entry;
+#endif
 	char fname[HTTP_SERVER_MAX_URL_LENGTH];
 	char content_type[HTTP_SERVER_MAX_CONTENT_TYPE_LEN] = "text/html";
 	/* Add couple of bytes to response template size to have space
@@ -505,6 +533,21 @@ int handle_http1_static_fs_resource(struct http_resource_detail_static_fs *stati
 			 client->url_buffer);
 	}
 
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS_CACHE)
+	ret = http_server_fs_cache_get(fname, content_type, &entry);
+	if (ret == 0) {
+		ret = send_http1_cached_fs_resource(client, entry);
+		http_server_fs_cache_put(entry);
+
+		return ret;
+	} else if (ret == -ENOENT) {
+		LOG_ERR("fs_stat %s: %d", fname, ret);
+		return send_http1_404(client);
+	}
+
+	/* Not cacheable, send it from the file system */
+#endif
+
 	/* open file, if it exists */
 	ret = http_server_find_file(fname, sizeof(fname), &file_size, &gzipped);
 	if (ret < 0) {
@@ -532,6 +575,9 @@ int handle_http1_static_fs_resource(struct http_resource_detail_static_fs *stati
 
 	client->http1_headers_sent = true;
 
+#if defined(CONFIG_NET_SOCKETS_SENDFILE)
+	ret = http_server_sendfile(client, &file, file_size);
+#else
 	/* read and send file */
 	remaining = file_size;
 	while (remaining > 0) {
@@ -547,7 +593,7 @@ int handle_http1_static_fs_resource(struct http_resource_detail_static_fs *stati
 		}
 		remaining -= len;
 	}
-	ret = http_server_sendall(client, "\r\n\r\n", 4);
+#endif
 
 close:
 	/* close file */
@@ -574,7 +620,7 @@ static int handle_http1_dynamic_resource(
 		return send_http1_405(client);
 	}
 
-	if (dynamic_detail->holder != NULL && dynamic_detail->holder != client) {
+	if (http_server_dynamic_resource_acquire(dynamic_detail, client) < 0) {
 		ret = send_http1_409(client);
 		if (ret < 0) {
 			return ret;
@@ -583,8 +629,6 @@ static int handle_http1_dynamic_resource(
 		return enter_http_done_state(client);
 	}
 
-	dynamic_detail->holder = client;
-
 	switch (client->method) {
 	case HTTP_HEAD:
 		if (user_method & BIT(HTTP_HEAD)) {
@@ -697,6 +741,9 @@ static int on_header_field(struct http_parser *parser, const char *at,
 				ctx->has_upgrade_header = true;
 			} else if (strcasecmp(ctx->header_buffer, "Sec-WebSocket-Key") == 0) {
 				ctx->websocket_sec_key_next = true;
+			} else if (IS_ENABLED(CONFIG_HTTP_SERVER_STATIC_FS_CACHE) &&
+				   strcasecmp(ctx->header_buffer, "If-None-Match") == 0) {
+				ctx->if_none_match_next = true;
 			}
 
 			ctx->header_buffer[0] = '\0';
@@ -737,6 +784,23 @@ static void populate_user_request_header(struct http_header_capture_ctx *ctx, co
 	ctx->count++;
 }
 
+/* Only the first entity tag of the list is used, in the format generated by
+ * the static file system cache.
+ */
+static void parse_if_none_match(struct http_client_ctx *ctx, const char *value)
+{
+	const char *start = strchr(value, '"');
+	char *end;
+
+	if (start == NULL) {
+		return;
+	}
+
+	start++;
+	ctx->if_none_match = strtoul(start, &end, 16);
+	ctx->has_if_none_match = (*end == '"' && end - start == 8);
+}
+
 static int on_header_value(struct http_parser *parser,
 			   const char *at, size_t length)
 {
@@ -784,6 +848,11 @@ static int on_header_value(struct http_parser *parser,
 				ctx->websocket_sec_key_next = false;
 			}
 
+			if (ctx->if_none_match_next) {
+				parse_if_none_match(ctx, ctx->header_buffer);
+				ctx->if_none_match_next = false;
+			}
+
 			ctx->header_buffer[0] = '\0';
 		}
 	}
@@ -862,6 +931,8 @@ int enter_http1_request(struct http_client_ctx *client)
 	client->parser_settings.on_message_complete = on_message_complete;
 	client->parser_state = HTTP1_INIT_HEADER_STATE;
 	client->http1_headers_sent = false;
+	client->if_none_match_next = false;
+	client->has_if_none_match = false;
 
 	if (IS_ENABLED(CONFIG_HTTP_SERVER_CAPTURE_HEADERS)) {
 		client->header_capture_ctx.store_next_value = false;
@@ -86,6 +86,12 @@ static struct http2_stream_ctx *allocate_http_stream_context(
 				HTTP_SERVER_INITIAL_WINDOW_SIZE;
 			client->streams[i].headers_sent = false;
 			client->streams[i].end_stream_sent = false;
+			client->streams[i].send_window = client->peer_initial_window;
+			client->streams[i].weight = HTTP2_DEFAULT_WEIGHT;
+			client->streams[i].tx_data = NULL;
+			client->streams[i].tx_remaining = 0;
+			client->streams[i].tx_file_open = false;
+			client->streams[i].tx_pending = false;
 			return &client->streams[i];
 		}
 	}
@@ -93,11 +99,24 @@ static struct http2_stream_ctx *allocate_http_stream_context(
 	return NULL;
 }
 
+static void release_http_stream_tx(struct http2_stream_ctx *stream)
+{
+	if (stream->tx_file_open) {
+		fs_close(&stream->tx_file);
+		stream->tx_file_open = false;
+	}
+
+	stream->tx_data = NULL;
+	stream->tx_remaining = 0;
+	stream->tx_pending = false;
+}
+
 static void release_http_stream_context(struct http_client_ctx *client,
 					uint32_t stream_id)
 {
 	ARRAY_FOR_EACH(client->streams, i) {
 		if (client->streams[i].stream_id == stream_id) {
+			release_http_stream_tx(&client->streams[i]);
 			client->streams[i].stream_id = 0;
 			client->streams[i].stream_state = HTTP2_STREAM_IDLE;
 			client->streams[i].current_detail = NULL;
@@ -116,7 +135,12 @@ static int add_header_field(struct http_client_ctx *client, uint8_t **buf,
 	client->header_field.value = value;
 	client->header_field.value_len = strlen(value);
 
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+	ret = http_hpack_encode_header_table(*buf, *buflen, &client->header_field,
+					     &client->hpack_table);
+#else
 	ret = http_hpack_encode_header(*buf, *buflen, &client->header_field);
+#endif
 	if (ret < 0) {
 		LOG_DBG("Failed to encode header, err %d", ret);
 		return ret;
@@ -217,8 +241,19 @@ static int send_data_frame(struct http_client_ctx *client, const char *payload,
 			   size_t length, uint32_t stream_id, uint8_t flags)
 {
 	uint8_t frame_header[HTTP2_FRAME_HEADER_SIZE];
+	struct http2_stream_ctx *stream;
 	int ret;
 
+	/* Account for all DATA frames, so that the scheduler does not overrun
+	 * the peer windows after a response was sent directly.
+	 */
+	client->send_window -= length;
+
+	stream = find_http_stream_context(client, stream_id);
+	if (stream != NULL) {
+		stream->send_window -= length;
+	}
+
 	encode_frame_header(frame_header, length, HTTP2_DATA_FRAME,
 			    is_header_flag_set(flags, HTTP2_FLAG_END_STREAM) ?
 			    HTTP2_FLAG_END_STREAM : 0,
@@ -239,6 +274,214 @@ static int send_data_frame(struct http_client_ctx *client, const char *payload,
 	return ret;
 }
 
+/* Size of the buffer the files are read to. The DATA frames are not limited
+ * by it, a larger frame is written to the socket in several pieces.
+ */
+#define HTTP2_FS_READ_SIZE 128
+
+static int send_file_data(struct http_client_ctx *client, struct fs_file_t *file,
+			  size_t len)
+{
+	uint8_t chunk[HTTP2_FS_READ_SIZE];
+	ssize_t read_len;
+	int ret;
+
+	while (len > 0) {
+		read_len = fs_read(file, chunk, MIN(len, sizeof(chunk)));
+		if (read_len <= 0) {
+			LOG_ERR("Filesystem read error (%d)", (int)read_len);
+			return read_len < 0 ? (int)read_len : -EIO;
+		}
+
+		ret = http_server_sendall(client, chunk, read_len);
+		if (ret < 0) {
+			LOG_DBG("Cannot write to socket (%d)", ret);
+			return ret;
+		}
+
+		len -= read_len;
+	}
+
+	return 0;
+}
+
+static bool stream_can_send(struct http_client_ctx *client,
+			    struct http2_stream_ctx *stream)
+{
+	return stream->tx_pending &&
+	       (stream->tx_remaining == 0 ||
+		(stream->send_window > 0 && client->send_window > 0));
+}
+
+static void finish_http_stream_tx(struct http_client_ctx *client,
+				  struct http2_stream_ctx *stream)
+{
+	stream->end_stream_sent = true;
+	release_http_stream_tx(stream);
+
+	/* The request was already received completely, nothing left to do
+	 * with the stream.
+	 */
+	if (stream->stream_state == HTTP2_STREAM_HALF_CLOSED_REMOTE) {
+		release_http_stream_context(client, stream->stream_id);
+	}
+}
+
+/* Send a single DATA frame of at most max_len bytes from the stream queue.
+ * Returns the number of payload bytes sent, 0 if the stream is blocked by
+ * flow control.
+ */
+static int send_stream_chunk(struct http_client_ctx *client,
+			     struct http2_stream_ctx *stream, size_t max_len)
+{
+	const uint8_t *payload;
+	size_t len;
+	bool last;
+	int ret;
+
+	len = MIN(max_len, stream->tx_remaining);
+	len = MIN(len, client->peer_max_frame_size);
+	len = MIN(len, (size_t)MAX(stream->send_window, 0));
+	len = MIN(len, (size_t)MAX(client->send_window, 0));
+
+	if (len == 0 && stream->tx_remaining > 0) {
+		return 0;
+	}
+
+	last = (len == stream->tx_remaining);
+	stream->tx_remaining -= len;
+
+	if (stream->tx_file_open) {
+		/* The frame header goes first, the file is read as it is sent */
+		payload = NULL;
+	} else {
+		payload = stream->tx_data;
+		stream->tx_data += len;
+	}
+
+	ret = send_data_frame(client, (const char *)payload, len, stream->stream_id,
+			      last ? HTTP2_FLAG_END_STREAM : 0);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (stream->tx_file_open) {
+		ret = send_file_data(client, &stream->tx_file, len);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	if (last) {
+		finish_http_stream_tx(client, stream);
+	}
+
+	return len;
+}
+
+static size_t stream_quantum(struct http2_stream_ctx *stream)
+{
+	return DIV_ROUND_UP((size_t)CONFIG_HTTP_SERVER_HTTP2_SCHED_QUANTUM *
+			    stream->weight, HTTP2_DEFAULT_WEIGHT);
+}
+
+static int send_stream_quantum(struct http_client_ctx *client,
+			       struct http2_stream_ctx *stream)
+{
+	size_t budget = stream_quantum(stream);
+	int ret;
+
+	while (budget > 0 && stream->tx_pending) {
+		ret = send_stream_chunk(client, stream, budget);
+		if (ret < 0) {
+			return ret;
+		}
+
+		if (ret == 0) {
+			if (stream->tx_pending) {
+				/* Blocked by flow control */
+				break;
+			}
+
+			continue;
+		}
+
+		budget -= MIN(budget, (size_t)ret);
+	}
+
+	return 0;
+}
+
+bool http2_send_ready(struct http_client_ctx *client)
+{
+	ARRAY_FOR_EACH(client->streams, i) {
+		if (stream_can_send(client, &client->streams[i])) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+int http2_send_pending(struct http_client_ctx *client)
+{
+	int ret;
+
+	/* One round of weighted round robin: every stream with data gets to
+	 * send up to its quantum, limited by the stream and connection
+	 * windows granted by the peer.
+	 */
+	ARRAY_FOR_EACH(client->streams, i) {
+		struct http2_stream_ctx *stream = &client->streams[i];
+
+		if (!stream_can_send(client, stream)) {
+			continue;
+		}
+
+		ret = send_stream_quantum(client, stream);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+void http2_release_streams(struct http_client_ctx *client)
+{
+	ARRAY_FOR_EACH(client->streams, i) {
+		release_http_stream_tx(&client->streams[i]);
+	}
+}
+
+/* Called once the peer has finished sending the request. A stream which
+ * still has a response queued is kept until the scheduler sends it.
+ */
+static void finish_http_stream(struct http_client_ctx *client,
+			       struct http2_stream_ctx *stream)
+{
+	if (stream->tx_pending) {
+		stream->stream_state = HTTP2_STREAM_HALF_CLOSED_REMOTE;
+		stream->current_detail = NULL;
+		return;
+	}
+
+	release_http_stream_context(client, stream->stream_id);
+}
+
+static int queue_data(struct http_client_ctx *client, struct http2_stream_ctx *stream,
+		      const uint8_t *data, size_t len)
+{
+	stream->tx_data = data;
+	stream->tx_remaining = len;
+	stream->tx_pending = true;
+
+	/* Give the new stream its first turn right away, the rest is sent
+	 * interleaved with the other streams from the server loop.
+	 */
+	return send_stream_quantum(client, stream);
+}
+
 int send_settings_frame(struct http_client_ctx *client, bool ack)
 {
 	uint8_t settings_frame[HTTP2_FRAME_HEADER_SIZE +
@@ -413,7 +656,7 @@ static int handle_http2_static_resource(
 	struct http_resource_detail_static *static_detail,
 	struct http2_frame *frame, struct http_client_ctx *client)
 {
-	const char *content_200;
+	const uint8_t *content_200;
 	size_t content_len;
 	int ret;
 
@@ -435,16 +678,12 @@ static int handle_http2_static_resource(
 		goto out;
 	}
 
-	ret = send_data_frame(client, content_200, content_len,
-			      frame->stream_identifier,
-			      HTTP2_FLAG_END_STREAM);
+	ret = queue_data(client, client->current_stream, content_200, content_len);
 	if (ret < 0) {
 		LOG_DBG("Cannot write to socket (%d)", ret);
 		goto out;
 	}
 
-	client->current_stream->end_stream_sent = true;
-
 out:
 	return ret;
 }
@@ -454,7 +693,7 @@ static int handle_http2_static_fs_resource(struct http_resource_detail_static_fs
 					   struct http_client_ctx *client)
 {
 	int ret;
-	struct fs_file_t file;
+	struct http2_stream_ctx *stream = client->current_stream;
 	char fname[HTTP_SERVER_MAX_URL_LENGTH];
 	char content_type[HTTP_SERVER_MAX_CONTENT_TYPE_LEN] = "text/html";
 	struct http_resource_detail res_detail = {
@@ -464,16 +703,15 @@ static int handle_http2_static_fs_resource(struct http_resource_detail_static_fs
 		.path_len = static_fs_detail->common.path_len,
 		.type = static_fs_detail->common.type,
 	};
+	size_t file_size;
 	bool gzipped;
 	int len;
-	int remaining;
-	char tmp[64];
 
 	if (client->method != HTTP_GET) {
 		return send_http2_405(client, frame);
 	}
 
-	if (client->current_stream == NULL) {
+	if (stream == NULL) {
 		return -ENOENT;
 	}
 
@@ -490,7 +728,7 @@ static int handle_http2_static_fs_resource(struct http_resource_detail_static_fs
 	}
 
 	/* open file, if it exists */
-	ret = http_server_find_file(fname, sizeof(fname), &client->data_len, &gzipped);
+	ret = http_server_find_file(fname, sizeof(fname), &file_size, &gzipped);
 	if (ret < 0) {
 		LOG_ERR("fs_stat %s: %d", fname, ret);
 
@@ -501,15 +739,15 @@ static int handle_http2_static_fs_resource(struct http_resource_detail_static_fs
 		}
 		return ret;
 	}
-	fs_file_t_init(&file);
-	ret = fs_open(&file, fname, FS_O_READ);
+	fs_file_t_init(&stream->tx_file);
+	ret = fs_open(&stream->tx_file, fname, FS_O_READ);
 	if (ret < 0) {
 		LOG_ERR("fs_open %s: %d", fname, ret);
-		if (ret < 0) {
-			return ret;
-		}
+		return ret;
 	}
 
+	stream->tx_file_open = true;
+
 	/* send headers */
 	if (gzipped) {
 		res_detail.content_encoding = "gzip";
@@ -521,29 +759,18 @@ static int handle_http2_static_fs_resource(struct http_resource_detail_static_fs
 		goto out;
 	}
 
-	/* read and send file */
-	remaining = client->data_len;
-	while (remaining > 0) {
-		len = fs_read(&file, tmp, sizeof(tmp));
-		if (len < 0) {
-			LOG_ERR("Filesystem read error (%d)", len);
-			goto out;
-		}
-
-		remaining -= len;
-		ret = send_data_frame(client, tmp, len, frame->stream_identifier,
-				      (remaining > 0) ? 0 : HTTP2_FLAG_END_STREAM);
-		if (ret < 0) {
-			LOG_DBG("Cannot write to socket (%d)", ret);
-			goto out;
-		}
+	/* The file is read and sent by the scheduler, the stream owns it
+	 * until the last frame is out.
+	 */
+	ret = queue_data(client, stream, NULL, file_size);
+	if (ret < 0) {
+		LOG_DBG("Cannot write to socket (%d)", ret);
 	}
 
-	client->current_stream->end_stream_sent = true;
-
 out:
-	/* close file */
-	fs_close(&file);
+	if (ret < 0) {
+		release_http_stream_tx(stream);
+	}
 
 	return ret;
 }
@@ -774,7 +1001,7 @@ static int handle_http2_dynamic_resource(
 		return send_http2_405(client, frame);
 	}
 
-	if (dynamic_detail->holder != NULL && dynamic_detail->holder != client) {
+	if (http_server_dynamic_resource_acquire(dynamic_detail, client) < 0) {
 		ret = send_http2_409(client, frame);
 		if (ret < 0) {
 			return ret;
@@ -783,8 +1010,6 @@ static int handle_http2_dynamic_resource(
 		return enter_http_done_state(client);
 	}
 
-	dynamic_detail->holder = client;
-
 	switch (client->method) {
 	case HTTP_GET:
 	case HTTP_DELETE:
@@ -1131,7 +1356,7 @@ int handle_http1_to_http2_upgrade(struct http_client_ctx *client)
 	 * to HTTP2.
 	 */
 	if (client->parser_state == HTTP1_MESSAGE_COMPLETE_STATE) {
-		release_http_stream_context(client, frame->stream_identifier);
+		finish_http_stream(client, client->current_stream);
 		client->current_detail = NULL;
 		client->server_state = HTTP_SERVER_PREFACE_STATE;
 		client->cursor += client->data_len;
@@ -1188,9 +1413,13 @@ static int parse_http_frame_priority_field(struct http_client_ctx *client)
 		return -EAGAIN;
 	}
 
-	/* Priority signalling is deprecated by RFC 9113, however it still
-	 * should be expected to receive, just drop the bytes.
+	/* Priority signalling is deprecated by RFC 9113, only the weight is
+	 * used by the send scheduler, stream dependencies are ignored.
 	 */
+	if (client->current_stream != NULL) {
+		client->current_stream->weight = client->cursor[4] + 1;
+	}
+
 	client->cursor += HTTP2_HEADERS_FRAME_PRIORITY_LEN;
 	client->data_len -= HTTP2_HEADERS_FRAME_PRIORITY_LEN;
 	frame->length -= HTTP2_HEADERS_FRAME_PRIORITY_LEN;
@@ -1462,6 +1691,12 @@ static int handle_http_frame_headers_end_stream(struct http_client_ctx *client)
 		return -ENOENT;
 	}
 
+	if (client->current_stream->tx_pending) {
+		/* Response body is still being sent by the scheduler */
+		finish_http_stream(client, client->current_stream);
+		return 0;
+	}
+
 	if (client->current_stream->current_detail == NULL) {
 		goto out;
 	}
@@ -1643,6 +1878,7 @@ error:
 int handle_http_frame_priority(struct http_client_ctx *client)
 {
 	struct http2_frame *frame = &client->current_frame;
+	struct http2_stream_ctx *stream_ctx;
 
 	LOG_DBG("HTTP_SERVER_FRAME_PRIORITY_STATE");
 
@@ -1654,9 +1890,14 @@ int handle_http_frame_priority(struct http_client_ctx *client)
 		return -EAGAIN;
 	}
 
-	/* Priority signalling is deprecated by RFC 9113, however it still
-	 * should be expected to receive, just drop the bytes.
+	/* Priority signalling is deprecated by RFC 9113, only the weight is
+	 * used by the send scheduler, stream dependencies are ignored.
 	 */
+	stream_ctx = find_http_stream_context(client, frame->stream_identifier);
+	if (stream_ctx != NULL) {
+		stream_ctx->weight = client->cursor[4] + 1;
+	}
+
 	client->data_len -= HTTP2_PRIORITY_FRAME_LEN;
 	client->cursor += HTTP2_PRIORITY_FRAME_LEN;
 
@@ -1705,6 +1946,49 @@ int handle_http_frame_rst_stream(struct http_client_ctx *client)
 	return 0;
 }
 
+static int apply_setting(struct http_client_ctx *client, uint16_t id, uint32_t value)
+{
+	int32_t delta;
+
+	switch (id) {
+	case HTTP2_SETTINGS_HEADER_TABLE_SIZE:
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+		http_hpack_encoder_table_set_max_size(&client->hpack_table, value);
+#endif
+		break;
+
+	case HTTP2_SETTINGS_INITIAL_WINDOW_SIZE:
+		if (value > HTTP2_MAX_WINDOW_SIZE) {
+			return -EBADMSG;
+		}
+
+		/* RFC 9113, ch. 6.9.2, the change applies to all open streams */
+		delta = (int32_t)value - client->peer_initial_window;
+		client->peer_initial_window = value;
+
+		ARRAY_FOR_EACH(client->streams, i) {
+			if (client->streams[i].stream_state != HTTP2_STREAM_IDLE) {
+				client->streams[i].send_window += delta;
+			}
+		}
+
+		break;
+
+	case HTTP2_SETTINGS_MAX_FRAME_SIZE:
+		if (value < HTTP2_DEFAULT_MAX_FRAME_SIZE || value > HTTP2_MAX_FRAME_SIZE) {
+			return -EBADMSG;
+		}
+
+		client->peer_max_frame_size = value;
+		break;
+
+	default:
+		break;
+	}
+
+	return 0;
+}
+
 int handle_http_frame_settings(struct http_client_ctx *client)
 {
 	struct http2_frame *frame = &client->current_frame;
@@ -1716,6 +2000,23 @@ int handle_http_frame_settings(struct http_client_ctx *client)
 		return -EAGAIN;
 	}
 
+	if (!is_header_flag_set(frame->flags, HTTP2_FLAG_SETTINGS_ACK)) {
+		if (frame->length % HTTP2_SETTINGS_FIELD_LEN != 0) {
+			return -EBADMSG;
+		}
+
+		for (uint32_t offset = 0; offset < frame->length;
+		     offset += HTTP2_SETTINGS_FIELD_LEN) {
+			int ret;
+
+			ret = apply_setting(client, sys_get_be16(client->cursor + offset),
+					    sys_get_be32(client->cursor + offset + 2));
+			if (ret < 0) {
+				return ret;
+			}
+		}
+	}
+
 	bytes_consumed = client->current_frame.length;
 	client->data_len -= bytes_consumed;
 	client->cursor += bytes_consumed;
@@ -1750,6 +2051,15 @@ int handle_http_frame_goaway(struct http_client_ctx *client)
 	client->data_len -= bytes_consumed;
 	client->cursor += bytes_consumed;
 
+	/* Finish the responses already in progress, as far as the peer
+	 * windows allow.
+	 */
+	while (http2_send_ready(client)) {
+		if (http2_send_pending(client) < 0) {
+			break;
+		}
+	}
+
 	enter_http_done_state(client);
 
 	return 0;
@@ -1758,19 +2068,54 @@ int handle_http_frame_goaway(struct http_client_ctx *client)
 int handle_http_frame_window_update(struct http_client_ctx *client)
 {
 	struct http2_frame *frame = &client->current_frame;
-	int bytes_consumed;
+	struct http2_stream_ctx *stream_ctx;
+	uint32_t increment;
+	int32_t *window;
 
 	LOG_DBG("HTTP_SERVER_FRAME_WINDOW_UPDATE");
 
-	/* TODO Implement flow control, for now just ignore. */
+	if (frame->length != HTTP2_WINDOW_UPDATE_FRAME_LEN) {
+		return -EBADMSG;
+	}
 
 	if (client->data_len < frame->length) {
 		return -EAGAIN;
 	}
 
-	bytes_consumed = client->current_frame.length;
-	client->data_len -= bytes_consumed;
-	client->cursor += bytes_consumed;
+	increment = sys_get_be32(client->cursor) & HTTP2_MAX_WINDOW_SIZE;
+
+	client->data_len -= HTTP2_WINDOW_UPDATE_FRAME_LEN;
+	client->cursor += HTTP2_WINDOW_UPDATE_FRAME_LEN;
+
+	/* A zero increment is a PROTOCOL_ERROR (RFC 9113, section 6.9). It is
+	 * only a stream error for stream updates, but as with the other
+	 * protocol errors the connection is closed.
+	 */
+	if (increment == 0) {
+		LOG_DBG("Zero flow control window increment");
+		return -EBADMSG;
+	}
+
+	if (frame->stream_identifier == 0) {
+		window = &client->send_window;
+	} else {
+		stream_ctx = find_http_stream_context(client, frame->stream_identifier);
+		/* Updates for already closed streams are expected, ignore them. */
+		window = (stream_ctx != NULL) ? &stream_ctx->send_window : NULL;
+	}
+
+	if (window != NULL) {
+		if ((int64_t)*window + increment > HTTP2_MAX_WINDOW_SIZE) {
+			LOG_DBG("Flow control window overflow");
+			return -EBADMSG;
+		}
+
+		*window += increment;
+	}
+
+	/* Queued data is sent from the server loop once the socket is
+	 * writable.
+	 */
 
 	client->server_state = HTTP_SERVER_FRAME_HEADER_STATE;
 
@@ -287,6 +287,44 @@ error:
 	return err_code;
 }
 
+#if defined(CONFIG_MQTT_SESSION)
+int mqtt_session_publish(struct mqtt_client *client,
+			 const struct mqtt_publish_param *param)
+{
+	int err_code;
+
+	NULL_PARAM_CHECK(client);
+	NULL_PARAM_CHECK(param);
+
+	mqtt_mutex_lock(client);
+
+	if (client->session == NULL) {
+		err_code = -EINVAL;
+		goto error;
+	}
+
+	err_code = mqtt_session_queue(client, param);
+	if (err_code < 0) {
+		goto error;
+	}
+
+	err_code = mqtt_session_send(client);
+	if (err_code < 0) {
+		NET_ERR("Transport write failed, err_code = %d, "
+			 "closing connection", err_code);
+		client_disconnect(client, err_code, true);
+	}
+
+error:
+	NET_DBG("[CID %p]:[State 0x%02x]: << result 0x%08x",
+		 client, client->internal.state, err_code);
+
+	mqtt_mutex_unlock(client);
+
+	return err_code;
+}
+#endif /* CONFIG_MQTT_SESSION */
+
 int mqtt_publish_qos1_ack(struct mqtt_client *client,
 			  const struct mqtt_puback_param *param)
 {
@@ -601,6 +639,15 @@ int mqtt_live(struct mqtt_client *client)
 
 	mqtt_mutex_lock(client);
 
+#if defined(CONFIG_MQTT_SESSION)
+	err_code = mqtt_session_retransmit(client, false);
+	if (err_code < 0) {
+		client_disconnect(client, err_code, true);
+		mqtt_mutex_unlock(client);
+		return err_code;
+	}
+#endif
+
 	elapsed_time = mqtt_elapsed_time_in_ms_get(
 				client->internal.last_activity);
 	if ((client->keepalive > 0) &&
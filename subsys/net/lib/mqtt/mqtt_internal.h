@@ -162,6 +162,46 @@ void event_notify(struct mqtt_client *client, const struct mqtt_evt *evt);
  */
 int mqtt_handle_rx(struct mqtt_client *client);
 
+#if defined(CONFIG_MQTT_SESSION)
+/**@brief Encodes a publish and adds it to the session queue.
+ *
+ * @param[in] client Identifies the client for which the procedure is requested.
+ * @param[in] param Publish message parameters.
+ *
+ * @return 0 if the procedure is successful, an error code otherwise.
+ */
+int mqtt_session_queue(struct mqtt_client *client,
+		       const struct mqtt_publish_param *param);
+
+/**@brief Sends the queued session messages that fit the in-flight window.
+ *
+ * @param[in] client Identifies the client for which the procedure is requested.
+ *
+ * @return 0 if the procedure is successful, an error code otherwise.
+ */
+int mqtt_session_send(struct mqtt_client *client);
+
+/**@brief Sends the unacknowledged session messages again.
+ *
+ * @param[in] client Identifies the client for which the procedure is requested.
+ * @param[in] all Send all messages instead of the timed out ones only.
+ *
+ * @return 0 if the procedure is successful, an error code otherwise.
+ */
+int mqtt_session_retransmit(struct mqtt_client *client, bool all);
+
+/**@brief Handles an acknowledgement of a session message.
+ *
+ * @param[in] client Identifies the client for which the procedure is requested.
+ * @param[in] type Packet type of the acknowledgement.
+ * @param[in] message_id Acknowledged message identifier.
+ *
+ * @return 0 if the procedure is successful, an error code otherwise.
+ */
+int mqtt_session_ack(struct mqtt_client *client, uint8_t type,
+		     uint16_t message_id);
+#endif /* CONFIG_MQTT_SESSION */
+
 /**@brief Constructs/encodes Connect packet.
  *
  * @param[in] client Identifies the client for which the procedure is requested.
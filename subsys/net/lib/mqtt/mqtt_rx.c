@@ -16,6 +16,46 @@ LOG_MODULE_REGISTER(net_mqtt_rx, CONFIG_MQTT_LOG_LEVEL);
  * @brief MQTT Received data handling.
  */
 
+#if defined(CONFIG_MQTT_SESSION)
+static int mqtt_session_handle_evt(struct mqtt_client *client,
+				   const struct mqtt_evt *evt)
+{
+	int err_code;
+
+	switch (evt->type) {
+	case MQTT_EVT_CONNACK:
+		if (!MQTT_HAS_STATE(client, MQTT_STATE_CONNECTED)) {
+			return 0;
+		}
+
+		/* Resend what the broker did not acknowledge before the
+		 * connection was lost, then continue with the queue.
+		 */
+		err_code = mqtt_session_retransmit(client, true);
+		if (err_code < 0) {
+			return err_code;
+		}
+
+		return mqtt_session_send(client);
+
+	case MQTT_EVT_PUBACK:
+		return mqtt_session_ack(client, MQTT_PKT_TYPE_PUBACK,
+					evt->param.puback.message_id);
+
+	case MQTT_EVT_PUBREC:
+		return mqtt_session_ack(client, MQTT_PKT_TYPE_PUBREC,
+					evt->param.pubrec.message_id);
+
+	case MQTT_EVT_PUBCOMP:
+		return mqtt_session_ack(client, MQTT_PKT_TYPE_PUBCOMP,
+					evt->param.pubcomp.message_id);
+
+	default:
+		return 0;
+	}
+}
+#endif /* CONFIG_MQTT_SESSION */
+
 static int mqtt_handle_packet(struct mqtt_client *client,
 			      uint8_t type_and_flags,
 			      uint32_t var_length,
@@ -142,6 +182,12 @@ static int mqtt_handle_packet(struct mqtt_client *client,
 		event_notify(client, &evt);
 	}
 
+#if defined(CONFIG_MQTT_SESSION)
+	if (notify_event && err_code == 0) {
+		err_code = mqtt_session_handle_evt(client, &evt);
+	}
+#endif
+
 	return err_code;
 }
 
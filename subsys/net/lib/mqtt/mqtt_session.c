@@ -0,0 +1,608 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file mqtt_session.c
+ *
+ * @brief Managed MQTT publish session.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_mqtt_session, CONFIG_MQTT_LOG_LEVEL);
+
+#include <zephyr/net/mqtt.h>
+#include <zephyr/sys/byteorder.h>
+
+#if defined(CONFIG_MQTT_SESSION_ZMS)
+#include <zephyr/fs/zms.h>
+#endif
+
+#include "mqtt_transport.h"
+#include "mqtt_internal.h"
+#include "mqtt_os.h"
+
+#define SESSION_WINDOW CONFIG_MQTT_SESSION_WINDOW
+#define SESSION_QUEUE_SIZE CONFIG_MQTT_SESSION_QUEUE_SIZE
+#define SESSION_TX_BATCH CONFIG_MQTT_SESSION_TX_BATCH
+#define SESSION_RETRANSMIT_TIMEOUT CONFIG_MQTT_SESSION_RETRANSMIT_TIMEOUT
+
+/* PUBREL has a fixed length, the packet replaces the publish in its slot */
+#define PUBREL_LEN 4
+
+/* Acknowledgement an in-flight message waits for */
+enum session_msg_state {
+	SESSION_MSG_FREE,
+	SESSION_MSG_WAIT_PUBACK,
+	SESSION_MSG_WAIT_PUBREC,
+	SESSION_MSG_WAIT_PUBCOMP,
+};
+
+/* Bytes of a message stored in flash, the unused part of data is skipped */
+#define SESSION_MSG_STORED_LEN(msg) (offsetof(struct mqtt_session_msg, data) + (msg)->len)
+
+struct session_tx {
+	struct iovec iov[SESSION_TX_BATCH];
+	size_t count;
+};
+
+static struct mqtt_session_msg *queue_peek(struct mqtt_session *session)
+{
+	return &session->queue[session->queue_head];
+}
+
+static struct mqtt_session_msg *queue_tail(struct mqtt_session *session)
+{
+	return &session->queue[(session->queue_head + session->queue_len) %
+			       SESSION_QUEUE_SIZE];
+}
+
+static void queue_pop(struct mqtt_session *session)
+{
+	session->queue_head = (session->queue_head + 1) % SESSION_QUEUE_SIZE;
+	session->queue_len--;
+}
+
+static struct mqtt_session_msg *inflight_find(struct mqtt_session *session,
+					      uint16_t message_id)
+{
+	for (size_t i = 0; i < SESSION_WINDOW; i++) {
+		struct mqtt_session_msg *msg = &session->inflight[i];
+
+		if (msg->state != SESSION_MSG_FREE && msg->message_id == message_id) {
+			return msg;
+		}
+	}
+
+	return NULL;
+}
+
+static bool queue_find(struct mqtt_session *session, uint16_t message_id)
+{
+	for (size_t i = 0; i < session->queue_len; i++) {
+		const struct mqtt_session_msg *msg =
+			&session->queue[(session->queue_head + i) % SESSION_QUEUE_SIZE];
+
+		if (msg->message_id == message_id) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Identifiers of messages in flight or queued in RAM are skipped. The ones
+ * stored in flash are newer than the identifier restored from there, so they
+ * are only reached after the identifiers wrap around.
+ */
+static uint16_t session_next_message_id(struct mqtt_session *session)
+{
+	do {
+		session->last_message_id++;
+	} while (session->last_message_id == 0U ||
+		 inflight_find(session, session->last_message_id) != NULL ||
+		 queue_find(session, session->last_message_id));
+
+	return session->last_message_id;
+}
+
+#if defined(CONFIG_MQTT_SESSION_ZMS)
+#define SESSION_ZMS_META_ID CONFIG_MQTT_SESSION_ZMS_ID_BASE
+#define SESSION_ZMS_MAX_ENTRIES CONFIG_MQTT_SESSION_ZMS_MAX_ENTRIES
+
+struct session_zms_meta {
+	uint32_t head;
+	uint32_t tail;
+};
+
+static uint32_t session_zms_id(uint32_t seq)
+{
+	return SESSION_ZMS_META_ID + 1U + (seq % SESSION_ZMS_MAX_ENTRIES);
+}
+
+static int session_zms_meta_store(struct mqtt_session *session)
+{
+	struct session_zms_meta meta = {
+		.head = session->fs_head,
+		.tail = session->fs_tail,
+	};
+	ssize_t ret;
+
+	ret = zms_write(session->fs, SESSION_ZMS_META_ID, &meta, sizeof(meta));
+
+	return ret < 0 ? ret : 0;
+}
+
+static bool session_zms_enabled(struct mqtt_session *session)
+{
+	return session->fs != NULL;
+}
+
+static bool session_zms_empty(struct mqtt_session *session)
+{
+	return session->fs == NULL || session->fs_head == session->fs_tail;
+}
+
+static int session_zms_push(struct mqtt_session *session,
+			    const struct mqtt_session_msg *msg)
+{
+	ssize_t ret;
+
+	if (session->fs_tail - session->fs_head >= SESSION_ZMS_MAX_ENTRIES) {
+		return -ENOMEM;
+	}
+
+	ret = zms_write(session->fs, session_zms_id(session->fs_tail), msg,
+			SESSION_MSG_STORED_LEN(msg));
+	if (ret < 0) {
+		NET_ERR("Cannot store message %u (%d)", msg->message_id, (int)ret);
+		return ret;
+	}
+
+	session->fs_tail++;
+
+	return session_zms_meta_store(session);
+}
+
+/* Move messages from flash to the RAM queue as it drains, keeping the
+ * original order.
+ */
+static void session_zms_load(struct mqtt_session *session)
+{
+	uint32_t fs_head = session->fs_head;
+
+	while (!session_zms_empty(session) && session->queue_len < SESSION_QUEUE_SIZE) {
+		struct mqtt_session_msg *msg = queue_tail(session);
+		uint32_t id = session_zms_id(session->fs_head);
+		ssize_t ret;
+
+		ret = zms_read(session->fs, id, msg, sizeof(*msg));
+		if (ret < (ssize_t)offsetof(struct mqtt_session_msg, data) ||
+		    ret != SESSION_MSG_STORED_LEN(msg)) {
+			NET_ERR("Dropping unreadable stored message (%d)", (int)ret);
+		} else {
+			msg->state = SESSION_MSG_FREE;
+			session->queue_len++;
+		}
+
+		(void)zms_delete(session->fs, id);
+		session->fs_head++;
+	}
+
+	if (session->fs_head != fs_head) {
+		(void)session_zms_meta_store(session);
+	}
+}
+
+/* Continue the message identifiers after the newest stored message, which
+ * is the highest identifier unless they wrapped around.
+ */
+static void session_zms_restore_message_id(struct mqtt_session *session)
+{
+	struct mqtt_session_msg msg;
+	ssize_t ret;
+
+	for (uint32_t seq = session->fs_head; seq != session->fs_tail; seq++) {
+		ret = zms_read(session->fs, session_zms_id(seq), &msg,
+			       offsetof(struct mqtt_session_msg, data));
+		if (ret < (ssize_t)offsetof(struct mqtt_session_msg, data)) {
+			continue;
+		}
+
+		if (msg.message_id != 0U) {
+			session->last_message_id = msg.message_id;
+		}
+	}
+}
+
+int mqtt_session_storage_set(struct mqtt_client *client, struct zms_fs *fs)
+{
+	struct session_zms_meta meta;
+	ssize_t ret;
+
+	NULL_PARAM_CHECK(client);
+	NULL_PARAM_CHECK(fs);
+
+	mqtt_mutex_lock(client);
+
+	if (client->session == NULL) {
+		ret = -EINVAL;
+		goto exit;
+	}
+
+	client->session->fs = fs;
+
+	ret = zms_read(fs, SESSION_ZMS_META_ID, &meta, sizeof(meta));
+	if (ret == sizeof(meta) && meta.tail - meta.head <= SESSION_ZMS_MAX_ENTRIES) {
+		client->session->fs_head = meta.head;
+		client->session->fs_tail = meta.tail;
+
+		NET_INFO("Restored %u stored messages", meta.tail - meta.head);
+
+		session_zms_restore_message_id(client->session);
+	} else {
+		client->session->fs_head = 0U;
+		client->session->fs_tail = 0U;
+	}
+
+	session_zms_load(client->session);
+	ret = 0;
+
+exit:
+	mqtt_mutex_unlock(client);
+
+	return ret;
+}
+#else
+static bool session_zms_enabled(struct mqtt_session *session)
+{
+	ARG_UNUSED(session);
+
+	return false;
+}
+
+static bool session_zms_empty(struct mqtt_session *session)
+{
+	ARG_UNUSED(session);
+
+	return true;
+}
+
+static int session_zms_push(struct mqtt_session *session,
+			    const struct mqtt_session_msg *msg)
+{
+	ARG_UNUSED(session);
+	ARG_UNUSED(msg);
+
+	return -ENOMEM;
+}
+
+static void session_zms_load(struct mqtt_session *session)
+{
+	ARG_UNUSED(session);
+}
+#endif /* CONFIG_MQTT_SESSION_ZMS */
+
+static int session_tx_flush(struct mqtt_client *client, struct session_tx *tx)
+{
+	struct msghdr msg = {
+		.msg_iov = tx->iov,
+		.msg_iovlen = tx->count,
+	};
+	int err_code;
+
+	if (tx->count == 0) {
+		return 0;
+	}
+
+	NET_DBG("[%p]: Writing %zu session packets.", client, tx->count);
+
+	err_code = mqtt_transport_write_msg(client, &msg);
+	tx->count = 0;
+	if (err_code < 0) {
+		NET_ERR("Session write failed, err_code = %d", err_code);
+		return err_code;
+	}
+
+	client->internal.last_activity = mqtt_sys_tick_in_ms_get();
+
+	return 0;
+}
+
+static int session_tx_add(struct mqtt_client *client, struct session_tx *tx,
+			  struct mqtt_session_msg *msg)
+{
+	tx->iov[tx->count].iov_base = msg->data;
+	tx->iov[tx->count].iov_len = msg->len;
+	tx->count++;
+
+	msg->sent_at = mqtt_sys_tick_in_ms_get();
+
+	if (tx->count == ARRAY_SIZE(tx->iov)) {
+		return session_tx_flush(client, tx);
+	}
+
+	return 0;
+}
+
+static struct mqtt_session_msg *inflight_alloc(struct mqtt_session *session)
+{
+	if (session->inflight_len >= SESSION_WINDOW) {
+		return NULL;
+	}
+
+	for (size_t i = 0; i < SESSION_WINDOW; i++) {
+		if (session->inflight[i].state == SESSION_MSG_FREE) {
+			return &session->inflight[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void inflight_free(struct mqtt_session *session, struct mqtt_session_msg *msg)
+{
+	msg->state = SESSION_MSG_FREE;
+	session->inflight_len--;
+}
+
+int mqtt_session_queue(struct mqtt_client *client,
+		       const struct mqtt_publish_param *param)
+{
+	struct mqtt_session *session = client->session;
+	struct mqtt_publish_param encoded = *param;
+	struct mqtt_session_msg staging;
+	struct mqtt_session_msg *msg;
+	struct buf_ctx packet;
+	size_t header_len;
+	int err_code;
+
+	/* Once messages overflow to flash, new ones follow them there to keep
+	 * the order.
+	 */
+	if (session->queue_len < SESSION_QUEUE_SIZE && session_zms_empty(session)) {
+		msg = queue_tail(session);
+	} else if (session_zms_enabled(session)) {
+		msg = &staging;
+	} else {
+		return -ENOMEM;
+	}
+
+	if (encoded.message.topic.qos > MQTT_QOS_0_AT_MOST_ONCE &&
+	    encoded.message_id == 0U) {
+		encoded.message_id = session_next_message_id(session);
+	}
+
+	if (encoded.message.payload.len > sizeof(msg->data)) {
+		return -EMSGSIZE;
+	}
+
+	packet.cur = msg->data;
+	packet.end = msg->data + sizeof(msg->data);
+
+	err_code = publish_encode(&encoded, &packet);
+	if (err_code < 0) {
+		return err_code == -ENOMEM ? -EMSGSIZE : err_code;
+	}
+
+	header_len = packet.end - packet.cur;
+	if (header_len + encoded.message.payload.len > sizeof(msg->data)) {
+		return -EMSGSIZE;
+	}
+
+	/* The encoder leaves room for the longest fixed header */
+	memmove(msg->data, packet.cur, header_len);
+	memcpy(msg->data + header_len, encoded.message.payload.data,
+	       encoded.message.payload.len);
+
+	msg->len = header_len + encoded.message.payload.len;
+	msg->message_id = encoded.message_id;
+	msg->qos = encoded.message.topic.qos;
+	msg->state = SESSION_MSG_FREE;
+	msg->sent_at = 0U;
+
+	if (msg == &staging) {
+		return session_zms_push(session, msg);
+	}
+
+	session->queue_len++;
+
+	return 0;
+}
+
+int mqtt_session_send(struct mqtt_client *client)
+{
+	struct mqtt_session *session = client->session;
+	struct session_tx tx = { 0 };
+	int err_code;
+
+	if (session == NULL || !MQTT_HAS_STATE(client, MQTT_STATE_CONNECTED)) {
+		return 0;
+	}
+
+	session_zms_load(session);
+
+	while (session->queue_len > 0) {
+		struct mqtt_session_msg *msg = queue_peek(session);
+
+		if (msg->qos > MQTT_QOS_0_AT_MOST_ONCE) {
+			struct mqtt_session_msg *slot = inflight_alloc(session);
+
+			if (slot == NULL) {
+				/* Window full, continue when a message is acknowledged */
+				break;
+			}
+
+			memcpy(slot, msg, offsetof(struct mqtt_session_msg, data) + msg->len);
+			slot->state = msg->qos == MQTT_QOS_1_AT_LEAST_ONCE ?
+				      SESSION_MSG_WAIT_PUBACK : SESSION_MSG_WAIT_PUBREC;
+			session->inflight_len++;
+			msg = slot;
+		}
+
+		/* The queue slot of a QoS 0 message is not reused before it
+		 * is written as the session is protected by the client lock.
+		 */
+		queue_pop(session);
+
+		err_code = session_tx_add(client, &tx, msg);
+		if (err_code < 0) {
+			return err_code;
+		}
+
+		if (session->queue_len == 0 && !session_zms_empty(session)) {
+			/* Loading reuses the queue slots referenced by the
+			 * pending write.
+			 */
+			err_code = session_tx_flush(client, &tx);
+			if (err_code < 0) {
+				return err_code;
+			}
+
+			session_zms_load(session);
+		}
+	}
+
+	return session_tx_flush(client, &tx);
+}
+
+int mqtt_session_retransmit(struct mqtt_client *client, bool all)
+{
+	struct mqtt_session *session = client->session;
+	struct session_tx tx = { 0 };
+	int err_code;
+
+	if (session == NULL || session->inflight_len == 0 ||
+	    !MQTT_HAS_STATE(client, MQTT_STATE_CONNECTED)) {
+		return 0;
+	}
+
+	for (size_t i = 0; i < SESSION_WINDOW; i++) {
+		struct mqtt_session_msg *msg = &session->inflight[i];
+
+		if (msg->state == SESSION_MSG_FREE) {
+			continue;
+		}
+
+		if (!all && mqtt_elapsed_time_in_ms_get(msg->sent_at) <
+			    SESSION_RETRANSMIT_TIMEOUT) {
+			continue;
+		}
+
+		NET_DBG("[%p]: Retransmitting message %u", client, msg->message_id);
+
+		if (msg->state != SESSION_MSG_WAIT_PUBCOMP) {
+			msg->data[0] |= MQTT_HEADER_DUP_MASK;
+		}
+
+		err_code = session_tx_add(client, &tx, msg);
+		if (err_code < 0) {
+			return err_code;
+		}
+	}
+
+	return session_tx_flush(client, &tx);
+}
+
+int mqtt_session_ack(struct mqtt_client *client, uint8_t type,
+		     uint16_t message_id)
+{
+	struct mqtt_session *session = client->session;
+	struct session_tx tx = { 0 };
+	struct mqtt_session_msg *msg;
+	int err_code;
+
+	if (session == NULL) {
+		return 0;
+	}
+
+	msg = inflight_find(session, message_id);
+	if (msg == NULL) {
+		/* Not a session message, or a duplicate acknowledgement */
+		return 0;
+	}
+
+	switch (type) {
+	case MQTT_PKT_TYPE_PUBACK:
+		if (msg->state != SESSION_MSG_WAIT_PUBACK) {
+			return 0;
+		}
+
+		inflight_free(session, msg);
+		break;
+
+	case MQTT_PKT_TYPE_PUBREC:
+		if (msg->state != SESSION_MSG_WAIT_PUBREC &&
+		    msg->state != SESSION_MSG_WAIT_PUBCOMP) {
+			return 0;
+		}
+
+		/* The publish is not needed anymore, keep the PUBREL in its
+		 * place for retransmissions.
+		 */
+		msg->data[0] = MQTT_MESSAGES_OPTIONS(MQTT_PKT_TYPE_PUBREL, 0, 1, 0);
+		msg->data[1] = PUBREL_LEN - MQTT_FIXED_HEADER_MIN_SIZE;
+		sys_put_be16(message_id, &msg->data[2]);
+		msg->len = PUBREL_LEN;
+		msg->state = SESSION_MSG_WAIT_PUBCOMP;
+
+		err_code = session_tx_add(client, &tx, msg);
+		if (err_code < 0) {
+			return err_code;
+		}
+
+		return session_tx_flush(client, &tx);
+
+	case MQTT_PKT_TYPE_PUBCOMP:
+		if (msg->state != SESSION_MSG_WAIT_PUBCOMP) {
+			return 0;
+		}
+
+		inflight_free(session, msg);
+		break;
+
+	default:
+		return 0;
+	}
+
+	/* The window has room again */
+	return mqtt_session_send(client);
+}
+
+int mqtt_session_init(struct mqtt_client *client, struct mqtt_session *session)
+{
+	NULL_PARAM_CHECK(client);
+	NULL_PARAM_CHECK(session);
+
+	mqtt_mutex_lock(client);
+
+	memset(session, 0, sizeof(*session));
+	client->session = session;
+
+	mqtt_mutex_unlock(client);
+
+	return 0;
+}
+
+int mqtt_session_pending(struct mqtt_client *client)
+{
+	int pending;
+
+	NULL_PARAM_CHECK(client);
+
+	mqtt_mutex_lock(client);
+
+	if (client->session == NULL) {
+		pending = -EINVAL;
+	} else {
+		pending = client->session->queue_len + client->session->inflight_len;
+#if defined(CONFIG_MQTT_SESSION_ZMS)
+		pending += client->session->fs_tail - client->session->fs_head;
+#endif
+	}
+
+	mqtt_mutex_unlock(client);
+
+	return pending;
+}
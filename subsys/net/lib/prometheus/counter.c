@@ -14,17 +14,50 @@
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(pm_counter, CONFIG_PROMETHEUS_LOG_LEVEL);
 
+#include "prometheus_cell.h"
+
 int prometheus_counter_add(struct prometheus_counter *counter, uint64_t value)
 {
+	struct prometheus_counter_cell *cell;
+	unsigned int key;
+	int cpu;
+
 	if (counter == NULL) {
 		return -EINVAL;
 	}
 
-	counter->value += value;
+	key = prometheus_cell_lock(&cpu);
+	cell = &counter->cells[cpu];
+
+	prometheus_cell_write_begin(&cell->seq);
+	cell->value += value;
+	prometheus_cell_write_end(&cell->seq);
+
+	prometheus_cell_unlock(key);
 
 	return 0;
 }
 
+uint64_t prometheus_counter_get(const struct prometheus_counter *counter)
+{
+	uint64_t total = 0;
+
+	for (int i = 0; i < ARRAY_SIZE(counter->cells); i++) {
+		const struct prometheus_counter_cell *cell = &counter->cells[i];
+		atomic_val_t seq;
+		uint64_t value;
+
+		do {
+			seq = prometheus_cell_read_begin(&cell->seq);
+			value = cell->value;
+		} while (prometheus_cell_read_retry(&cell->seq, seq));
+
+		total += value;
+	}
+
+	return total;
+}
+
 int prometheus_counter_set(struct prometheus_counter *counter, uint64_t value)
 {
 	uint64_t old_value;
@@ -33,18 +66,16 @@ int prometheus_counter_set(struct prometheus_counter *counter, uint64_t value)
 		return -EINVAL;
 	}
 
-	if (value == counter->value) {
+	old_value = prometheus_counter_get(counter);
+	if (value == old_value) {
 		return 0;
 	}
 
-	old_value = counter->value;
 	if (value < old_value) {
 		LOG_DBG("Cannot set counter to a lower value (%" PRIu64 " < %" PRIu64 ")",
 			value, old_value);
 		return -EINVAL;
 	}
 
-	counter->value += (value - old_value);
-
-	return 0;
+	return prometheus_counter_add(counter, value - old_value);
 }
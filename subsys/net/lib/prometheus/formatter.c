@@ -13,6 +13,7 @@
 #include <zephyr/net/prometheus/gauge.h>
 #include <zephyr/net/prometheus/counter.h>
 
+#include <float.h>
 #include <stdarg.h>
 #include <stdio.h>
 #include <string.h>
@@ -24,245 +25,342 @@
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(pm_formatter, CONFIG_PROMETHEUS_LOG_LEVEL);
 
-static int write_metric_to_buffer(char *buffer, size_t buffer_size, const char *format, ...)
+/* Lines of a metric, in exposition order. The value lines follow
+ * FORMAT_LINE_VALUES, see format_next_line().
+ */
+enum {
+	FORMAT_LINE_HELP,
+	FORMAT_LINE_TYPE,
+	FORMAT_LINE_VALUES,
+};
+
+static int format_line(char *buffer, size_t buffer_size, const char *format, ...)
 {
-	/* helper function to write formatted metric to buffer */
 	va_list args;
-	size_t len = strlen(buffer);
-
-	if (len >= buffer_size) {
-		return -ENOMEM;
-	}
-	buffer += len;
-	buffer_size -= len;
+	int len;
 
 	va_start(args, format);
 	len = vsnprintf(buffer, buffer_size, format, args);
 	va_end(args);
-	if (len >= buffer_size) {
+
+	if (len < 0) {
+		return -EINVAL;
+	}
+
+	if ((size_t)len >= buffer_size) {
+		/* Do not leave a partial line behind */
+		if (buffer_size > 0) {
+			buffer[0] = '\0';
+		}
+
 		return -ENOMEM;
 	}
 
-	return 0;
+	return len;
 }
 
-int prometheus_format_one_metric(struct prometheus_metric *metric, char *buffer,
-				 size_t buffer_size, int *written)
+static const char *metric_type_str(enum prometheus_metric_type type)
 {
-	int ret = 0;
+	switch (type) {
+	case PROMETHEUS_COUNTER:
+		return "counter";
+	case PROMETHEUS_GAUGE:
+		return "gauge";
+	case PROMETHEUS_HISTOGRAM:
+		return "histogram";
+	case PROMETHEUS_SUMMARY:
+		return "summary";
+	default:
+		return "untyped";
+	}
+}
 
-	/* write HELP line if available */
-	if (metric->description[0] != '\0') {
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# HELP %s %s\n", metric->name,
-					     metric->description);
-		if (ret < 0) {
-			LOG_ERR("Error writing to buffer");
-			goto out;
-		}
+static int format_counter_line(const struct prometheus_metric *metric, int idx,
+			       char *buffer, size_t buffer_size)
+{
+	const struct prometheus_counter *counter =
+		CONTAINER_OF(metric, struct prometheus_counter, base);
+
+	if (idx >= metric->num_labels) {
+		return 0;
 	}
 
-	/* write TYPE line */
-	switch (metric->type) {
-	case PROMETHEUS_COUNTER:
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# TYPE %s counter\n", metric->name);
-		if (ret < 0) {
-			LOG_ERR("Error writing counter");
-			goto out;
-		}
+	return format_line(buffer, buffer_size, "%s{%s=\"%s\"} %llu\n", metric->name,
+			   metric->labels[idx].key, metric->labels[idx].value,
+			   (unsigned long long)prometheus_counter_get(counter));
+}
 
-		break;
+static int format_gauge_line(const struct prometheus_metric *metric, int idx,
+			     char *buffer, size_t buffer_size)
+{
+	const struct prometheus_gauge *gauge =
+		CONTAINER_OF(metric, struct prometheus_gauge, base);
 
-	case PROMETHEUS_GAUGE:
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# TYPE %s gauge\n", metric->name);
-		if (ret < 0) {
-			LOG_ERR("Error writing gauge");
-			goto out;
-		}
+	if (idx >= metric->num_labels) {
+		return 0;
+	}
 
-		break;
+	return format_line(buffer, buffer_size, "%s{%s=\"%s\"} %f\n", metric->name,
+			   metric->labels[idx].key, metric->labels[idx].value,
+			   prometheus_gauge_get(gauge));
+}
 
-	case PROMETHEUS_HISTOGRAM:
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# TYPE %s histogram\n", metric->name);
-		if (ret < 0) {
-			LOG_ERR("Error writing histogram");
-			goto out;
-		}
+static int format_histogram_line(const struct prometheus_metric *metric, int idx,
+				 char *buffer, size_t buffer_size)
+{
+	const struct prometheus_histogram *histogram =
+		CONTAINER_OF(metric, struct prometheus_histogram, base);
+	int num_buckets = histogram->num_buckets;
+	bool has_inf;
+
+	/* Prometheus requires a +Inf bucket, add one unless the user did */
+	has_inf = num_buckets > 0 && histogram->buckets[num_buckets - 1].upper_bound > DBL_MAX;
+
+	if (idx < num_buckets) {
+		return format_line(buffer, buffer_size, "%s_bucket{le=\"%f\"} %lu\n",
+				   metric->name, histogram->buckets[idx].upper_bound,
+				   prometheus_histogram_get_bucket(histogram, idx));
+	}
 
-		break;
+	idx -= num_buckets;
 
-	case PROMETHEUS_SUMMARY:
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# TYPE %s summary\n", metric->name);
-		if (ret < 0) {
-			LOG_ERR("Error writing summary");
-			goto out;
+	if (!has_inf) {
+		if (idx == 0) {
+			return format_line(buffer, buffer_size, "%s_bucket{le=\"+Inf\"} %lu\n",
+					   metric->name,
+					   prometheus_histogram_get_count(histogram));
 		}
 
-		break;
+		idx--;
+	}
 
+	switch (idx) {
+	case 0:
+		return format_line(buffer, buffer_size, "%s_sum %f\n", metric->name,
+				   prometheus_histogram_get_sum(histogram));
+	case 1:
+		return format_line(buffer, buffer_size, "%s_count %lu\n", metric->name,
+				   prometheus_histogram_get_count(histogram));
 	default:
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# TYPE %s untyped\n", metric->name);
-		if (ret < 0) {
-			LOG_ERR("Error writing untyped");
-			goto out;
-		}
+		return 0;
+	}
+}
 
-		break;
+static int format_summary_line(const struct prometheus_metric *metric, int idx,
+			       char *buffer, size_t buffer_size)
+{
+	const struct prometheus_summary *summary =
+		CONTAINER_OF(metric, struct prometheus_summary, base);
+	int num_quantiles = summary->num_quantiles;
+
+	if (idx < num_quantiles) {
+		return format_line(buffer, buffer_size, "%s{%s=\"%f\"} %f\n", metric->name,
+				   "quantile", summary->quantiles[idx].quantile,
+				   summary->quantiles[idx].value);
 	}
 
-	/* write metric-specific fields */
-	switch (metric->type) {
-	case PROMETHEUS_COUNTER: {
-		const struct prometheus_counter *counter =
-			CONTAINER_OF(metric, struct prometheus_counter, base);
+	switch (idx - num_quantiles) {
+	case 0:
+		return format_line(buffer, buffer_size, "%s_sum %f\n", metric->name,
+				   prometheus_summary_get_sum(summary));
+	case 1:
+		return format_line(buffer, buffer_size, "%s_count %lu\n", metric->name,
+				   prometheus_summary_get_count(summary));
+	default:
+		return 0;
+	}
+}
 
-		LOG_DBG("counter->value: %llu", counter->value);
+/* Format the next line of a metric and advance the line index. Returns the
+ * length of the line, 0 when the metric is complete, -ENOMEM if the line
+ * does not fit (the line index is then left as is).
+ */
+static int format_next_line(const struct prometheus_metric *metric, int *line,
+			    char *buffer, size_t buffer_size)
+{
+	int ret;
 
-		for (int i = 0; i < metric->num_labels; ++i) {
-			ret = write_metric_to_buffer(
-				buffer + *written, buffer_size - *written,
-				"%s{%s=\"%s\"} %llu\n", metric->name, metric->labels[i].key,
-				metric->labels[i].value, counter->value);
-			if (ret < 0) {
-				LOG_ERR("Error writing counter");
-				goto out;
-			}
+	if (*line == FORMAT_LINE_HELP && metric->description[0] == '\0') {
+		(*line)++;
+	}
+
+	switch (*line) {
+	case FORMAT_LINE_HELP:
+		ret = format_line(buffer, buffer_size, "# HELP %s %s\n", metric->name,
+				  metric->description);
+		break;
+
+	case FORMAT_LINE_TYPE:
+		ret = format_line(buffer, buffer_size, "# TYPE %s %s\n", metric->name,
+				  metric_type_str(metric->type));
+		break;
+
+	default:
+		switch (metric->type) {
+		case PROMETHEUS_COUNTER:
+			ret = format_counter_line(metric, *line - FORMAT_LINE_VALUES,
+						  buffer, buffer_size);
+			break;
+		case PROMETHEUS_GAUGE:
+			ret = format_gauge_line(metric, *line - FORMAT_LINE_VALUES,
+						buffer, buffer_size);
+			break;
+		case PROMETHEUS_HISTOGRAM:
+			ret = format_histogram_line(metric, *line - FORMAT_LINE_VALUES,
+						    buffer, buffer_size);
+			break;
+		case PROMETHEUS_SUMMARY:
+			ret = format_summary_line(metric, *line - FORMAT_LINE_VALUES,
+						  buffer, buffer_size);
+			break;
+		default:
+			/* should not happen */
+			LOG_ERR("Unsupported metric type %d", metric->type);
+			ret = -EINVAL;
+			break;
 		}
 
 		break;
 	}
 
-	case PROMETHEUS_GAUGE: {
-		const struct prometheus_gauge *gauge =
-			CONTAINER_OF(metric, struct prometheus_gauge, base);
+	if (ret > 0) {
+		(*line)++;
+	}
 
-		LOG_DBG("gauge->value: %f", gauge->value);
+	return ret;
+}
 
-		for (int i = 0; i < metric->num_labels; ++i) {
-			ret = write_metric_to_buffer(
-				buffer + *written, buffer_size - *written,
-				"%s{%s=\"%s\"} %f\n", metric->name, metric->labels[i].key,
-				metric->labels[i].value, gauge->value);
-			if (ret < 0) {
-				LOG_ERR("Error writing gauge");
-				goto out;
-			}
-		}
+int prometheus_format_one_metric(struct prometheus_metric *metric, char *buffer,
+				 size_t buffer_size, int *written)
+{
+	size_t len;
+	int line = 0;
+	int ret;
 
-		break;
+	if (*written < 0 || (size_t)*written >= buffer_size) {
+		return -ENOMEM;
 	}
 
-	case PROMETHEUS_HISTOGRAM: {
-		const struct prometheus_histogram *histogram =
-			CONTAINER_OF(metric, struct prometheus_histogram, base);
+	/* Append to whatever is already in the buffer */
+	len = *written + strnlen(buffer + *written, buffer_size - *written);
 
-		LOG_DBG("histogram->count: %lu", histogram->count);
+	while ((ret = format_next_line(metric, &line, buffer + len, buffer_size - len)) > 0) {
+		len += ret;
+	}
 
-		for (int i = 0; i < histogram->num_buckets; ++i) {
-			ret = write_metric_to_buffer(
-				buffer + *written, buffer_size - *written,
-				"%s_bucket{le=\"%f\"} %lu\n", metric->name,
-				histogram->buckets[i].upper_bound,
-				histogram->buckets[i].count);
-			if (ret < 0) {
-				LOG_ERR("Error writing histogram");
-				goto out;
-			}
-		}
+	if (ret < 0) {
+		LOG_ERR("Error writing %s (%d)", metric->name, ret);
+		return ret;
+	}
 
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "%s_sum %f\n", metric->name, histogram->sum);
-		if (ret < 0) {
-			LOG_ERR("Error writing histogram");
-			goto out;
-		}
+	*written = len;
 
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "%s_count %lu\n", metric->name,
-					     histogram->count);
-		if (ret < 0) {
-			LOG_ERR("Error writing histogram");
-			goto out;
-		}
+	return 0;
+}
 
-		break;
+int prometheus_format_exposition(struct prometheus_collector *collector, char *buffer,
+				 size_t buffer_size)
+{
+	struct prometheus_metric *metric;
+	struct prometheus_metric *tmp;
+	int written = 0;
+	int ret = 0;
+
+	if (collector == NULL || buffer == NULL || buffer_size == 0) {
+		LOG_ERR("Invalid arguments");
+		return -EINVAL;
 	}
 
-	case PROMETHEUS_SUMMARY: {
-		const struct prometheus_summary *summary =
-			CONTAINER_OF(metric, struct prometheus_summary, base);
+	k_mutex_lock(&collector->lock, K_FOREVER);
 
-		LOG_DBG("summary->count: %lu", summary->count);
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&collector->metrics, metric, tmp, node) {
 
-		for (int i = 0; i < summary->num_quantiles; ++i) {
-			ret = write_metric_to_buffer(
-				buffer + *written, buffer_size - *written,
-				"%s{%s=\"%f\"} %f\n", metric->name, "quantile",
-				summary->quantiles[i].quantile,
-				summary->quantiles[i].value);
+		/* If there is a user callback, use it to update the metric data. */
+		if (collector->user_cb) {
+			ret = collector->user_cb(collector, metric, collector->user_data);
 			if (ret < 0) {
-				LOG_ERR("Error writing summary");
+				if (ret == -EAGAIN) {
+					/* Skip this metric for now */
+					continue;
+				}
+
+				LOG_ERR("Error in user callback (%d)", ret);
 				goto out;
 			}
 		}
 
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "%s_sum %f\n", metric->name, summary->sum);
+		ret = prometheus_format_one_metric(metric, buffer, buffer_size, &written);
 		if (ret < 0) {
-			LOG_ERR("Error writing summary");
 			goto out;
 		}
+	}
 
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "%s_count %lu\n", metric->name,
-					     summary->count);
-		if (ret < 0) {
-			LOG_ERR("Error writing summary");
-			goto out;
-		}
+out:
+	k_mutex_unlock(&collector->lock);
 
-		break;
-	}
+	return ret;
+}
 
-	default:
-		/* should not happen */
-		LOG_ERR("Unsupported metric type %d", metric->type);
-		ret = -EINVAL;
-		goto out;
+int prometheus_format_stream_init(struct prometheus_format_stream *stream,
+				  struct prometheus_collector *collector)
+{
+	if (stream == NULL || collector == NULL) {
+		return -EINVAL;
 	}
 
-out:
-	return ret;
+	stream->collector = collector;
+	stream->metric = NULL;
+	stream->line = 0;
+	stream->scraped = false;
+	stream->started = false;
+
+	return 0;
 }
 
-int prometheus_format_exposition(struct prometheus_collector *collector, char *buffer,
-				 size_t buffer_size)
+static void stream_next_metric(struct prometheus_format_stream *stream)
 {
-	struct prometheus_metric *metric;
-	struct prometheus_metric *tmp;
-	int written = 0;
+	stream->metric = SYS_SLIST_PEEK_NEXT_CONTAINER(stream->metric, node);
+	stream->line = 0;
+	stream->scraped = false;
+}
+
+int prometheus_format_stream(struct prometheus_format_stream *stream, char *buffer,
+			     size_t buffer_size, size_t *len)
+{
+	struct prometheus_collector *collector;
+	size_t written = 0;
 	int ret = 0;
 
-	if (collector == NULL || buffer == NULL || buffer_size == 0) {
+	if (stream == NULL || stream->collector == NULL || buffer == NULL ||
+	    buffer_size == 0 || len == NULL) {
 		LOG_ERR("Invalid arguments");
 		return -EINVAL;
 	}
 
+	collector = stream->collector;
+	buffer[0] = '\0';
+
+	/* The lock is only held while a chunk is formatted. Metrics are never
+	 * freed, so the position stays valid while the chunk is being sent.
+	 */
 	k_mutex_lock(&collector->lock, K_FOREVER);
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&collector->metrics, metric, tmp, node) {
+	if (!stream->started) {
+		stream->metric = SYS_SLIST_PEEK_HEAD_CONTAINER(&collector->metrics,
+							       stream->metric, node);
+		stream->started = true;
+	}
 
+	while (stream->metric != NULL) {
 		/* If there is a user callback, use it to update the metric data. */
-		if (collector->user_cb) {
-			ret = collector->user_cb(collector, metric, collector->user_data);
+		if (!stream->scraped && collector->user_cb) {
+			ret = collector->user_cb(collector, stream->metric,
+						 collector->user_data);
 			if (ret < 0) {
 				if (ret == -EAGAIN) {
 					/* Skip this metric for now */
+					stream_next_metric(stream);
+					ret = 0;
 					continue;
 				}
 
@@ -271,14 +369,81 @@ int prometheus_format_exposition(struct prometheus_collector *collector, char *b
 			}
 		}
 
-		ret = prometheus_format_one_metric(metric, buffer, buffer_size, &written);
+		stream->scraped = true;
+
+		ret = format_next_line(stream->metric, &stream->line, buffer + written,
+				       buffer_size - written);
+		if (ret == -ENOMEM && written > 0) {
+			/* Chunk is full, continue from this line next time */
+			ret = -EAGAIN;
+			goto out;
+		}
+
 		if (ret < 0) {
+			LOG_ERR("Error writing %s (%d)", stream->metric->name, ret);
 			goto out;
 		}
+
+		if (ret == 0) {
+			stream_next_metric(stream);
+			continue;
+		}
+
+		written += ret;
 	}
 
 out:
 	k_mutex_unlock(&collector->lock);
 
+	*len = written;
+
 	return ret;
 }
+
+int prometheus_http_handler(struct http_client_ctx *client, enum http_data_status status,
+			    const struct http_request_ctx *request_ctx,
+			    struct http_response_ctx *response_ctx, void *user_data)
+{
+	struct prometheus_http_context *ctx = user_data;
+	size_t len = 0;
+	int ret;
+
+	ARG_UNUSED(client);
+	ARG_UNUSED(request_ctx);
+
+	if (status == HTTP_SERVER_DATA_ABORTED) {
+		ctx->streaming = false;
+		return 0;
+	}
+
+	if (status != HTTP_SERVER_DATA_FINAL) {
+		return 0;
+	}
+
+	if (!ctx->streaming) {
+		ret = prometheus_format_stream_init(&ctx->stream, ctx->collector);
+		if (ret < 0) {
+			return ret;
+		}
+
+		ctx->streaming = true;
+	}
+
+	/* The server calls us again for the next chunk until final_chunk is set */
+	ret = prometheus_format_stream(&ctx->stream, ctx->buffer, ctx->buffer_size, &len);
+	if (ret < 0 && ret != -EAGAIN) {
+		LOG_ERR("Cannot format exposition data (%d)", ret);
+		ctx->streaming = false;
+		return ret;
+	}
+
+	response_ctx->body = (const uint8_t *)ctx->buffer;
+	response_ctx->body_len = len;
+	response_ctx->final_chunk = (ret == 0);
+
+	if (ret == 0) {
+		ctx->streaming = false;
+	}
+
+	return 0;
+}
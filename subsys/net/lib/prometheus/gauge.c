@@ -22,8 +22,25 @@ int prometheus_gauge_set(struct prometheus_gauge *gauge, double value)
 	}
 
 	if (gauge) {
-		gauge->value = value;
+		K_SPINLOCK(&gauge->lock) {
+			gauge->value = value;
+		}
 	}
 
 	return 0;
 }
+
+double prometheus_gauge_get(const struct prometheus_gauge *gauge)
+{
+	/* The lock is only needed because a double store is not atomic on
+	 * all architectures, the gauge itself is not modified.
+	 */
+	struct k_spinlock *lock = (struct k_spinlock *)&gauge->lock;
+	double value = 0.0;
+
+	K_SPINLOCK(lock) {
+		value = gauge->value;
+	}
+
+	return value;
+}
@@ -14,30 +14,93 @@
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(pm_histogram, CONFIG_PROMETHEUS_LOG_LEVEL);
 
+#include "prometheus_cell.h"
+
 int prometheus_histogram_observe(struct prometheus_histogram *histogram, double value)
 {
+	struct prometheus_histogram_cell *cell;
+	unsigned int key;
+	size_t bucket;
+	int cpu;
+
 	if (!histogram) {
 		return -EINVAL;
 	}
 
+	/* find appropriate bucket, the cumulative counts are computed when
+	 * the histogram is read
+	 */
+	for (bucket = 0; bucket < histogram->num_buckets; ++bucket) {
+		if (value <= histogram->buckets[bucket].upper_bound) {
+			break;
+		}
+	}
+
+	key = prometheus_cell_lock(&cpu);
+	cell = &histogram->cells[cpu];
+
+	prometheus_cell_write_begin(&cell->seq);
+
 	/* increment count */
-	histogram->count++;
+	cell->count++;
 
 	/* update sum */
-	histogram->sum += value;
+	cell->sum += value;
 
-	/* find appropriate bucket */
-	for (size_t i = 0; i < histogram->num_buckets; ++i) {
-		if (value <= histogram->buckets[i].upper_bound) {
-			/* increment count for the bucket */
-			histogram->buckets[i].count++;
+	if (bucket < histogram->num_buckets) {
+		/* increment count for the bucket */
+		histogram->buckets[bucket].cells[cpu]++;
+	}
 
-			LOG_DBG("value: %f, bucket: %f, count: %lu", value,
-				histogram->buckets[i].upper_bound, histogram->buckets[i].count);
+	prometheus_cell_write_end(&cell->seq);
 
-			break;
+	prometheus_cell_unlock(key);
+
+	return 0;
+}
+
+double prometheus_histogram_get_sum(const struct prometheus_histogram *histogram)
+{
+	double total = 0.0;
+
+	for (int i = 0; i < ARRAY_SIZE(histogram->cells); i++) {
+		const struct prometheus_histogram_cell *cell = &histogram->cells[i];
+		atomic_val_t seq;
+		double sum;
+
+		do {
+			seq = prometheus_cell_read_begin(&cell->seq);
+			sum = cell->sum;
+		} while (prometheus_cell_read_retry(&cell->seq, seq));
+
+		total += sum;
+	}
+
+	return total;
+}
+
+unsigned long prometheus_histogram_get_count(const struct prometheus_histogram *histogram)
+{
+	unsigned long total = 0;
+
+	/* A single word is always read atomically */
+	for (int i = 0; i < ARRAY_SIZE(histogram->cells); i++) {
+		total += histogram->cells[i].count;
+	}
+
+	return total;
+}
+
+unsigned long prometheus_histogram_get_bucket(const struct prometheus_histogram *histogram,
+					      size_t bucket)
+{
+	unsigned long total = 0;
+
+	for (size_t i = 0; i <= bucket && i < histogram->num_buckets; i++) {
+		for (int cpu = 0; cpu < PROMETHEUS_CELL_COUNT; cpu++) {
+			total += histogram->buckets[i].cells[cpu];
 		}
 	}
 
-	return 0;
+	return total;
 }
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_SUBSYS_NET_LIB_PROMETHEUS_CELL_H_
+#define ZEPHYR_SUBSYS_NET_LIB_PROMETHEUS_CELL_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/barrier.h>
+#include <zephyr/net/prometheus/metric.h>
+
+/* Each CPU only writes its own cell, with local interrupts locked so that
+ * an ISR cannot interleave with a thread updating the same cell. The
+ * sequence count is odd while a cell is being written, which lets readers
+ * on other CPUs (or threads interrupted by a writer) retry instead of using
+ * a torn value.
+ */
+
+static inline unsigned int prometheus_cell_lock(int *cell)
+{
+	unsigned int key = arch_irq_lock();
+
+#if PROMETHEUS_CELL_COUNT > 1
+	*cell = arch_curr_cpu()->id;
+#else
+	*cell = 0;
+#endif
+
+	return key;
+}
+
+static inline void prometheus_cell_unlock(unsigned int key)
+{
+	arch_irq_unlock(key);
+}
+
+static inline void prometheus_cell_write_begin(atomic_t *seq)
+{
+	/* Only the owning CPU writes the sequence count */
+	atomic_set(seq, atomic_get(seq) + 1);
+	barrier_dmem_fence_full();
+}
+
+static inline void prometheus_cell_write_end(atomic_t *seq)
+{
+	barrier_dmem_fence_full();
+	atomic_set(seq, atomic_get(seq) + 1);
+}
+
+static inline atomic_val_t prometheus_cell_read_begin(const atomic_t *seq)
+{
+	atomic_val_t start;
+
+	while (((start = atomic_get(seq)) & 1) != 0) {
+	}
+
+	barrier_dmem_fence_full();
+
+	return start;
+}
+
+static inline bool prometheus_cell_read_retry(const atomic_t *seq, atomic_val_t start)
+{
+	barrier_dmem_fence_full();
+
+	return atomic_get(seq) != start;
+}
+
+#endif /* ZEPHYR_SUBSYS_NET_LIB_PROMETHEUS_CELL_H_ */
@@ -14,17 +14,33 @@
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(pm_summary, CONFIG_PROMETHEUS_LOG_LEVEL);
 
+#include "prometheus_cell.h"
+
+static void summary_add(struct prometheus_summary *summary, double value,
+			unsigned long count)
+{
+	struct prometheus_summary_cell *cell;
+	unsigned int key;
+	int cpu;
+
+	key = prometheus_cell_lock(&cpu);
+	cell = &summary->cells[cpu];
+
+	prometheus_cell_write_begin(&cell->seq);
+	cell->count += count;
+	cell->sum += value;
+	prometheus_cell_write_end(&cell->seq);
+
+	prometheus_cell_unlock(key);
+}
+
 int prometheus_summary_observe(struct prometheus_summary *summary, double value)
 {
 	if (!summary) {
 		return -EINVAL;
 	}
 
-	/* increment count */
-	summary->count++;
-
-	/* update sum */
-	summary->sum += value;
+	summary_add(summary, value, 1);
 
 	return 0;
 }
@@ -39,20 +55,51 @@ int prometheus_summary_observe_set(struct prometheus_summary *summary,
 		return -EINVAL;
 	}
 
-	if (value == summary->sum && count == summary->count) {
+	old_count = prometheus_summary_get_count(summary);
+	old_sum = prometheus_summary_get_sum(summary);
+
+	if (value == old_sum && count == old_count) {
 		return 0;
 	}
 
-	old_count = summary->count;
 	if (count < old_count) {
 		LOG_DBG("Cannot set summary count to a lower value");
 		return -EINVAL;
 	}
 
-	summary->count += (count - old_count);
-
-	old_sum = summary->sum;
-	summary->sum += (value - old_sum);
+	summary_add(summary, value - old_sum, count - old_count);
 
 	return 0;
 }
+
+double prometheus_summary_get_sum(const struct prometheus_summary *summary)
+{
+	double total = 0.0;
+
+	for (int i = 0; i < ARRAY_SIZE(summary->cells); i++) {
+		const struct prometheus_summary_cell *cell = &summary->cells[i];
+		atomic_val_t seq;
+		double sum;
+
+		do {
+			seq = prometheus_cell_read_begin(&cell->seq);
+			sum = cell->sum;
+		} while (prometheus_cell_read_retry(&cell->seq, seq));
+
+		total += sum;
+	}
+
+	return total;
+}
+
+unsigned long prometheus_summary_get_count(const struct prometheus_summary *summary)
+{
+	unsigned long total = 0;
+
+	/* A single word is always read atomically */
+	for (int i = 0; i < ARRAY_SIZE(summary->cells); i++) {
+		total += summary->cells[i].count;
+	}
+
+	return total;
+}
@@ -710,6 +710,75 @@ fail:
 #include <zephyr/syscalls/zsock_recvmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+/* The zero-copy calls pass kernel objects around, so they are not system
+ * calls. They are routed through the ioctl handler so that only the socket
+ * types that know about them (native inet sockets) accept them.
+ */
+static int sock_buf_ioctl(int sock, unsigned int request, ...)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	va_list args;
+	void *obj;
+	int ret;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	va_start(args, request);
+	ret = vtable->fd_vtable.ioctl(obj, request, args);
+	va_end(args);
+
+	k_mutex_unlock(lock);
+
+	return ret;
+}
+
+ssize_t zsock_sendto_buf(int sock, struct net_buf *buf, int flags,
+			 const struct sockaddr *dest_addr, socklen_t addrlen)
+{
+	int bytes_sent;
+
+	if (buf == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	bytes_sent = sock_buf_ioctl(sock, ZFD_IOCTL_SENDTO_BUF, buf, flags,
+				    dest_addr, addrlen);
+
+	sock_obj_core_update_send_stats(sock, bytes_sent);
+
+	return bytes_sent;
+}
+
+ssize_t zsock_recvfrom_buf(int sock, struct net_buf **buf, int flags,
+			   struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	int bytes_received;
+
+	if (buf == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	*buf = NULL;
+
+	bytes_received = sock_buf_ioctl(sock, ZFD_IOCTL_RECVFROM_BUF, buf,
+					flags, src_addr, addrlen);
+
+	sock_obj_core_update_recv_stats(sock, bytes_received);
+
+	return bytes_received;
+}
+#endif /* CONFIG_NET_SOCKETS_ZEROCOPY */
+
 /* As this is limited function, we don't follow POSIX signature, with
  * "..." instead of last arg.
  */
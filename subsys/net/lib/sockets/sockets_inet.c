@@ -82,6 +82,25 @@ static void zsock_flush_queue(struct net_context *ctx)
 	(void)k_condvar_signal(&ctx->cond.recv);
 }
 
+/* Let the epoll instances watching the socket know about a readiness change */
+static void zsock_notify(struct net_context *ctx, short events)
+{
+#if defined(CONFIG_ZVFS_EPOLL)
+	if (sock_is_error(ctx)) {
+		events |= ZSOCK_POLLERR;
+	}
+
+	if (sock_is_eof(ctx)) {
+		events |= ZSOCK_POLLHUP;
+	}
+
+	zvfs_poll_notify(&ctx->poll_notifiers, events);
+#else
+	ARG_UNUSED(ctx);
+	ARG_UNUSED(events);
+#endif
+}
+
 static int zsock_socket_internal(int family, int type, int proto)
 {
 	int fd = zvfs_reserve_fd();
@@ -123,6 +142,10 @@ static int zsock_socket_internal(int family, int type, int proto)
 	 */
 	k_condvar_init(&ctx->cond.recv);
 
+#if defined(CONFIG_ZVFS_EPOLL)
+	sys_slist_init(&ctx->poll_notifiers);
+#endif
+
 	/* TCP context is effectively owned by both application
 	 * and the stack: stack may detect that peer closed/aborted
 	 * connection, but it must not dispose of the context behind
@@ -166,6 +189,9 @@ int zsock_close_ctx(struct net_context *ctx, int sock)
 
 	zsock_flush_queue(ctx);
 
+	/* Detaches the notifiers, the epoll instances drop the socket */
+	zsock_notify(ctx, ZSOCK_POLLNVAL);
+
 	ret = net_context_put(ctx);
 	if (ret < 0) {
 		errno = -ret;
@@ -195,6 +221,9 @@ static void zsock_accepted_cb(struct net_context *new_ctx,
 				       NULL);
 		k_fifo_init(&new_ctx->recv_q);
 		k_condvar_init(&new_ctx->cond.recv);
+#if defined(CONFIG_ZVFS_EPOLL)
+		sys_slist_init(&new_ctx->poll_notifiers);
+#endif
 
 		k_fifo_put(&parent->accept_q, new_ctx);
 
@@ -208,6 +237,8 @@ static void zsock_accepted_cb(struct net_context *new_ctx,
 		net_context_ref(new_ctx);
 
 		(void)k_condvar_signal(&parent->cond.recv);
+
+		zsock_notify(parent, ZSOCK_POLLIN);
 	}
 
 }
@@ -262,6 +293,8 @@ unlock:
 	/* Wake reader if it was sleeping */
 	(void)k_condvar_signal(&ctx->cond.recv);
 
+	zsock_notify(ctx, ZSOCK_POLLIN);
+
 	if (ctx->cond.lock) {
 		(void)k_mutex_unlock(ctx->cond.lock);
 	}
@@ -290,6 +323,8 @@ int zsock_shutdown_ctx(struct net_context *ctx, int how)
 
 		zsock_flush_queue(ctx);
 
+		zsock_notify(ctx, ZSOCK_POLLIN);
+
 		return 0;
 	}
 
@@ -335,6 +370,8 @@ static void zsock_connected_cb(struct net_context *ctx, int status, void *user_d
 		ctx->user_data = INT_TO_POINTER(-status);
 		sock_set_error(ctx);
 	}
+
+	zsock_notify(ctx, ZSOCK_POLLOUT);
 }
 
 int zsock_connect_ctx(struct net_context *ctx, const struct sockaddr *addr,
@@ -1052,6 +1089,42 @@ static int update_msg_controllen(struct msghdr *msg)
 	return 0;
 }
 
+static int sock_get_src_addr(struct net_context *ctx, struct net_pkt *pkt,
+			     struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	int ret;
+
+	if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
+	    net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
+		ret = sock_get_offload_pkt_src_addr(pkt, ctx, src_addr,
+						    *addrlen);
+		if (ret < 0) {
+			NET_DBG("sock_get_offload_pkt_src_addr %d", ret);
+			return ret;
+		}
+	} else {
+		ret = sock_get_pkt_src_addr(pkt, net_context_get_proto(ctx),
+					    src_addr, *addrlen);
+		if (ret < 0) {
+			NET_DBG("sock_get_pkt_src_addr %d", ret);
+			return ret;
+		}
+	}
+
+	/* addrlen is a value-result argument, set to actual
+	 * size of source address
+	 */
+	if (src_addr->sa_family == AF_INET) {
+		*addrlen = sizeof(struct sockaddr_in);
+	} else if (src_addr->sa_family == AF_INET6) {
+		*addrlen = sizeof(struct sockaddr_in6);
+	} else {
+		return -ENOTSUP;
+	}
+
+	return 0;
+}
+
 static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 				       struct msghdr *msg,
 				       void *buf,
@@ -1103,38 +1176,11 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 	net_pkt_cursor_backup(pkt, &backup);
 
 	if (src_addr && addrlen) {
-		if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
-		    net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
-			int ret;
-
-			ret  = sock_get_offload_pkt_src_addr(pkt, ctx, src_addr,
-								*addrlen);
-			if (ret < 0) {
-				errno = -ret;
-				NET_DBG("sock_get_offload_pkt_src_addr %d", ret);
-				goto fail;
-			}
-		} else {
-			int ret;
-
-			ret = sock_get_pkt_src_addr(pkt, net_context_get_proto(ctx),
-						   src_addr, *addrlen);
-			if (ret < 0) {
-				errno = -ret;
-				NET_DBG("sock_get_pkt_src_addr %d", ret);
-				goto fail;
-			}
-		}
+		int ret;
 
-		/* addrlen is a value-result argument, set to actual
-		 * size of source address
-		 */
-		if (src_addr->sa_family == AF_INET) {
-			*addrlen = sizeof(struct sockaddr_in);
-		} else if (src_addr->sa_family == AF_INET6) {
-			*addrlen = sizeof(struct sockaddr_in6);
-		} else {
-			errno = ENOTSUP;
+		ret = sock_get_src_addr(ctx, pkt, src_addr, addrlen);
+		if (ret < 0) {
+			errno = -ret;
 			goto fail;
 		}
 	}
@@ -1506,6 +1552,255 @@ ssize_t zsock_recvmsg_ctx(struct net_context *ctx, struct msghdr *msg,
 	return -1;
 }
 
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+static ssize_t zsock_sendto_buf_ctx(struct net_context *ctx,
+				    struct net_buf *buf, int flags,
+				    const struct sockaddr *dest_addr,
+				    socklen_t addrlen)
+{
+	k_timeout_t timeout = K_FOREVER;
+	uint32_t retry_timeout = WAIT_BUFS_INITIAL_MS;
+	k_timepoint_t buf_timeout, end;
+	int status;
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+		buf_timeout = sys_timepoint_calc(K_NO_WAIT);
+	} else {
+		net_context_get_option(ctx, NET_OPT_SNDTIMEO, &timeout, NULL);
+		buf_timeout = sys_timepoint_calc(MAX_WAIT_BUFS);
+	}
+	end = sys_timepoint_calc(timeout);
+
+	/* Register the callback before sending in order to receive the response
+	 * from the peer.
+	 */
+	status = net_context_recv(ctx, zsock_received_cb,
+				  K_NO_WAIT, ctx->user_data);
+	if (status < 0) {
+		errno = -status;
+		return -1;
+	}
+
+	while (1) {
+		/* The buffers are still ours if the sending fails, so they
+		 * can be retried as is.
+		 */
+		status = net_context_sendto_buf(ctx, buf, dest_addr, addrlen,
+						NULL, timeout, ctx->user_data);
+		if (status < 0) {
+			status = send_check_and_wait(ctx, status, buf_timeout,
+						     timeout, &retry_timeout);
+			if (status < 0) {
+				return status;
+			}
+
+			/* Update the timeout value in case loop is repeated. */
+			timeout = sys_timepoint_timeout(end);
+
+			continue;
+		}
+
+		break;
+	}
+
+	return status;
+}
+
+/* Detach the unread data of a received packet from it. The headers that
+ * were already parsed and any trailing bytes are dropped, so the returned
+ * chain only contains the payload.
+ */
+static struct net_buf *pkt_detach_payload(struct net_pkt *pkt, size_t len)
+{
+	size_t skip = net_pkt_get_current_offset(pkt);
+	struct net_buf *frags = pkt->buffer;
+	struct net_buf *frag;
+
+	pkt->buffer = NULL;
+
+	while (frags != NULL && skip >= frags->len) {
+		skip -= frags->len;
+		frags = net_buf_frag_del(NULL, frags);
+	}
+
+	if (frags == NULL || len == 0) {
+		if (frags != NULL) {
+			net_buf_unref(frags);
+		}
+
+		return NULL;
+	}
+
+	net_buf_pull(frags, skip);
+
+	for (frag = frags; frag != NULL; frag = frag->frags) {
+		if (frag->len >= len) {
+			frag->len = len;
+
+			if (frag->frags != NULL) {
+				net_buf_unref(frag->frags);
+				frag->frags = NULL;
+			}
+
+			break;
+		}
+
+		len -= frag->len;
+	}
+
+	return frags;
+}
+
+static ssize_t zsock_recv_dgram_buf(struct net_context *ctx,
+				    struct net_buf **buf, int flags,
+				    struct sockaddr *src_addr,
+				    socklen_t *addrlen)
+{
+	k_timeout_t timeout = K_FOREVER;
+	struct net_pkt *pkt;
+	size_t recv_len;
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else {
+		int ret;
+
+		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
+
+		ret = zsock_wait_data(ctx, &timeout);
+		if (ret < 0) {
+			errno = -ret;
+			return -1;
+		}
+	}
+
+	pkt = k_fifo_get(&ctx->recv_q, timeout);
+	if (!pkt) {
+		errno = EAGAIN;
+		return -1;
+	}
+
+	if (src_addr && addrlen) {
+		int ret;
+
+		ret = sock_get_src_addr(ctx, pkt, src_addr, addrlen);
+		if (ret < 0) {
+			net_pkt_unref(pkt);
+			errno = -ret;
+			return -1;
+		}
+	}
+
+	recv_len = net_pkt_remaining_data(pkt);
+	*buf = pkt_detach_payload(pkt, recv_len);
+
+	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS) ||
+	    IS_ENABLED(CONFIG_TRACING_NET_CORE)) {
+		net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+	}
+
+	net_pkt_unref(pkt);
+
+	return recv_len;
+}
+
+static ssize_t zsock_recv_stream_buf(struct net_context *ctx,
+				     struct net_buf **buf, int flags)
+{
+	k_timeout_t timeout = K_FOREVER;
+	struct net_pkt *pkt;
+	size_t recv_len;
+	int res;
+
+	if (!net_context_is_used(ctx)) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (net_context_get_state(ctx) != NET_CONTEXT_CONNECTED) {
+		errno = ENOTCONN;
+		return -1;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else if (!sock_is_eof(ctx) && !sock_is_error(ctx)) {
+		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
+	}
+
+	do {
+		if (sock_is_error(ctx)) {
+			errno = POINTER_TO_INT(ctx->user_data);
+			return -1;
+		}
+
+		if (sock_is_eof(ctx)) {
+			return 0;
+		}
+
+		if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			res = zsock_wait_data(ctx, &timeout);
+			if (res < 0) {
+				errno = -res;
+				return -1;
+			}
+		}
+
+		pkt = k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+		if (pkt == NULL) {
+			errno = EAGAIN;
+			return -1;
+		}
+
+		if (net_pkt_eof(pkt)) {
+			sock_set_eof(ctx);
+		}
+
+		recv_len = net_pkt_remaining_data(pkt);
+		*buf = pkt_detach_payload(pkt, recv_len);
+
+		if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS) ||
+		    IS_ENABLED(CONFIG_TRACING_NET_CORE)) {
+			net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+		}
+
+		net_pkt_unref(pkt);
+
+		/* Skip the packets that only carried the EOF marker */
+	} while (recv_len == 0);
+
+	net_context_update_recv_wnd(ctx, recv_len);
+
+	return recv_len;
+}
+
+static ssize_t zsock_recvfrom_buf_ctx(struct net_context *ctx,
+				      struct net_buf **buf, int flags,
+				      struct sockaddr *src_addr,
+				      socklen_t *addrlen)
+{
+	enum net_sock_type sock_type = net_context_get_type(ctx);
+
+	if ((flags & ZSOCK_MSG_PEEK) ||
+	    (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
+	     net_if_is_ip_offloaded(net_context_get_iface(ctx)))) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if (sock_type == SOCK_DGRAM) {
+		return zsock_recv_dgram_buf(ctx, buf, flags, src_addr, addrlen);
+	} else if (sock_type == SOCK_STREAM) {
+		return zsock_recv_stream_buf(ctx, buf, flags);
+	}
+
+	errno = EOPNOTSUPP;
+
+	return -1;
+}
+#endif /* CONFIG_NET_SOCKETS_ZEROCOPY */
+
 static int zsock_poll_prepare_ctx(struct net_context *ctx,
 				  struct zsock_pollfd *pfd,
 				  struct k_poll_event **pev,
@@ -1595,6 +1890,43 @@ static int zsock_poll_update_ctx(struct net_context *ctx,
 	return 0;
 }
 
+#if defined(CONFIG_ZVFS_EPOLL)
+/* Same readiness rules as zsock_poll_update_ctx(), without k_poll events */
+static int zsock_poll_status_ctx(struct net_context *ctx, int events)
+{
+	int revents = 0;
+
+	if (events & ZSOCK_POLLIN) {
+		if (!k_fifo_is_empty(&ctx->recv_q) || sock_is_eof(ctx)) {
+			revents |= ZSOCK_POLLIN;
+		}
+	}
+
+	if (events & ZSOCK_POLLOUT) {
+		if (IS_ENABLED(CONFIG_NET_NATIVE_TCP) &&
+		    net_context_get_type(ctx) == SOCK_STREAM) {
+			if (k_sem_count_get(net_tcp_tx_sem_get(ctx)) > 0 &&
+			    !sock_is_eof(ctx) &&
+			    (net_context_get_state(ctx) == NET_CONTEXT_CONNECTED)) {
+				revents |= ZSOCK_POLLOUT;
+			}
+		} else {
+			revents |= ZSOCK_POLLOUT;
+		}
+	}
+
+	if (sock_is_error(ctx)) {
+		revents |= ZSOCK_POLLERR;
+	}
+
+	if (sock_is_eof(ctx)) {
+		revents |= ZSOCK_POLLHUP;
+	}
+
+	return revents;
+}
+#endif /* CONFIG_ZVFS_EPOLL */
+
 static enum tcp_conn_option get_tcp_option(int optname)
 {
 	switch (optname) {
@@ -2919,6 +3251,68 @@ static int sock_ioctl_vmeth(void *obj, unsigned int request, va_list args)
 		return 0;
 	}
 
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+	case ZFD_IOCTL_SENDTO_BUF: {
+		struct net_buf *buf;
+		const struct sockaddr *dest_addr;
+		socklen_t addrlen;
+		int flags;
+
+		buf = va_arg(args, struct net_buf *);
+		flags = va_arg(args, int);
+		dest_addr = va_arg(args, const struct sockaddr *);
+		addrlen = va_arg(args, socklen_t);
+
+		return zsock_sendto_buf_ctx(obj, buf, flags, dest_addr, addrlen);
+	}
+
+	case ZFD_IOCTL_RECVFROM_BUF: {
+		struct net_buf **buf;
+		struct sockaddr *src_addr;
+		socklen_t *addrlen;
+		int flags;
+
+		buf = va_arg(args, struct net_buf **);
+		flags = va_arg(args, int);
+		src_addr = va_arg(args, struct sockaddr *);
+		addrlen = va_arg(args, socklen_t *);
+
+		return zsock_recvfrom_buf_ctx(obj, buf, flags, src_addr, addrlen);
+	}
+#endif /* CONFIG_NET_SOCKETS_ZEROCOPY */
+
+#if defined(CONFIG_ZVFS_EPOLL)
+	case ZFD_IOCTL_POLL_NOTIFIER_ADD:
+	case ZFD_IOCTL_POLL_NOTIFIER_REMOVE: {
+		struct net_context *ctx = obj;
+		struct zvfs_poll_notifier *notifier;
+
+		if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
+		    net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
+			errno = EOPNOTSUPP;
+			return -1;
+		}
+
+		notifier = va_arg(args, struct zvfs_poll_notifier *);
+
+		if (request == ZFD_IOCTL_POLL_NOTIFIER_ADD) {
+			zvfs_poll_notifier_add(&ctx->poll_notifiers, notifier);
+		} else {
+			zvfs_poll_notifier_remove(&ctx->poll_notifiers, notifier);
+		}
+
+		return 0;
+	}
+
+	case ZFD_IOCTL_POLL_STATUS: {
+		int events;
+
+		events = va_arg(args, int);
+
+		return zsock_poll_status_ctx(obj, events);
+	}
+#endif /* CONFIG_ZVFS_EPOLL */
+
 	default:
 		errno = EOPNOTSUPP;
 		return -1;
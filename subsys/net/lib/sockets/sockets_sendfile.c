@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_sock_sendfile, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net_buf.h>
+
+#define SENDFILE_BUF_SIZE CONFIG_NET_SOCKETS_SENDFILE_BUF_SIZE
+
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+NET_BUF_POOL_FIXED_DEFINE(sendfile_pool, CONFIG_NET_SOCKETS_SENDFILE_BUF_COUNT,
+			  SENDFILE_BUF_SIZE, 0, NULL);
+
+/* Read the file straight into a network buffer and hand it over to the
+ * stack, which releases it back to the pool once the data is sent.
+ */
+static ssize_t sendfile_chunk_buf(int sock, struct fs_file_t *file, size_t len)
+{
+	struct net_buf *buf;
+	ssize_t ret;
+
+	buf = net_buf_alloc(&sendfile_pool, K_NO_WAIT);
+	if (buf == NULL) {
+		return -ENOBUFS;
+	}
+
+	ret = fs_read(file, buf->data, len);
+	if (ret <= 0) {
+		net_buf_unref(buf);
+		return ret;
+	}
+
+	net_buf_add(buf, ret);
+
+	if (zsock_sendto_buf(sock, buf, 0, NULL, 0) < 0) {
+		int err = errno;
+
+		/* The buffer is still ours, rewind so that the data is sent
+		 * again by the next attempt.
+		 */
+		(void)fs_seek(file, -(off_t)buf->len, FS_SEEK_CUR);
+		net_buf_unref(buf);
+
+		return -err;
+	}
+
+	return ret;
+}
+#endif /* CONFIG_NET_SOCKETS_ZEROCOPY */
+
+/* Kept out of line so that the chunk buffer only takes stack space when
+ * the data has to be copied.
+ */
+static __noinline ssize_t sendfile_chunk_copy(int sock, struct fs_file_t *file,
+					      size_t len)
+{
+	uint8_t chunk[SENDFILE_BUF_SIZE];
+	ssize_t read_len;
+	ssize_t ret;
+
+	read_len = fs_read(file, chunk, len);
+	if (read_len <= 0) {
+		return read_len;
+	}
+
+	ret = zsock_send(sock, chunk, read_len, 0);
+	if (ret < 0) {
+		ret = -errno;
+		(void)fs_seek(file, -(off_t)read_len, FS_SEEK_CUR);
+	} else if (ret < read_len) {
+		(void)fs_seek(file, -(off_t)(read_len - ret), FS_SEEK_CUR);
+	}
+
+	return ret;
+}
+
+static ssize_t sendfile_chunk(int sock, struct fs_file_t *file, size_t len,
+			      bool *zerocopy)
+{
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+	ssize_t ret;
+
+	if (*zerocopy) {
+		ret = sendfile_chunk_buf(sock, file, len);
+		if (ret == -EOPNOTSUPP) {
+			/* Not a native socket, e.g. TLS */
+			*zerocopy = false;
+		} else if (ret != -ENOBUFS) {
+			return ret;
+		}
+	}
+#else
+	ARG_UNUSED(zerocopy);
+#endif
+
+	return sendfile_chunk_copy(sock, file, len);
+}
+
+ssize_t zsock_sendfile(int out_sock, struct fs_file_t *file, off_t *offset,
+		       size_t count)
+{
+	bool zerocopy = IS_ENABLED(CONFIG_NET_SOCKETS_ZEROCOPY);
+	off_t file_pos = 0;
+	size_t sent = 0;
+	ssize_t ret = 0;
+
+	if (file == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (offset != NULL) {
+		file_pos = fs_tell(file);
+		if (file_pos < 0) {
+			errno = -file_pos;
+			return -1;
+		}
+
+		ret = fs_seek(file, *offset, FS_SEEK_SET);
+		if (ret < 0) {
+			errno = -ret;
+			return -1;
+		}
+	}
+
+	while (sent < count) {
+		ret = sendfile_chunk(out_sock, file, MIN(count - sent, SENDFILE_BUF_SIZE),
+				     &zerocopy);
+		if (ret <= 0) {
+			break;
+		}
+
+		sent += ret;
+	}
+
+	if (offset != NULL) {
+		*offset += sent;
+		(void)fs_seek(file, file_pos, FS_SEEK_SET);
+	}
+
+	if (ret < 0 && sent == 0) {
+		LOG_DBG("sendfile to %d failed (%zd)", out_sock, ret);
+		errno = -ret;
+		return -1;
+	}
+
+	return sent;
+}
@@ -46,7 +46,9 @@ LOG_MODULE_REGISTER(net_sock_tls, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <mbedtls/ssl_cookie.h>
 #include <mbedtls/error.h>
 #include <mbedtls/platform.h>
-#include <mbedtls/ssl_cache.h>
+#if defined(MBEDTLS_SSL_TICKET_C)
+#include <mbedtls/ssl_ticket.h>
+#endif
 #endif /* CONFIG_MBEDTLS */
 
 #include "sockets_internal.h"
@@ -101,7 +103,7 @@ struct dtls_timing_context {
 
 /** TLS peer address/session ID mapping. */
 struct tls_session_cache {
-	/** Creation time. */
+	/** Last use time, for LRU eviction. */
 	int64_t timestamp;
 
 	/** Peer address. */
@@ -114,6 +116,31 @@ struct tls_session_cache {
 	size_t session_len;
 };
 
+#define SERVER_SESSION_COUNT CONFIG_NET_SOCKETS_TLS_MAX_SERVER_SESSION_COUNT
+
+#if SERVER_SESSION_COUNT > 0
+/** TLS server session ID/session mapping. */
+struct tls_server_session_cache {
+	/** Last use time, for LRU eviction. */
+	int64_t timestamp;
+
+	/** Creation time, for session expiry. */
+	int64_t created;
+
+	/** Session ID assigned by the server. */
+	unsigned char id[32];
+
+	/** Session ID length. */
+	size_t id_len;
+
+	/** Session buffer. */
+	uint8_t *session;
+
+	/** Session length. */
+	size_t session_len;
+};
+#endif
+
 #if defined(CONFIG_NET_SOCKETS_ENABLE_DTLS)
 struct tls_dtls_cid {
 	bool enabled;
@@ -250,13 +277,24 @@ static struct tls_context tls_contexts[CONFIG_NET_SOCKETS_TLS_MAX_CONTEXTS];
 
 static struct tls_session_cache client_cache[CONFIG_NET_SOCKETS_TLS_MAX_CLIENT_SESSION_COUNT];
 
-#if defined(MBEDTLS_SSL_CACHE_C)
-static mbedtls_ssl_cache_context server_cache;
+#if SERVER_SESSION_COUNT > 0
+static struct tls_server_session_cache server_cache[SERVER_SESSION_COUNT];
 #endif
 
+#if defined(MBEDTLS_SSL_TICKET_C)
+/* Ticket keys are shared by all server sockets, and set up on first use. */
+static mbedtls_ssl_ticket_context ticket_ctx;
+static bool ticket_ctx_ready;
+#endif
+
+static struct tls_session_cache_stats session_stats;
+
 /* A mutex for protecting TLS context allocation. */
 static struct k_mutex context_lock;
 
+/* A mutex for protecting the session caches, ticket keys and statistics. */
+static struct k_mutex session_lock;
+
 /* Arbitrary delay value to wait if mbedTLS reports it cannot proceed for
  * reasons other than TX/RX block.
  */
@@ -271,6 +309,27 @@ static void tls_session_cache_reset(void)
 	}
 
 	(void)memset(client_cache, 0, sizeof(client_cache));
+
+#if SERVER_SESSION_COUNT > 0
+	for (int i = 0; i < ARRAY_SIZE(server_cache); i++) {
+		if (server_cache[i].session != NULL) {
+			mbedtls_free(server_cache[i].session);
+		}
+	}
+
+	(void)memset(server_cache, 0, sizeof(server_cache));
+#endif
+
+#if defined(MBEDTLS_SSL_TICKET_C)
+	/* Drop the ticket keys as well, so that the tickets issued so far
+	 * can no longer be used.
+	 */
+	if (ticket_ctx_ready) {
+		mbedtls_ssl_ticket_free(&ticket_ctx);
+		mbedtls_ssl_ticket_init(&ticket_ctx);
+		ticket_ctx_ready = false;
+	}
+#endif
 }
 
 bool net_socket_is_tls(void *obj)
@@ -368,9 +427,10 @@ static int tls_init(void)
 	(void)memset(client_cache, 0, sizeof(client_cache));
 
 	k_mutex_init(&context_lock);
+	k_mutex_init(&session_lock);
 
-#if defined(MBEDTLS_SSL_CACHE_C)
-	mbedtls_ssl_cache_init(&server_cache);
+#if defined(MBEDTLS_SSL_TICKET_C)
+	mbedtls_ssl_ticket_init(&ticket_ctx);
 #endif
 
 	return 0;
@@ -591,10 +651,12 @@ static int tls_session_save(const struct sockaddr *peer_addr,
 				break;
 			}
 
-			/* Remember the oldest entry and reuse if needed. */
+			/* Remember the least recently used entry and reuse
+			 * if needed.
+			 */
 			if (entry == NULL ||
 			    (entry->session != NULL &&
-			     entry->timestamp < client_cache[i].timestamp)) {
+			     client_cache[i].timestamp < entry->timestamp)) {
 				entry = &client_cache[i];
 			}
 		}
@@ -603,6 +665,10 @@ static int tls_session_save(const struct sockaddr *peer_addr,
 	/* Allocate session and save */
 
 	if (entry->session != NULL) {
+		if (!peer_addr_cmp(&entry->peer_addr, peer_addr)) {
+			session_stats.evictions++;
+		}
+
 		mbedtls_free(entry->session);
 		entry->session = NULL;
 	}
@@ -646,6 +712,7 @@ static int tls_session_get(const struct sockaddr *peer_addr,
 	}
 
 	if (entry == NULL) {
+		session_stats.misses++;
 		return -ENOENT;
 	}
 
@@ -655,10 +722,14 @@ static int tls_session_get(const struct sockaddr *peer_addr,
 		/* Discard corrupted session data. */
 		mbedtls_free(entry->session);
 		entry->session = NULL;
+		session_stats.misses++;
 		NET_ERR("Failed to load TLS session %d", ret);
 		return -EIO;
 	}
 
+	entry->timestamp = k_uptime_get();
+	session_stats.hits++;
+
 	return 0;
 }
 
@@ -683,7 +754,9 @@ static void tls_session_store(struct tls_context *context,
 		goto exit;
 	}
 
+	k_mutex_lock(&session_lock, K_FOREVER);
 	ret = tls_session_save(&peer_addr, &session);
+	k_mutex_unlock(&session_lock);
 	if (ret < 0) {
 		NET_ERR("Failed to save session for %p", context);
 	}
@@ -707,7 +780,9 @@ static void tls_session_restore(struct tls_context *context,
 	memcpy(&peer_addr, addr, addrlen);
 	mbedtls_ssl_session_init(&session);
 
+	k_mutex_lock(&session_lock, K_FOREVER);
 	ret = tls_session_get(&peer_addr, &session);
+	k_mutex_unlock(&session_lock);
 	if (ret < 0) {
 		NET_DBG("Session not found for %p", context);
 		goto exit;
@@ -722,14 +797,252 @@ exit:
 	mbedtls_ssl_session_free(&session);
 }
 
-static void tls_session_purge(void)
+#if SERVER_SESSION_COUNT > 0
+static bool server_session_expired(struct tls_server_session_cache *entry)
 {
-	tls_session_cache_reset();
+	if (CONFIG_NET_SOCKETS_TLS_SERVER_SESSION_TIMEOUT == 0) {
+		return false;
+	}
+
+	return k_uptime_get() - entry->created >=
+	       (int64_t)CONFIG_NET_SOCKETS_TLS_SERVER_SESSION_TIMEOUT * MSEC_PER_SEC;
+}
+
+static void server_session_free(struct tls_server_session_cache *entry)
+{
+	mbedtls_free(entry->session);
+	entry->session = NULL;
+	entry->session_len = 0;
+	entry->id_len = 0;
+}
+
+/* mbedTLS session cache callback, looking up a session by its ID. */
+static int tls_server_session_get(void *data, unsigned char const *session_id,
+				  size_t session_id_len,
+				  mbedtls_ssl_session *session)
+{
+	struct tls_server_session_cache *entry = NULL;
+	int ret = -1;
+
+	ARG_UNUSED(data);
 
-#if defined(MBEDTLS_SSL_CACHE_C)
-	mbedtls_ssl_cache_free(&server_cache);
-	mbedtls_ssl_cache_init(&server_cache);
+	k_mutex_lock(&session_lock, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(server_cache); i++) {
+		if (server_cache[i].session != NULL &&
+		    server_cache[i].id_len == session_id_len &&
+		    memcmp(server_cache[i].id, session_id, session_id_len) == 0) {
+			entry = &server_cache[i];
+			break;
+		}
+	}
+
+	if (entry == NULL) {
+		session_stats.misses++;
+		goto exit;
+	}
+
+	if (server_session_expired(entry)) {
+		server_session_free(entry);
+		session_stats.misses++;
+		goto exit;
+	}
+
+	ret = mbedtls_ssl_session_load(session, entry->session,
+				       entry->session_len);
+	if (ret < 0) {
+		/* Discard corrupted session data. */
+		NET_ERR("Failed to load TLS session %d", ret);
+		server_session_free(entry);
+		session_stats.misses++;
+		goto exit;
+	}
+
+	entry->timestamp = k_uptime_get();
+	session_stats.hits++;
+
+exit:
+	k_mutex_unlock(&session_lock);
+
+	return ret;
+}
+
+/* mbedTLS session cache callback, storing a session after a full handshake. */
+static int tls_server_session_set(void *data, unsigned char const *session_id,
+				  size_t session_id_len,
+				  const mbedtls_ssl_session *session)
+{
+	struct tls_server_session_cache *entry = NULL;
+	size_t session_len;
+	uint8_t *buf;
+	int ret;
+
+	ARG_UNUSED(data);
+
+	if (session_id_len == 0 ||
+	    session_id_len > sizeof(server_cache[0].id)) {
+		return -1;
+	}
+
+	(void)mbedtls_ssl_session_save(session, NULL, 0, &session_len);
+
+	buf = mbedtls_calloc(1, session_len);
+	if (buf == NULL) {
+		NET_ERR("Failed to allocate session buffer.");
+		return -1;
+	}
+
+	ret = mbedtls_ssl_session_save(session, buf, session_len, &session_len);
+	if (ret < 0) {
+		NET_ERR("Failed to serialize session, err: -0x%x.", -ret);
+		mbedtls_free(buf);
+		return -1;
+	}
+
+	k_mutex_lock(&session_lock, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(server_cache); i++) {
+		if (server_cache[i].session == NULL ||
+		    server_session_expired(&server_cache[i])) {
+			/* Free or stale entry, prefer it over evicting. */
+			if (entry == NULL || entry->session != NULL) {
+				entry = &server_cache[i];
+			}
+
+			continue;
+		}
+
+		if (server_cache[i].id_len == session_id_len &&
+		    memcmp(server_cache[i].id, session_id, session_id_len) == 0) {
+			/* Same session, overwrite it. */
+			entry = &server_cache[i];
+			break;
+		}
+
+		/* Remember the least recently used entry. */
+		if (entry == NULL ||
+		    (entry->session != NULL &&
+		     server_cache[i].timestamp < entry->timestamp)) {
+			entry = &server_cache[i];
+		}
+	}
+
+	if (entry->session != NULL) {
+		if (!server_session_expired(entry) &&
+		    (entry->id_len != session_id_len ||
+		     memcmp(entry->id, session_id, session_id_len) != 0)) {
+			session_stats.evictions++;
+		}
+
+		mbedtls_free(entry->session);
+	}
+
+	entry->session = buf;
+	entry->session_len = session_len;
+	memcpy(entry->id, session_id, session_id_len);
+	entry->id_len = session_id_len;
+	entry->created = k_uptime_get();
+	entry->timestamp = entry->created;
+
+	k_mutex_unlock(&session_lock);
+
+	return 0;
+}
+#endif /* SERVER_SESSION_COUNT > 0 */
+
+#if defined(MBEDTLS_SSL_TICKET_C)
+#if defined(CONFIG_NET_SOCKETS_TLS_SESSION_TICKET_LIFETIME)
+#define TICKET_LIFETIME CONFIG_NET_SOCKETS_TLS_SESSION_TICKET_LIFETIME
+#else
+/* Tickets enabled by a custom mbedTLS configuration file */
+#define TICKET_LIFETIME 86400
+#endif
+
+static int tls_ticket_setup(void)
+{
+	mbedtls_cipher_type_t cipher;
+	int ret = 0;
+
+#if defined(MBEDTLS_GCM_C)
+	cipher = MBEDTLS_CIPHER_AES_128_GCM;
+#elif defined(MBEDTLS_CCM_C)
+	cipher = MBEDTLS_CIPHER_AES_128_CCM;
+#elif defined(MBEDTLS_CHACHAPOLY_C)
+	cipher = MBEDTLS_CIPHER_CHACHA20_POLY1305;
+#else
+	return -ENOTSUP;
 #endif
+
+	k_mutex_lock(&session_lock, K_FOREVER);
+
+	if (!ticket_ctx_ready) {
+		ret = mbedtls_ssl_ticket_setup(&ticket_ctx, tls_ctr_drbg_random,
+					       NULL, cipher, TICKET_LIFETIME);
+		if (ret != 0) {
+			NET_ERR("Failed to set up session tickets, err: -0x%x.",
+				-ret);
+			mbedtls_ssl_ticket_free(&ticket_ctx);
+			mbedtls_ssl_ticket_init(&ticket_ctx);
+			ret = -EIO;
+		} else {
+			ticket_ctx_ready = true;
+		}
+	}
+
+	k_mutex_unlock(&session_lock);
+
+	return ret;
+}
+
+/* Session ticket callbacks, serializing access to the shared ticket keys
+ * (which may be rotated by a purge) and counting ticket resumptions.
+ */
+static int tls_ticket_write(void *data, const mbedtls_ssl_session *session,
+			    unsigned char *start, const unsigned char *end,
+			    size_t *tlen, uint32_t *lifetime)
+{
+	int ret = MBEDTLS_ERR_SSL_INTERNAL_ERROR;
+
+	k_mutex_lock(&session_lock, K_FOREVER);
+
+	if (ticket_ctx_ready) {
+		ret = mbedtls_ssl_ticket_write(data, session, start, end, tlen,
+					       lifetime);
+	}
+
+	k_mutex_unlock(&session_lock);
+
+	return ret;
+}
+
+static int tls_ticket_parse(void *data, mbedtls_ssl_session *session,
+			    unsigned char *buf, size_t len)
+{
+	int ret = MBEDTLS_ERR_SSL_INVALID_MAC;
+
+	k_mutex_lock(&session_lock, K_FOREVER);
+
+	if (ticket_ctx_ready) {
+		ret = mbedtls_ssl_ticket_parse(data, session, buf, len);
+	}
+
+	if (ret == 0) {
+		session_stats.ticket_hits++;
+	} else {
+		session_stats.ticket_misses++;
+	}
+
+	k_mutex_unlock(&session_lock);
+
+	return ret;
+}
+#endif /* MBEDTLS_SSL_TICKET_C */
+
+static void tls_session_purge(void)
+{
+	k_mutex_lock(&session_lock, K_FOREVER);
+	tls_session_cache_reset();
+	k_mutex_unlock(&session_lock);
 }
 
 static inline int time_left(uint32_t start, uint32_t timeout)
@@ -1413,13 +1726,21 @@ static int tls_mbedtls_init(struct tls_context *context, bool is_server)
 	}
 #endif /* CONFIG_MBEDTLS_SSL_ALPN */
 
-#if defined(MBEDTLS_SSL_CACHE_C)
 	if (is_server && context->options.cache_enabled) {
-		mbedtls_ssl_conf_session_cache(&context->config, &server_cache,
-					       mbedtls_ssl_cache_get,
-					       mbedtls_ssl_cache_set);
-	}
+#if SERVER_SESSION_COUNT > 0
+		mbedtls_ssl_conf_session_cache(&context->config, NULL,
+					       tls_server_session_get,
+					       tls_server_session_set);
+#endif
+#if defined(MBEDTLS_SSL_TICKET_C)
+		if (tls_ticket_setup() == 0) {
+			mbedtls_ssl_conf_session_tickets_cb(&context->config,
+							    tls_ticket_write,
+							    tls_ticket_parse,
+							    &ticket_ctx);
+		}
 #endif
+	}
 
 #if defined(MBEDTLS_SSL_EARLY_DATA)
 	mbedtls_ssl_conf_early_data(&context->config, MBEDTLS_SSL_EARLY_DATA_ENABLED);
@@ -1945,6 +2266,22 @@ static int tls_opt_session_cache_get(struct tls_context *context,
 	return 0;
 }
 
+static int tls_opt_session_cache_stats_get(struct tls_context *context,
+					   void *optval, socklen_t *optlen)
+{
+	ARG_UNUSED(context);
+
+	if (*optlen != sizeof(struct tls_session_cache_stats)) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&session_lock, K_FOREVER);
+	memcpy(optval, &session_stats, sizeof(session_stats));
+	k_mutex_unlock(&session_lock);
+
+	return 0;
+}
+
 static int tls_opt_session_cache_purge_set(struct tls_context *context,
 					   const void *optval, socklen_t optlen)
 {
@@ -3493,6 +3830,10 @@ int ztls_getsockopt_ctx(struct tls_context *ctx, int level, int optname,
 		err = tls_opt_session_cache_get(ctx, optval, optlen);
 		break;
 
+	case TLS_SESSION_CACHE_STATS:
+		err = tls_opt_session_cache_stats_get(ctx, optval, optlen);
+		break;
+
 #if defined(CONFIG_NET_SOCKETS_ENABLE_DTLS)
 	case TLS_DTLS_HANDSHAKE_TIMEOUT_MIN:
 		err = tls_opt_dtls_handshake_timeout_get(ctx, optval,
@@ -5,6 +5,7 @@
  */
 
 #include <zephyr/init.h>
+#include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/net/socket.h>
 
@@ -48,6 +49,28 @@ K_THREAD_STACK_DEFINE(zperf_work_q_stack, CONFIG_ZPERF_WORK_Q_STACK_SIZE);
 
 static struct k_work_q zperf_work_q;
 
+#if CONFIG_NET_ZPERF_MAX_STREAMS > 1
+#define ZPERF_STREAM_THREAD_PRIORITY                                                               \
+	CLAMP(CONFIG_NET_ZPERF_STREAM_THREAD_PRIORITY, K_HIGHEST_APPLICATION_THREAD_PRIO,          \
+	      K_LOWEST_APPLICATION_THREAD_PRIO)
+
+/* The first stream runs in the context of the caller */
+#define ZPERF_STREAM_THREADS (CONFIG_NET_ZPERF_MAX_STREAMS - 1)
+
+struct zperf_stream {
+	struct k_thread thread;
+	zperf_stream_fn fn;
+	void *user_data;
+	struct zperf_results results;
+	int ret;
+};
+
+K_THREAD_STACK_ARRAY_DEFINE(zperf_stream_stacks, ZPERF_STREAM_THREADS,
+			    CONFIG_NET_ZPERF_STREAM_STACK_SIZE);
+static struct zperf_stream zperf_streams[ZPERF_STREAM_THREADS];
+static K_MUTEX_DEFINE(zperf_streams_lock);
+#endif /* CONFIG_NET_ZPERF_MAX_STREAMS > 1 */
+
 int zperf_get_ipv6_addr(char *host, char *prefix_str, struct in6_addr *addr)
 {
 	struct net_if_ipv6_prefix *prefix;
@@ -220,6 +243,172 @@ uint32_t zperf_packet_duration(uint32_t packet_size, uint32_t rate_in_kbps)
 			  (rate_in_kbps * 1024U));
 }
 
+void zperf_results_add(struct zperf_results *results,
+		       const struct zperf_results *stream)
+{
+	results->nb_packets_sent += stream->nb_packets_sent;
+	results->nb_packets_rcvd += stream->nb_packets_rcvd;
+	results->nb_packets_lost += stream->nb_packets_lost;
+	results->nb_packets_outorder += stream->nb_packets_outorder;
+	results->nb_packets_errors += stream->nb_packets_errors;
+	results->total_len += stream->total_len;
+	results->cpu_cycles += stream->cpu_cycles;
+	results->jitter_in_us = MAX(results->jitter_in_us, stream->jitter_in_us);
+	results->send_jitter_in_us = MAX(results->send_jitter_in_us,
+					 stream->send_jitter_in_us);
+	results->packet_size = stream->packet_size;
+
+	for (int i = 0; i < ZPERF_LATENCY_HIST_BUCKETS; i++) {
+		results->send_latency_hist[i] += stream->send_latency_hist[i];
+	}
+}
+
+void zperf_record_send_latency(struct zperf_results *results,
+			       uint32_t latency_us, uint32_t *last_latency_us)
+{
+	int32_t diff = (int32_t)(latency_us - *last_latency_us);
+	int bucket = 0;
+
+	if (latency_us > 0) {
+		bucket = MIN(32 - __builtin_clz(latency_us),
+			     ZPERF_LATENCY_HIST_BUCKETS - 1);
+	}
+
+	results->send_latency_hist[bucket]++;
+
+	/* Smoothed the same way as the interarrival jitter of RFC 3550 */
+	if (diff < 0) {
+		diff = -diff;
+	}
+
+	results->send_jitter_in_us += (diff - (int32_t)results->send_jitter_in_us) / 16;
+	*last_latency_us = latency_us;
+}
+
+static uint64_t zperf_cpu_cycles(void)
+{
+#if defined(CONFIG_SCHED_THREAD_USAGE_ALL)
+	k_thread_runtime_stats_t stats;
+
+	if (k_thread_runtime_stats_all_get(&stats) == 0) {
+		return stats.total_cycles;
+	}
+#endif
+
+	return 0;
+}
+
+#if CONFIG_NET_ZPERF_MAX_STREAMS > 1
+static void zperf_stream_thread(void *p1, void *p2, void *p3)
+{
+	struct zperf_stream *stream = p1;
+
+	ARG_UNUSED(p3);
+
+	stream->ret = stream->fn(POINTER_TO_INT(p2), stream->user_data,
+				 &stream->results);
+}
+
+static int zperf_start_streams(int num_streams, zperf_stream_fn fn,
+			       void *user_data)
+{
+	if (k_mutex_lock(&zperf_streams_lock, K_NO_WAIT) < 0) {
+		NET_ERR("Parallel streams already in use");
+		return -EBUSY;
+	}
+
+	for (int i = 1; i < num_streams; i++) {
+		struct zperf_stream *stream = &zperf_streams[i - 1];
+		k_tid_t tid;
+
+		memset(&stream->results, 0, sizeof(stream->results));
+		stream->fn = fn;
+		stream->user_data = user_data;
+		stream->ret = 0;
+
+		tid = k_thread_create(&stream->thread, zperf_stream_stacks[i - 1],
+				      K_THREAD_STACK_SIZEOF(zperf_stream_stacks[i - 1]),
+				      zperf_stream_thread, stream, INT_TO_POINTER(i), NULL,
+				      ZPERF_STREAM_THREAD_PRIORITY, 0, K_FOREVER);
+#if defined(CONFIG_SMP) && defined(CONFIG_SCHED_CPU_MASK)
+		(void)k_thread_cpu_pin(tid, i % arch_num_cpus());
+#endif
+		k_thread_name_set(tid, "zperf_stream");
+		k_thread_start(tid);
+	}
+
+	return 0;
+}
+
+static int zperf_join_streams(int num_streams, struct zperf_results *results)
+{
+	int ret = 0;
+
+	for (int i = 1; i < num_streams; i++) {
+		struct zperf_stream *stream = &zperf_streams[i - 1];
+
+		(void)k_thread_join(&stream->thread, K_FOREVER);
+
+		if (stream->ret < 0 && ret == 0) {
+			ret = stream->ret;
+		}
+
+		zperf_results_add(results, &stream->results);
+		results->time_in_us = MAX(results->time_in_us,
+					  stream->results.time_in_us);
+		results->client_time_in_us = MAX(results->client_time_in_us,
+						 stream->results.client_time_in_us);
+	}
+
+	k_mutex_unlock(&zperf_streams_lock);
+
+	return ret;
+}
+#endif /* CONFIG_NET_ZPERF_MAX_STREAMS > 1 */
+
+int zperf_run_streams(int num_streams, zperf_stream_fn fn, void *user_data,
+		      struct zperf_results *results)
+{
+	uint64_t start_cycles;
+	int ret;
+
+	num_streams = MAX(num_streams, 1);
+	if (num_streams > CONFIG_NET_ZPERF_MAX_STREAMS) {
+		NET_ERR("Too many streams (%d), maximum is %d", num_streams,
+			CONFIG_NET_ZPERF_MAX_STREAMS);
+		return -EINVAL;
+	}
+
+	memset(results, 0, sizeof(*results));
+	start_cycles = zperf_cpu_cycles();
+
+#if CONFIG_NET_ZPERF_MAX_STREAMS > 1
+	if (num_streams > 1) {
+		ret = zperf_start_streams(num_streams, fn, user_data);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+#endif
+
+	ret = fn(0, user_data, results);
+
+#if CONFIG_NET_ZPERF_MAX_STREAMS > 1
+	if (num_streams > 1) {
+		int stream_ret = zperf_join_streams(num_streams, results);
+
+		if (ret == 0) {
+			ret = stream_ret;
+		}
+	}
+#endif
+
+	results->num_streams = num_streams;
+	results->cpu_cycles = zperf_cpu_cycles() - start_cycles;
+
+	return ret;
+}
+
 void zperf_async_work_submit(struct k_work *work)
 {
 	k_work_submit_to_queue(&zperf_work_q, work);
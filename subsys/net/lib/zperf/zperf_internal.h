@@ -53,6 +53,12 @@
 
 #define ZPERF_VERSION "1.1"
 
+/* iperf2 client header flags, requesting the server to run a dual test,
+ * i.e. to connect back to the client while receiving.
+ */
+#define ZPERF_FLAGS_VERSION1 0x80000000
+#define ZPERF_FLAGS_RUN_NOW 0x00000001
+
 struct zperf_udp_datagram {
 	int32_t id;
 	uint32_t tv_sec;
@@ -90,6 +96,12 @@ struct zperf_async_upload_context {
 	void *user_data;
 };
 
+/* Runs a single stream of an upload, the stream index is in
+ * [0, num_streams).
+ */
+typedef int (*zperf_stream_fn)(int stream, void *user_data,
+			       struct zperf_results *results);
+
 static inline uint32_t time_delta(uint32_t ts, uint32_t t)
 {
 	return (t >= ts) ? (t - ts) : (ULONG_MAX - ts + t);
@@ -108,6 +120,13 @@ int zperf_prepare_upload_sock(const struct sockaddr *peer_addr, uint8_t tos,
 
 uint32_t zperf_packet_duration(uint32_t packet_size, uint32_t rate_in_kbps);
 
+int zperf_run_streams(int num_streams, zperf_stream_fn fn, void *user_data,
+		      struct zperf_results *results);
+void zperf_results_add(struct zperf_results *results,
+		       const struct zperf_results *stream);
+void zperf_record_send_latency(struct zperf_results *results,
+			       uint32_t latency_us, uint32_t *last_latency_us);
+
 void zperf_async_work_submit(struct k_work *work);
 void zperf_udp_uploader_init(void);
 void zperf_tcp_uploader_init(void);
@@ -475,6 +475,46 @@ static int cmd_udp_download(const struct shell *sh, size_t argc,
 	}
 }
 
+static void shell_upload_print_cpu_latency(const struct shell *sh,
+					   struct zperf_results *results)
+{
+	uint64_t total_bytes = (uint64_t)results->nb_packets_sent *
+			       results->packet_size;
+
+	if (results->num_streams > 1) {
+		shell_fprintf(sh, SHELL_NORMAL, "Streams:\t\t%u\n",
+			      results->num_streams);
+	}
+
+	if (results->cpu_cycles != 0U && total_bytes != 0U) {
+		uint64_t cycles_per_byte = (results->cpu_cycles * 100U) / total_bytes;
+
+		shell_fprintf(sh, SHELL_NORMAL, "CPU cycles/byte:\t%llu.%02u\n",
+			      cycles_per_byte / 100U,
+			      (unsigned int)(cycles_per_byte % 100U));
+	}
+
+	shell_fprintf(sh, SHELL_NORMAL, "Send jitter:\t\t");
+	print_number(sh, results->send_jitter_in_us, TIME_US, TIME_US_UNIT);
+	shell_fprintf(sh, SHELL_NORMAL, "\n");
+
+	shell_fprintf(sh, SHELL_NORMAL, "Send latency:\t");
+	for (int i = 0; i < ZPERF_LATENCY_HIST_BUCKETS; i++) {
+		if (results->send_latency_hist[i] == 0U) {
+			continue;
+		}
+
+		if (i < ZPERF_LATENCY_HIST_BUCKETS - 1) {
+			shell_fprintf(sh, SHELL_NORMAL, " <%luus:%u", BIT(i),
+				      results->send_latency_hist[i]);
+		} else {
+			shell_fprintf(sh, SHELL_NORMAL, " >=%luus:%u", BIT(i - 1),
+				      results->send_latency_hist[i]);
+		}
+	}
+	shell_fprintf(sh, SHELL_NORMAL, "\n");
+}
+
 static void shell_udp_upload_print_stats(const struct shell *sh,
 					 struct zperf_results *results)
 {
@@ -536,6 +576,8 @@ static void shell_udp_upload_print_stats(const struct shell *sh,
 		shell_fprintf(sh, SHELL_NORMAL, "\t(");
 		print_number(sh, client_rate_in_kbps, KBPS, KBPS_UNIT);
 		shell_fprintf(sh, SHELL_NORMAL, ")\n");
+
+		shell_upload_print_cpu_latency(sh, results);
 	}
 }
 
@@ -569,6 +611,8 @@ static void shell_tcp_upload_print_stats(const struct shell *sh,
 		shell_fprintf(sh, SHELL_NORMAL, "Rate:\t\t");
 		print_number(sh, client_rate_in_kbps, KBPS, KBPS_UNIT);
 		shell_fprintf(sh, SHELL_NORMAL, "\n");
+
+		shell_upload_print_cpu_latency(sh, results);
 	}
 }
 
@@ -600,6 +644,8 @@ static void shell_tcp_upload_print_periodic(const struct shell *sh,
 		shell_fprintf(sh, SHELL_NORMAL, "Rate: ");
 		print_number(sh, client_rate_in_kbps, KBPS, KBPS_UNIT);
 		shell_fprintf(sh, SHELL_NORMAL, "\n");
+
+		shell_upload_print_cpu_latency(sh, results);
 	}
 }
 
@@ -704,6 +750,34 @@ static void send_ping(const struct shell *sh,
 	(void)net_icmp_cleanup_ctx(&ctx);
 }
 
+static void tcp_session_cb(enum zperf_status status,
+			   struct zperf_results *result,
+			   void *user_data);
+
+static int start_bidir_server(const struct shell *sh, uint16_t port,
+			      bool is_udp)
+{
+	struct zperf_download_params param = { .port = port };
+	int ret;
+
+	if (is_udp) {
+		ret = zperf_udp_download(&param, udp_session_cb, (void *)sh);
+	} else {
+		ret = zperf_tcp_download(&param, tcp_session_cb, (void *)sh);
+	}
+
+	if (ret < 0 && ret != -EALREADY) {
+		shell_fprintf(sh, SHELL_ERROR,
+			      "Failed to start %s server (%d)\n",
+			      is_udp ? "UDP" : "TCP", ret);
+		return ret;
+	}
+
+	shell_fprintf(sh, SHELL_NORMAL, "Receiving on port %u\n", port);
+
+	return 0;
+}
+
 static int execute_upload(const struct shell *sh,
 			  const struct zperf_upload_params *param,
 			  bool is_udp, bool async)
@@ -719,6 +793,19 @@ static int execute_upload(const struct shell *sh,
 		      param->packet_size);
 	shell_fprintf(sh, SHELL_NORMAL, "Rate:\t\t%u kbps\n",
 		      param->rate_kbps);
+
+	if (param->options.num_streams > 1) {
+		shell_fprintf(sh, SHELL_NORMAL, "Streams:\t%u\n",
+			      param->options.num_streams);
+	}
+
+	if (param->options.bidir_port != 0) {
+		ret = start_bidir_server(sh, param->options.bidir_port, is_udp);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
 	shell_fprintf(sh, SHELL_NORMAL, "Starting...\n");
 
 	if (IS_ENABLED(CONFIG_NET_IPV6) && param->peer_addr.sa_family == AF_INET6) {
@@ -926,6 +1013,26 @@ static int shell_cmd_upload(const struct shell *sh, size_t argc,
 			opt_cnt += 2;
 			break;
 
+		case 'P': {
+			int streams = parse_arg(&i, argc, argv);
+
+			if (streams < 1 || streams > CONFIG_NET_ZPERF_MAX_STREAMS) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "Parse error: %s (max %d streams)\n",
+					      argv[i], CONFIG_NET_ZPERF_MAX_STREAMS);
+				return -ENOEXEC;
+			}
+
+			param.options.num_streams = streams;
+			opt_cnt += 2;
+			break;
+		}
+
+		case 'd':
+			param.options.bidir_port = DEF_PORT;
+			opt_cnt += 1;
+			break;
+
 		default:
 			shell_fprintf(sh, SHELL_WARNING,
 				      "Unrecognized argument: %s\n", argv[i]);
@@ -1159,6 +1266,26 @@ static int shell_cmd_upload2(const struct shell *sh, size_t argc,
 			opt_cnt += 2;
 			break;
 
+		case 'P': {
+			int streams = parse_arg(&i, argc, argv);
+
+			if (streams < 1 || streams > CONFIG_NET_ZPERF_MAX_STREAMS) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "Parse error: %s (max %d streams)\n",
+					      argv[i], CONFIG_NET_ZPERF_MAX_STREAMS);
+				return -ENOEXEC;
+			}
+
+			param.options.num_streams = streams;
+			opt_cnt += 2;
+			break;
+		}
+
+		case 'd':
+			param.options.bidir_port = DEF_PORT;
+			opt_cnt += 1;
+			break;
+
 		default:
 			shell_fprintf(sh, SHELL_WARNING,
 				      "Unrecognized argument: %s\n", argv[i]);
@@ -1460,7 +1587,7 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_tcp_download,
 SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_tcp,
 	SHELL_CMD(upload, NULL,
 		  "[<options>] <dest ip> <dest port> <duration> <packet size>[K]\n"
-		  "<options>     command options (optional): [-S tos -a]\n"
+		  "<options>     command options (optional): [-S tos -a -P num -d]\n"
 		  "<dest ip>     IP destination\n"
 		  "<dest port>   port destination\n"
 		  "<duration>    of the test in seconds "
@@ -1473,6 +1600,8 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_tcp,
 		  "-a: Asynchronous call (shell will not block for the upload)\n"
 		  "-i sec: Periodic reporting interval in seconds (async only)\n"
 		  "-n: Disable Nagle's algorithm\n"
+		  "-P num: Number of parallel streams\n"
+		  "-d: Bidirectional test, the peer sends back to port " DEF_PORT_STR "\n"
 #ifdef CONFIG_NET_CONTEXT_PRIORITY
 		  "-p: Specify custom packet priority\n"
 #endif /* CONFIG_NET_CONTEXT_PRIORITY */
@@ -1481,7 +1610,7 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_tcp,
 		  cmd_tcp_upload),
 	SHELL_CMD(upload2, NULL,
 		  "[<options>] v6|v4 <duration> <packet size>[K]\n"
-		  "<options>     command options (optional): [-S tos -a]\n"
+		  "<options>     command options (optional): [-S tos -a -P num -d]\n"
 		  "<v6|v4>:      Use either IPv6 or IPv4\n"
 		  "<duration>    of the test in seconds "
 							"(default " DEF_DURATION_SECONDS_STR ")\n"
@@ -1493,6 +1622,8 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_tcp,
 		  "-a: Asynchronous call (shell will not block for the upload)\n"
 		  "-i sec: Periodic reporting interval in seconds (async only)\n"
 		  "-n: Disable Nagle's algorithm\n"
+		  "-P num: Number of parallel streams\n"
+		  "-d: Bidirectional test, the peer sends back to port " DEF_PORT_STR "\n"
 #ifdef CONFIG_NET_CONTEXT_PRIORITY
 		  "-p: Specify custom packet priority\n"
 #endif /* CONFIG_NET_CONTEXT_PRIORITY */
@@ -1525,7 +1656,7 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_udp,
 	SHELL_CMD(upload, NULL,
 		  "[<options>] <dest ip> [<dest port> <duration> <packet size>[K] "
 							"<baud rate>[K|M]]\n"
-		  "<options>     command options (optional): [-S tos -a]\n"
+		  "<options>     command options (optional): [-S tos -a -P num -d]\n"
 		  "<dest ip>     IP destination\n"
 		  "<dest port>   port destination\n"
 		  "<duration>    of the test in seconds "
@@ -1538,6 +1669,8 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_udp,
 		  "Available options:\n"
 		  "-S tos: Specify IPv4/6 type of service\n"
 		  "-a: Asynchronous call (shell will not block for the upload)\n"
+		  "-P num: Number of parallel streams\n"
+		  "-d: Bidirectional test, the peer sends back to port " DEF_PORT_STR "\n"
 #ifdef CONFIG_NET_CONTEXT_PRIORITY
 		  "-p: Specify custom packet priority\n"
 #endif /* CONFIG_NET_CONTEXT_PRIORITY */
@@ -1547,7 +1680,7 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_udp,
 		  cmd_udp_upload),
 	SHELL_CMD(upload2, NULL,
 		  "[<options>] v6|v4 [<duration> <packet size>[K] <baud rate>[K|M]]\n"
-		  "<options>     command options (optional): [-S tos -a]\n"
+		  "<options>     command options (optional): [-S tos -a -P num -d]\n"
 		  "<v6|v4>:      Use either IPv6 or IPv4\n"
 		  "<duration>    of the test in seconds "
 							"(default " DEF_DURATION_SECONDS_STR ")\n"
@@ -1559,6 +1692,8 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_udp,
 		  "Available options:\n"
 		  "-S tos: Specify IPv4/6 type of service\n"
 		  "-a: Asynchronous call (shell will not block for the upload)\n"
+		  "-P num: Number of parallel streams\n"
+		  "-d: Bidirectional test, the peer sends back to port " DEF_PORT_STR "\n"
 #ifdef CONFIG_NET_CONTEXT_PRIORITY
 		  "-p: Specify custom packet priority\n"
 #endif /* CONFIG_NET_CONTEXT_PRIORITY */
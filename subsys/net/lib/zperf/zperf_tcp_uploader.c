@@ -18,8 +18,17 @@ LOG_MODULE_DECLARE(net_zperf, CONFIG_NET_ZPERF_LOG_LEVEL);
 
 static char sample_packet[PACKET_SIZE_MAX];
 
+BUILD_ASSERT(sizeof(struct zperf_client_hdr_v1) <= PACKET_SIZE_MAX, "Invalid PACKET_SIZE_MAX");
+
 static struct zperf_async_upload_context tcp_async_upload_ctx;
 
+struct tcp_upload_streams {
+	int socks[CONFIG_NET_ZPERF_MAX_STREAMS];
+	int num_streams;
+	uint32_t duration_ms;
+	uint16_t packet_size;
+};
+
 static ssize_t sendall(int sock, const void *buf, size_t len)
 {
 	while (len) {
@@ -45,6 +54,7 @@ static int tcp_upload(int sock,
 	int64_t start_time, end_time;
 	uint32_t nb_packets = 0U, nb_errors = 0U;
 	uint32_t alloc_errors = 0U;
+	uint32_t last_latency = 0U;
 	int ret = 0;
 
 	if (packet_size > PACKET_SIZE_MAX) {
@@ -56,17 +66,15 @@ static int tcp_upload(int sock,
 	/* Start the loop */
 	start_time = k_uptime_ticks();
 
-	(void)memset(sample_packet, 'z', sizeof(sample_packet));
-
-	/* Set the "flags" field in start of the packet to be 0.
-	 * As the protocol is not properly described anywhere, it is
-	 * not certain if this is a proper thing to do.
-	 */
-	(void)memset(sample_packet, 0, sizeof(uint32_t));
-
 	do {
+		uint32_t send_start = k_cycle_get_32();
+
 		/* Send the packet */
 		ret = sendall(sock, sample_packet, packet_size);
+
+		zperf_record_send_latency(results,
+					  k_cyc_to_us_floor32(k_cycle_get_32() - send_start),
+					  &last_latency);
 		if (ret < 0) {
 			if (nb_errors == 0 && ret != -ENOMEM) {
 				NET_ERR("Failed to send the packet (%d)", errno);
@@ -122,26 +130,103 @@ static int tcp_upload(int sock,
 	return 0;
 }
 
+static void tcp_init_packet(const struct zperf_upload_params *param,
+			    int num_streams)
+{
+	struct zperf_client_hdr_v1 *hdr = (struct zperf_client_hdr_v1 *)sample_packet;
+
+	(void)memset(sample_packet, 'z', sizeof(sample_packet));
+
+	/* Set the "flags" field in start of the packet to be 0.
+	 * As the protocol is not properly described anywhere, it is
+	 * not certain if this is a proper thing to do.
+	 */
+	(void)memset(sample_packet, 0, sizeof(uint32_t));
+
+	if (param->options.bidir_port == 0) {
+		return;
+	}
+
+	/* Ask the server to connect back to us while receiving. A negative
+	 * amount is the test duration in units of 10 ms.
+	 */
+	hdr->flags = htonl(ZPERF_FLAGS_VERSION1 | ZPERF_FLAGS_RUN_NOW);
+	hdr->num_of_threads = htonl(num_streams);
+	hdr->port = htonl(param->options.bidir_port);
+	hdr->buffer_len = htonl(param->packet_size);
+	hdr->bandwidth = 0;
+	hdr->num_of_bytes = htonl(-(int32_t)(param->duration_ms / 10U));
+}
+
+static void tcp_close_streams(struct tcp_upload_streams *streams)
+{
+	for (int i = 0; i < streams->num_streams; i++) {
+		zsock_close(streams->socks[i]);
+	}
+}
+
+static int tcp_open_streams(const struct zperf_upload_params *param,
+			    struct tcp_upload_streams *streams)
+{
+	int num_streams = MAX(param->options.num_streams, 1);
+
+	if (num_streams > CONFIG_NET_ZPERF_MAX_STREAMS) {
+		NET_ERR("Too many streams (%d), maximum is %d", num_streams,
+			CONFIG_NET_ZPERF_MAX_STREAMS);
+		return -EINVAL;
+	}
+
+	streams->num_streams = 0;
+	streams->duration_ms = param->duration_ms;
+	streams->packet_size = param->packet_size;
+
+	for (int i = 0; i < num_streams; i++) {
+		int sock;
+
+		sock = zperf_prepare_upload_sock(&param->peer_addr, param->options.tos,
+						 param->options.priority,
+						 param->options.tcp_nodelay, IPPROTO_TCP);
+		if (sock < 0) {
+			tcp_close_streams(streams);
+			return sock;
+		}
+
+		streams->socks[streams->num_streams++] = sock;
+	}
+
+	tcp_init_packet(param, num_streams);
+
+	return 0;
+}
+
+static int tcp_upload_stream(int stream, void *user_data,
+			     struct zperf_results *results)
+{
+	struct tcp_upload_streams *streams = user_data;
+
+	return tcp_upload(streams->socks[stream], streams->duration_ms,
+			  streams->packet_size, results);
+}
+
 int zperf_tcp_upload(const struct zperf_upload_params *param,
 		     struct zperf_results *result)
 {
-	int sock;
+	struct tcp_upload_streams streams;
 	int ret;
 
 	if (param == NULL || result == NULL) {
 		return -EINVAL;
 	}
 
-	sock = zperf_prepare_upload_sock(&param->peer_addr, param->options.tos,
-					 param->options.priority, param->options.tcp_nodelay,
-					 IPPROTO_TCP);
-	if (sock < 0) {
-		return sock;
+	ret = tcp_open_streams(param, &streams);
+	if (ret < 0) {
+		return ret;
 	}
 
-	ret = tcp_upload(sock, param->duration_ms, param->packet_size, result);
+	ret = zperf_run_streams(streams.num_streams, tcp_upload_stream, &streams,
+				result);
 
-	zsock_close(sock);
+	tcp_close_streams(&streams);
 
 	return ret;
 }
@@ -153,16 +238,13 @@ static void tcp_upload_async_work(struct k_work *work)
 	struct zperf_results result = { 0 };
 	int ret;
 	struct zperf_upload_params param = upload_ctx->param;
-	int sock;
+	struct tcp_upload_streams streams;
 
 	upload_ctx->callback(ZPERF_SESSION_STARTED, NULL,
 			     upload_ctx->user_data);
 
-	sock = zperf_prepare_upload_sock(&param.peer_addr, param.options.tos,
-					 param.options.priority, param.options.tcp_nodelay,
-					 IPPROTO_TCP);
-
-	if (sock < 0) {
+	ret = tcp_open_streams(&param, &streams);
+	if (ret < 0) {
 		upload_ctx->callback(ZPERF_SESSION_ERROR, NULL,
 				     upload_ctx->user_data);
 		return;
@@ -181,14 +263,13 @@ static void tcp_upload_async_work(struct k_work *work)
 		struct zperf_results periodic_result;
 
 		for (; rounds > 0; rounds--) {
-			uint32_t round_duration;
-
 			if (rounds == 1) {
-				round_duration = last_round_duration;
+				streams.duration_ms = last_round_duration;
 			} else {
-				round_duration = report_interval;
+				streams.duration_ms = report_interval;
 			}
-			ret = tcp_upload(sock, round_duration, param.packet_size, &periodic_result);
+			ret = zperf_run_streams(streams.num_streams, tcp_upload_stream,
+						&streams, &periodic_result);
 			if (ret < 0) {
 				upload_ctx->callback(ZPERF_SESSION_ERROR, NULL,
 						     upload_ctx->user_data);
@@ -197,15 +278,15 @@ static void tcp_upload_async_work(struct k_work *work)
 			upload_ctx->callback(ZPERF_SESSION_PERIODIC_RESULT, &periodic_result,
 					     upload_ctx->user_data);
 
-			result.nb_packets_sent += periodic_result.nb_packets_sent;
+			zperf_results_add(&result, &periodic_result);
 			result.client_time_in_us += periodic_result.client_time_in_us;
-			result.nb_packets_errors += periodic_result.nb_packets_errors;
 		}
 
-		result.packet_size = periodic_result.packet_size;
+		result.num_streams = periodic_result.num_streams;
 
 	} else {
-		ret = tcp_upload(sock, param.duration_ms, param.packet_size, &result);
+		ret = zperf_run_streams(streams.num_streams, tcp_upload_stream,
+					&streams, &result);
 		if (ret < 0) {
 			upload_ctx->callback(ZPERF_SESSION_ERROR, NULL,
 					     upload_ctx->user_data);
@@ -216,7 +297,7 @@ static void tcp_upload_async_work(struct k_work *work)
 	upload_ctx->callback(ZPERF_SESSION_FINISHED, &result,
 			     upload_ctx->user_data);
 cleanup:
-	zsock_close(sock);
+	tcp_close_streams(&streams);
 }
 
 int zperf_tcp_upload_async(const struct zperf_upload_params *param,
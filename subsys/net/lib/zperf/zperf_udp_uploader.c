@@ -14,9 +14,12 @@ LOG_MODULE_DECLARE(net_zperf, CONFIG_NET_ZPERF_LOG_LEVEL);
 
 #include "zperf_internal.h"
 
-static uint8_t sample_packet[sizeof(struct zperf_udp_datagram) +
-			     sizeof(struct zperf_client_hdr_v1) +
-			     PACKET_SIZE_MAX];
+#define SAMPLE_PACKET_SIZE (sizeof(struct zperf_udp_datagram) +	\
+			    sizeof(struct zperf_client_hdr_v1) +	\
+			    PACKET_SIZE_MAX)
+
+/* Each stream fills in its own sequence numbers and timestamps */
+static uint8_t sample_packets[CONFIG_NET_ZPERF_MAX_STREAMS][SAMPLE_PACKET_SIZE];
 
 static struct zperf_async_upload_context udp_async_upload_ctx;
 
@@ -46,7 +49,7 @@ static inline void zperf_upload_decode_stat(const uint8_t *data,
 		ntohl(UNALIGNED_GET(&stat->jitter1)) * USEC_PER_SEC;
 }
 
-static inline int zperf_upload_fin(int sock,
+static inline int zperf_upload_fin(int sock, uint8_t *sample_packet,
 				   uint32_t nb_packets,
 				   uint64_t end_time,
 				   uint32_t packet_size,
@@ -85,7 +88,7 @@ static inline int zperf_upload_fin(int sock,
 		hdr->flags = 0;
 		hdr->num_of_threads = htonl(1);
 		hdr->port = 0;
-		hdr->buffer_len = sizeof(sample_packet) -
+		hdr->buffer_len = SAMPLE_PACKET_SIZE -
 			sizeof(*datagram) - sizeof(*hdr);
 		hdr->bandwidth = 0;
 		hdr->num_of_bytes = htonl(packet_size);
@@ -140,8 +143,11 @@ static inline int zperf_upload_fin(int sock,
 
 static int udp_upload(int sock, int port,
 		      const struct zperf_upload_params *param,
+		      uint8_t *sample_packet,
 		      struct zperf_results *results)
 {
+	int num_streams = MAX(param->options.num_streams, 1);
+	uint32_t flags = 0U;
 	uint32_t duration_in_ms = param->duration_ms;
 	uint32_t packet_size = param->packet_size;
 	uint32_t rate_in_kbps = param->rate_kbps;
@@ -149,6 +155,7 @@ static int udp_upload(int sock, int port,
 	uint32_t packet_duration = k_us_to_ticks_ceil32(packet_duration_us);
 	uint32_t delay = packet_duration;
 	uint32_t nb_packets = 0U;
+	uint32_t last_latency = 0U;
 	int64_t start_time, end_time;
 	int64_t print_time, last_loop_time;
 	uint32_t print_period;
@@ -174,7 +181,13 @@ static int udp_upload(int sock, int port,
 	print_period = k_ms_to_ticks_ceil32(MSEC_PER_SEC);
 	print_time = start_time + print_period;
 
-	(void)memset(sample_packet, 'z', sizeof(sample_packet));
+	(void)memset(sample_packet, 'z', SAMPLE_PACKET_SIZE);
+
+	if (param->options.bidir_port != 0) {
+		/* Ask the server to send to us while receiving */
+		flags = ZPERF_FLAGS_VERSION1 | ZPERF_FLAGS_RUN_NOW;
+		port = param->options.bidir_port;
+	}
 
 	do {
 		struct zperf_udp_datagram *datagram;
@@ -182,6 +195,7 @@ static int udp_upload(int sock, int port,
 		uint64_t usecs64;
 		uint32_t secs, usecs;
 		int64_t loop_time;
+		uint32_t send_start;
 		int32_t adjust;
 
 		/* Timestamp */
@@ -218,16 +232,20 @@ static int udp_upload(int sock, int port,
 
 		hdr = (struct zperf_client_hdr_v1 *)(sample_packet +
 						     sizeof(*datagram));
-		hdr->flags = 0;
-		hdr->num_of_threads = htonl(1);
+		hdr->flags = htonl(flags);
+		hdr->num_of_threads = htonl(num_streams);
 		hdr->port = htonl(port);
-		hdr->buffer_len = sizeof(sample_packet) -
+		hdr->buffer_len = SAMPLE_PACKET_SIZE -
 			sizeof(*datagram) - sizeof(*hdr);
 		hdr->bandwidth = htonl(rate_in_kbps);
 		hdr->num_of_bytes = htonl(packet_size);
 
 		/* Send the packet */
+		send_start = k_cycle_get_32();
 		ret = zsock_send(sock, sample_packet, packet_size, 0);
+		zperf_record_send_latency(results,
+					  k_cyc_to_us_floor32(k_cycle_get_32() - send_start),
+					  &last_latency);
 		if (ret < 0) {
 			NET_ERR("Failed to send the packet (%d)", errno);
 			return -errno;
@@ -267,8 +285,8 @@ static int udp_upload(int sock, int port,
 	} else {
 		return -EINVAL;
 	}
-	ret = zperf_upload_fin(sock, nb_packets, end_time, packet_size,
-			       results, is_mcast_pkt);
+	ret = zperf_upload_fin(sock, sample_packet, nb_packets, end_time,
+			       packet_size, results, is_mcast_pkt);
 	if (ret < 0) {
 		return ret;
 	}
@@ -282,18 +300,15 @@ static int udp_upload(int sock, int port,
 	return 0;
 }
 
-int zperf_udp_upload(const struct zperf_upload_params *param,
-		     struct zperf_results *result)
+static int udp_upload_stream(int stream, void *user_data,
+			     struct zperf_results *results)
 {
+	const struct zperf_upload_params *param = user_data;
 	int port = 0;
 	int sock;
 	int ret;
 	struct ifreq req;
 
-	if (param == NULL || result == NULL) {
-		return -EINVAL;
-	}
-
 	if (param->peer_addr.sa_family == AF_INET) {
 		port = ntohs(net_sin(&param->peer_addr)->sin_port);
 	} else if (param->peer_addr.sa_family == AF_INET6) {
@@ -321,13 +336,24 @@ int zperf_udp_upload(const struct zperf_upload_params *param,
 		}
 	}
 
-	ret = udp_upload(sock, port, param, result);
+	ret = udp_upload(sock, port, param, sample_packets[stream], results);
 
 	zsock_close(sock);
 
 	return ret;
 }
 
+int zperf_udp_upload(const struct zperf_upload_params *param,
+		     struct zperf_results *result)
+{
+	if (param == NULL || result == NULL) {
+		return -EINVAL;
+	}
+
+	return zperf_run_streams(param->options.num_streams, udp_upload_stream,
+				 (void *)param, result);
+}
+
 static void udp_upload_async_work(struct k_work *work)
 {
 	struct zperf_async_upload_context *upload_ctx =
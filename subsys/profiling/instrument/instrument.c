@@ -0,0 +1,378 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/debug/symtab.h>
+#include <zephyr/profiling/instrument.h>
+#include <zephyr/sys/printk.h>
+
+/* Only the application is built with -finstrument-functions, this keeps
+ * the hooks safe should the rest of the tree be built with it as well.
+ */
+#define __no_instrument __attribute__((no_instrument_function))
+
+#define INSTRUMENT_TRACE_EVENTS CONFIG_PROFILING_INSTRUMENT_TRACE_EVENTS
+
+struct instrument_frame {
+	void *fn;
+	uint64_t start;
+	/* Inclusive cycles of the functions called so far */
+	uint64_t child;
+};
+
+/* Shadow stack of the instrumented functions a thread is in */
+struct instrument_stack {
+	k_tid_t thread;
+	uint16_t depth;
+	/* Calls deeper than the shadow stack, which are not recorded */
+	uint16_t overflow;
+	struct instrument_frame frames[CONFIG_PROFILING_INSTRUMENT_STACK_DEPTH];
+};
+
+struct instrument_trace_event {
+	void *fn;
+	k_tid_t thread;
+	uint64_t start;
+	uint64_t duration;
+};
+
+static struct instrument_stack stacks[CONFIG_PROFILING_INSTRUMENT_THREADS];
+static struct instrument_stack *current_stack;
+
+static struct instrument_func_stats funcs[CONFIG_PROFILING_INSTRUMENT_FUNCTIONS];
+static uint32_t funcs_dropped;
+
+#if INSTRUMENT_TRACE_EVENTS > 0
+static struct instrument_trace_event trace[INSTRUMENT_TRACE_EVENTS];
+static uint32_t trace_len;
+static uint32_t trace_dropped;
+#endif
+
+static bool enabled = true;
+
+/* Both hash tables are indexed by pointers, which are at least word aligned */
+static inline __no_instrument size_t ptr_hash(const void *ptr, size_t size)
+{
+	return ((uintptr_t)ptr / sizeof(void *)) % size;
+}
+
+/* Called with interrupts locked. Threads are mapped to their shadow stack
+ * on first use, the last stack used is cached since the same thread keeps
+ * calling until it is switched out.
+ */
+static __no_instrument struct instrument_stack *instrument_stack_get(void)
+{
+	k_tid_t thread = k_current_get();
+	size_t idx;
+
+	if ((current_stack != NULL) && (current_stack->thread == thread)) {
+		return current_stack;
+	}
+
+	if (thread == NULL) {
+		/* Before the kernel runs threads */
+		return NULL;
+	}
+
+	idx = ptr_hash(thread, ARRAY_SIZE(stacks));
+
+	for (size_t i = 0; i < ARRAY_SIZE(stacks); i++) {
+		struct instrument_stack *stack = &stacks[idx];
+
+		if (stack->thread == NULL) {
+			stack->thread = thread;
+		}
+
+		if (stack->thread == thread) {
+			current_stack = stack;
+			return stack;
+		}
+
+		idx = (idx + 1) % ARRAY_SIZE(stacks);
+	}
+
+	return NULL;
+}
+
+static __no_instrument void instrument_func_update(void *fn, uint64_t inclusive,
+						   uint64_t exclusive)
+{
+	size_t idx = ptr_hash(fn, ARRAY_SIZE(funcs));
+
+	for (size_t i = 0; i < ARRAY_SIZE(funcs); i++) {
+		struct instrument_func_stats *stats = &funcs[idx];
+
+		if (stats->addr == 0U) {
+			stats->addr = (uintptr_t)fn;
+		}
+
+		if (stats->addr == (uintptr_t)fn) {
+			stats->calls++;
+			stats->inclusive += inclusive;
+			stats->exclusive += exclusive;
+			return;
+		}
+
+		idx = (idx + 1) % ARRAY_SIZE(funcs);
+	}
+
+	funcs_dropped++;
+}
+
+static __no_instrument void instrument_trace_add(void *fn, k_tid_t thread, uint64_t start,
+						 uint64_t duration)
+{
+#if INSTRUMENT_TRACE_EVENTS > 0
+	if (trace_len == ARRAY_SIZE(trace)) {
+		trace_dropped++;
+		return;
+	}
+
+	trace[trace_len++] = (struct instrument_trace_event){
+		.fn = fn,
+		.thread = thread,
+		.start = start,
+		.duration = duration,
+	};
+#else
+	ARG_UNUSED(fn);
+	ARG_UNUSED(thread);
+	ARG_UNUSED(start);
+	ARG_UNUSED(duration);
+#endif
+}
+
+__no_instrument void __cyg_profile_func_enter(void *fn, void *call_site)
+{
+	struct instrument_stack *stack;
+	unsigned int key;
+
+	ARG_UNUSED(call_site);
+
+	if (!enabled) {
+		return;
+	}
+
+	key = arch_irq_lock();
+
+	stack = instrument_stack_get();
+	if (stack != NULL) {
+		if (stack->depth < ARRAY_SIZE(stack->frames)) {
+			struct instrument_frame *frame = &stack->frames[stack->depth++];
+
+			frame->fn = fn;
+			frame->child = 0U;
+			/* Last, to leave the hook itself out of the measurement */
+			frame->start = k_cycle_get_64();
+		} else {
+			stack->overflow++;
+		}
+	}
+
+	arch_irq_unlock(key);
+}
+
+/* Exits are handled while recording is disabled too, so that functions
+ * entered before are popped. Exits of functions entered while recording
+ * was disabled don't match the top of the shadow stack and are ignored.
+ */
+__no_instrument void __cyg_profile_func_exit(void *fn, void *call_site)
+{
+	uint64_t now = k_cycle_get_64();
+	struct instrument_stack *stack;
+	struct instrument_frame *frame;
+	uint64_t inclusive;
+	unsigned int key;
+
+	ARG_UNUSED(call_site);
+
+	key = arch_irq_lock();
+
+	stack = instrument_stack_get();
+	if (stack == NULL) {
+		goto out;
+	}
+
+	if (stack->overflow > 0U) {
+		stack->overflow--;
+		goto out;
+	}
+
+	if ((stack->depth == 0U) || (stack->frames[stack->depth - 1U].fn != fn)) {
+		goto out;
+	}
+
+	frame = &stack->frames[--stack->depth];
+	inclusive = now - frame->start;
+
+	if (stack->depth > 0U) {
+		stack->frames[stack->depth - 1U].child += inclusive;
+	}
+
+	if (enabled) {
+		instrument_func_update(fn, inclusive, inclusive - frame->child);
+		instrument_trace_add(fn, stack->thread, frame->start, inclusive);
+	}
+
+out:
+	arch_irq_unlock(key);
+}
+
+void instrument_enable(bool enable)
+{
+	enabled = enable;
+}
+
+void instrument_reset(void)
+{
+	unsigned int key = arch_irq_lock();
+
+	memset(funcs, 0, sizeof(funcs));
+	funcs_dropped = 0U;
+#if INSTRUMENT_TRACE_EVENTS > 0
+	trace_len = 0U;
+	trace_dropped = 0U;
+#endif
+
+	arch_irq_unlock(key);
+}
+
+uint32_t instrument_func_stats_foreach(int (*cb)(const struct instrument_func_stats *stats,
+						 void *data),
+				       void *data)
+{
+	struct instrument_func_stats stats;
+	unsigned int key;
+
+	for (size_t i = 0; i < ARRAY_SIZE(funcs); i++) {
+		key = arch_irq_lock();
+		stats = funcs[i];
+		arch_irq_unlock(key);
+
+		if (stats.addr == 0U) {
+			continue;
+		}
+
+		if (cb(&stats, data) != 0) {
+			break;
+		}
+	}
+
+	return funcs_dropped;
+}
+
+#if INSTRUMENT_TRACE_EVENTS > 0
+static int trace_printf(instrument_write_t write, void *ctx, const char *fmt, ...)
+{
+	char line[128];
+	va_list args;
+	int len;
+
+	va_start(args, fmt);
+	len = vsnprintk(line, sizeof(line), fmt, args);
+	va_end(args);
+
+	if (len < 0) {
+		return len;
+	}
+
+	return write(line, MIN((size_t)len, sizeof(line) - 1), ctx);
+}
+
+/* Chrome trace timestamps are in microseconds */
+static int trace_us_print(instrument_write_t write, void *ctx, const char *key,
+			  uint64_t cycles)
+{
+	uint64_t ns = k_cyc_to_ns_floor64(cycles);
+
+	return trace_printf(write, ctx, ",\"%s\":%llu.%03u", key, ns / NSEC_PER_USEC,
+			    (unsigned int)(ns % NSEC_PER_USEC));
+}
+
+static int trace_event_print(instrument_write_t write, void *ctx,
+			     const struct instrument_trace_event *event, bool *first)
+{
+	int ret;
+
+#ifdef CONFIG_SYMTAB
+	uint32_t offset;
+
+	ret = trace_printf(write, ctx, "%s\n{\"name\":\"%s\"", *first ? "" : ",",
+			   symtab_find_symbol_name((uintptr_t)event->fn, &offset));
+#else
+	ret = trace_printf(write, ctx, "%s\n{\"name\":\"%p\"", *first ? "" : ",", event->fn);
+#endif
+	*first = false;
+	ret = ret ? ret : trace_printf(write, ctx, ",\"ph\":\"X\",\"pid\":0,\"tid\":%lu",
+				       (unsigned long)(uintptr_t)event->thread);
+	ret = ret ? ret : trace_us_print(write, ctx, "ts", event->start);
+	ret = ret ? ret : trace_us_print(write, ctx, "dur", event->duration);
+
+	return ret ? ret : write("}", 1, ctx);
+}
+
+static int trace_thread_names_print(instrument_write_t write, void *ctx, bool *first)
+{
+	int ret = 0;
+
+	for (size_t i = 0; (i < ARRAY_SIZE(stacks)) && (ret == 0); i++) {
+		const char *name;
+
+		if (stacks[i].thread == NULL) {
+			continue;
+		}
+
+		name = k_thread_name_get(stacks[i].thread);
+		if ((name == NULL) || (name[0] == '\0')) {
+			continue;
+		}
+
+		ret = trace_printf(write, ctx,
+				   "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,"
+				   "\"tid\":%lu,\"args\":{\"name\":\"%s\"}}",
+				   *first ? "" : ",", (unsigned long)(uintptr_t)stacks[i].thread,
+				   name);
+		*first = false;
+	}
+
+	return ret;
+}
+
+int instrument_chrome_trace_export(instrument_write_t write, void *ctx)
+{
+	bool was_enabled = enabled;
+	bool first = true;
+	int ret;
+
+	enabled = false;
+
+	ret = trace_printf(write, ctx, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+	ret = ret ? ret : trace_thread_names_print(write, ctx, &first);
+
+	for (uint32_t i = 0; (i < trace_len) && (ret == 0); i++) {
+		ret = trace_event_print(write, ctx, &trace[i], &first);
+	}
+
+	ret = ret ? ret : trace_printf(write, ctx,
+				       "],\n\"otherData\":{\"dropped_calls\":%u,"
+				       "\"dropped_stats_calls\":%u}}\n",
+				       trace_dropped, funcs_dropped);
+
+	enabled = was_enabled;
+
+	return ret;
+}
+#else
+int instrument_chrome_trace_export(instrument_write_t write, void *ctx)
+{
+	ARG_UNUSED(write);
+	ARG_UNUSED(ctx);
+
+	return -ENOTSUP;
+}
+#endif /* INSTRUMENT_TRACE_EVENTS > 0 */
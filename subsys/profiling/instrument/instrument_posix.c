@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <cmdline.h>
+#include <posix_native_task.h>
+#include <zephyr/profiling/instrument.h>
+#include "instrument_posix_bottom.h"
+
+static const char *file_name;
+
+static int instrument_posix_write(const char *data, size_t len, void *ctx)
+{
+	return instrument_posix_write_bottom(data, len, ctx) == 0 ? 0 : -EIO;
+}
+
+/* Write the recorded calls when the program exits */
+static void instrument_posix_export(void)
+{
+	void *out_stream;
+
+	if (file_name == NULL) {
+		file_name = "instrument.json";
+	}
+
+	out_stream = instrument_posix_open_bottom(file_name);
+	if (out_stream == NULL) {
+		return;
+	}
+
+	(void)instrument_chrome_trace_export(instrument_posix_write, out_stream);
+
+	instrument_posix_close_bottom(out_stream);
+}
+
+static void instrument_posix_option(void)
+{
+	static struct args_struct_t instrument_option[] = {
+		{
+			.manual = false,
+			.is_mandatory = false,
+			.is_switch = false,
+			.option = "instrument-file",
+			.name = "file_name",
+			.type = 's',
+			.dest = (void *)&file_name,
+			.call_when_found = NULL,
+			.descript = "File name for the function instrumentation trace "
+				    "(Chrome trace event format).",
+		},
+		ARG_TABLE_ENDMARKER
+	};
+
+	native_add_command_line_opts(instrument_option);
+}
+
+NATIVE_TASK(instrument_posix_option, PRE_BOOT_1, 1);
+NATIVE_TASK(instrument_posix_export, ON_EXIT, 1);
@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include "nsi_tracing.h"
+#include "instrument_posix_bottom.h"
+
+void *instrument_posix_open_bottom(const char *file_name)
+{
+	FILE *f = fopen(file_name, "w");
+
+	if (f == NULL) {
+		nsi_print_warning("%s: Could not open instrumentation trace file %s\n",
+				  __func__, file_name);
+	}
+
+	return (void *)f;
+}
+
+int instrument_posix_write_bottom(const void *data, unsigned long length, void *out_stream)
+{
+	if (fwrite(data, length, 1, (FILE *)out_stream) != 1) {
+		return -1;
+	}
+
+	return 0;
+}
+
+void instrument_posix_close_bottom(void *out_stream)
+{
+	fclose((FILE *)out_stream);
+}
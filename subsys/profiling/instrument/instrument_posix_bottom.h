@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * "Bottom" of the instrumentation trace export for the native/hosted
+ * targets. When built with the native_simulator this is built in the
+ * runner context, that is, with the host C library and include paths.
+ *
+ * Note: None of these functions are public interfaces.
+ */
+
+#ifndef SUBSYS_PROFILING_INSTRUMENT_POSIX_BOTTOM_H
+#define SUBSYS_PROFILING_INSTRUMENT_POSIX_BOTTOM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void *instrument_posix_open_bottom(const char *file_name);
+int instrument_posix_write_bottom(const void *data, unsigned long length, void *out_stream);
+void instrument_posix_close_bottom(void *out_stream);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SUBSYS_PROFILING_INSTRUMENT_POSIX_BOTTOM_H */
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/debug/symtab.h>
+#include <zephyr/profiling/instrument.h>
+
+static int instrument_stats_print(const struct instrument_func_stats *stats, void *data)
+{
+	const struct shell *sh = data;
+
+#ifdef CONFIG_SYMTAB
+	uint32_t offset;
+
+	shell_fprintf(sh, SHELL_NORMAL, "%-32s",
+		      symtab_find_symbol_name(stats->addr, &offset));
+#else
+	shell_fprintf(sh, SHELL_NORMAL, "0x%-30lx", (unsigned long)stats->addr);
+#endif
+	shell_print(sh, " %10u %14llu %14llu", stats->calls,
+		    k_cyc_to_ns_floor64(stats->inclusive), k_cyc_to_ns_floor64(stats->exclusive));
+
+	return 0;
+}
+
+static int cmd_instrument_stats(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	uint32_t dropped;
+
+	shell_print(sh, "%-32s %10s %14s %14s", "function", "calls", "inclusive ns",
+		    "exclusive ns");
+	dropped = instrument_func_stats_foreach(instrument_stats_print, (void *)sh);
+	if (dropped > 0U) {
+		shell_warn(sh, "%u calls of functions not recorded, table full", dropped);
+	}
+
+	return 0;
+}
+
+static int instrument_shell_write(const char *data, size_t len, void *ctx)
+{
+	shell_fprintf((const struct shell *)ctx, SHELL_NORMAL, "%.*s", (int)len, data);
+
+	return 0;
+}
+
+static int cmd_instrument_trace(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	int ret = instrument_chrome_trace_export(instrument_shell_write, (void *)sh);
+
+	if (ret != 0) {
+		shell_error(sh, "Trace not available (%d)", ret);
+		return -ENOEXEC;
+	}
+
+	return 0;
+}
+
+static int cmd_instrument_enable(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(sh);
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	instrument_enable(true);
+
+	return 0;
+}
+
+static int cmd_instrument_disable(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(sh);
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	instrument_enable(false);
+
+	return 0;
+}
+
+static int cmd_instrument_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(sh);
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	instrument_reset();
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(m_sub_instrument,
+	SHELL_CMD_ARG(stats, NULL, "Print per function statistics", cmd_instrument_stats, 0, 0),
+	SHELL_CMD_ARG(trace, NULL, "Print the recorded calls as Chrome trace JSON",
+		      cmd_instrument_trace, 0, 0),
+	SHELL_CMD_ARG(enable, NULL, "Start recording", cmd_instrument_enable, 0, 0),
+	SHELL_CMD_ARG(disable, NULL, "Stop recording", cmd_instrument_disable, 0, 0),
+	SHELL_CMD_ARG(reset, NULL, "Clear statistics and trace", cmd_instrument_reset, 0, 0),
+	SHELL_SUBCMD_SET_END
+);
+SHELL_CMD_ARG_REGISTER(instrument, &m_sub_instrument, "Function instrumentation", NULL, 0, 0);
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <cmsis_core.h>
+
+static bool valid_stack(uintptr_t addr, k_tid_t current)
+{
+	return current->stack_info.start <= addr &&
+		addr < current->stack_info.start + current->stack_info.size;
+}
+
+static inline bool in_text_region(uintptr_t addr)
+{
+	extern uintptr_t __text_region_start, __text_region_end;
+
+	return (addr >= (uintptr_t)&__text_region_start) && (addr < (uintptr_t)&__text_region_end);
+}
+
+/*
+ * On exception entry the core pushes r0-r3, r12, lr, pc and xPSR of the
+ * interrupted thread on its stack (PSP), described by struct arch_esf.
+ *
+ * Thumb code does not keep a frame chain that can be walked reliably, as
+ * GCC may place r7 anywhere in the frame or not use it at all. The trace
+ * therefore holds the interrupted program counter and, if it points to
+ * code, the link register, which attributes samples to the function and
+ * usually its caller.
+ */
+size_t arch_perf_current_stack_trace(uintptr_t *buf, size_t size)
+{
+	const struct arch_esf *const esf = (const struct arch_esf *)__get_PSP();
+	size_t idx = 0;
+
+	if (size < 2U) {
+		return 0;
+	}
+
+	/* PSP is outside of the thread stack e.g. during system calls */
+	if (!valid_stack((uintptr_t)esf, _current)) {
+		return 0;
+	}
+
+	buf[idx++] = (uintptr_t)esf->basic.pc;
+
+	/* Clear the Thumb bit, EXC_RETURN values are filtered out as well */
+	if (in_text_region((uintptr_t)(esf->basic.lr & ~1U))) {
+		buf[idx++] = (uintptr_t)(esf->basic.lr & ~1U);
+	}
+
+	return idx;
+}
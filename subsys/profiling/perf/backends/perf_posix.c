@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+
+/* Zephyr threads run on host thread stacks, whose bounds are not known
+ * here. Limit how far a single frame may be from the previous one instead.
+ */
+#define MAX_FRAME_SIZE 0x10000
+
+static inline bool in_text_region(uintptr_t addr)
+{
+	/* Provided by the default host linker script */
+	extern char __executable_start[], etext[];
+
+	return (addr >= (uintptr_t)__executable_start) && (addr < (uintptr_t)etext);
+}
+
+/*
+ * Interrupts are delivered on the stack of the interrupted thread, so the
+ * frame chain leads from this function through the interrupt handling
+ * back into the thread. The frames of the timer interrupt handling are
+ * part of every sample, at the leaf end of the trace.
+ *
+ * stack frame in memory (x86, x86_64 and AArch64 hosts):
+ * (addresses growth up)
+ *  ....
+ *  ra
+ *  fp (next) <- fp (curr)
+ *  ....
+ */
+size_t arch_perf_current_stack_trace(uintptr_t *buf, size_t size)
+{
+	void **fp = __builtin_frame_address(0);
+	size_t idx = 0;
+
+	while (fp != NULL) {
+		if (idx >= size) {
+			return 0;
+		}
+
+		if (!in_text_region((uintptr_t)fp[1])) {
+			break;
+		}
+
+		buf[idx++] = (uintptr_t)fp[1];
+		void **new_fp = (void **)fp[0];
+
+		/*
+		 * anti-infinity-loop if
+		 * new_fp can't be smaller than fp, cause the stack is growing down
+		 * and trace moves deeper into the stack
+		 */
+		if ((new_fp <= fp) || ((uintptr_t)new_fp - (uintptr_t)fp > MAX_FRAME_SIZE)) {
+			break;
+		}
+		fp = new_fp;
+	}
+
+	return idx;
+}
@@ -10,11 +10,26 @@
 #include <zephyr/arch/cpu.h>
 #include <zephyr/shell/shell.h>
 #include <zephyr/shell/shell_uart.h>
+#include <zephyr/debug/symtab.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 size_t arch_perf_current_stack_trace(uintptr_t *buf, size_t size);
 
+#ifdef CONFIG_PROFILING_PERF_AGGREGATE
+/* Limits the time spent in the timer handler once the table fills up */
+#define PERF_MAX_PROBES 32
+
+/* One distinct stack trace of a thread and how many samples hit it */
+struct perf_stack {
+	k_tid_t thread;
+	uint32_t count;
+	size_t depth;
+	uintptr_t ips[CONFIG_PROFILING_PERF_MAX_DEPTH];
+};
+#endif
+
 struct perf_data_t {
 	struct k_timer timer;
 
@@ -22,9 +37,28 @@ struct perf_data_t {
 
 	struct k_work_delayable dwork;
 
+	bool running;
+	bool continuous;
+	uint32_t samples;
+	uint32_t lost;
+
+	/* The current sample is unwound here before it is stored */
+	uintptr_t trace[CONFIG_PROFILING_PERF_MAX_DEPTH];
+
+#ifdef CONFIG_PROFILING_PERF_AGGREGATE
+	size_t stacks_used;
+	struct perf_stack stacks[CONFIG_PROFILING_PERF_STACKS];
+#else
+	/* Records of a length followed by the return addresses. In continuous
+	 * mode the buffer is a ring, a zero length marks where the writer
+	 * wrapped around.
+	 */
+	size_t head;
 	size_t idx;
+	size_t records;
 	uintptr_t buf[CONFIG_PROFILING_PERF_BUFFER_SIZE];
 	bool buf_full;
+#endif
 };
 
 static void perf_tracer(struct k_timer *timer);
@@ -34,26 +68,128 @@ static struct perf_data_t perf_data = {
 	.dwork = Z_WORK_DELAYABLE_INITIALIZER(perf_dwork_handler),
 };
 
+#ifdef CONFIG_PROFILING_PERF_AGGREGATE
+static bool perf_store(struct perf_data_t *perf_data_ptr, size_t trace_length)
+{
+	k_tid_t thread = k_current_get();
+	/* FNV-1a over the thread and the return addresses */
+	uint32_t hash = 2166136261U ^ (uint32_t)(uintptr_t)thread;
+
+	for (size_t i = 0; i < trace_length; i++) {
+		hash = (hash ^ (uint32_t)perf_data_ptr->trace[i]) * 16777619U;
+	}
+
+	for (size_t n = 0; n < MIN(PERF_MAX_PROBES, CONFIG_PROFILING_PERF_STACKS); n++) {
+		struct perf_stack *stack =
+			&perf_data_ptr->stacks[(hash + n) % CONFIG_PROFILING_PERF_STACKS];
+
+		if (stack->count == 0U) {
+			stack->thread = thread;
+			stack->depth = trace_length;
+			memcpy(stack->ips, perf_data_ptr->trace, trace_length * sizeof(uintptr_t));
+			stack->count = 1U;
+			perf_data_ptr->stacks_used++;
+			return true;
+		}
+
+		if ((stack->thread == thread) && (stack->depth == trace_length) &&
+		    (memcmp(stack->ips, perf_data_ptr->trace,
+			    trace_length * sizeof(uintptr_t)) == 0)) {
+			stack->count++;
+			return true;
+		}
+	}
+
+	return false;
+}
+#else
+static bool perf_buf_fits(struct perf_data_t *perf_data_ptr, size_t size)
+{
+	if (perf_data_ptr->head < perf_data_ptr->idx) {
+		return perf_data_ptr->idx + size <= CONFIG_PROFILING_PERF_BUFFER_SIZE;
+	}
+
+	/* Wrapped, or head == idx which means the ring is full */
+	return perf_data_ptr->idx + size <= perf_data_ptr->head;
+}
+
+static size_t perf_buf_next(struct perf_data_t *perf_data_ptr, size_t pos)
+{
+	pos += perf_data_ptr->buf[pos] + 1;
+
+	if ((pos >= CONFIG_PROFILING_PERF_BUFFER_SIZE) || (perf_data_ptr->buf[pos] == 0U)) {
+		pos = 0;
+	}
+
+	return pos;
+}
+
+static bool perf_store(struct perf_data_t *perf_data_ptr, size_t trace_length)
+{
+	size_t size = trace_length + 1;
+
+	if (size > CONFIG_PROFILING_PERF_BUFFER_SIZE) {
+		return false;
+	}
+
+	if (perf_data_ptr->records == 0U) {
+		perf_data_ptr->head = 0;
+		perf_data_ptr->idx = 0;
+	}
+
+	while ((perf_data_ptr->records > 0U) && !perf_buf_fits(perf_data_ptr, size)) {
+		if (!perf_data_ptr->continuous) {
+			return false;
+		}
+
+		if (perf_data_ptr->head < perf_data_ptr->idx) {
+			/* No room left at the end, continue at the start */
+			if (perf_data_ptr->idx < CONFIG_PROFILING_PERF_BUFFER_SIZE) {
+				perf_data_ptr->buf[perf_data_ptr->idx] = 0U;
+			}
+			perf_data_ptr->idx = 0;
+		} else {
+			/* Drop the oldest sample */
+			perf_data_ptr->head = perf_buf_next(perf_data_ptr, perf_data_ptr->head);
+			if (--perf_data_ptr->records == 0U) {
+				perf_data_ptr->head = 0;
+				perf_data_ptr->idx = 0;
+			}
+		}
+	}
+
+	perf_data_ptr->buf[perf_data_ptr->idx] = trace_length;
+	memcpy(&perf_data_ptr->buf[perf_data_ptr->idx + 1], perf_data_ptr->trace,
+	       trace_length * sizeof(uintptr_t));
+	perf_data_ptr->idx += size;
+	perf_data_ptr->records++;
+
+	return true;
+}
+#endif /* CONFIG_PROFILING_PERF_AGGREGATE */
+
 static void perf_tracer(struct k_timer *timer)
 {
 	struct perf_data_t *perf_data_ptr =
 		(struct perf_data_t *)k_timer_user_data_get(timer);
 
-	size_t trace_length = 0;
+	size_t trace_length = arch_perf_current_stack_trace(perf_data_ptr->trace,
+							    ARRAY_SIZE(perf_data_ptr->trace));
 
-	if (++perf_data_ptr->idx < CONFIG_PROFILING_PERF_BUFFER_SIZE) {
-		trace_length = arch_perf_current_stack_trace(
-					perf_data_ptr->buf + perf_data_ptr->idx,
-					CONFIG_PROFILING_PERF_BUFFER_SIZE - perf_data_ptr->idx);
+	perf_data_ptr->samples++;
+
+	/* Too deep or could not be unwound */
+	if (trace_length == 0) {
+		perf_data_ptr->lost++;
+		return;
 	}
 
-	if (trace_length != 0) {
-		perf_data_ptr->buf[perf_data_ptr->idx - 1] = trace_length;
-		perf_data_ptr->idx += trace_length;
-	} else {
-		--perf_data_ptr->idx;
+	if (!perf_store(perf_data_ptr, trace_length)) {
+		perf_data_ptr->lost++;
+#ifndef CONFIG_PROFILING_PERF_AGGREGATE
 		perf_data_ptr->buf_full = true;
 		k_work_reschedule(&perf_data_ptr->dwork, K_NO_WAIT);
+#endif
 	}
 }
 
@@ -63,92 +199,239 @@ static void perf_dwork_handler(struct k_work *work)
 	struct perf_data_t *perf_data_ptr = CONTAINER_OF(dwork, struct perf_data_t, dwork);
 
 	k_timer_stop(&perf_data_ptr->timer);
+	perf_data_ptr->running = false;
+#ifndef CONFIG_PROFILING_PERF_AGGREGATE
 	if (perf_data_ptr->buf_full) {
 		shell_error(perf_data_ptr->sh, "Perf buf overflow!");
-	} else {
-		shell_print(perf_data_ptr->sh, "Perf done!");
+		return;
 	}
+#endif
+	shell_print(perf_data_ptr->sh, "Perf done!");
 }
 
 static int cmd_perf_record(const struct shell *sh, size_t argc, char **argv)
 {
-	if (k_work_delayable_is_pending(&perf_data.dwork)) {
+	if (perf_data.running) {
 		shell_warn(sh, "Perf is running");
 		return -EINPROGRESS;
 	}
 
+#ifndef CONFIG_PROFILING_PERF_AGGREGATE
 	if (perf_data.buf_full) {
 		shell_warn(sh, "Perf buffer is full");
 		return -ENOBUFS;
 	}
+#endif
+
+	long long duration_ms = strtoll(argv[1], NULL, 10);
+	long long frequency = strtoll(argv[2], NULL, 10);
 
-	k_timeout_t duration = K_MSEC(strtoll(argv[1], NULL, 10));
-	k_timeout_t period = K_NSEC(1000000000 / strtoll(argv[2], NULL, 10));
+	if ((duration_ms < 0) || (frequency <= 0)) {
+		shell_error(sh, "Invalid duration or frequency");
+		return -EINVAL;
+	}
+
+	k_timeout_t period = K_NSEC(1000000000 / frequency);
 
 	perf_data.sh = sh;
+	perf_data.continuous = (duration_ms == 0);
+	perf_data.running = true;
 
 	k_timer_user_data_set(&perf_data.timer, &perf_data);
 	k_timer_start(&perf_data.timer, K_NO_WAIT, period);
 
-	k_work_schedule(&perf_data.dwork, duration);
+	if (!perf_data.continuous) {
+		k_work_schedule(&perf_data.dwork, K_MSEC(duration_ms));
+	}
 
 	shell_print(sh, "Enabled perf");
 
 	return 0;
 }
 
+static int cmd_perf_stop(const struct shell *sh, size_t argc, char **argv)
+{
+	if (!perf_data.running) {
+		shell_warn(sh, "Perf is not running");
+		return -EALREADY;
+	}
+
+	k_timer_stop(&perf_data.timer);
+	(void)k_work_cancel_delayable(&perf_data.dwork);
+	perf_data.running = false;
+
+	shell_print(sh, "Perf stopped");
+
+	return 0;
+}
+
 static int cmd_perf_clear(const struct shell *sh, size_t argc, char **argv)
 {
 	if (sh != NULL) {
-		if (k_work_delayable_is_pending(&perf_data.dwork)) {
+		if (perf_data.running) {
 			shell_warn(sh, "Perf is running");
 			return -EINPROGRESS;
 		}
 		shell_print(sh, "Perf buffer cleared");
 	}
 
+	perf_data.samples = 0;
+	perf_data.lost = 0;
+#ifdef CONFIG_PROFILING_PERF_AGGREGATE
+	memset(perf_data.stacks, 0, sizeof(perf_data.stacks));
+	perf_data.stacks_used = 0;
+#else
+	perf_data.head = 0;
 	perf_data.idx = 0;
+	perf_data.records = 0;
 	perf_data.buf_full = false;
+#endif
 
 	return 0;
 }
 
 static int cmd_perf_info(const struct shell *sh, size_t argc, char **argv)
 {
-	if (k_work_delayable_is_pending(&perf_data.dwork)) {
-		shell_print(sh, "Perf is running");
+	if (perf_data.running) {
+		shell_print(sh, "Perf is running%s", perf_data.continuous ? " (continuous)" : "");
+	}
+
+#ifdef CONFIG_PROFILING_PERF_AGGREGATE
+	shell_print(sh, "Perf stacks: %zu/%d", perf_data.stacks_used,
+		    CONFIG_PROFILING_PERF_STACKS);
+#else
+	size_t used = perf_data.idx;
+
+	if (perf_data.records > 0U && perf_data.head >= perf_data.idx) {
+		used = CONFIG_PROFILING_PERF_BUFFER_SIZE - perf_data.head + perf_data.idx;
 	}
 
-	shell_print(sh, "Perf buf: %zu/%d %s", perf_data.idx, CONFIG_PROFILING_PERF_BUFFER_SIZE,
+	shell_print(sh, "Perf buf: %zu/%d %s", used, CONFIG_PROFILING_PERF_BUFFER_SIZE,
 		    perf_data.buf_full ? "(full)" : "");
+#endif
+	shell_print(sh, "Samples: %u, lost: %u", perf_data.samples, perf_data.lost);
+
+	return 0;
+}
+
+/* Print one stack trace in the folded format of FlameGraph, outermost
+ * frame first. Consecutive frames of the same function are merged, like
+ * scripts/profiling/stackcollapse.py does.
+ */
+static void perf_print_folded(const struct shell *sh, k_tid_t thread,
+			      const uintptr_t *ips, size_t depth, uint32_t count)
+{
+	bool first = true;
+#ifdef CONFIG_SYMTAB
+	const char *prev = NULL;
+#endif
+
+	if (thread != NULL) {
+		const char *name = k_thread_name_get(thread);
+
+		if ((name != NULL) && (name[0] != '\0')) {
+			shell_fprintf(sh, SHELL_NORMAL, "%s", name);
+		} else {
+			shell_fprintf(sh, SHELL_NORMAL, "%p", (void *)thread);
+		}
+		first = false;
+	}
+
+	for (size_t i = depth; i-- > 0;) {
+#ifdef CONFIG_SYMTAB
+		uint32_t offset;
+		const char *name = symtab_find_symbol_name(ips[i], &offset);
+
+		if (name == prev) {
+			continue;
+		}
+		prev = name;
+
+		shell_fprintf(sh, SHELL_NORMAL, "%s%s", first ? "" : ";", name);
+#else
+		shell_fprintf(sh, SHELL_NORMAL, "%s0x%lx", first ? "" : ";",
+			      (unsigned long)ips[i]);
+#endif
+		first = false;
+	}
+
+	shell_fprintf(sh, SHELL_NORMAL, " %u\n", count);
+}
+
+static int cmd_perf_folded(const struct shell *sh, size_t argc, char **argv)
+{
+	if (perf_data.running) {
+		shell_warn(sh, "Perf is running");
+		return -EINPROGRESS;
+	}
+
+#ifdef CONFIG_PROFILING_PERF_AGGREGATE
+	for (size_t i = 0; i < CONFIG_PROFILING_PERF_STACKS; i++) {
+		const struct perf_stack *stack = &perf_data.stacks[i];
+
+		if (stack->count > 0U) {
+			perf_print_folded(sh, stack->thread, stack->ips, stack->depth,
+					  stack->count);
+		}
+	}
+#else
+	size_t pos = perf_data.head;
+
+	for (size_t r = 0; r < perf_data.records; r++) {
+		perf_print_folded(sh, NULL, &perf_data.buf[pos + 1], perf_data.buf[pos], 1U);
+		pos = perf_buf_next(&perf_data, pos);
+	}
+#endif
 
 	return 0;
 }
 
 static int cmd_perf_print(const struct shell *sh, size_t argc, char **argv)
 {
-	if (k_work_delayable_is_pending(&perf_data.dwork)) {
+	if (perf_data.running) {
 		shell_warn(sh, "Perf is running");
 		return -EINPROGRESS;
 	}
 
-	shell_print(sh, "Perf buf length %zu", perf_data.idx);
-	for (size_t i = 0; i < perf_data.idx; i++) {
-		shell_print(sh, "%016lx", perf_data.buf[i]);
+#ifdef CONFIG_PROFILING_PERF_AGGREGATE
+	shell_error(sh, "Samples are aggregated, use perf folded");
+
+	return -ENOTSUP;
+#else
+	size_t length = 0;
+	size_t pos = perf_data.head;
+
+	for (size_t r = 0; r < perf_data.records; r++) {
+		length += perf_data.buf[pos] + 1;
+		pos = perf_buf_next(&perf_data, pos);
+	}
+
+	shell_print(sh, "Perf buf length %zu", length);
+
+	pos = perf_data.head;
+	for (size_t r = 0; r < perf_data.records; r++) {
+		for (size_t i = 0; i <= perf_data.buf[pos]; i++) {
+			shell_print(sh, "%016lx", perf_data.buf[pos + i]);
+		}
+		pos = perf_buf_next(&perf_data, pos);
 	}
 
 	cmd_perf_clear(NULL, 0, NULL);
 
 	return 0;
+#endif
 }
 
 #define CMD_HELP_RECORD                                                                            \
 	"Start recording for <duration> ms on <frequency> Hz\n"                                    \
+	"A duration of 0 records continuously until perf stop\n"                                   \
 	"Usage: record <duration> <frequency>"
 
 SHELL_STATIC_SUBCMD_SET_CREATE(m_sub_perf,
 	SHELL_CMD_ARG(record, NULL, CMD_HELP_RECORD, cmd_perf_record, 3, 0),
+	SHELL_CMD_ARG(stop, NULL, "Stop recording", cmd_perf_stop, 0, 0),
 	SHELL_CMD_ARG(printbuf, NULL, "Print the perf buffer", cmd_perf_print, 0, 0),
+	SHELL_CMD_ARG(folded, NULL, "Print stack traces in folded format", cmd_perf_folded, 0, 0),
 	SHELL_CMD_ARG(clear, NULL, "Clear the perf buffer", cmd_perf_clear, 0, 0),
 	SHELL_CMD_ARG(info, NULL, "Print the perf info", cmd_perf_info, 0, 0),
 	SHELL_SUBCMD_SET_END
@@ -122,6 +122,9 @@ const char *shell_backend_dummy_get_output(const struct shell *sh,
 {
 	struct shell_dummy *sh_dummy = (struct shell_dummy *)sh->iface->ctx;
 
+	/* Output may still be waiting in the shell output buffer. */
+	z_shell_tx_buffer_flush(sh);
+
 	sh_dummy->buf[sh_dummy->len] = '\0';
 	*sizep = sh_dummy->len;
 	sh_dummy->len = 0;
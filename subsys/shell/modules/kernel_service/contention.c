@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "kernel_shell.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel/obj_core.h>
+
+struct contention_ctx {
+	const struct shell *sh;
+	const char *type_name;
+	size_t obj_core_offset;
+	bool json;
+	bool first;
+};
+
+static const struct {
+	uint32_t id;
+	const char *name;
+} contention_types[] = {
+#ifdef CONFIG_OBJ_CORE_MUTEX
+	{ K_OBJ_TYPE_MUTEX_ID, "mutex" },
+#endif /* CONFIG_OBJ_CORE_MUTEX */
+#ifdef CONFIG_OBJ_CORE_SEM
+	{ K_OBJ_TYPE_SEM_ID, "sem" },
+#endif /* CONFIG_OBJ_CORE_SEM */
+};
+
+/* Waiters may have exited since, their name is only read while they exist */
+static const char *waiter_name(struct k_thread *thread)
+{
+	const char *name = NULL;
+
+	if (IS_ENABLED(CONFIG_KERNEL_THREAD_SHELL) && z_thread_is_valid(thread)) {
+		name = k_thread_name_get(thread);
+	}
+
+	return (name != NULL) ? name : "";
+}
+
+static void waiters_print(struct contention_ctx *ctx, struct k_obj_core_contention *stats)
+{
+	bool first = true;
+
+	for (size_t i = 0; i < ARRAY_SIZE(stats->waiters); i++) {
+		struct k_obj_core_waiter *waiter = &stats->waiters[i];
+
+		if (waiter->count == 0U) {
+			continue;
+		}
+
+		if (ctx->json) {
+			shell_fprintf(ctx->sh, SHELL_NORMAL,
+				      "%s{\"thread\":\"%p\",\"name\":\"%s\",\"count\":%u}",
+				      first ? "" : ",", (void *)waiter->thread,
+				      waiter_name(waiter->thread), waiter->count);
+		} else {
+			shell_print(ctx->sh, "    waiter %p %-20s %u", (void *)waiter->thread,
+				    waiter_name(waiter->thread), waiter->count);
+		}
+
+		first = false;
+	}
+}
+
+static int obj_contention_print(struct k_obj_core *obj_core, void *data)
+{
+	struct contention_ctx *ctx = data;
+	struct k_obj_core_contention stats;
+	void *obj = (uint8_t *)obj_core - ctx->obj_core_offset;
+	uint32_t acquired;
+
+	k_obj_core_contention_get(obj_core, &stats);
+
+	acquired = stats.uncontended + stats.contended;
+	if ((acquired == 0U) && (stats.timeouts == 0U)) {
+		return 0;
+	}
+
+	if (ctx->json) {
+		shell_fprintf(ctx->sh, SHELL_NORMAL,
+			      "%s\n{\"type\":\"%s\",\"object\":\"%p\",\"acquired\":%u,"
+			      "\"contended\":%u,\"timeouts\":%u,\"total_wait_us\":%llu,"
+			      "\"max_wait_us\":%llu,\"waiters\":[",
+			      ctx->first ? "" : ",", ctx->type_name, obj, acquired,
+			      stats.contended, stats.timeouts,
+			      k_cyc_to_us_floor64(stats.total_wait),
+			      k_cyc_to_us_floor64(stats.max_wait));
+		waiters_print(ctx, &stats);
+		shell_fprintf(ctx->sh, SHELL_NORMAL, "]}");
+	} else {
+		shell_print(ctx->sh, "%-5s %p %10u %10u %8u %12llu %10llu", ctx->type_name, obj,
+			    acquired, stats.contended, stats.timeouts,
+			    k_cyc_to_us_floor64(stats.total_wait),
+			    k_cyc_to_us_floor64(stats.max_wait));
+		waiters_print(ctx, &stats);
+	}
+
+	ctx->first = false;
+
+	return 0;
+}
+
+#ifdef CONFIG_OBJ_CORE_CONTENTION_SPINLOCK
+static int spin_contention_print(const struct k_spin_contention *stats, void *data)
+{
+	struct contention_ctx *ctx = data;
+
+	if (stats->contended == 0U) {
+		return 0;
+	}
+
+	if (ctx->json) {
+		shell_fprintf(ctx->sh, SHELL_NORMAL,
+			      "%s\n{\"lock\":\"%p\",\"contended\":%u,\"total_wait_us\":%llu,"
+			      "\"max_wait_us\":%llu}",
+			      ctx->first ? "" : ",", (void *)stats->lock, stats->contended,
+			      k_cyc_to_us_floor64(stats->total_wait),
+			      k_cyc_to_us_floor64(stats->max_wait));
+	} else {
+		shell_print(ctx->sh, "%p %10u %12llu %10llu", (void *)stats->lock,
+			    stats->contended, k_cyc_to_us_floor64(stats->total_wait),
+			    k_cyc_to_us_floor64(stats->max_wait));
+	}
+
+	ctx->first = false;
+
+	return 0;
+}
+#endif /* CONFIG_OBJ_CORE_CONTENTION_SPINLOCK */
+
+static void objs_contention_print(struct contention_ctx *ctx)
+{
+	struct k_obj_type *type;
+
+	for (size_t i = 0; i < ARRAY_SIZE(contention_types); i++) {
+		type = k_obj_type_find(contention_types[i].id);
+		if (type == NULL) {
+			continue;
+		}
+
+		ctx->type_name = contention_types[i].name;
+		ctx->obj_core_offset = type->obj_core_offset;
+		k_obj_type_walk_unlocked(type, obj_contention_print, ctx);
+	}
+}
+
+static int cmd_kernel_contention(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	struct contention_ctx ctx = {
+		.sh = sh,
+		.first = true,
+	};
+
+	shell_print(sh, "type  object       acquired  contended timeouts total us     max us");
+	objs_contention_print(&ctx);
+
+#ifdef CONFIG_OBJ_CORE_CONTENTION_SPINLOCK
+	shell_print(sh, "\nspinlock     contended total us     max us");
+	k_spin_contention_walk(spin_contention_print, &ctx);
+	shell_print(sh, "untracked: %u", k_spin_contention_dropped_get());
+#endif /* CONFIG_OBJ_CORE_CONTENTION_SPINLOCK */
+
+	return 0;
+}
+
+static int cmd_kernel_contention_json(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	struct contention_ctx ctx = {
+		.sh = sh,
+		.json = true,
+		.first = true,
+	};
+
+	shell_fprintf(sh, SHELL_NORMAL, "{\"objects\":[");
+	objs_contention_print(&ctx);
+	shell_fprintf(sh, SHELL_NORMAL, "]");
+
+#ifdef CONFIG_OBJ_CORE_CONTENTION_SPINLOCK
+	ctx.first = true;
+	shell_fprintf(sh, SHELL_NORMAL, ",\n\"spinlocks\":[");
+	k_spin_contention_walk(spin_contention_print, &ctx);
+	shell_fprintf(sh, SHELL_NORMAL, "],\n\"spinlocks_dropped\":%u",
+		      k_spin_contention_dropped_get());
+#endif /* CONFIG_OBJ_CORE_CONTENTION_SPINLOCK */
+
+	shell_print(sh, "}");
+
+	return 0;
+}
+
+static int obj_contention_reset(struct k_obj_core *obj_core, void *data)
+{
+	ARG_UNUSED(data);
+
+	k_obj_core_contention_reset(obj_core);
+
+	return 0;
+}
+
+static int cmd_kernel_contention_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(sh);
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	struct k_obj_type *type;
+
+	for (size_t i = 0; i < ARRAY_SIZE(contention_types); i++) {
+		type = k_obj_type_find(contention_types[i].id);
+		if (type != NULL) {
+			k_obj_type_walk_locked(type, obj_contention_reset, NULL);
+		}
+	}
+
+#ifdef CONFIG_OBJ_CORE_CONTENTION_SPINLOCK
+	k_spin_contention_reset();
+#endif /* CONFIG_OBJ_CORE_CONTENTION_SPINLOCK */
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel_contention,
+	SHELL_CMD(json, NULL, "Dump contention statistics as JSON.", cmd_kernel_contention_json),
+	SHELL_CMD(reset, NULL, "Reset contention statistics.", cmd_kernel_contention_reset),
+	SHELL_SUBCMD_SET_END
+);
+
+KERNEL_CMD_ADD(contention, &sub_kernel_contention, "Mutex, semaphore and spinlock contention.",
+	       cmd_kernel_contention);
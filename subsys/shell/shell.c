@@ -33,10 +33,6 @@
 #define SHELL_INIT_OPTION_PRINTER	(NULL)
 #define SHELL_TX_MTX_TIMEOUT_MS		50
 
-#define SHELL_THREAD_PRIORITY \
-	COND_CODE_1(CONFIG_SHELL_THREAD_PRIORITY_OVERRIDE, \
-			(CONFIG_SHELL_THREAD_PRIORITY), (K_LOWEST_APPLICATION_THREAD_PRIO))
-
 BUILD_ASSERT(SHELL_THREAD_PRIORITY >=
 		  K_HIGHEST_APPLICATION_THREAD_PRIO
 		&& SHELL_THREAD_PRIORITY <= K_LOWEST_APPLICATION_THREAD_PRIO,
@@ -1218,6 +1214,10 @@ static int instance_init(const struct shell *sh,
 
 	k_mutex_init(&sh->ctx->wr_mtx);
 
+#if defined(CONFIG_SHELL_TX_BUFFER)
+	z_shell_tx_buffer_init(sh);
+#endif
+
 	for (int i = 0; i < SHELL_SIGNALS; i++) {
 		k_poll_signal_init(&sh->ctx->signals[i]);
 		k_poll_event_init(&sh->ctx->events[i],
@@ -1280,6 +1280,8 @@ static int instance_uninit(const struct shell *sh)
 		z_shell_log_backend_disable(sh->log_backend);
 	}
 
+	z_shell_tx_buffer_flush(sh);
+
 	err = sh->iface->api->uninit(sh->iface);
 	if (err != 0) {
 		return err;
@@ -1564,6 +1566,43 @@ void shell_vfprintf(const struct shell *sh, enum shell_vt100_color color,
 	k_mutex_unlock(&sh->ctx->wr_mtx);
 }
 
+/* This function mustn't be used from shell context to avoid deadlock.
+ * However it can be used in shell command handlers.
+ */
+void shell_write(const struct shell *sh, const void *data, size_t length)
+{
+	__ASSERT_NO_MSG(sh);
+	__ASSERT(!k_is_in_isr(), "Thread context required.");
+	__ASSERT_NO_MSG(sh->ctx);
+	__ASSERT_NO_MSG(z_flag_cmd_ctx_get(sh) ||
+			(k_current_get() != sh->ctx->tid));
+	__ASSERT_NO_MSG(sh->fprintf_ctx);
+	__ASSERT_NO_MSG(data);
+
+	/* Sending a message to a non-active shell leads to a dead lock. */
+	if (state_get(sh) != SHELL_STATE_ACTIVE) {
+		z_flag_print_noinit_set(sh, true);
+		return;
+	}
+
+	if (k_mutex_lock(&sh->ctx->wr_mtx, K_MSEC(SHELL_TX_MTX_TIMEOUT_MS)) != 0) {
+		return;
+	}
+
+	if (!z_flag_cmd_ctx_get(sh) && !sh->ctx->bypass && z_flag_use_vt100_get(sh)) {
+		z_shell_cmd_line_erase(sh);
+	}
+	/* Data formatted before must be written first. */
+	z_transport_buffer_flush(sh);
+	z_shell_raw_write(sh, data, length);
+	if (!z_flag_cmd_ctx_get(sh) && !sh->ctx->bypass && z_flag_use_vt100_get(sh)) {
+		z_shell_print_prompt_and_cmd(sh);
+	}
+	z_transport_buffer_flush(sh);
+
+	k_mutex_unlock(&sh->ctx->wr_mtx);
+}
+
 /* These functions mustn't be used from shell context to avoid deadlock:
  * - shell_fprintf_impl
  * - shell_fprintf_info
@@ -1752,6 +1791,9 @@ int shell_execute_cmd(const struct shell *sh, const char *cmd)
 	ret_val = execute(sh);
 	k_mutex_unlock(&sh->ctx->wr_mtx);
 
+	/* Output of the command is complete when returning. */
+	z_shell_tx_buffer_flush(sh);
+
 	cmd_buffer_clear(sh);
 
 	return ret_val;
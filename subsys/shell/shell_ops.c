@@ -5,6 +5,7 @@
  */
 
 #include <ctype.h>
+#include <string.h>
 #include "shell_ops.h"
 
 #define CMD_CURSOR_LEN 8
@@ -448,11 +449,9 @@ static void shell_pend_on_txdone(const struct shell *sh)
 	}
 }
 
-void z_shell_write(const struct shell *sh, const void *data,
-		 size_t length)
+static void transport_write(const struct shell *sh, const void *data,
+			    size_t length)
 {
-	__ASSERT_NO_MSG(sh && data);
-
 	size_t offset = 0;
 	size_t tmp_cnt;
 
@@ -472,6 +471,236 @@ void z_shell_write(const struct shell *sh, const void *data,
 	}
 }
 
+#if defined(CONFIG_SHELL_TX_BUFFER)
+static K_SEM_DEFINE(tx_buffer_sem, 0, 1);
+
+/* The buffered data is only released once written, so only one context at a
+ * time may claim it and write the transport: the output thread or a context
+ * writing the transport directly.
+ */
+static void tx_writer_begin(const struct shell *sh)
+{
+	k_mutex_lock(&sh->ctx->tx_mtx, K_FOREVER);
+
+	while (sh->ctx->tx_writer != NULL) {
+		k_condvar_wait(&sh->ctx->tx_done, &sh->ctx->tx_mtx, K_FOREVER);
+	}
+
+	sh->ctx->tx_writer = k_current_get();
+	k_mutex_unlock(&sh->ctx->tx_mtx);
+}
+
+static void tx_writer_end(const struct shell *sh)
+{
+	k_mutex_lock(&sh->ctx->tx_mtx, K_FOREVER);
+	sh->ctx->tx_writer = NULL;
+	k_condvar_broadcast(&sh->ctx->tx_done);
+	k_mutex_unlock(&sh->ctx->tx_mtx);
+}
+
+/* Write the buffered output to the transport, in chunks as large as the ring
+ * buffer allows. Writers waiting for space are woken after each chunk. Must
+ * be called by the writer, see tx_writer_begin().
+ */
+static void tx_buffer_drain(const struct shell *sh, k_timeout_t timeout)
+{
+	uint8_t *data;
+	uint32_t len;
+
+	while (true) {
+		if (k_mutex_lock(&sh->ctx->tx_mtx, timeout) != 0) {
+			break;
+		}
+
+		len = ring_buf_get_claim(&sh->ctx->tx_ringbuf, &data, UINT32_MAX);
+		k_mutex_unlock(&sh->ctx->tx_mtx);
+
+		if (len == 0) {
+			break;
+		}
+
+		transport_write(sh, data, len);
+
+		k_mutex_lock(&sh->ctx->tx_mtx, K_FOREVER);
+		(void)ring_buf_get_finish(&sh->ctx->tx_ringbuf, len);
+		k_condvar_broadcast(&sh->ctx->tx_done);
+		k_mutex_unlock(&sh->ctx->tx_mtx);
+	}
+}
+
+static void tx_buffer_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		k_sem_take(&tx_buffer_sem, K_FOREVER);
+
+		STRUCT_SECTION_FOREACH(shell, sh) {
+			if (sh->ctx->tid != NULL) {
+				tx_writer_begin(sh);
+				tx_buffer_drain(sh, K_FOREVER);
+				tx_writer_end(sh);
+			}
+		}
+	}
+}
+
+K_THREAD_DEFINE(shell_tx_thread, CONFIG_SHELL_TX_THREAD_STACK_SIZE, tx_buffer_thread,
+		NULL, NULL, NULL, SHELL_THREAD_PRIORITY, 0, 0);
+
+/* The transport is written directly when waiting for space is not possible,
+ * or when the output thread itself prints, e.g. a log message of the
+ * transport in immediate mode.
+ */
+static bool tx_buffer_bypass(const struct shell *sh)
+{
+	return z_flag_sync_mode_get(sh) || k_is_in_isr() || k_is_pre_kernel() ||
+	       (sh->ctx->state == SHELL_STATE_PANIC_MODE_ACTIVE) ||
+	       (k_current_get() == shell_tx_thread);
+}
+
+/* Pass what is still buffered to the transport before writing it directly.
+ * In thread context, the caller waits for the output thread to finish the
+ * chunk it is writing and becomes the writer, returning true: it must call
+ * tx_writer_end() once its own data is written. In panic mode and before the
+ * kernel runs, waiting is not possible and the buffer is only drained if no
+ * chunk is being written. Interrupts and the writer itself, e.g. when the
+ * transport logs in immediate mode, write directly.
+ */
+static bool tx_buffer_bypass_drain(const struct shell *sh)
+{
+	bool busy;
+
+	if (k_is_in_isr() || (k_current_get() == shell_tx_thread) ||
+	    (sh->ctx->tx_writer == k_current_get())) {
+		return false;
+	}
+
+	if (k_is_pre_kernel() || (sh->ctx->state == SHELL_STATE_PANIC_MODE_ACTIVE)) {
+		if (k_mutex_lock(&sh->ctx->tx_mtx, K_NO_WAIT) != 0) {
+			return false;
+		}
+
+		busy = (sh->ctx->tx_writer != NULL);
+		k_mutex_unlock(&sh->ctx->tx_mtx);
+
+		if (!busy) {
+			tx_buffer_drain(sh, K_NO_WAIT);
+		}
+
+		return false;
+	}
+
+	tx_writer_begin(sh);
+	tx_buffer_drain(sh, K_FOREVER);
+
+	return true;
+}
+
+static void tx_buffer_put(const struct shell *sh, const uint8_t *data,
+			  size_t length)
+{
+	uint32_t cnt;
+
+	k_mutex_lock(&sh->ctx->tx_mtx, K_FOREVER);
+
+	while (true) {
+		cnt = ring_buf_put(&sh->ctx->tx_ringbuf, data, length);
+		data += cnt;
+		length -= cnt;
+
+		k_sem_give(&tx_buffer_sem);
+
+		if (length == 0) {
+			break;
+		}
+
+		/* Buffer full, wait for the transport to catch up. */
+		k_condvar_wait(&sh->ctx->tx_done, &sh->ctx->tx_mtx, K_FOREVER);
+	}
+
+	k_mutex_unlock(&sh->ctx->tx_mtx);
+}
+
+void z_shell_tx_buffer_init(const struct shell *sh)
+{
+	ring_buf_init(&sh->ctx->tx_ringbuf, sizeof(sh->ctx->tx_buf),
+		      sh->ctx->tx_buf);
+	k_mutex_init(&sh->ctx->tx_mtx);
+	k_condvar_init(&sh->ctx->tx_done);
+	sh->ctx->tx_writer = NULL;
+}
+
+void z_shell_tx_buffer_flush(const struct shell *sh)
+{
+	if (tx_buffer_bypass(sh)) {
+		if (tx_buffer_bypass_drain(sh)) {
+			tx_writer_end(sh);
+		}
+		return;
+	}
+
+	k_mutex_lock(&sh->ctx->tx_mtx, K_FOREVER);
+
+	while (!ring_buf_is_empty(&sh->ctx->tx_ringbuf)) {
+		k_sem_give(&tx_buffer_sem);
+		k_condvar_wait(&sh->ctx->tx_done, &sh->ctx->tx_mtx, K_FOREVER);
+	}
+
+	k_mutex_unlock(&sh->ctx->tx_mtx);
+}
+#else
+void z_shell_tx_buffer_flush(const struct shell *sh)
+{
+	ARG_UNUSED(sh);
+}
+#endif /* CONFIG_SHELL_TX_BUFFER */
+
+void z_shell_write(const struct shell *sh, const void *data,
+		 size_t length)
+{
+	__ASSERT_NO_MSG(sh && data);
+
+#if defined(CONFIG_SHELL_TX_BUFFER)
+	if (!tx_buffer_bypass(sh)) {
+		tx_buffer_put(sh, data, length);
+		return;
+	}
+
+	if (tx_buffer_bypass_drain(sh)) {
+		transport_write(sh, data, length);
+		tx_writer_end(sh);
+		return;
+	}
+#endif
+
+	transport_write(sh, data, length);
+}
+
+void z_shell_raw_write(const struct shell *sh, const void *data, size_t length)
+{
+	const char *str = data;
+	const char *lf;
+
+	if (sh->shell_flag != SHELL_FLAG_OLF_CRLF) {
+		z_shell_write(sh, data, length);
+		return;
+	}
+
+	while ((length > 0) && ((lf = memchr(str, '\n', length)) != NULL)) {
+		z_shell_write(sh, str, lf - str);
+		z_shell_write(sh, "\r\n", 2);
+		length -= lf - str + 1;
+		str = lf + 1;
+	}
+
+	if (length > 0) {
+		z_shell_write(sh, str, length);
+	}
+}
+
 /* Function shall be only used by the fprintf module. */
 void z_shell_print_stream(const void *user_ctx, const char *data, size_t len)
 {
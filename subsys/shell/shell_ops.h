@@ -15,6 +15,10 @@
 extern "C" {
 #endif
 
+#define SHELL_THREAD_PRIORITY \
+	COND_CODE_1(CONFIG_SHELL_THREAD_PRIORITY_OVERRIDE, \
+			(CONFIG_SHELL_THREAD_PRIORITY), (K_LOWEST_APPLICATION_THREAD_PRIO))
+
 static inline void z_shell_raw_fprintf(const struct shell_fprintf *const ctx,
 				       const char *fmt, ...)
 {
@@ -350,6 +354,19 @@ void z_shell_write(const struct shell *sh, const void *data, size_t length);
  */
 void z_shell_print_stream(const void *user_ctx, const char *data, size_t len);
 
+/** @brief Initialize the output buffer of the instance. */
+void z_shell_tx_buffer_init(const struct shell *sh);
+
+/**
+ * @brief Write data without formatting, mapping line feeds like the fprintf
+ *	  module does.
+ *
+ * @param sh Shell instance.
+ * @param data Data to write.
+ * @param length Length of the data.
+ */
+void z_shell_raw_write(const struct shell *sh, const void *data, size_t length);
+
 /** @internal @brief Function for setting font color */
 void z_shell_vt100_color_set(const struct shell *sh,
 			     enum shell_vt100_color color);
@@ -13,6 +13,45 @@
 #include <zephyr/net/socket_poll.h>
 #include <zephyr/net/net_if.h>
 #include <zephyr/net/net_pkt.h>
+#include <tracing_core.h>
+
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+/* Packet header and context of the generated metadata. Each CPU is its own
+ * stream instance, as timestamps are only monotonic within the events of one
+ * CPU. Sizes are given in bits.
+ */
+struct ctf_packet_header {
+	uint32_t magic;
+	uint32_t stream_instance_id;
+} __packed;
+
+struct ctf_packet_context {
+	uint32_t packet_size;
+	uint32_t content_size;
+} __packed;
+
+struct ctf_packet {
+	struct ctf_packet_header header;
+	struct ctf_packet_context context;
+} __packed;
+
+void tracing_cpu_buffer_handle(uint8_t cpu, uint8_t *data, uint32_t length)
+{
+	struct ctf_packet packet = {
+		.header = {
+			.magic = 0xC1FC1FC1U,
+			.stream_instance_id = cpu,
+		},
+		.context = {
+			.packet_size = (sizeof(packet) + length) * 8U,
+			.content_size = (sizeof(packet) + length) * 8U,
+		},
+	};
+
+	tracing_buffer_handle((uint8_t *)&packet, sizeof(packet));
+	tracing_buffer_handle(data, length);
+}
+#endif
 
 static void _get_thread_name(struct k_thread *thread,
 			     ctf_bounded_string_t *name)
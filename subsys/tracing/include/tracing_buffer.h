@@ -113,6 +113,46 @@ uint32_t tracing_buffer_get(uint8_t *data, uint32_t size);
  */
 uint32_t tracing_cmd_buffer_alloc(uint8_t **data);
 
+/**
+ * @brief Allocate space for one packet in the buffer of a CPU.
+ *
+ * Only code running on @p cpu with local interrupts locked may write to
+ * its buffer.
+ *
+ * @param cpu CPU id.
+ * @param data Pointer to the allocated space.
+ * @param size Packet size (in bytes).
+ *
+ * @return Size of the allocated space, may be less than @p size.
+ */
+uint32_t tracing_cpu_buffer_alloc(unsigned int cpu, uint8_t **data, uint32_t size);
+
+/**
+ * @brief Commit a packet allocated in the buffer of a CPU.
+ *
+ * @param cpu CPU id.
+ * @param size Packet size (in bytes).
+ */
+void tracing_cpu_buffer_commit(unsigned int cpu, uint32_t size);
+
+/**
+ * @brief Claim the oldest packet from the buffer of a CPU.
+ *
+ * @param cpu CPU id.
+ * @param data Pointer to the packet.
+ *
+ * @return Packet size (in bytes), 0 if the buffer is empty.
+ */
+uint32_t tracing_cpu_buffer_claim(unsigned int cpu, uint8_t **data);
+
+/**
+ * @brief Free a packet claimed from the buffer of a CPU.
+ *
+ * @param cpu CPU id.
+ * @param size Packet size (in bytes).
+ */
+void tracing_cpu_buffer_free(unsigned int cpu, uint32_t size);
+
 #ifdef __cplusplus
 }
 #endif
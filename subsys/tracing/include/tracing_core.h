@@ -53,6 +53,25 @@ void tracing_cmd_handle(uint8_t *buf, uint32_t length);
  */
 void tracing_trigger_output(bool before_put_is_empty);
 
+/**
+ * @brief Trigger tracing thread to drain the buffer of a CPU.
+ *
+ * @param cpu CPU id.
+ */
+void tracing_trigger_cpu_output(unsigned int cpu);
+
+/**
+ * @brief Give packets drained from the buffer of a CPU to backend.
+ *
+ * Formats that tag the data of each CPU override this function, by default
+ * the data is given to the backend as is.
+ *
+ * @param cpu CPU id.
+ * @param data Tracing buffer address.
+ * @param length Tracing buffer length.
+ */
+void tracing_cpu_buffer_handle(uint8_t cpu, uint8_t *data, uint32_t length);
+
 /**
  * @brief Check if we are in tracing thread context.
  *
@@ -4,10 +4,11 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <zephyr/kernel.h>
 #include <zephyr/sys/ring_buffer.h>
+#include <zephyr/sys/spsc_pbuf.h>
+#include <tracing_buffer.h>
 
-static struct ring_buf tracing_ring_buf;
-static uint8_t tracing_buffer[CONFIG_TRACING_BUFFER_SIZE + 1];
 static uint8_t tracing_cmd_buffer[CONFIG_TRACING_CMD_BUFFER_SIZE];
 
 uint32_t tracing_cmd_buffer_alloc(uint8_t **data)
@@ -17,6 +18,47 @@ uint32_t tracing_cmd_buffer_alloc(uint8_t **data)
 	return sizeof(tracing_cmd_buffer);
 }
 
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+static struct spsc_pbuf *tracing_cpu_pbuf[CONFIG_MP_MAX_NUM_CPUS];
+static uint32_t tracing_cpu_buffer[CONFIG_MP_MAX_NUM_CPUS]
+				  [CONFIG_TRACING_BUFFER_SIZE / sizeof(uint32_t)];
+
+uint32_t tracing_cpu_buffer_alloc(unsigned int cpu, uint8_t **data, uint32_t size)
+{
+	int ret;
+
+	ret = spsc_pbuf_alloc(tracing_cpu_pbuf[cpu], MIN(size, SPSC_PBUF_MAX_LEN),
+			      (char **)data);
+
+	return ret < 0 ? 0 : ret;
+}
+
+void tracing_cpu_buffer_commit(unsigned int cpu, uint32_t size)
+{
+	spsc_pbuf_commit(tracing_cpu_pbuf[cpu], size);
+}
+
+uint32_t tracing_cpu_buffer_claim(unsigned int cpu, uint8_t **data)
+{
+	return spsc_pbuf_claim(tracing_cpu_pbuf[cpu], (char **)data);
+}
+
+void tracing_cpu_buffer_free(unsigned int cpu, uint32_t size)
+{
+	spsc_pbuf_free(tracing_cpu_pbuf[cpu], size);
+}
+
+void tracing_buffer_init(void)
+{
+	for (unsigned int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		tracing_cpu_pbuf[i] = spsc_pbuf_init(tracing_cpu_buffer[i],
+						     sizeof(tracing_cpu_buffer[i]), 0);
+	}
+}
+#else
+static struct ring_buf tracing_ring_buf;
+static uint8_t tracing_buffer[CONFIG_TRACING_BUFFER_SIZE + 1];
+
 uint32_t tracing_buffer_put_claim(uint8_t **data, uint32_t size)
 {
 	return ring_buf_put_claim(&tracing_ring_buf, data, size);
@@ -67,3 +109,4 @@ uint32_t tracing_buffer_space_get(void)
 {
 	return ring_buf_space_get(&tracing_ring_buf);
 }
+#endif /* CONFIG_TRACING_PER_CPU_BUFFERS */
@@ -54,6 +54,64 @@ static K_SEM_DEFINE(tracing_thread_sem, 0, 1);
 static K_THREAD_STACK_DEFINE(tracing_thread_stack,
 			CONFIG_TRACING_THREAD_STACK_SIZE);
 
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+BUILD_ASSERT(CONFIG_MP_MAX_NUM_CPUS <= ATOMIC_BITS);
+
+/* CPUs whose buffer got data since the tracing thread last drained it */
+static atomic_t tracing_cpu_pending;
+
+/* Consecutive events of a CPU are gathered so that the backend and the
+ * format see packets rather than single events.
+ */
+static void tracing_cpu_buffer_drain(unsigned int cpu)
+{
+	static uint8_t packet[CONFIG_TRACING_PER_CPU_PACKET_SIZE];
+	uint32_t packet_length = 0;
+	uint32_t length;
+	uint8_t *data;
+
+	while ((length = tracing_cpu_buffer_claim(cpu, &data)) > 0) {
+		if (packet_length + length > sizeof(packet)) {
+			if (packet_length > 0) {
+				tracing_cpu_buffer_handle(cpu, packet, packet_length);
+				packet_length = 0;
+			}
+
+			if (length > sizeof(packet)) {
+				tracing_cpu_buffer_handle(cpu, data, length);
+				tracing_cpu_buffer_free(cpu, length);
+				continue;
+			}
+		}
+
+		memcpy(&packet[packet_length], data, length);
+		packet_length += length;
+		tracing_cpu_buffer_free(cpu, length);
+	}
+
+	if (packet_length > 0) {
+		tracing_cpu_buffer_handle(cpu, packet, packet_length);
+	}
+}
+
+static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
+{
+	tracing_thread_tid = k_current_get();
+
+	while (true) {
+		if (atomic_get(&tracing_cpu_pending) == 0) {
+			k_sem_take(&tracing_thread_sem, K_FOREVER);
+			continue;
+		}
+
+		for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+			if (atomic_test_and_clear_bit(&tracing_cpu_pending, cpu)) {
+				tracing_cpu_buffer_drain(cpu);
+			}
+		}
+	}
+}
+#else
 static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
 {
 	uint8_t *transferring_buf;
@@ -77,6 +135,7 @@ static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
 		}
 	}
 }
+#endif /* CONFIG_TRACING_PER_CPU_BUFFERS */
 
 static void tracing_thread_timer_expiry_fn(struct k_timer *timer)
 {
@@ -131,6 +190,20 @@ void tracing_trigger_output(bool before_put_is_empty)
 	}
 }
 
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+void tracing_trigger_cpu_output(unsigned int cpu)
+{
+	tracing_trigger_output(!atomic_test_and_set_bit(&tracing_cpu_pending, cpu));
+}
+
+__weak void tracing_cpu_buffer_handle(uint8_t cpu, uint8_t *data, uint32_t length)
+{
+	ARG_UNUSED(cpu);
+
+	tracing_buffer_handle(data, length);
+}
+#endif
+
 bool is_tracing_thread(void)
 {
 	return (!k_is_in_isr() && (k_current_get() == tracing_thread_tid));
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define DISABLE_SYSCALL_TRACING
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/spsc_pbuf.h>
+#include <tracing_core.h>
+#include <tracing_buffer.h>
+#include <zephyr/tracing/tracing_format.h>
+
+/* Each CPU only writes to its own buffer. Locking local interrupts keeps an
+ * ISR from interleaving with a thread writing to the same buffer and the
+ * thread from migrating to another CPU, no lock is shared between CPUs.
+ */
+
+static void tracing_cpu_put_done(unsigned int cpu, bool put_success)
+{
+	if (put_success) {
+		tracing_trigger_cpu_output(cpu);
+	} else {
+		tracing_packet_drop_handle();
+	}
+}
+
+void tracing_format_string(const char *str, ...)
+{
+	unsigned int key, cpu;
+	bool put_success = false;
+	uint32_t length;
+	uint8_t *buf;
+	va_list args;
+	int ret;
+
+	if (!is_tracing_enabled() || is_tracing_thread()) {
+		return;
+	}
+
+	va_start(args, str);
+
+	key = arch_irq_lock();
+	cpu = arch_curr_cpu()->id;
+
+	/* Format in place into the largest contiguous space available, the
+	 * string is only committed when it fits.
+	 */
+	length = tracing_cpu_buffer_alloc(cpu, &buf, SPSC_PBUF_MAX_LEN);
+	if (length > 0) {
+		ret = vsnprintk((char *)buf, length, str, args);
+		if (ret > 0 && (uint32_t)ret < length) {
+			tracing_cpu_buffer_commit(cpu, ret);
+			put_success = true;
+		}
+	}
+
+	arch_irq_unlock(key);
+
+	va_end(args);
+
+	tracing_cpu_put_done(cpu, put_success);
+}
+
+void tracing_format_raw_data(uint8_t *data, uint32_t length)
+{
+	bool put_success = false;
+	unsigned int key, cpu;
+	uint8_t *buf;
+
+	if (!is_tracing_enabled() || is_tracing_thread()) {
+		return;
+	}
+
+	key = arch_irq_lock();
+	cpu = arch_curr_cpu()->id;
+
+	if (tracing_cpu_buffer_alloc(cpu, &buf, length) >= length) {
+		memcpy(buf, data, length);
+		tracing_cpu_buffer_commit(cpu, length);
+		put_success = true;
+	}
+
+	arch_irq_unlock(key);
+
+	tracing_cpu_put_done(cpu, put_success);
+}
+
+void tracing_format_data(tracing_data_t *tracing_data_array, uint32_t count)
+{
+	bool put_success = false;
+	uint32_t length = 0U;
+	unsigned int key, cpu;
+	uint8_t *buf;
+
+	if (!is_tracing_enabled() || is_tracing_thread()) {
+		return;
+	}
+
+	for (uint32_t i = 0; i < count; i++) {
+		length += tracing_data_array[i].length;
+	}
+
+	key = arch_irq_lock();
+	cpu = arch_curr_cpu()->id;
+
+	if (length > 0 && tracing_cpu_buffer_alloc(cpu, &buf, length) >= length) {
+		for (uint32_t i = 0; i < count; i++) {
+			memcpy(buf, tracing_data_array[i].data, tracing_data_array[i].length);
+			buf += tracing_data_array[i].length;
+		}
+
+		tracing_cpu_buffer_commit(cpu, length);
+		put_success = true;
+	}
+
+	arch_irq_unlock(key);
+
+	tracing_cpu_put_done(cpu, put_success);
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#define WAITER_STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static K_MUTEX_DEFINE(test_mutex);
+static K_SEM_DEFINE(test_sem, 0, 1);
+
+static struct k_thread waiter_thread;
+static K_THREAD_STACK_DEFINE(waiter_stack, WAITER_STACK_SIZE);
+
+static void mutex_waiter_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_mutex_lock(&test_mutex, K_FOREVER);
+	k_mutex_unlock(&test_mutex);
+}
+
+static void sem_waiter_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_sem_take(&test_sem, K_FOREVER);
+}
+
+static k_tid_t waiter_start(k_thread_entry_t entry)
+{
+	return k_thread_create(&waiter_thread, waiter_stack, WAITER_STACK_SIZE,
+			       entry, NULL, NULL, NULL,
+			       K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+}
+
+static void waiter_check(struct k_obj_core_contention *stats, k_tid_t tid, uint32_t count)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(stats->waiters); i++) {
+		if (stats->waiters[i].thread == tid) {
+			zassert_equal(stats->waiters[i].count, count,
+				      "waiter count %u, expected %u",
+				      stats->waiters[i].count, count);
+			return;
+		}
+	}
+
+	zassert_unreachable("waiter %p not recorded", tid);
+}
+
+ZTEST(obj_core_contention, test_mutex_contention)
+{
+	struct k_obj_core_contention stats;
+	k_tid_t tid;
+
+	k_obj_core_contention_reset(K_OBJ_CORE(&test_mutex));
+
+	/* Uncontended, including a recursive lock */
+	k_mutex_lock(&test_mutex, K_FOREVER);
+	k_mutex_lock(&test_mutex, K_FOREVER);
+	k_mutex_unlock(&test_mutex);
+
+	/* The waiter blocks on the mutex while it is held */
+	tid = waiter_start(mutex_waiter_entry);
+	k_msleep(10);
+	k_mutex_unlock(&test_mutex);
+	k_thread_join(tid, K_FOREVER);
+
+	k_obj_core_contention_get(K_OBJ_CORE(&test_mutex), &stats);
+
+	zassert_equal(stats.contended, 1, "contended %u", stats.contended);
+	zassert_equal(stats.uncontended, 2, "uncontended %u", stats.uncontended);
+	zassert_equal(stats.timeouts, 0, "timeouts %u", stats.timeouts);
+	zassert_true(stats.max_wait > 0);
+	zassert_true(stats.total_wait >= stats.max_wait);
+	waiter_check(&stats, &waiter_thread, 1);
+}
+
+ZTEST(obj_core_contention, test_sem_contention)
+{
+	struct k_obj_core_contention stats;
+	k_tid_t tid;
+
+	k_obj_core_contention_reset(K_OBJ_CORE(&test_sem));
+
+	k_sem_give(&test_sem);
+	zassert_equal(k_sem_take(&test_sem, K_NO_WAIT), 0);
+
+	/* A failed attempt without waiting is not recorded */
+	zassert_equal(k_sem_take(&test_sem, K_NO_WAIT), -EBUSY);
+
+	zassert_equal(k_sem_take(&test_sem, K_MSEC(10)), -EAGAIN);
+
+	tid = waiter_start(sem_waiter_entry);
+	k_msleep(10);
+	k_sem_give(&test_sem);
+	k_thread_join(tid, K_FOREVER);
+
+	k_obj_core_contention_get(K_OBJ_CORE(&test_sem), &stats);
+
+	zassert_equal(stats.uncontended, 1, "uncontended %u", stats.uncontended);
+	zassert_equal(stats.contended, 1, "contended %u", stats.contended);
+	zassert_equal(stats.timeouts, 1, "timeouts %u", stats.timeouts);
+	waiter_check(&stats, &waiter_thread, 1);
+	waiter_check(&stats, k_current_get(), 1);
+
+	k_obj_core_contention_reset(K_OBJ_CORE(&test_sem));
+	k_obj_core_contention_get(K_OBJ_CORE(&test_sem), &stats);
+
+	zassert_equal(stats.uncontended + stats.contended + stats.timeouts, 0);
+	zassert_equal(stats.total_wait, 0);
+}
+
+ZTEST_SUITE(obj_core_contention, NULL, NULL, NULL, NULL, NULL);
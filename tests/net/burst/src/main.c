@@ -0,0 +1,552 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <zephyr/net/ethernet.h>
+#include <zephyr/net/dummy.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_l2.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/random/random.h>
+
+#include "net_private.h"
+
+/* Local experimental Ethertype, the test driver ignores other frames */
+#define TEST_PTYPE 0x88b5
+
+#define TEST_PKTS 8
+#define BENCH_PKTS 256
+#define BENCH_BURST 8
+
+#define WAIT_TIME K_SECONDS(1)
+
+struct eth_context {
+	uint8_t mac_addr[6];
+};
+
+static struct eth_context eth_context;
+static struct eth_context dummy_context;
+
+static struct net_if *eth_iface;
+static struct net_if *dummy_iface;
+
+static uint32_t tx_seq[TEST_PKTS];
+static size_t tx_seen;
+static size_t tx_burst_calls;
+static size_t tx_burst_max;
+static size_t tx_burst_pkts;
+static size_t tx_single_pkts;
+static size_t tx_burst_accept;
+static uint32_t tx_fail_seq;
+static K_SEM_DEFINE(tx_sem, 0, K_SEM_MAX_LIMIT);
+
+static uint32_t rx_seq[TEST_PKTS];
+static size_t rx_seen;
+static K_SEM_DEFINE(rx_sem, 0, K_SEM_MAX_LIMIT);
+
+static void generate_mac(uint8_t *mac_addr)
+{
+	/* 00-00-5E-00-53-xx Documentation RFC 7042 */
+	mac_addr[0] = 0x00;
+	mac_addr[1] = 0x00;
+	mac_addr[2] = 0x5E;
+	mac_addr[3] = 0x00;
+	mac_addr[4] = 0x53;
+	mac_addr[5] = sys_rand8_get();
+}
+
+static int eth_pkt_seq_get(struct net_pkt *pkt, uint32_t *seq)
+{
+	if (NET_ETH_HDR(pkt)->type != htons(TEST_PTYPE)) {
+		return -ENOENT;
+	}
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_skip(pkt, sizeof(struct net_eth_hdr)) ||
+	    net_pkt_read_be32(pkt, seq)) {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static void eth_tx_record(uint32_t seq)
+{
+	if (tx_seen < ARRAY_SIZE(tx_seq)) {
+		tx_seq[tx_seen] = seq;
+	}
+
+	tx_seen++;
+	k_sem_give(&tx_sem);
+}
+
+static int eth_tx(const struct device *dev, struct net_pkt *pkt)
+{
+	uint32_t seq;
+
+	ARG_UNUSED(dev);
+
+	if (eth_pkt_seq_get(pkt, &seq) < 0) {
+		return 0;
+	}
+
+	if (seq == tx_fail_seq) {
+		k_sem_give(&tx_sem);
+		return -EIO;
+	}
+
+	tx_single_pkts++;
+	eth_tx_record(seq);
+
+	return 0;
+}
+
+/* Takes at most tx_burst_accept packets, the L2 has to send the rest
+ * one by one with eth_tx().
+ */
+static int eth_tx_burst(const struct device *dev, struct net_pkt **pkts,
+			size_t count)
+{
+	size_t taken = MIN(count, tx_burst_accept);
+	uint32_t seq;
+
+	ARG_UNUSED(dev);
+
+	tx_burst_calls++;
+	tx_burst_max = MAX(tx_burst_max, count);
+
+	if (taken == 0) {
+		return -EAGAIN;
+	}
+
+	for (size_t i = 0; i < taken; i++) {
+		if (eth_pkt_seq_get(pkts[i], &seq) == 0) {
+			zassert_not_equal(seq, tx_fail_seq,
+					  "Failing packet passed to burst");
+			eth_tx_record(seq);
+		}
+	}
+
+	tx_burst_pkts += taken;
+
+	return taken;
+}
+
+static void eth_iface_init(struct net_if *iface)
+{
+	const struct device *dev = net_if_get_device(iface);
+	struct eth_context *context = dev->data;
+
+	net_if_set_link_addr(iface, context->mac_addr,
+			     sizeof(context->mac_addr),
+			     NET_LINK_ETHERNET);
+
+	ethernet_init(iface);
+}
+
+static int eth_init(const struct device *dev)
+{
+	struct eth_context *context = dev->data;
+
+	generate_mac(context->mac_addr);
+
+	return 0;
+}
+
+static const struct ethernet_api eth_api_funcs = {
+	.iface_api.init = eth_iface_init,
+	.send = eth_tx,
+	.send_burst = eth_tx_burst,
+};
+
+ETH_NET_DEVICE_INIT(eth_burst_test, "eth_burst_test", eth_init, NULL,
+		    &eth_context, NULL, CONFIG_ETH_INIT_PRIORITY,
+		    &eth_api_funcs, NET_ETH_MTU);
+
+static enum net_verdict dummy_recv(struct net_if *iface, struct net_pkt *pkt)
+{
+	uint32_t seq;
+
+	ARG_UNUSED(iface);
+
+	zassert_ok(net_pkt_read_be32(pkt, &seq), "Cannot read sequence");
+
+	if (rx_seen < ARRAY_SIZE(rx_seq)) {
+		rx_seq[rx_seen] = seq;
+	}
+
+	rx_seen++;
+	net_pkt_unref(pkt);
+	k_sem_give(&rx_sem);
+
+	return NET_OK;
+}
+
+static int dummy_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static void dummy_iface_init(struct net_if *iface)
+{
+	const struct device *dev = net_if_get_device(iface);
+	struct eth_context *context = dev->data;
+
+	net_if_set_link_addr(iface, context->mac_addr,
+			     sizeof(context->mac_addr),
+			     NET_LINK_DUMMY);
+}
+
+static struct dummy_api dummy_api_funcs = {
+	.iface_api.init = dummy_iface_init,
+	.send = dummy_send,
+	.recv = dummy_recv,
+};
+
+NET_DEVICE_INIT(dummy_burst_test, "dummy_burst_test", eth_init, NULL,
+		&dummy_context, NULL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,
+		&dummy_api_funcs, DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2),
+		NET_ETH_MTU);
+
+static uint32_t tx_pkts_free(void)
+{
+	struct k_mem_slab *tx;
+
+	net_pkt_get_info(NULL, &tx, NULL, NULL);
+
+	return k_mem_slab_num_free_get(tx);
+}
+
+static uint32_t rx_pkts_free(void)
+{
+	struct k_mem_slab *rx;
+
+	net_pkt_get_info(&rx, NULL, NULL, NULL);
+
+	return k_mem_slab_num_free_get(rx);
+}
+
+static struct net_pkt *tx_pkt_alloc(uint32_t seq)
+{
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(eth_iface, sizeof(seq), AF_UNSPEC, 0,
+					K_MSEC(100));
+	zassert_not_null(pkt, "Cannot allocate TX packet");
+
+	zassert_ok(net_pkt_write_be32(pkt, seq), "Cannot write sequence");
+
+	net_pkt_set_ll_proto_type(pkt, TEST_PTYPE);
+	net_pkt_lladdr_src(pkt)->addr = net_if_get_link_addr(eth_iface)->addr;
+	net_pkt_lladdr_src(pkt)->len = net_if_get_link_addr(eth_iface)->len;
+
+	return pkt;
+}
+
+/* Queue the packets with the scheduler locked, so that the TX thread finds
+ * all of them in its queue when it wakes up.
+ */
+static void tx_queue(uint32_t first, size_t count)
+{
+	struct net_pkt *pkts[TEST_PKTS];
+
+	zassert_true(count <= ARRAY_SIZE(pkts));
+
+	for (size_t i = 0; i < count; i++) {
+		pkts[i] = tx_pkt_alloc(first + i);
+	}
+
+	k_sched_lock();
+
+	for (size_t i = 0; i < count; i++) {
+		net_if_queue_tx(eth_iface, pkts[i]);
+	}
+
+	k_sched_unlock();
+}
+
+static void tx_wait(size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		zassert_ok(k_sem_take(&tx_sem, WAIT_TIME), "Packet %zu not sent", i);
+	}
+
+	/* Let the TX thread finish with the burst */
+	k_msleep(10);
+}
+
+static struct net_pkt *rx_pkt_alloc(uint32_t seq)
+{
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_rx_alloc_with_buffer(dummy_iface, sizeof(seq), AF_UNSPEC,
+					   0, K_MSEC(100));
+	zassert_not_null(pkt, "Cannot allocate RX packet");
+
+	zassert_ok(net_pkt_write_be32(pkt, seq), "Cannot write sequence");
+
+	return pkt;
+}
+
+static void rx_wait(size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		zassert_ok(k_sem_take(&rx_sem, WAIT_TIME), "Packet %zu not received", i);
+	}
+}
+
+ZTEST(net_burst, test_tx_burst_order)
+{
+	uint32_t free_pkts = tx_pkts_free();
+
+	tx_queue(0, TEST_PKTS);
+	tx_wait(TEST_PKTS);
+
+	zassert_equal(tx_seen, TEST_PKTS, "Sent %zu packets", tx_seen);
+
+	for (size_t i = 0; i < TEST_PKTS; i++) {
+		zassert_equal(tx_seq[i], i, "Packet %zu sent as %u", i, tx_seq[i]);
+	}
+
+	if (CONFIG_NET_TC_TX_BURST > 1) {
+		zassert_true(tx_burst_calls > 0, "Burst was not used");
+		zassert_true(tx_burst_max > 1, "Only one packet per burst");
+		zassert_equal(tx_burst_pkts, TEST_PKTS, "Burst sent %zu packets",
+			      tx_burst_pkts);
+	} else {
+		zassert_equal(tx_burst_calls, 0, "Burst used without TX burst");
+		zassert_equal(tx_single_pkts, TEST_PKTS);
+	}
+
+	zassert_equal(tx_pkts_free(), free_pkts, "TX packets leaked");
+}
+
+ZTEST(net_burst, test_tx_burst_partial)
+{
+	uint32_t free_pkts = tx_pkts_free();
+
+	if (CONFIG_NET_TC_TX_BURST == 1) {
+		ztest_test_skip();
+	}
+
+	tx_burst_accept = 3;
+
+	tx_queue(0, TEST_PKTS);
+	tx_wait(TEST_PKTS);
+
+	zassert_equal(tx_seen, TEST_PKTS, "Sent %zu packets", tx_seen);
+
+	/* What the driver did not take must follow in the original order */
+	for (size_t i = 0; i < TEST_PKTS; i++) {
+		zassert_equal(tx_seq[i], i, "Packet %zu sent as %u", i, tx_seq[i]);
+	}
+
+	zassert_equal(tx_burst_pkts, 3, "Burst sent %zu packets", tx_burst_pkts);
+	zassert_equal(tx_single_pkts, TEST_PKTS - 3, "Single sent %zu packets",
+		      tx_single_pkts);
+
+	zassert_equal(tx_pkts_free(), free_pkts, "TX packets leaked");
+}
+
+ZTEST(net_burst, test_tx_burst_unsent)
+{
+	uint32_t free_pkts = tx_pkts_free();
+
+	tx_burst_accept = 2;
+	tx_fail_seq = 4;
+
+	tx_queue(0, TEST_PKTS);
+	tx_wait(TEST_PKTS);
+
+	/* The failed packet is released by the stack and is not retried */
+	zassert_equal(tx_seen, TEST_PKTS - 1, "Sent %zu packets", tx_seen);
+
+	for (uint32_t i = 0, seq = 0; i < tx_seen; i++, seq++) {
+		if (seq == tx_fail_seq) {
+			seq++;
+		}
+
+		zassert_equal(tx_seq[i], seq, "Packet %u sent as %u", i, tx_seq[i]);
+	}
+
+	zassert_equal(tx_pkts_free(), free_pkts, "TX packets leaked");
+}
+
+ZTEST(net_burst, test_rx_burst_order)
+{
+	struct net_pkt *pkts[TEST_PKTS];
+	uint32_t free_pkts = rx_pkts_free();
+	int ret;
+
+	for (size_t i = 0; i < TEST_PKTS; i++) {
+		pkts[i] = rx_pkt_alloc(i);
+	}
+
+	ret = net_recv_data_burst(dummy_iface, pkts, TEST_PKTS);
+	zassert_equal(ret, TEST_PKTS, "Stack took %d packets", ret);
+
+	rx_wait(TEST_PKTS);
+
+	zassert_equal(rx_seen, TEST_PKTS, "Received %zu packets", rx_seen);
+
+	for (size_t i = 0; i < TEST_PKTS; i++) {
+		zassert_equal(rx_seq[i], i, "Packet %zu received as %u", i, rx_seq[i]);
+	}
+
+	zassert_equal(rx_pkts_free(), free_pkts, "RX packets leaked");
+}
+
+ZTEST(net_burst, test_rx_burst_partial)
+{
+	struct net_pkt *pkts[TEST_PKTS];
+	uint32_t free_pkts = rx_pkts_free();
+	size_t bad = 3;
+	int ret;
+
+	for (size_t i = 0; i < TEST_PKTS; i++) {
+		if (i == bad) {
+			/* An empty packet stops the burst */
+			pkts[i] = net_pkt_rx_alloc_on_iface(dummy_iface, K_MSEC(100));
+			zassert_not_null(pkts[i], "Cannot allocate RX packet");
+			continue;
+		}
+
+		pkts[i] = rx_pkt_alloc(i);
+	}
+
+	ret = net_recv_data_burst(dummy_iface, pkts, TEST_PKTS);
+	zassert_equal(ret, bad, "Stack took %d packets", ret);
+
+	rx_wait(bad);
+
+	zassert_equal(rx_seen, bad, "Received %zu packets", rx_seen);
+
+	for (size_t i = 0; i < bad; i++) {
+		zassert_equal(rx_seq[i], i, "Packet %zu received as %u", i, rx_seq[i]);
+	}
+
+	/* Nothing is taken if the first packet is rejected */
+	ret = net_recv_data_burst(dummy_iface, &pkts[bad], TEST_PKTS - bad);
+	zassert_equal(ret, -ENODATA, "Unexpected result %d", ret);
+
+	/* The caller still owns what the stack did not take */
+	for (size_t i = bad; i < TEST_PKTS; i++) {
+		net_pkt_unref(pkts[i]);
+	}
+
+	zassert_equal(k_sem_take(&rx_sem, K_MSEC(100)), -EAGAIN,
+		      "Rejected packet received");
+	zassert_equal(rx_pkts_free(), free_pkts, "RX packets leaked");
+}
+
+static uint64_t bench_rx(size_t burst)
+{
+	struct net_pkt *pkts[BENCH_BURST];
+	uint64_t cycles = 0;
+	uint32_t start;
+
+	for (size_t sent = 0; sent < BENCH_PKTS; sent += burst) {
+		for (size_t i = 0; i < burst; i++) {
+			pkts[i] = rx_pkt_alloc(sent + i);
+		}
+
+		start = k_cycle_get_32();
+
+		if (burst == 1) {
+			zassert_ok(net_recv_data(dummy_iface, pkts[0]));
+		} else {
+			zassert_equal(net_recv_data_burst(dummy_iface, pkts, burst),
+				      burst);
+		}
+
+		rx_wait(burst);
+
+		cycles += k_cycle_get_32() - start;
+	}
+
+	return cycles;
+}
+
+static uint64_t bench_tx(void)
+{
+	uint64_t cycles = 0;
+	uint32_t start;
+
+	for (size_t sent = 0; sent < BENCH_PKTS; sent += BENCH_BURST) {
+		start = k_cycle_get_32();
+
+		tx_queue(sent, BENCH_BURST);
+
+		for (size_t i = 0; i < BENCH_BURST; i++) {
+			zassert_ok(k_sem_take(&tx_sem, WAIT_TIME));
+		}
+
+		cycles += k_cycle_get_32() - start;
+	}
+
+	return cycles;
+}
+
+/* Prints the cost per packet of the single and burst RX paths, and of the
+ * TX path with the configured TX burst. The simulated clock of native_sim
+ * does not advance while code runs, so use a QEMU target to get numbers.
+ */
+ZTEST(net_burst, test_burst_benchmark)
+{
+	uint64_t single, burst, tx;
+
+	Z_TEST_SKIP_IFDEF(CONFIG_ARCH_POSIX);
+
+	single = bench_rx(1);
+	burst = bench_rx(BENCH_BURST);
+	tx = bench_tx();
+
+	TC_PRINT("RX single: %u cycles/packet\n", (uint32_t)(single / BENCH_PKTS));
+	TC_PRINT("RX burst %d: %u cycles/packet\n", BENCH_BURST,
+		 (uint32_t)(burst / BENCH_PKTS));
+	TC_PRINT("TX burst %d: %u cycles/packet\n", CONFIG_NET_TC_TX_BURST,
+		 (uint32_t)(tx / BENCH_PKTS));
+}
+
+static void *net_burst_setup(void)
+{
+	eth_iface = net_if_get_first_by_type(&NET_L2_GET_NAME(ETHERNET));
+	zassert_not_null(eth_iface, "No Ethernet interface");
+
+	dummy_iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	zassert_not_null(dummy_iface, "No dummy interface");
+
+	(void)net_if_up(eth_iface);
+	(void)net_if_up(dummy_iface);
+
+	return NULL;
+}
+
+static void net_burst_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	tx_seen = 0;
+	tx_burst_calls = 0;
+	tx_burst_max = 0;
+	tx_burst_pkts = 0;
+	tx_single_pkts = 0;
+	tx_burst_accept = SIZE_MAX;
+	tx_fail_seq = UINT32_MAX;
+	k_sem_reset(&tx_sem);
+
+	rx_seen = 0;
+	k_sem_reset(&rx_sem);
+}
+
+ZTEST_SUITE(net_burst, NULL, net_burst_setup, net_burst_before, NULL, NULL);
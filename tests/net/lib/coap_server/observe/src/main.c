@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/net/coap_service.h>
+#include <zephyr/net/socket.h>
+
+#define SERVER_ADDR   "127.0.0.1"
+#define NUM_CLIENTS   2
+#define RECV_TIMEOUT  1000
+#define TEST_PAYLOAD  "42"
+
+static const uint16_t test_service_port = 5683;
+COAP_SERVICE_DEFINE(test_service, SERVER_ADDR, &test_service_port, COAP_SERVICE_AUTOSTART);
+
+static int obs_get(struct coap_resource *resource, struct coap_packet *request,
+		   struct sockaddr *addr, socklen_t addr_len)
+{
+	ARG_UNUSED(resource);
+	ARG_UNUSED(request);
+	ARG_UNUSED(addr);
+	ARG_UNUSED(addr_len);
+
+	return -ENOSYS;
+}
+
+static const char * const obs_path[] = { "obs", NULL };
+COAP_RESOURCE_DEFINE(obs_resource, test_service, {
+	.path = obs_path,
+	.get = obs_get,
+});
+
+static int client_fd[NUM_CLIENTS] = { -1, -1 };
+static struct sockaddr client_addr[NUM_CLIENTS];
+static struct sockaddr server_addr;
+static uint8_t client_token[NUM_CLIENTS][4] = {
+	{ 0x01, 0x02, 0x03, 0x04 },
+	{ 0xa1, 0xa2 },
+};
+static const uint8_t client_tkl[NUM_CLIENTS] = { 4, 2 };
+
+static size_t pending_count(void)
+{
+	return coap_pendings_count(test_service.data->pending,
+				   CONFIG_COAP_SERVICE_PENDING_MESSAGES);
+}
+
+/* Register the client as an observer, as if its GET request with the Observe
+ * option was received by the resource handler.
+ */
+static void client_observe(int client)
+{
+	uint8_t data[32];
+	struct coap_packet request;
+
+	zassert_ok(coap_packet_init(&request, data, sizeof(data), COAP_VERSION_1, COAP_TYPE_CON,
+				    client_tkl[client], client_token[client], COAP_METHOD_GET,
+				    coap_next_id()));
+	zassert_ok(coap_append_option_int(&request, COAP_OPTION_OBSERVE, 0));
+	zassert_ok(coap_resource_parse_observe(&obs_resource, &request, &client_addr[client]));
+}
+
+static void client_recv(int client, struct coap_packet *cpkt, uint8_t *data, size_t len)
+{
+	int ret;
+
+	ret = zsock_recv(client_fd[client], data, len, 0);
+	zassert_true(ret > 0, "Client %d did not receive a message (%d)", client, errno);
+	zassert_ok(coap_packet_parse(cpkt, data, ret, NULL, 0));
+}
+
+static void client_expect_no_message(int client)
+{
+	uint8_t data[CONFIG_COAP_SERVER_MESSAGE_SIZE];
+	int ret;
+
+	ret = zsock_recv(client_fd[client], data, sizeof(data), ZSOCK_MSG_DONTWAIT);
+	zassert_equal(ret, -1, "Client %d received an unexpected message", client);
+	zassert_equal(errno, EAGAIN, "recv() failed (%d)", errno);
+}
+
+static void client_ack(int client, const struct coap_packet *cpkt)
+{
+	uint8_t data[16];
+	struct coap_packet ack;
+	int ret;
+
+	zassert_ok(coap_ack_init(&ack, cpkt, data, sizeof(data), 0));
+
+	ret = zsock_sendto(client_fd[client], ack.data, ack.offset, 0, &server_addr,
+			   sizeof(struct sockaddr_in));
+	zassert_equal(ret, ack.offset, "sendto() failed (%d)", errno);
+}
+
+/* Verify that a notification carries the observer's own token and the shared body */
+static void expect_notification(int client, const struct coap_packet *cpkt, uint8_t type,
+				int age)
+{
+	uint8_t token[COAP_TOKEN_MAX_LEN];
+	const uint8_t *payload;
+	uint16_t payload_len;
+
+	zassert_equal(coap_header_get_type(cpkt), type, "Unexpected message type");
+	zassert_equal(coap_header_get_code(cpkt), COAP_RESPONSE_CODE_CONTENT,
+		      "Unexpected response code");
+	zassert_equal(coap_header_get_token(cpkt, token), client_tkl[client],
+		      "Unexpected token length");
+	zassert_mem_equal(token, client_token[client], client_tkl[client], "Unexpected token");
+	zassert_equal(coap_get_option_int(cpkt, COAP_OPTION_OBSERVE), age,
+		      "Unexpected observe option");
+
+	payload = coap_packet_get_payload(cpkt, &payload_len);
+	zassert_not_null(payload, "Missing payload");
+	zassert_equal(payload_len, strlen(TEST_PAYLOAD), "Unexpected payload length");
+	zassert_mem_equal(payload, TEST_PAYLOAD, payload_len, "Unexpected payload");
+}
+
+static int build_notification(struct coap_packet *cpkt, uint8_t *data, size_t len, uint8_t type)
+{
+	int age = coap_resource_next_age(&obs_resource);
+
+	/* The token and message ID are replaced for each observer */
+	zassert_ok(coap_packet_init(cpkt, data, len, COAP_VERSION_1, type, 0, NULL,
+				    COAP_RESPONSE_CODE_CONTENT, 0));
+	zassert_ok(coap_append_option_int(cpkt, COAP_OPTION_OBSERVE, age));
+	zassert_ok(coap_append_option_int(cpkt, COAP_OPTION_CONTENT_FORMAT,
+					  COAP_CONTENT_FORMAT_TEXT_PLAIN));
+	zassert_ok(coap_packet_append_payload_marker(cpkt));
+	zassert_ok(coap_packet_append_payload(cpkt, (const uint8_t *)TEST_PAYLOAD,
+					      strlen(TEST_PAYLOAD)));
+
+	return age;
+}
+
+ZTEST(coap_server_observe, test_notify_observers_non)
+{
+	uint8_t data[CONFIG_COAP_SERVER_MESSAGE_SIZE];
+	uint8_t rx[NUM_CLIENTS][CONFIG_COAP_SERVER_MESSAGE_SIZE];
+	struct coap_packet notification;
+	struct coap_packet received[NUM_CLIENTS];
+	int age;
+
+	for (int i = 0; i < NUM_CLIENTS; i++) {
+		client_observe(i);
+	}
+
+	age = build_notification(&notification, data, sizeof(data), COAP_TYPE_NON_CON);
+
+	zassert_equal(coap_resource_notify_observers(&obs_resource, &notification, NULL),
+		      NUM_CLIENTS, "Not all observers notified");
+
+	for (int i = 0; i < NUM_CLIENTS; i++) {
+		client_recv(i, &received[i], rx[i], sizeof(rx[i]));
+		expect_notification(i, &received[i], COAP_TYPE_NON_CON, age);
+	}
+
+	zassert_not_equal(coap_header_get_id(&received[0]), coap_header_get_id(&received[1]),
+			  "Notifications share a message ID");
+
+	/* Non-confirmable notifications are not kept for retransmission */
+	zassert_equal(pending_count(), 0, "Unexpected pending message");
+}
+
+ZTEST(coap_server_observe, test_notify_observers_con)
+{
+	const struct coap_transmission_parameters params = {
+		.ack_timeout = 200,
+		.coap_backoff_percent = 200,
+		.max_retransmission = 1,
+	};
+	uint8_t data[CONFIG_COAP_SERVER_MESSAGE_SIZE];
+	uint8_t rx[NUM_CLIENTS][CONFIG_COAP_SERVER_MESSAGE_SIZE];
+	struct coap_packet notification;
+	struct coap_packet received[NUM_CLIENTS];
+	struct coap_packet retransmission;
+	int64_t start;
+	int age;
+
+	for (int i = 0; i < NUM_CLIENTS; i++) {
+		client_observe(i);
+	}
+
+	age = build_notification(&notification, data, sizeof(data), COAP_TYPE_CON);
+
+	start = k_uptime_get();
+	zassert_equal(coap_resource_notify_observers(&obs_resource, &notification, &params),
+		      NUM_CLIENTS, "Not all observers notified");
+	zassert_equal(pending_count(), NUM_CLIENTS, "Notifications not pending");
+
+	for (int i = 0; i < NUM_CLIENTS; i++) {
+		client_recv(i, &received[i], rx[i], sizeof(rx[i]));
+		expect_notification(i, &received[i], COAP_TYPE_CON, age);
+	}
+
+	/* An acknowledged notification is released right away */
+	client_ack(0, &received[0]);
+	k_msleep(50);
+	zassert_equal(pending_count(), 1, "Acknowledged notification not released");
+
+	/* The other one is retransmitted once the ACK timeout expires */
+	client_recv(1, &retransmission, data, sizeof(data));
+	zassert_true(k_uptime_get() - start >= params.ack_timeout, "Retransmitted too early");
+	zassert_equal(coap_header_get_id(&retransmission), coap_header_get_id(&received[1]),
+		      "Retransmission with a different message ID");
+	expect_notification(1, &retransmission, COAP_TYPE_CON, age);
+
+	/* After the last retransmission times out, the observer is dropped */
+	k_msleep(2 * params.ack_timeout + 100);
+	zassert_equal(pending_count(), 0, "Timed out notification not released");
+	zassert_equal(sys_slist_len(&obs_resource.observers), 1,
+		      "Unresponsive observer not removed");
+
+	client_expect_no_message(0);
+	client_expect_no_message(1);
+}
+
+ZTEST(coap_server_observe, test_retransmission_order)
+{
+	/* The message sent first expires last */
+	const struct coap_transmission_parameters params_slow = {
+		.ack_timeout = 400,
+		.coap_backoff_percent = 100,
+		.max_retransmission = 1,
+	};
+	const struct coap_transmission_parameters params_fast = {
+		.ack_timeout = 100,
+		.coap_backoff_percent = 100,
+		.max_retransmission = 1,
+	};
+	uint8_t slow_data[16];
+	uint8_t fast_data[16];
+	uint8_t data[CONFIG_COAP_SERVER_MESSAGE_SIZE];
+	struct coap_packet slow, fast, received;
+	int64_t start;
+
+	zassert_ok(coap_packet_init(&slow, slow_data, sizeof(slow_data), COAP_VERSION_1, COAP_TYPE_CON,
+				    0, NULL, COAP_RESPONSE_CODE_CONTENT, coap_next_id()));
+	start = k_uptime_get();
+	zassert_ok(coap_service_send(&test_service, &slow, &client_addr[0],
+				     sizeof(struct sockaddr_in), &params_slow));
+
+	zassert_ok(coap_packet_init(&fast, fast_data, sizeof(fast_data), COAP_VERSION_1, COAP_TYPE_CON,
+				    0, NULL, COAP_RESPONSE_CODE_CONTENT, coap_next_id()));
+	zassert_ok(coap_service_send(&test_service, &fast, &client_addr[0],
+				     sizeof(struct sockaddr_in), &params_fast));
+
+	zassert_equal(pending_count(), 2, "Messages not pending");
+
+	client_recv(0, &received, data, sizeof(data));
+	zassert_equal(coap_header_get_id(&received), coap_header_get_id(&slow));
+	client_recv(0, &received, data, sizeof(data));
+	zassert_equal(coap_header_get_id(&received), coap_header_get_id(&fast));
+
+	/* Retransmissions come in the order of expiry, not of sending */
+	client_recv(0, &received, data, sizeof(data));
+	zassert_equal(coap_header_get_id(&received), coap_header_get_id(&fast),
+		      "Message with the shorter timeout not retransmitted first");
+	zassert_true(k_uptime_get() - start >= params_fast.ack_timeout,
+		     "Retransmitted too early");
+
+	client_recv(0, &received, data, sizeof(data));
+	zassert_equal(coap_header_get_id(&received), coap_header_get_id(&slow),
+		      "Message with the longer timeout not retransmitted");
+	zassert_true(k_uptime_get() - start >= params_slow.ack_timeout,
+		     "Retransmitted too early");
+
+	/* Both are given up on after their last timeout */
+	k_msleep(params_slow.ack_timeout + 100);
+	zassert_equal(pending_count(), 0, "Timed out messages not released");
+	client_expect_no_message(0);
+}
+
+static void *coap_server_observe_setup(void)
+{
+	struct sockaddr_in *addr4;
+	struct timeval optval = {
+		.tv_sec = RECV_TIMEOUT / MSEC_PER_SEC,
+		.tv_usec = (RECV_TIMEOUT % MSEC_PER_SEC) * USEC_PER_MSEC,
+	};
+	socklen_t len;
+
+	addr4 = (struct sockaddr_in *)&server_addr;
+	addr4->sin_family = AF_INET;
+	addr4->sin_port = htons(test_service_port);
+	zassert_equal(zsock_inet_pton(AF_INET, SERVER_ADDR, &addr4->sin_addr), 1);
+
+	for (int i = 0; i < NUM_CLIENTS; i++) {
+		addr4 = (struct sockaddr_in *)&client_addr[i];
+		addr4->sin_family = AF_INET;
+		addr4->sin_port = 0;
+		zassert_equal(zsock_inet_pton(AF_INET, SERVER_ADDR, &addr4->sin_addr), 1);
+
+		client_fd[i] = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+		zassert_true(client_fd[i] >= 0, "socket() failed (%d)", errno);
+		zassert_ok(zsock_setsockopt(client_fd[i], SOL_SOCKET, SO_RCVTIMEO, &optval,
+					    sizeof(optval)));
+		zassert_ok(zsock_bind(client_fd[i], &client_addr[i], sizeof(*addr4)));
+
+		/* Observers are identified by the bound ephemeral port */
+		len = sizeof(client_addr[i]);
+		zassert_ok(zsock_getsockname(client_fd[i], &client_addr[i], &len));
+	}
+
+	/* Wait for the server thread to start the service */
+	while (coap_service_is_running(&test_service) != 1) {
+		k_msleep(10);
+	}
+
+	return NULL;
+}
+
+static void coap_server_observe_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	for (int i = 0; i < NUM_CLIENTS; i++) {
+		(void)coap_resource_remove_observer_by_addr(&obs_resource, &client_addr[i]);
+	}
+}
+
+ZTEST_SUITE(coap_server_observe, NULL, coap_server_observe_setup, NULL,
+	    coap_server_observe_after, NULL);
@@ -133,3 +133,95 @@ ZTEST(net_dns_cache_test, test_expired_entries_removed)
 	zassert_equal(1, dns_cache_find(&test_dns_cache, query, info_read, 3));
 	zassert_equal(AF_INET, info_read[0].ai_family);
 }
+
+ZTEST(net_dns_cache_test, test_many_names)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read = {0};
+	char query[sizeof("example-00.com")];
+
+	for (size_t i = 0; i < TEST_DNS_CACHE_SIZE; i++) {
+		snprintk(query, sizeof(query), "example-%02zu.com", i);
+		info_write.ai_addrlen = i;
+		zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write,
+					 TEST_DNS_CACHE_DEFAULT_TTL + i),
+			   "Cache entry adding should work.");
+	}
+
+	for (size_t i = 0; i < TEST_DNS_CACHE_SIZE; i++) {
+		snprintk(query, sizeof(query), "example-%02zu.com", i);
+		zassert_equal(1, dns_cache_find(&test_dns_cache, query, &info_read, 1));
+		zassert_equal(i, info_read.ai_addrlen);
+	}
+
+	/* The name closest to expiry is replaced when the cache is full */
+	zassert_ok(dns_cache_add(&test_dns_cache, "example.com", &info_write,
+				 TEST_DNS_CACHE_DEFAULT_TTL));
+	zassert_equal(0, dns_cache_find(&test_dns_cache, "example-00.com", &info_read, 1));
+	zassert_equal(1, dns_cache_find(&test_dns_cache, "example-01.com", &info_read, 1));
+
+	zassert_ok(dns_cache_remove(&test_dns_cache, "example-01.com"));
+	zassert_equal(0, dns_cache_find(&test_dns_cache, "example-01.com", &info_read, 1));
+	zassert_equal(1, dns_cache_find(&test_dns_cache, "example-02.com", &info_read, 1));
+}
+
+ZTEST(net_dns_cache_test, test_negative_entry)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read = {0};
+	const char *query = "example.com";
+
+	zassert_ok(dns_cache_add_negative(&test_dns_cache, query, AF_UNSPEC,
+					  TEST_DNS_CACHE_DEFAULT_TTL));
+	zassert_equal(-ENOENT, dns_cache_find(&test_dns_cache, query, &info_read, 1));
+	zassert_equal(-ENOENT, dns_cache_lookup(&test_dns_cache, query, AF_INET6, &info_read, 1,
+						NULL));
+
+	/* An answer replaces the negative entry */
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write, TEST_DNS_CACHE_DEFAULT_TTL));
+	zassert_equal(1, dns_cache_find(&test_dns_cache, query, &info_read, 1));
+	zassert_equal(0, dns_cache_lookup(&test_dns_cache, query, AF_INET6, &info_read, 1, NULL));
+
+	zassert_ok(dns_cache_add_negative(&test_dns_cache, query, AF_INET6,
+					  TEST_DNS_CACHE_DEFAULT_TTL));
+	zassert_equal(-ENOENT, dns_cache_lookup(&test_dns_cache, query, AF_INET6, &info_read, 1,
+						NULL));
+	zassert_equal(1, dns_cache_lookup(&test_dns_cache, query, AF_INET, &info_read, 1, NULL));
+
+	k_sleep(K_MSEC(TEST_DNS_CACHE_DEFAULT_TTL * 1000 + 1));
+	zassert_equal(0, dns_cache_find(&test_dns_cache, query, &info_read, 1));
+}
+
+ZTEST(net_dns_cache_test, test_prefetch)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read[2] = {0};
+	const char *query = "example.com";
+	bool prefetch = false;
+
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write, TEST_DNS_CACHE_DEFAULT_TTL));
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write, TEST_DNS_CACHE_DEFAULT_TTL));
+
+	for (int i = 0; i < CONFIG_DNS_RESOLVER_CACHE_PREFETCH_HITS; i++) {
+		zassert_equal(2, dns_cache_lookup(&test_dns_cache, query, AF_INET, info_read, 2,
+						  &prefetch));
+		zassert_false(prefetch);
+	}
+
+	/* A hot name is refreshed once when it is about to expire */
+	k_sleep(K_MSEC(TEST_DNS_CACHE_DEFAULT_TTL * 1000 *
+		       (100 - CONFIG_DNS_RESOLVER_CACHE_PREFETCH_THRESHOLD) / 100 + 1));
+	zassert_equal(2, dns_cache_lookup(&test_dns_cache, query, AF_INET, info_read, 2,
+					  &prefetch));
+	zassert_true(prefetch);
+
+	prefetch = false;
+	zassert_equal(2, dns_cache_lookup(&test_dns_cache, query, AF_INET, info_read, 2,
+					  &prefetch));
+	zassert_false(prefetch);
+
+	/* The refreshed answer replaces the old entries */
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write,
+				 TEST_DNS_CACHE_DEFAULT_TTL * 2));
+	zassert_equal(1, dns_cache_find(&test_dns_cache, query, info_read, 2));
+}
@@ -233,6 +233,24 @@ BUILD_ASSERT(sizeof(long_payload) - 1 > CONFIG_HTTP_SERVER_CLIENT_BUFFER_SIZE,
 	0x69, 0xd2, 0x9a, 0xc4, 0xc0, 0x57, 0x68, 0x0b, 0x83
 #define TEST_HTTP2_DATA_POST_ROOT_STREAM_1 TEST_HTTP2_DATA_POST_DYNAMIC_STREAM_1
 
+/* Frames used by the flow control tests, "/large" is requested with a literal,
+ * non-Huffman encoded path.
+ */
+#define TEST_BE32(val) \
+	(((val) >> 24) & 0xff), (((val) >> 16) & 0xff), (((val) >> 8) & 0xff), ((val) & 0xff)
+#define TEST_HTTP2_SETTINGS_INITIAL_WINDOW_SIZE(size) \
+	0x00, 0x00, 0x06, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, \
+	0x00, 0x04, TEST_BE32(size)
+#define TEST_HTTP2_WINDOW_UPDATE(stream_id, increment) \
+	0x00, 0x00, 0x04, 0x08, 0x00, 0x00, 0x00, 0x00, stream_id, \
+	TEST_BE32(increment)
+#define TEST_HTTP2_HEADERS_GET_LARGE_WITH_WEIGHT(stream_id, weight) \
+	0x00, 0x00, 0x0f, 0x01, 0x25, 0x00, 0x00, 0x00, stream_id, \
+	0x00, 0x00, 0x00, 0x00, (weight) - 1, \
+	0x82, 0x86, 0x04, 0x06, 0x2f, 0x6c, 0x61, 0x72, 0x67, 0x65
+#define TEST_HTTP2_HEADERS_GET_LARGE(stream_id) \
+	TEST_HTTP2_HEADERS_GET_LARGE_WITH_WEIGHT(stream_id, 16)
+
 static uint16_t test_http_service_port = SERVER_PORT;
 HTTP_SERVICE_DEFINE(test_http_service, SERVER_IPV4_ADDR,
 		    &test_http_service_port, 1, 10, NULL, NULL);
@@ -250,6 +268,21 @@ struct http_resource_detail_static static_resource_detail = {
 HTTP_RESOURCE_DEFINE(static_resource, test_http_service, "/",
 		     &static_resource_detail);
 
+/* Larger than the scheduler share of a stream, filled with a counting pattern */
+#define TEST_LARGE_PAYLOAD_LEN 1024
+static uint8_t large_payload[TEST_LARGE_PAYLOAD_LEN];
+struct http_resource_detail_static large_resource_detail = {
+	.common = {
+			.type = HTTP_RESOURCE_TYPE_STATIC,
+			.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+		},
+	.static_data = large_payload,
+	.static_data_len = sizeof(large_payload),
+};
+
+HTTP_RESOURCE_DEFINE(large_resource, test_http_service, "/large",
+		     &large_resource_detail);
+
 static uint8_t dynamic_payload[32];
 static size_t dynamic_payload_len = sizeof(dynamic_payload);
 static bool dynamic_error;
@@ -720,6 +753,21 @@ static void expect_http2_window_update_frame(size_t *offset, int stream_id)
 	test_consume_data(offset, frame.length);
 }
 
+/* Verify that the server does not send anything more for now. */
+static void expect_no_data(size_t *offset)
+{
+	int ret;
+
+	zassert_equal(*offset, 0, "Unexpected data received");
+
+	/* Give the server some time to send anything it would */
+	k_msleep(100);
+
+	ret = zsock_recv(client_fd, buf, sizeof(buf), ZSOCK_MSG_DONTWAIT);
+	zassert_equal(ret, -1, "Unexpected data received");
+	zassert_equal(errno, EAGAIN, "recv() failed (%d)", errno);
+}
+
 ZTEST(server_function_tests, test_http2_get_concurrent_streams)
 {
 	static const uint8_t request_get_2_streams[] = {
@@ -1416,6 +1464,196 @@ ZTEST(server_function_tests, test_http2_rst_stream)
 	zassert_equal(ret, 0, "Connection should've been closed");
 }
 
+ZTEST(server_function_tests, test_http2_weighted_streams)
+{
+	static const uint8_t request[] = {
+		TEST_HTTP2_MAGIC,
+		TEST_HTTP2_SETTINGS,
+		TEST_HTTP2_SETTINGS_ACK,
+		TEST_HTTP2_HEADERS_GET_LARGE_WITH_WEIGHT(TEST_STREAM_ID_1, 8),
+		TEST_HTTP2_HEADERS_GET_LARGE_WITH_WEIGHT(TEST_STREAM_ID_2, 2),
+		TEST_HTTP2_GOAWAY,
+	};
+	/* Bytes each stream may send in one scheduling round */
+	const size_t quantum_1 = CONFIG_HTTP_SERVER_HTTP2_SCHED_QUANTUM * 8 / 16;
+	const size_t quantum_2 = CONFIG_HTTP_SERVER_HTTP2_SCHED_QUANTUM * 2 / 16;
+	size_t sent_1 = 0, sent_2 = 0;
+	bool end_1 = false, end_2 = false;
+	struct http2_frame frame;
+	size_t offset = 0;
+	size_t *sent;
+	int ret;
+
+	ret = zsock_send(client_fd, request, sizeof(request), 0);
+	zassert_not_equal(ret, -1, "send() failed (%d)", errno);
+
+	memset(buf, 0, sizeof(buf));
+
+	expect_http2_settings_frame(&offset, false);
+	expect_http2_settings_frame(&offset, true);
+
+	while (!end_1 || !end_2) {
+		test_get_frame_header(&offset, &frame);
+
+		if (frame.type == HTTP2_HEADERS_FRAME) {
+			test_read_data(&offset, frame.length);
+			test_consume_data(&offset, frame.length);
+			continue;
+		}
+
+		zassert_equal(frame.type, HTTP2_DATA_FRAME, "Expected data frame");
+
+		if (frame.stream_identifier == TEST_STREAM_ID_1) {
+			zassert_false(end_1, "Data after the end of the stream");
+			zassert_true(frame.length <= quantum_1,
+				     "Frame exceeds the stream share (%u)", frame.length);
+			sent = &sent_1;
+		} else {
+			zassert_equal(frame.stream_identifier, TEST_STREAM_ID_2,
+				      "Invalid data frame stream ID");
+			zassert_false(end_2, "Data after the end of the stream");
+			zassert_true(frame.length <= quantum_2,
+				     "Frame exceeds the stream share (%u)", frame.length);
+			sent = &sent_2;
+		}
+
+		test_read_data(&offset, frame.length);
+		zassert_mem_equal(buf, large_payload + *sent, frame.length,
+				  "Unexpected data payload");
+		test_consume_data(&offset, frame.length);
+		*sent += frame.length;
+
+		if ((frame.flags & HTTP2_FLAG_END_STREAM) == 0) {
+			continue;
+		}
+
+		if (frame.stream_identifier == TEST_STREAM_ID_1) {
+			/* The heavier stream finishes first, the other one
+			 * got at most a quarter of the data by then.
+			 */
+			zassert_false(end_2, "Stream with lower weight finished first");
+			zassert_true(sent_2 * 4 <= sent_1,
+				     "Stream with lower weight got too much (%zu)", sent_2);
+			end_1 = true;
+		} else {
+			end_2 = true;
+		}
+	}
+
+	zassert_equal(sent_1, sizeof(large_payload), "Invalid amount of data sent");
+	zassert_equal(sent_2, sizeof(large_payload), "Invalid amount of data sent");
+}
+
+ZTEST(server_function_tests, test_http2_window_exhausted)
+{
+	static const uint8_t request[] = {
+		TEST_HTTP2_MAGIC,
+		TEST_HTTP2_SETTINGS,
+		TEST_HTTP2_SETTINGS_INITIAL_WINDOW_SIZE(100),
+		TEST_HTTP2_SETTINGS_ACK,
+		TEST_HTTP2_HEADERS_GET_LARGE(TEST_STREAM_ID_1),
+	};
+	static const uint8_t window_update[] = {
+		TEST_HTTP2_WINDOW_UPDATE(TEST_STREAM_ID_1, TEST_LARGE_PAYLOAD_LEN - 100),
+		TEST_HTTP2_GOAWAY,
+	};
+	size_t offset = 0;
+	int ret;
+
+	ret = zsock_send(client_fd, request, sizeof(request), 0);
+	zassert_not_equal(ret, -1, "send() failed (%d)", errno);
+
+	memset(buf, 0, sizeof(buf));
+
+	expect_http2_settings_frame(&offset, false);
+	expect_http2_settings_frame(&offset, true);
+	expect_http2_settings_frame(&offset, true);
+	expect_http2_headers_frame(&offset, TEST_STREAM_ID_1, HTTP2_FLAG_END_HEADERS, NULL, 0);
+	expect_http2_data_frame(&offset, TEST_STREAM_ID_1, large_payload, 100, 0);
+
+	/* The stream window is used up, the response stalls */
+	expect_no_data(&offset);
+
+	ret = zsock_send(client_fd, window_update, sizeof(window_update), 0);
+	zassert_not_equal(ret, -1, "send() failed (%d)", errno);
+
+	expect_http2_data_frame(&offset, TEST_STREAM_ID_1, large_payload + 100,
+				TEST_LARGE_PAYLOAD_LEN - 100, HTTP2_FLAG_END_STREAM);
+}
+
+ZTEST(server_function_tests, test_http2_window_shrink)
+{
+	static const uint8_t request[] = {
+		TEST_HTTP2_MAGIC,
+		TEST_HTTP2_SETTINGS,
+		TEST_HTTP2_SETTINGS_INITIAL_WINDOW_SIZE(100),
+		TEST_HTTP2_SETTINGS_ACK,
+		TEST_HTTP2_HEADERS_GET_LARGE(TEST_STREAM_ID_1),
+	};
+	/* Shrinking the initial window by 50 makes the window of the open
+	 * stream negative, so only half of the update can be used.
+	 */
+	static const uint8_t shrink[] = {
+		TEST_HTTP2_SETTINGS_INITIAL_WINDOW_SIZE(50),
+		TEST_HTTP2_WINDOW_UPDATE(TEST_STREAM_ID_1, 100),
+	};
+	static const uint8_t window_update[] = {
+		TEST_HTTP2_WINDOW_UPDATE(TEST_STREAM_ID_1, TEST_LARGE_PAYLOAD_LEN - 150),
+		TEST_HTTP2_GOAWAY,
+	};
+	size_t offset = 0;
+	int ret;
+
+	ret = zsock_send(client_fd, request, sizeof(request), 0);
+	zassert_not_equal(ret, -1, "send() failed (%d)", errno);
+
+	memset(buf, 0, sizeof(buf));
+
+	expect_http2_settings_frame(&offset, false);
+	expect_http2_settings_frame(&offset, true);
+	expect_http2_settings_frame(&offset, true);
+	expect_http2_headers_frame(&offset, TEST_STREAM_ID_1, HTTP2_FLAG_END_HEADERS, NULL, 0);
+	expect_http2_data_frame(&offset, TEST_STREAM_ID_1, large_payload, 100, 0);
+	expect_no_data(&offset);
+
+	ret = zsock_send(client_fd, shrink, sizeof(shrink), 0);
+	zassert_not_equal(ret, -1, "send() failed (%d)", errno);
+
+	expect_http2_settings_frame(&offset, true);
+	expect_http2_data_frame(&offset, TEST_STREAM_ID_1, large_payload + 100, 50, 0);
+	expect_no_data(&offset);
+
+	ret = zsock_send(client_fd, window_update, sizeof(window_update), 0);
+	zassert_not_equal(ret, -1, "send() failed (%d)", errno);
+
+	expect_http2_data_frame(&offset, TEST_STREAM_ID_1, large_payload + 150,
+				TEST_LARGE_PAYLOAD_LEN - 150, HTTP2_FLAG_END_STREAM);
+}
+
+ZTEST(server_function_tests, test_http2_window_update_zero_increment)
+{
+	static const uint8_t request[] = {
+		TEST_HTTP2_MAGIC,
+		TEST_HTTP2_SETTINGS,
+		TEST_HTTP2_SETTINGS_ACK,
+		TEST_HTTP2_WINDOW_UPDATE(0, 0),
+	};
+	size_t offset = 0;
+	int ret;
+
+	ret = zsock_send(client_fd, request, sizeof(request), 0);
+	zassert_not_equal(ret, -1, "send() failed (%d)", errno);
+
+	memset(buf, 0, sizeof(buf));
+
+	/* A zero increment is a protocol error, the server disconnects */
+	expect_http2_settings_frame(&offset, false);
+	expect_http2_settings_frame(&offset, true);
+
+	ret = zsock_recv(client_fd, buf, sizeof(buf), 0);
+	zassert_equal(ret, 0, "Connection should've been closed");
+}
+
 static const char http1_header_capture_common_response[] = "HTTP/1.1 200\r\n"
 							   "Transfer-Encoding: chunked\r\n"
 							   "Content-Type: text/plain\r\n"
@@ -2493,6 +2731,7 @@ ZTEST(server_function_tests_no_init, test_parse_http_frames)
 
 #include <zephyr/fs/fs.h>
 #include <zephyr/fs/littlefs.h>
+#include <zephyr/sys/crc.h>
 
 FS_LITTLEFS_DECLARE_DEFAULT_CONFIG(storage);
 
@@ -2664,15 +2903,44 @@ ZTEST(server_function_tests, test_http1_static_fs)
 		"User-Agent: curl/7.68.0\r\n"
 		"Accept: */*\r\n"
 		"\r\n";
-	static const char expected_response[] =
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS_CACHE)
+	/* Cached responses carry the CRC-32 of the content as ETag */
+	static const char etag_format[] = "ETag: \"%08x\"\r\n";
+	static const char http1_cond_request_format[] =
+		"GET /static_file.html HTTP/1.1\r\n"
+		"Host: 127.0.0.1:8080\r\n"
+		"If-None-Match: \"%08x\"\r\n"
+		"\r\n";
+	static const char expected_not_modified_format[] =
+		"HTTP/1.1 304 Not Modified\r\n"
+		"ETag: \"%08x\"\r\n"
+		"\r\n";
+	uint32_t etag = crc32_ieee((const uint8_t *)TEST_STATIC_FS_PAYLOAD,
+				   strlen(TEST_STATIC_FS_PAYLOAD));
+	/* Each "%08x" grows by 4 characters when formatted */
+	char http1_cond_request[sizeof(http1_cond_request_format) + 4];
+	char expected_not_modified[sizeof(expected_not_modified_format) + 4];
+	char etag_header[sizeof(etag_format) + 4];
+#else
+	static const char etag_header[] = "";
+#endif
+	static const char expected_headers[] =
 		"HTTP/1.1 200 OK\r\n"
 		"Content-Length: 30\r\n"
-		"Content-Type: text/html\r\n"
-		"\r\n"
-		TEST_STATIC_FS_PAYLOAD;
+		"Content-Type: text/html\r\n";
+	char expected_response[sizeof(expected_headers) + sizeof(etag_header) +
+			       sizeof(TEST_STATIC_FS_PAYLOAD) + 2];
+	size_t expected_len;
 	size_t offset = 0;
 	int ret;
 
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS_CACHE)
+	snprintk(etag_header, sizeof(etag_header), etag_format, etag);
+#endif
+	snprintk(expected_response, sizeof(expected_response), "%s%s\r\n%s",
+		 expected_headers, etag_header, TEST_STATIC_FS_PAYLOAD);
+	expected_len = strlen(expected_response);
+
 	ret = setup_fs();
 	zassert_equal(ret, TC_PASS, "Failed to mount fs");
 
@@ -2681,9 +2949,27 @@ ZTEST(server_function_tests, test_http1_static_fs)
 
 	memset(buf, 0, sizeof(buf));
 
-	test_read_data(&offset, sizeof(expected_response) - 1);
-	zassert_mem_equal(buf, expected_response, sizeof(expected_response) - 1,
+	test_read_data(&offset, expected_len);
+	zassert_mem_equal(buf, expected_response, expected_len,
 			  "Received data doesn't match expected response");
+
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS_CACHE)
+	test_consume_data(&offset, expected_len);
+
+	/* The second request is served from the cache, and revalidated by the ETag */
+	snprintk(http1_cond_request, sizeof(http1_cond_request),
+		 http1_cond_request_format, etag);
+	ret = zsock_send(client_fd, http1_cond_request, strlen(http1_cond_request), 0);
+	zassert_not_equal(ret, -1, "send() failed (%d)", errno);
+
+	snprintk(expected_not_modified, sizeof(expected_not_modified),
+		 expected_not_modified_format, etag);
+	expected_len = strlen(expected_not_modified);
+
+	test_read_data(&offset, expected_len);
+	zassert_mem_equal(buf, expected_not_modified, expected_len,
+			  "Received data doesn't match expected response");
+#endif
 }
 #endif /* DT_HAS_COMPAT_STATUS_OKAY(zephyr_ram_disk) */
 
@@ -2705,6 +2991,10 @@ static void http_server_tests_before(void *fixture)
 	dynamic_payload_len = 0;
 	dynamic_error = false;
 
+	for (size_t i = 0; i < sizeof(large_payload); i++) {
+		large_payload[i] = (uint8_t)i;
+	}
+
 	ret = http_server_start();
 	if (ret < 0) {
 		printk("Failed to start the server\n");
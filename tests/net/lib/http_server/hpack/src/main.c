@@ -494,4 +494,84 @@ ZTEST(http2_hpack, test_http2_hpack_literal_not_indexed_decode)
 				 ARRAY_SIZE(test_enc_literal_not_indexed_headers));
 }
 
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+BUILD_ASSERT(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE == 128,
+	     "Expected encodings depend on the dynamic table size");
+
+/* Encoded in sequence with a single dynamic table, starting with a size
+ * update to the 128 bytes table.
+ */
+static const struct example_headers test_enc_dynamic_headers[] = {
+	{ ":status", "200", { 0x3f, 0x61, 0x88 }, 3 },
+	{ "content-type", "text/html",
+	  { 0x5f, 0x87, 0x49, 0x7c, 0xa5, 0x89, 0xd3, 0x4d, 0x1f }, 9 },
+	{ "content-type", "text/html", { 0xbe }, 1 },
+	{ "x-custom", "abc",
+	  { 0x40, 0x86, 0xf2, 0xb1, 0x2d, 0x42, 0x4f, 0x4f, 0x82, 0x1c, 0x64 }, 11 },
+	{ "x-custom", "abc", { 0xbe }, 1 },
+	/* Name from the dynamic table, evicts content-type */
+	{ "x-custom", "abd", { 0x7e, 0x03, 0x61, 0x62, 0x64 }, 5 },
+	{ "content-type", "text/html",
+	  { 0x5f, 0x87, 0x49, 0x7c, 0xa5, 0x89, 0xd3, 0x4d, 0x1f }, 9 },
+};
+
+ZTEST(http2_hpack, test_http2_hpack_dynamic_table_encode)
+{
+	struct http_hpack_encoder_table table;
+
+	http_hpack_encoder_table_init(&table);
+
+	for (int i = 0; i < ARRAY_SIZE(test_enc_dynamic_headers); i++) {
+		const struct example_headers *example = &test_enc_dynamic_headers[i];
+		struct http_hpack_header_buf hdr = {
+			.name = example->name,
+			.value = example->value,
+			.name_len = strlen(example->name),
+			.value_len = strlen(example->value)
+		};
+		int ret;
+
+		ret = http_hpack_encode_header_table(test_buf, sizeof(test_buf), &hdr,
+						     &table);
+		zassert_equal(ret, example->encoded_len, "Wrong encoding length (%d)", i);
+		zassert_mem_equal(test_buf, example->encoded, ret,
+				  "Header wrongly encoded (%d)", i);
+	}
+
+	zassert_equal(table.count, 2, "Wrong number of entries");
+	zassert_equal(table.size, 96, "Wrong table size");
+}
+
+ZTEST(http2_hpack, test_http2_hpack_dynamic_table_resize)
+{
+	static const uint8_t expected[] = { 0x20, 0x10, 0x86, 0xf2, 0xb1, 0x2d,
+					    0x42, 0x4f, 0x4f, 0x82, 0x1c, 0x64 };
+	struct http_hpack_encoder_table table;
+	struct http_hpack_header_buf hdr = {
+		.name = "x-custom",
+		.value = "abc",
+		.name_len = strlen("x-custom"),
+		.value_len = strlen("abc"),
+	};
+	int ret;
+
+	http_hpack_encoder_table_init(&table);
+
+	ret = http_hpack_encode_header_table(test_buf, sizeof(test_buf), &hdr, &table);
+	zassert_true(ret > 0, "Failed to encode header");
+	zassert_equal(table.count, 1, "Header not added to the table");
+
+	/* Peer disabled the dynamic table, the entry is evicted, and the
+	 * header is sent as a literal after a size update.
+	 */
+	http_hpack_encoder_table_set_max_size(&table, 0);
+	zassert_equal(table.count, 0, "Entry not evicted");
+
+	ret = http_hpack_encode_header_table(test_buf, sizeof(test_buf), &hdr, &table);
+	zassert_equal(ret, sizeof(expected), "Wrong encoding length");
+	zassert_mem_equal(test_buf, expected, ret, "Header wrongly encoded");
+	zassert_equal(table.count, 0, "Header added to the table");
+}
+#endif /* CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE */
+
 ZTEST_SUITE(http2_hpack, NULL, NULL, NULL, NULL, NULL);
@@ -43,8 +43,15 @@ static struct mqtt_test_ctx {
 	uint16_t msg_id;
 	int payload_left;
 	const uint8_t *payload;
+	/* Acknowledgements are handled by the session layer */
+	bool session;
 } test_ctx;
 
+/* When set, the broker does not acknowledge publishes on its own */
+static bool broker_manual_ack;
+static uint16_t broker_last_message_id;
+static uint8_t broker_last_flags;
+
 static const uint8_t payload_short[] = "Short payload";
 static const uint8_t payload_long[] = LOREM_IPSUM;
 
@@ -232,7 +239,10 @@ static void broker_validate_packet(uint8_t *buf, size_t length, uint8_t type,
 		zassert_mem_equal(buf + var_len, test_ctx.payload,
 				  strlen(test_ctx.payload), "Invalid payload");
 
-		if (ack) {
+		broker_last_flags = flags;
+		broker_last_message_id = ack ? sys_get_be16(buf + topic_len + 2) : 0U;
+
+		if (ack && !broker_manual_ack) {
 			/* Copy packet ID. */
 			memcpy(reply_ack + 2, buf + topic_len + 2, 2);
 			test_send_reply(reply_ack, sizeof(reply_ack));
@@ -264,6 +274,9 @@ static void broker_validate_packet(uint8_t *buf, size_t length, uint8_t type,
 	case MQTT_PKT_TYPE_PUBREL: {
 		uint8_t reply[sizeof(pubcomp_reply_template)];
 
+		broker_last_flags = flags;
+		broker_last_message_id = sys_get_be16(buf);
+
 		memcpy(reply, pubcomp_reply_template, sizeof(reply));
 		memcpy(reply + 2, buf, 2);
 		test_send_reply(reply, sizeof(reply));
@@ -512,6 +525,10 @@ static void mqtt_evt_handler(struct mqtt_client *const client,
 		zassert_equal(evt->param.pubrec.message_id, test_ctx.msg_id,
 			      "Invalid packet ID received.");
 
+		if (test_ctx.session) {
+			break;
+		}
+
 		ret = mqtt_publish_qos2_release(client, &rel_param);
 		zassert_ok(ret, "Failed to send MQTT PUBREL: %d", ret);
 
@@ -801,11 +818,311 @@ ZTEST(mqtt_client, test_mqtt_pubsub_long)
 	zassert_true(test_ctx.puback_handled, "MQTT client should receive puback");
 }
 
+#if defined(CONFIG_MQTT_SESSION)
+static struct mqtt_session session;
+
+ZTEST(mqtt_client, test_mqtt_session_publish_queued)
+{
+	struct mqtt_publish_param param = { 0 };
+	int ret;
+
+	test_ctx.payload = payload_short;
+	test_ctx.msg_id = 1U;
+
+	ret = mqtt_session_init(&client_ctx, &session);
+	zassert_ok(ret, "MQTT session init failed (%d)", ret);
+
+	param.message.topic.qos = MQTT_QOS_1_AT_LEAST_ONCE;
+	param.message.topic.topic.utf8 = (uint8_t *)get_mqtt_topic();
+	param.message.topic.topic.size = strlen(param.message.topic.topic.utf8);
+	param.message.payload.data = (uint8_t *)test_ctx.payload;
+	param.message.payload.len = strlen(test_ctx.payload);
+	param.message_id = test_ctx.msg_id;
+
+	/* Queued while disconnected, sent once the connection is accepted */
+	ret = mqtt_session_publish(&client_ctx, &param);
+	zassert_ok(ret, "MQTT session failed to queue publish (%d)", ret);
+	zassert_equal(mqtt_session_pending(&client_ctx), 1, "Publish should be queued");
+
+	test_connect();
+	broker_process(MQTT_PKT_TYPE_PUBLISH);
+
+	client_wait(false);
+	ret = mqtt_input(&client_ctx);
+	zassert_ok(ret, "MQTT client input processing failed (%d)", ret);
+	zassert_true(test_ctx.puback_handled, "MQTT client should receive puback");
+	zassert_equal(mqtt_session_pending(&client_ctx), 0, "Publish should be completed");
+
+	test_disconnect();
+}
+
+static void session_publish(enum mqtt_qos qos)
+{
+	struct mqtt_publish_param param = { 0 };
+	int ret;
+
+	param.message.topic.qos = qos;
+	param.message.topic.topic.utf8 = (uint8_t *)get_mqtt_topic();
+	param.message.topic.topic.size = strlen(param.message.topic.topic.utf8);
+	param.message.payload.data = (uint8_t *)test_ctx.payload;
+	param.message.payload.len = strlen(test_ctx.payload);
+
+	/* The session assigns the message IDs */
+	ret = mqtt_session_publish(&client_ctx, &param);
+	zassert_ok(ret, "MQTT session failed to queue publish (%d)", ret);
+}
+
+static void session_setup(void)
+{
+	int ret;
+
+	test_ctx.payload = payload_short;
+	test_ctx.session = true;
+	broker_manual_ack = true;
+
+	ret = mqtt_session_init(&client_ctx, &session);
+	zassert_ok(ret, "MQTT session init failed (%d)", ret);
+}
+
+/* Receive a publish at the broker and return its message ID */
+static uint16_t broker_receive_publish(void)
+{
+	broker_process(MQTT_PKT_TYPE_PUBLISH);
+	zassert_not_equal(broker_last_message_id, 0U, "Publish without a message ID");
+
+	return broker_last_message_id;
+}
+
+static void broker_expect_nothing(void)
+{
+	struct zsock_pollfd fds[] = {
+		{ c_sock, ZSOCK_POLLIN, 0 },
+	};
+
+	zassert_equal(broker_offset, 0, "Unexpected data at the broker");
+	zassert_equal(zsock_poll(fds, ARRAY_SIZE(fds), TIMEOUT), 0,
+		      "Unexpected packet at the broker");
+}
+
+/* Acknowledge a message at the broker and let the client process it */
+static void broker_ack(const uint8_t *template, uint16_t message_id)
+{
+	uint8_t reply[sizeof(puback_reply_template)];
+	int ret;
+
+	memcpy(reply, template, sizeof(reply));
+	sys_put_be16(message_id, reply + 2);
+	test_ctx.msg_id = message_id;
+	test_send_reply(reply, sizeof(reply));
+
+	client_wait(false);
+	ret = mqtt_input(&client_ctx);
+	zassert_ok(ret, "MQTT client input processing failed (%d)", ret);
+}
+
+ZTEST(mqtt_client, test_mqtt_session_window)
+{
+	uint16_t ids[CONFIG_MQTT_SESSION_WINDOW + 1];
+	uint16_t id;
+
+	session_setup();
+	test_connect();
+
+	for (int i = 0; i < CONFIG_MQTT_SESSION_WINDOW + 2; i++) {
+		session_publish(MQTT_QOS_1_AT_LEAST_ONCE);
+	}
+
+	/* Only a window of messages is sent before they are acknowledged */
+	for (int i = 0; i < CONFIG_MQTT_SESSION_WINDOW; i++) {
+		ids[i] = broker_receive_publish();
+
+		for (int j = 0; j < i; j++) {
+			zassert_not_equal(ids[i], ids[j], "Message ID reused in flight");
+		}
+	}
+
+	broker_expect_nothing();
+	zassert_equal(mqtt_session_pending(&client_ctx), CONFIG_MQTT_SESSION_WINDOW + 2,
+		      "Messages should be pending");
+
+	/* Each acknowledgement lets one more message in */
+	broker_ack(puback_reply_template, ids[0]);
+	zassert_true(test_ctx.puback_handled, "MQTT client should receive puback");
+
+	id = broker_receive_publish();
+	for (int i = 1; i < CONFIG_MQTT_SESSION_WINDOW; i++) {
+		zassert_not_equal(id, ids[i], "Message ID reused in flight");
+	}
+
+	ids[CONFIG_MQTT_SESSION_WINDOW] = id;
+	broker_expect_nothing();
+	zassert_equal(mqtt_session_pending(&client_ctx), CONFIG_MQTT_SESSION_WINDOW + 1,
+		      "Acknowledged message should be completed");
+
+	for (int i = 1; i <= CONFIG_MQTT_SESSION_WINDOW; i++) {
+		broker_ack(puback_reply_template, ids[i]);
+	}
+
+	broker_receive_publish();
+	broker_ack(puback_reply_template, broker_last_message_id);
+	zassert_equal(mqtt_session_pending(&client_ctx), 0, "All messages should be completed");
+
+	test_disconnect();
+}
+
+ZTEST(mqtt_client, test_mqtt_session_retransmit)
+{
+	uint16_t id;
+	int ret;
+
+	session_setup();
+	test_connect();
+
+	session_publish(MQTT_QOS_1_AT_LEAST_ONCE);
+	id = broker_receive_publish();
+	zassert_false(broker_last_flags & MQTT_HEADER_DUP_MASK,
+		      "First transmission should not be a duplicate");
+
+	/* Nothing is resent before the timeout */
+	ret = mqtt_live(&client_ctx);
+	zassert_true(ret == 0 || ret == -EAGAIN, "MQTT live failed (%d)", ret);
+	broker_expect_nothing();
+
+	k_msleep(CONFIG_MQTT_SESSION_RETRANSMIT_TIMEOUT);
+
+	ret = mqtt_live(&client_ctx);
+	zassert_true(ret == 0 || ret == -EAGAIN, "MQTT live failed (%d)", ret);
+	zassert_equal(broker_receive_publish(), id, "Retransmission with another message ID");
+	zassert_true(broker_last_flags & MQTT_HEADER_DUP_MASK,
+		     "Retransmission should have the DUP flag");
+
+	broker_ack(puback_reply_template, id);
+	zassert_equal(mqtt_session_pending(&client_ctx), 0, "Publish should be completed");
+
+	test_disconnect();
+}
+
+ZTEST(mqtt_client, test_mqtt_session_qos2)
+{
+	uint16_t id;
+
+	session_setup();
+	test_connect();
+
+	session_publish(MQTT_QOS_2_EXACTLY_ONCE);
+	id = broker_receive_publish();
+
+	/* The session answers PUBREC with PUBREL on its own, PUBCOMP completes */
+	broker_ack(pubrec_reply_template, id);
+	broker_process(MQTT_PKT_TYPE_PUBREL);
+	zassert_equal(broker_last_message_id, id, "Invalid PUBREL message ID");
+	zassert_equal(mqtt_session_pending(&client_ctx), 1, "Publish should be in flight");
+
+	client_wait(false);
+	zassert_ok(mqtt_input(&client_ctx), "MQTT client input processing failed");
+	zassert_true(test_ctx.pubcomp_handled, "MQTT client should receive pubcomp");
+	zassert_equal(mqtt_session_pending(&client_ctx), 0, "Publish should be completed");
+
+	test_disconnect();
+}
+
+#if defined(CONFIG_MQTT_SESSION_ZMS)
+#include <zephyr/drivers/flash.h>
+#include <zephyr/fs/zms.h>
+#include <zephyr/storage/flash_map.h>
+
+#define TEST_ZMS_AREA storage_partition
+
+/* Messages left in flash by the previous run, and the ones queued after the
+ * reboot. Without the restored message ID the new ones would reuse them.
+ */
+#define TEST_STORED_MSGS 2
+#define TEST_NEW_MSGS (CONFIG_MQTT_SESSION_QUEUE_SIZE + TEST_STORED_MSGS)
+
+static struct zms_fs session_fs;
+
+static void session_fs_mount(void)
+{
+	const struct flash_area *fa;
+	struct flash_pages_info info;
+	int ret;
+
+	ret = flash_area_open(FIXED_PARTITION_ID(TEST_ZMS_AREA), &fa);
+	zassert_ok(ret, "flash_area_open() failed (%d)", ret);
+
+	session_fs.offset = FIXED_PARTITION_OFFSET(TEST_ZMS_AREA);
+	session_fs.flash_device = flash_area_get_device(fa);
+	ret = flash_get_page_info_by_offs(session_fs.flash_device, session_fs.offset, &info);
+	zassert_ok(ret, "Unable to get page info (%d)", ret);
+
+	session_fs.sector_size = info.size;
+	session_fs.sector_count = FIXED_PARTITION_SIZE(TEST_ZMS_AREA) / info.size;
+
+	ret = zms_mount(&session_fs);
+	zassert_ok(ret, "zms_mount() failed (%d)", ret);
+}
+
+ZTEST(mqtt_client, test_mqtt_session_zms_restore)
+{
+	uint16_t ids[TEST_STORED_MSGS + TEST_NEW_MSGS];
+	int ret;
+
+	session_fs_mount();
+	zassert_ok(zms_clear(&session_fs), "zms_clear() failed");
+	session_fs_mount();
+
+	session_setup();
+	ret = mqtt_session_storage_set(&client_ctx, &session_fs);
+	zassert_ok(ret, "MQTT session storage set failed (%d)", ret);
+
+	/* The RAM queue is filled first, the rest overflows to flash */
+	for (int i = 0; i < CONFIG_MQTT_SESSION_QUEUE_SIZE + TEST_STORED_MSGS; i++) {
+		session_publish(MQTT_QOS_1_AT_LEAST_ONCE);
+	}
+
+	zassert_equal(mqtt_session_pending(&client_ctx),
+		      CONFIG_MQTT_SESSION_QUEUE_SIZE + TEST_STORED_MSGS,
+		      "Messages should be queued");
+
+	/* Reboot, only the messages in flash survive. The message IDs of the
+	 * new ones must not collide with them.
+	 */
+	session_setup();
+	session_fs_mount();
+	ret = mqtt_session_storage_set(&client_ctx, &session_fs);
+	zassert_ok(ret, "MQTT session storage set failed (%d)", ret);
+	zassert_equal(mqtt_session_pending(&client_ctx), TEST_STORED_MSGS,
+		      "Messages should be restored");
+
+	for (int i = 0; i < TEST_NEW_MSGS; i++) {
+		session_publish(MQTT_QOS_1_AT_LEAST_ONCE);
+	}
+
+	test_connect();
+
+	for (int i = 0; i < ARRAY_SIZE(ids); i++) {
+		ids[i] = broker_receive_publish();
+
+		for (int j = 0; j < i; j++) {
+			zassert_not_equal(ids[i], ids[j], "Message ID %u used twice", ids[i]);
+		}
+
+		broker_ack(puback_reply_template, ids[i]);
+	}
+
+	zassert_equal(mqtt_session_pending(&client_ctx), 0, "All messages should be completed");
+
+	test_disconnect();
+}
+#endif /* CONFIG_MQTT_SESSION_ZMS */
+#endif /* CONFIG_MQTT_SESSION */
+
 static void mqtt_tests_before(void *fixture)
 {
 	ARG_UNUSED(fixture);
 
 	memset(&test_ctx, 0, sizeof(test_ctx));
+	broker_manual_ack = false;
 	broker_init();
 	client_init(&client_ctx);
 }
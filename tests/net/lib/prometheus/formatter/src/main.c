@@ -45,7 +45,7 @@ ZTEST(test_formatter, test_prometheus_formatter_simple)
 
 	zassert_equal(counter, &test_counter, "Counter not found in collector");
 
-	zassert_equal(test_counter.value, 0, "Counter value is not 0");
+	zassert_equal(prometheus_counter_get(&test_counter), 0, "Counter value is not 0");
 
 	ret = prometheus_counter_inc(&test_counter);
 	zassert_ok(ret, "Error incrementing counter");
@@ -53,7 +53,7 @@ ZTEST(test_formatter, test_prometheus_formatter_simple)
 	ret = prometheus_counter_inc(&test_counter2);
 	zassert_ok(ret, "Error incrementing counter 2");
 
-	zassert_equal(counter->value, 1, "Counter value is not 1");
+	zassert_equal(prometheus_counter_get(counter), 1, "Counter value is not 1");
 
 	ret = prometheus_format_exposition(&test_custom_collector, formatted, sizeof(formatted));
 	zassert_ok(ret, "Error formatting exposition data");
@@ -63,4 +63,53 @@ ZTEST(test_formatter, test_prometheus_formatter_simple)
 		      exposed, formatted);
 }
 
+/**
+ * @brief Test streamed Prometheus exposition
+ * @details The test shall format the collector in chunks that are smaller
+ * than the whole exposition and check that the chunks add up to the
+ * same output as the non-streamed formatter.
+ */
+ZTEST(test_formatter, test_prometheus_formatter_stream)
+{
+	struct prometheus_format_stream stream;
+	char expected[MAX_BUFFER_SIZE] = { 0 };
+	char streamed[MAX_BUFFER_SIZE] = { 0 };
+	char chunk[48];
+	size_t total = 0;
+	int chunks = 0;
+	size_t len;
+	int ret;
+
+	prometheus_collector_register_metric(&test_custom_collector, &test_counter.base);
+	prometheus_collector_register_metric(&test_custom_collector, &test_counter2.base);
+
+	ret = prometheus_format_exposition(&test_custom_collector, expected, sizeof(expected));
+	zassert_ok(ret, "Error formatting exposition data");
+
+	ret = prometheus_format_stream_init(&stream, &test_custom_collector);
+	zassert_ok(ret, "Error initializing stream");
+
+	do {
+		ret = prometheus_format_stream(&stream, chunk, sizeof(chunk), &len);
+		zassert_true(ret == 0 || ret == -EAGAIN, "Error formatting chunk (%d)", ret);
+		zassert_true(total + len < sizeof(streamed), "Too much data");
+
+		memcpy(streamed + total, chunk, len);
+		total += len;
+		chunks++;
+	} while (ret == -EAGAIN);
+
+	zassert_true(chunks > 1, "Exposition was not split into chunks");
+	zassert_equal(strcmp(streamed, expected), 0,
+		      "Streamed exposition is not as expected (expected\n\"%s\", got\n\"%s\")",
+		      expected, streamed);
+
+	/* A chunk buffer that cannot hold a single line is an error */
+	ret = prometheus_format_stream_init(&stream, &test_custom_collector);
+	zassert_ok(ret, "Error initializing stream");
+
+	ret = prometheus_format_stream(&stream, chunk, 8, &len);
+	zassert_equal(ret, -ENOMEM, "Expected -ENOMEM, got %d", ret);
+}
+
 ZTEST_SUITE(test_formatter, NULL, NULL, NULL, NULL, NULL);
@@ -24,17 +24,48 @@ ZTEST(test_histogram, test_histogram_observe)
 {
 	int ret;
 
-	zassert_equal(test_histogram_m.sum, 0, "Histogram value is not 0");
+	zassert_equal(prometheus_histogram_get_sum(&test_histogram_m), 0, "Histogram value is not 0");
 
 	ret = prometheus_histogram_observe(&test_histogram_m, 1);
 	zassert_ok(ret, "Error observing histogram");
 
-	zassert_equal(test_histogram_m.sum, 1.0, "Histogram value is not 1");
+	zassert_equal(prometheus_histogram_get_sum(&test_histogram_m), 1.0, "Histogram value is not 1");
 
 	ret = prometheus_histogram_observe(&test_histogram_m, 2);
 	zassert_ok(ret, "Error observing histogram");
 
-	zassert_equal(test_histogram_m.sum, 3.0, "Histogram value is not 2");
+	zassert_equal(prometheus_histogram_get_sum(&test_histogram_m), 3.0, "Histogram value is not 2");
+}
+
+static struct prometheus_histogram_bucket test_buckets[] = {
+	{ .upper_bound = 1.0 },
+	{ .upper_bound = 10.0 },
+};
+
+PROMETHEUS_HISTOGRAM_DEFINE(test_histogram_buckets, "Test histogram buckets",
+			    ({ .key = "test", .value = "buckets" }), NULL);
+
+/**
+ * @brief Test prometheus_histogram_get_bucket
+ *
+ * @details The test shall observe values falling into different buckets and
+ * check that the bucket counts are cumulative.
+ */
+ZTEST(test_histogram, test_histogram_buckets)
+{
+	test_histogram_buckets.buckets = test_buckets;
+	test_histogram_buckets.num_buckets = ARRAY_SIZE(test_buckets);
+
+	zassert_ok(prometheus_histogram_observe(&test_histogram_buckets, 0.5));
+	zassert_ok(prometheus_histogram_observe(&test_histogram_buckets, 5.0));
+	zassert_ok(prometheus_histogram_observe(&test_histogram_buckets, 50.0));
+
+	zassert_equal(prometheus_histogram_get_bucket(&test_histogram_buckets, 0), 1,
+		      "Wrong count in bucket 0");
+	zassert_equal(prometheus_histogram_get_bucket(&test_histogram_buckets, 1), 2,
+		      "Wrong count in bucket 1");
+	zassert_equal(prometheus_histogram_get_count(&test_histogram_buckets), 3,
+		      "Wrong total count");
 }
 
 ZTEST_SUITE(test_histogram, NULL, NULL, NULL, NULL, NULL);
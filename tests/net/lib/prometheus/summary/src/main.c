@@ -24,17 +24,17 @@ ZTEST(test_summary, test_summary_observe)
 {
 	int ret;
 
-	zassert_equal(test_summary_m.sum, 0, "Histogram value is not 0");
+	zassert_equal(prometheus_summary_get_sum(&test_summary_m), 0, "Histogram value is not 0");
 
 	ret = prometheus_summary_observe(&test_summary_m, 1);
 	zassert_ok(ret, "Error observing histogram");
 
-	zassert_equal(test_summary_m.sum, 1, "Histogram value is not 1");
+	zassert_equal(prometheus_summary_get_sum(&test_summary_m), 1, "Histogram value is not 1");
 
 	ret = prometheus_summary_observe(&test_summary_m, 2);
 	zassert_ok(ret, "Error observing histogram");
 
-	zassert_equal(test_summary_m.sum, 3, "Histogram value is not 3");
+	zassert_equal(prometheus_summary_get_sum(&test_summary_m), 3, "Histogram value is not 3");
 }
 
 ZTEST_SUITE(test_summary, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/zperf.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/shell/shell_dummy.h>
+
+#include "zperf_internal.h"
+
+#define TEST_STREAMS CONFIG_NET_ZPERF_MAX_STREAMS
+#define TEST_DURATION_MS 500
+#define TEST_PACKET_SIZE 100
+#define TEST_RATE_KBPS 100
+
+/* The shell test uses the default port of the dual test, the other tests
+ * use ports of their own.
+ */
+#define TEST_TCP_PORT 5002
+#define TEST_UDP_PORT 5003
+#define TEST_RAW_PORT 5004
+#define TEST_BIDIR_PORT 5005
+
+static K_SEM_DEFINE(sessions_done, 0, TEST_STREAMS);
+static uint64_t sessions_len;
+
+/* Streams received by the test in place of a zperf server */
+struct test_stream_rx {
+	struct zperf_client_hdr_v1 hdr;
+	size_t len;
+};
+
+static struct test_stream_rx streams_rx[TEST_STREAMS];
+static int rx_listen_sock;
+
+static K_THREAD_STACK_DEFINE(rx_stack, 2048);
+static struct k_thread rx_thread;
+
+static void session_cb(enum zperf_status status, struct zperf_results *result,
+		       void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	if (status == ZPERF_SESSION_FINISHED) {
+		sessions_len += result->total_len;
+		k_sem_give(&sessions_done);
+	}
+}
+
+static void sessions_reset(void)
+{
+	k_sem_reset(&sessions_done);
+	sessions_len = 0;
+}
+
+static void upload_params_init(struct zperf_upload_params *param, uint16_t port)
+{
+	struct sockaddr_in *addr = net_sin(&param->peer_addr);
+
+	memset(param, 0, sizeof(*param));
+
+	addr->sin_family = AF_INET;
+	addr->sin_port = htons(port);
+	zassert_ok(net_addr_pton(AF_INET, "127.0.0.1", &addr->sin_addr));
+
+	param->duration_ms = TEST_DURATION_MS;
+	param->packet_size = TEST_PACKET_SIZE;
+	param->rate_kbps = TEST_RATE_KBPS;
+	param->options.priority = -1;
+	param->options.num_streams = TEST_STREAMS;
+}
+
+static void upload_results_check(const struct zperf_results *results)
+{
+	uint32_t sends = 0;
+
+	zassert_equal(results->num_streams, TEST_STREAMS);
+	zassert_equal(results->packet_size, TEST_PACKET_SIZE);
+	zassert_true(results->nb_packets_sent >= TEST_STREAMS, "%u packets sent",
+		     results->nb_packets_sent);
+	zassert_true(results->client_time_in_us >= TEST_DURATION_MS * USEC_PER_MSEC);
+	zassert_true(results->cpu_cycles > 0);
+
+	/* Every send call of every stream is in the latency histogram */
+	for (int i = 0; i < ZPERF_LATENCY_HIST_BUCKETS; i++) {
+		sends += results->send_latency_hist[i];
+	}
+
+	zassert_equal(sends, results->nb_packets_sent + results->nb_packets_errors,
+		      "%u sends in the histogram, %u packets sent, %u errors", sends,
+		      results->nb_packets_sent, results->nb_packets_errors);
+}
+
+ZTEST(zperf, test_tcp_streams)
+{
+	struct zperf_download_params download = { .port = TEST_TCP_PORT };
+	struct zperf_upload_params param;
+	struct zperf_results results;
+
+	sessions_reset();
+	zassert_ok(zperf_tcp_download(&download, session_cb, NULL));
+
+	upload_params_init(&param, TEST_TCP_PORT);
+	zassert_ok(zperf_tcp_upload(&param, &results));
+	upload_results_check(&results);
+
+	/* One session per stream, together they carry all the data sent */
+	for (int i = 0; i < TEST_STREAMS; i++) {
+		zassert_ok(k_sem_take(&sessions_done, K_SECONDS(5)),
+			   "%d of %d sessions finished", i, TEST_STREAMS);
+	}
+
+	zassert_equal(sessions_len, (uint64_t)results.nb_packets_sent * TEST_PACKET_SIZE);
+
+	zassert_ok(zperf_tcp_download_stop());
+}
+
+ZTEST(zperf, test_udp_streams)
+{
+	struct zperf_download_params download = { .port = TEST_UDP_PORT };
+	struct zperf_upload_params param;
+	struct zperf_results results;
+
+	sessions_reset();
+	zassert_ok(zperf_udp_download(&download, session_cb, NULL));
+
+	upload_params_init(&param, TEST_UDP_PORT);
+	zassert_ok(zperf_udp_upload(&param, &results));
+	upload_results_check(&results);
+
+	for (int i = 0; i < TEST_STREAMS; i++) {
+		zassert_ok(k_sem_take(&sessions_done, K_SECONDS(5)),
+			   "%d of %d sessions finished", i, TEST_STREAMS);
+	}
+
+	/* The server statistics are summed over the streams */
+	zassert_true(results.nb_packets_rcvd > 0);
+	zassert_true(results.nb_packets_rcvd <= results.nb_packets_sent, "%u of %u received",
+		     results.nb_packets_rcvd, results.nb_packets_sent);
+	zassert_equal(results.total_len, sessions_len);
+
+	zassert_ok(zperf_udp_download_stop());
+}
+
+/* The streams are read one after the other. A stream stops sending once its
+ * duration is over, so it never waits for the following ones to be read.
+ */
+static void rx_thread_entry(void *p1, void *p2, void *p3)
+{
+	static uint8_t buf[512];
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < TEST_STREAMS; i++) {
+		struct test_stream_rx *rx = &streams_rx[i];
+		ssize_t len;
+		int sock;
+
+		sock = zsock_accept(rx_listen_sock, NULL, NULL);
+		if (sock < 0) {
+			return;
+		}
+
+		while ((len = zsock_recv(sock, buf, sizeof(buf), 0)) > 0) {
+			if (rx->len < sizeof(rx->hdr)) {
+				memcpy((uint8_t *)&rx->hdr + rx->len, buf,
+				       MIN((size_t)len, sizeof(rx->hdr) - rx->len));
+			}
+
+			rx->len += len;
+		}
+
+		zsock_close(sock);
+	}
+}
+
+ZTEST(zperf, test_tcp_dual)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(TEST_RAW_PORT),
+	};
+	struct zperf_upload_params param;
+	struct zperf_results results;
+	size_t total_len = 0;
+
+	memset(streams_rx, 0, sizeof(streams_rx));
+
+	rx_listen_sock = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	zassert_true(rx_listen_sock >= 0);
+	zassert_ok(zsock_bind(rx_listen_sock, (struct sockaddr *)&addr, sizeof(addr)));
+	zassert_ok(zsock_listen(rx_listen_sock, TEST_STREAMS));
+
+	k_thread_create(&rx_thread, rx_stack, K_THREAD_STACK_SIZEOF(rx_stack),
+			rx_thread_entry, NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	upload_params_init(&param, TEST_RAW_PORT);
+	param.options.bidir_port = TEST_BIDIR_PORT;
+	zassert_ok(zperf_tcp_upload(&param, &results));
+	upload_results_check(&results);
+
+	zassert_ok(k_thread_join(&rx_thread, K_SECONDS(5)), "Streams not received");
+	zsock_close(rx_listen_sock);
+
+	for (int i = 0; i < TEST_STREAMS; i++) {
+		struct test_stream_rx *rx = &streams_rx[i];
+
+		zassert_true(rx->len >= TEST_PACKET_SIZE, "Stream %d: %zu bytes", i, rx->len);
+		zassert_equal(rx->len % TEST_PACKET_SIZE, 0, "Stream %d: %zu bytes", i, rx->len);
+
+		/* The iperf2 header asks the peer to connect back */
+		zassert_equal(ntohl(rx->hdr.flags), ZPERF_FLAGS_VERSION1 | ZPERF_FLAGS_RUN_NOW);
+		zassert_equal(ntohl(rx->hdr.num_of_threads), TEST_STREAMS);
+		zassert_equal(ntohl(rx->hdr.port), TEST_BIDIR_PORT);
+		zassert_equal(ntohl(rx->hdr.buffer_len), TEST_PACKET_SIZE);
+
+		total_len += rx->len;
+	}
+
+	zassert_equal(total_len, (size_t)results.nb_packets_sent * TEST_PACKET_SIZE);
+}
+
+static const char *shell_cmd_run(const char *cmd, int expected)
+{
+	const struct shell *sh = shell_backend_dummy_get_ptr();
+	size_t size;
+
+	shell_backend_dummy_clear_output(sh);
+	zassert_equal(shell_execute_cmd(sh, cmd), expected, "'%s' failed", cmd);
+
+	return shell_backend_dummy_get_output(sh, &size);
+}
+
+static void shell_output_expect(const char *output, const char *expect)
+{
+	zassert_not_null(strstr(output, expect), "'%s' not found in '%s'", expect, output);
+}
+
+/* The dual test starts a server on the default port, the upload goes to
+ * that server over the loopback interface.
+ */
+ZTEST(zperf, test_shell_dual)
+{
+	char streams[32];
+	char cmd[64];
+	const char *output;
+
+	snprintk(cmd, sizeof(cmd), "zperf tcp upload -P %d 127.0.0.1 " DEF_PORT_STR " 1 100",
+		 TEST_STREAMS + 1);
+	(void)shell_cmd_run(cmd, -ENOEXEC);
+
+	snprintk(streams, sizeof(streams), "Streams:\t\t%d\n", TEST_STREAMS);
+
+	snprintk(cmd, sizeof(cmd), "zperf tcp upload -P %d -d 127.0.0.1 " DEF_PORT_STR " 1 100",
+		 TEST_STREAMS);
+	output = shell_cmd_run(cmd, 0);
+	shell_output_expect(output, "Receiving on port " DEF_PORT_STR "\n");
+	shell_output_expect(output, "Upload completed!\n");
+	shell_output_expect(output, streams);
+	shell_output_expect(output, "Send latency:\t");
+	(void)shell_cmd_run("zperf tcp download stop", 0);
+
+	snprintk(cmd, sizeof(cmd),
+		 "zperf udp upload -P %d -d 127.0.0.1 " DEF_PORT_STR " 1 100 100K", TEST_STREAMS);
+	output = shell_cmd_run(cmd, 0);
+	shell_output_expect(output, "Receiving on port " DEF_PORT_STR "\n");
+	shell_output_expect(output, "Upload completed!\n");
+	shell_output_expect(output, streams);
+	shell_output_expect(output, "Send latency:\t");
+	zassert_is_null(strstr(output, "LAST PACKET NOT RECEIVED"), "%s", output);
+	(void)shell_cmd_run("zperf udp download stop", 0);
+}
+
+ZTEST_SUITE(zperf, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,329 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_ROUTE_LOG_LEVEL);
+
+#include <zephyr/types.h>
+#include <zephyr/ztest.h>
+#include <zephyr/random/random.h>
+
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/dummy.h>
+
+#include "net_private.h"
+#include "route.h"
+#include "route_lpm.h"
+
+#define BENCH_MAX_ROUTES 512
+#define BENCH_LOOKUPS 20000
+
+struct test_route {
+	struct net_route_lpm_entry lpm;
+	uint8_t prefix[sizeof(struct in6_addr)];
+	uint8_t prefix_len;
+};
+
+static struct test_route routes[BENCH_MAX_ROUTES];
+
+static uint8_t dummy_iface_api_data;
+
+static int dummy_iface_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return 0;
+}
+
+static void dummy_iface_setup(struct net_if *iface)
+{
+	ARG_UNUSED(iface);
+}
+
+static int dummy_iface_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static struct dummy_api dummy_iface_api = {
+	.iface_api.init = dummy_iface_setup,
+	.send = dummy_iface_send,
+};
+
+NET_DEVICE_INIT_INSTANCE(route_lpm_test_1, "route_lpm_test_1", iface_1,
+			 dummy_iface_init, NULL, &dummy_iface_api_data, NULL,
+			 CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &dummy_iface_api,
+			 DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), 127);
+
+NET_DEVICE_INIT_INSTANCE(route_lpm_test_2, "route_lpm_test_2", iface_2,
+			 dummy_iface_init, NULL, &dummy_iface_api_data, NULL,
+			 CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &dummy_iface_api,
+			 DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), 127);
+
+static struct net_if *test_ifaces[2];
+
+static void iface_cb(struct net_if *iface, void *user_data)
+{
+	int *count = user_data;
+
+	if (net_if_l2(iface) != &NET_L2_GET_NAME(DUMMY)) {
+		return;
+	}
+
+	if (*count < ARRAY_SIZE(test_ifaces)) {
+		test_ifaces[(*count)++] = iface;
+	}
+}
+
+static void route_set(struct test_route *route, const char *addr,
+		      uint8_t prefix_len)
+{
+	sa_family_t family = strchr(addr, ':') ? AF_INET6 : AF_INET;
+
+	memset(route, 0, sizeof(*route));
+	zassert_ok(net_addr_pton(family, addr, route->prefix), "bad address %s", addr);
+	route->prefix_len = prefix_len;
+}
+
+static struct test_route *lookup(sa_family_t family, struct net_if *iface,
+				 const char *addr)
+{
+	uint8_t buf[sizeof(struct in6_addr)];
+	struct net_route_lpm_entry *entry;
+
+	zassert_ok(net_addr_pton(family, addr, buf), "bad address %s", addr);
+
+	entry = net_route_lpm_lookup(family, iface, buf);
+	if (entry == NULL) {
+		return NULL;
+	}
+
+	return CONTAINER_OF(entry, struct test_route, lpm);
+}
+
+static void routes_clear(void)
+{
+	ARRAY_FOR_EACH_PTR(routes, route) {
+		if (route->lpm.trie_node != NULL) {
+			zassert_ok(net_route_lpm_remove(&route->lpm));
+		}
+	}
+
+	zassert_equal(net_route_lpm_free_nodes(), CONFIG_NET_ROUTE_LPM_MAX_NODES,
+		      "Trie nodes leaked");
+}
+
+ZTEST(route_lpm_test_suite, test_ipv6_longest_match)
+{
+	static const struct {
+		const char *addr;
+		uint8_t len;
+	} prefixes[] = {
+		{ "::", 0 },
+		{ "2001:db8::", 32 },
+		{ "2001:db8:1::", 48 },
+		{ "2001:db8:1:2::", 64 },
+		{ "2001:db8:1:2::42", 128 },
+		{ "2001:db8:8000::", 33 },
+	};
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_IPV6);
+
+	for (int i = 0; i < ARRAY_SIZE(prefixes); i++) {
+		route_set(&routes[i], prefixes[i].addr, prefixes[i].len);
+		zassert_ok(net_route_lpm_insert(AF_INET6, &routes[i].lpm,
+						routes[i].prefix,
+						routes[i].prefix_len, NULL));
+	}
+
+	zassert_equal_ptr(lookup(AF_INET6, NULL, "2001:db8:1:2::42"), &routes[4]);
+	zassert_equal_ptr(lookup(AF_INET6, NULL, "2001:db8:1:2::43"), &routes[3]);
+	zassert_equal_ptr(lookup(AF_INET6, NULL, "2001:db8:1:3::1"), &routes[2]);
+	zassert_equal_ptr(lookup(AF_INET6, NULL, "2001:db8:2::1"), &routes[1]);
+	zassert_equal_ptr(lookup(AF_INET6, NULL, "2001:db8:8001::1"), &routes[5]);
+	zassert_equal_ptr(lookup(AF_INET6, NULL, "fe80::1"), &routes[0]);
+
+	/* Removing an intermediate prefix falls back to the shorter one */
+	zassert_ok(net_route_lpm_remove(&routes[2].lpm));
+	zassert_equal_ptr(lookup(AF_INET6, NULL, "2001:db8:1:3::1"), &routes[1]);
+	zassert_equal_ptr(lookup(AF_INET6, NULL, "2001:db8:1:2::43"), &routes[3]);
+
+	zassert_ok(net_route_lpm_remove(&routes[0].lpm));
+	zassert_is_null(lookup(AF_INET6, NULL, "fe80::1"));
+	zassert_equal(net_route_lpm_remove(&routes[0].lpm), -ENOENT);
+
+	routes_clear();
+}
+
+ZTEST(route_lpm_test_suite, test_ipv4_longest_match)
+{
+	route_set(&routes[0], "10.0.0.0", 8);
+	route_set(&routes[1], "10.1.0.0", 16);
+	route_set(&routes[2], "10.1.2.0", 24);
+	route_set(&routes[3], "192.0.2.1", 32);
+
+	for (int i = 0; i < 4; i++) {
+		zassert_ok(net_route_lpm_insert(AF_INET, &routes[i].lpm,
+						routes[i].prefix,
+						routes[i].prefix_len, NULL));
+	}
+
+	zassert_equal_ptr(lookup(AF_INET, NULL, "10.1.2.3"), &routes[2]);
+	zassert_equal_ptr(lookup(AF_INET, NULL, "10.1.3.3"), &routes[1]);
+	zassert_equal_ptr(lookup(AF_INET, NULL, "10.2.3.3"), &routes[0]);
+	zassert_equal_ptr(lookup(AF_INET, NULL, "192.0.2.1"), &routes[3]);
+	zassert_is_null(lookup(AF_INET, NULL, "192.0.2.2"));
+
+	/* The families do not share prefixes */
+	zassert_is_null(lookup(AF_INET6, NULL, "a01:203::"));
+
+	routes_clear();
+}
+
+ZTEST(route_lpm_test_suite, test_iface_filter)
+{
+	struct net_if *iface1 = test_ifaces[0];
+	struct net_if *iface2 = test_ifaces[1];
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_IPV6);
+
+	route_set(&routes[0], "2001:db8::", 32);
+	route_set(&routes[1], "2001:db8::", 32);
+	route_set(&routes[2], "2001:db8:1::", 48);
+
+	zassert_ok(net_route_lpm_insert(AF_INET6, &routes[0].lpm, routes[0].prefix,
+					routes[0].prefix_len, iface1));
+	zassert_ok(net_route_lpm_insert(AF_INET6, &routes[1].lpm, routes[1].prefix,
+					routes[1].prefix_len, iface2));
+	zassert_ok(net_route_lpm_insert(AF_INET6, &routes[2].lpm, routes[2].prefix,
+					routes[2].prefix_len, iface1));
+	zassert_equal(net_route_lpm_insert(AF_INET6, &routes[2].lpm, routes[2].prefix,
+					   routes[2].prefix_len, iface1), -EALREADY);
+
+	zassert_equal_ptr(lookup(AF_INET6, iface1, "2001:db8:1::1"), &routes[2]);
+	zassert_equal_ptr(lookup(AF_INET6, iface2, "2001:db8:1::1"), &routes[1]);
+	zassert_equal_ptr(lookup(AF_INET6, NULL, "2001:db8:1::1"), &routes[2]);
+
+	routes_clear();
+}
+
+static void route_ipv4_cb(struct net_route_entry_ipv4 *entry, void *user_data)
+{
+	ARG_UNUSED(entry);
+	ARG_UNUSED(user_data);
+}
+
+ZTEST(route_lpm_test_suite, test_ipv4_route_table)
+{
+	struct net_if *iface = test_ifaces[0];
+	struct net_route_entry_ipv4 *route, *def;
+	struct in_addr prefix, gw, dst, found_gw;
+
+	net_addr_pton(AF_INET, "0.0.0.0", &prefix);
+	net_addr_pton(AF_INET, "192.0.2.1", &gw);
+	def = net_route_ipv4_add(iface, &prefix, 0, &gw);
+	zassert_not_null(def);
+
+	net_addr_pton(AF_INET, "198.51.100.0", &prefix);
+	net_addr_pton(AF_INET, "192.0.2.2", &gw);
+	route = net_route_ipv4_add(iface, &prefix, 24, &gw);
+	zassert_not_null(route);
+
+	net_addr_pton(AF_INET, "198.51.100.7", &dst);
+	zassert_equal_ptr(net_route_ipv4_lookup(iface, &dst), route);
+	zassert_true(net_ipv4_addr_cmp(&net_route_ipv4_lookup(NULL, &dst)->gw, &gw));
+	zassert_true(net_route_ipv4_get_gw(iface, &dst, &found_gw));
+	zassert_true(net_ipv4_addr_cmp(&found_gw, &gw));
+
+	net_addr_pton(AF_INET, "203.0.113.7", &dst);
+	zassert_equal_ptr(net_route_ipv4_lookup(iface, &dst), def);
+
+	/* Adding the same prefix again updates the gateway */
+	net_addr_pton(AF_INET, "192.0.2.3", &gw);
+	zassert_equal_ptr(net_route_ipv4_add(iface, &prefix, 24, &gw), route);
+	zassert_true(net_ipv4_addr_cmp(&route->gw, &gw));
+
+	zassert_equal(net_route_ipv4_foreach(route_ipv4_cb, NULL), 2);
+
+	zassert_ok(net_route_ipv4_del(route));
+	zassert_equal(net_route_ipv4_del(route), -ENOENT);
+
+	net_addr_pton(AF_INET, "198.51.100.7", &dst);
+	zassert_equal_ptr(net_route_ipv4_lookup(iface, &dst), def);
+
+	zassert_ok(net_route_ipv4_del(def));
+	zassert_is_null(net_route_ipv4_lookup(iface, &dst));
+	zassert_false(net_route_ipv4_get_gw(iface, &dst, &found_gw));
+}
+
+static void random_prefix(struct test_route *route)
+{
+	sys_rand_get(route->prefix, sizeof(route->prefix));
+
+	/* Keep the prefixes in the same /16 so that they share nodes */
+	route->prefix[0] = 0x20;
+	route->prefix[1] = 0x01;
+	route->prefix_len = 16 + sys_rand32_get() % (128 - 16 + 1);
+}
+
+ZTEST(route_lpm_test_suite, test_lookup_rate)
+{
+	static uint8_t addrs[64][sizeof(struct in6_addr)];
+	int count = 0;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NET_IPV6);
+
+	ARRAY_FOR_EACH(addrs, i) {
+		sys_rand_get(addrs[i], sizeof(addrs[i]));
+		addrs[i][0] = 0x20;
+		addrs[i][1] = 0x01;
+	}
+
+	for (int size = 16; size <= BENCH_MAX_ROUTES; size *= 2) {
+		uint32_t start, cycles;
+
+		for (; count < size; count++) {
+			random_prefix(&routes[count]);
+			zassert_ok(net_route_lpm_insert(AF_INET6, &routes[count].lpm,
+							routes[count].prefix,
+							routes[count].prefix_len,
+							NULL));
+		}
+
+		start = k_cycle_get_32();
+
+		for (int i = 0; i < BENCH_LOOKUPS; i++) {
+			(void)net_route_lpm_lookup(AF_INET6, NULL,
+						   addrs[i % ARRAY_SIZE(addrs)]);
+		}
+
+		cycles = k_cycle_get_32() - start;
+
+		TC_PRINT("%4d routes: %u cycles/lookup, %llu lookups/sec\n",
+			 size, cycles / BENCH_LOOKUPS,
+			 cycles ? ((uint64_t)BENCH_LOOKUPS *
+				   sys_clock_hw_cycles_per_sec()) / cycles : 0ULL);
+	}
+
+	routes_clear();
+}
+
+static void *setup(void)
+{
+	int count = 0;
+
+	net_if_foreach(iface_cb, &count);
+
+	zassert_equal(count, ARRAY_SIZE(test_ifaces), "Test interfaces not found");
+
+	return NULL;
+}
+
+ZTEST_SUITE(route_lpm_test_suite, NULL, setup, NULL, NULL, NULL);
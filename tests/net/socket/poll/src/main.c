@@ -248,4 +248,110 @@ ZTEST(net_socket_poll, test_pollout_tcp)
 	zassert_equal(res, 0, "close failed");
 }
 
+ZTEST(net_socket_poll, test_epoll)
+{
+	int res;
+	int ep;
+	int c_sock;
+	int s_sock;
+	struct sockaddr_in6 c_addr;
+	struct sockaddr_in6 s_addr;
+	struct zsock_epoll_event ev;
+	struct zsock_epoll_event events[2];
+	uint32_t tstamp;
+	ssize_t len;
+	char buf[10];
+
+	if (!IS_ENABLED(CONFIG_ZVFS_EPOLL)) {
+		ztest_test_skip();
+	}
+
+	prepare_sock_udp_v6(MY_IPV6_ADDR, CLIENT_PORT, &c_sock, &c_addr);
+	prepare_sock_udp_v6(MY_IPV6_ADDR, SERVER_PORT, &s_sock, &s_addr);
+
+	res = zsock_bind(s_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "bind failed");
+
+	res = zsock_connect(c_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "connect failed");
+
+	ep = zsock_epoll_create(0);
+	zassert_true(ep >= 0, "epoll_create failed");
+
+	ev.events = ZSOCK_EPOLLIN;
+	ev.data.fd = s_sock;
+	res = zsock_epoll_ctl(ep, ZSOCK_EPOLL_CTL_ADD, s_sock, &ev);
+	zassert_equal(res, 0, "epoll_ctl failed");
+
+	res = zsock_epoll_ctl(ep, ZSOCK_EPOLL_CTL_ADD, s_sock, &ev);
+	zassert_equal(res, -1, "duplicate add should fail");
+	zassert_equal(errno, EEXIST, "");
+
+	/* Nothing ready yet */
+	tstamp = k_uptime_get_32();
+	res = zsock_epoll_wait(ep, events, ARRAY_SIZE(events), 30);
+	tstamp = k_uptime_get_32() - tstamp;
+	zassert_equal(res, 0, "");
+	zassert_true(tstamp >= 30U && tstamp <= 30 + FUZZ * 2, "tstamp %d", tstamp);
+
+	len = zsock_send(c_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid send len");
+
+	res = zsock_epoll_wait(ep, events, ARRAY_SIZE(events), 100);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].data.fd, s_sock, "");
+	zassert_equal(events[0].events, ZSOCK_EPOLLIN, "");
+
+	/* Level triggered: reported again until the data is read */
+	res = zsock_epoll_wait(ep, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 1, "");
+
+	len = zsock_recv(s_sock, BUF_AND_SIZE(buf), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid recv len");
+
+	res = zsock_epoll_wait(ep, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+	/* Edge triggered: reported once per notification */
+	ev.events = ZSOCK_EPOLLIN | ZSOCK_EPOLLET;
+	res = zsock_epoll_ctl(ep, ZSOCK_EPOLL_CTL_MOD, s_sock, &ev);
+	zassert_equal(res, 0, "epoll_ctl failed");
+
+	len = zsock_send(c_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid send len");
+
+	res = zsock_epoll_wait(ep, events, ARRAY_SIZE(events), 100);
+	zassert_equal(res, 1, "");
+
+	res = zsock_epoll_wait(ep, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+	len = zsock_recv(s_sock, BUF_AND_SIZE(buf), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid recv len");
+
+	res = zsock_epoll_ctl(ep, ZSOCK_EPOLL_CTL_DEL, s_sock, NULL);
+	zassert_equal(res, 0, "epoll_ctl failed");
+
+	res = zsock_epoll_ctl(ep, ZSOCK_EPOLL_CTL_DEL, s_sock, NULL);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, ENOENT, "");
+
+	/* Closed sockets are dropped from the instance */
+	ev.events = ZSOCK_EPOLLIN;
+	ev.data.fd = c_sock;
+	res = zsock_epoll_ctl(ep, ZSOCK_EPOLL_CTL_ADD, c_sock, &ev);
+	zassert_equal(res, 0, "epoll_ctl failed");
+
+	res = zsock_close(c_sock);
+	zassert_equal(res, 0, "close failed");
+
+	res = zsock_epoll_wait(ep, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+	res = zsock_close(s_sock);
+	zassert_equal(res, 0, "close failed");
+	res = zsock_close(ep);
+	zassert_equal(res, 0, "close failed");
+}
+
 ZTEST_SUITE(net_socket_poll, NULL, NULL, NULL, NULL, NULL);
@@ -2502,6 +2502,176 @@ ZTEST(net_socket_tcp, test_keepalive_timeout)
 	test_context_cleanup();
 }
 
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+static atomic_t zerocopy_released;
+
+static void zerocopy_destroy(struct net_buf *buf)
+{
+	atomic_inc(&zerocopy_released);
+	net_buf_destroy(buf);
+}
+
+NET_BUF_POOL_DEFINE(zerocopy_pool, 4, sizeof(TEST_STR_SMALL), 0,
+		    zerocopy_destroy);
+
+static struct net_buf *zerocopy_chain(const char *data, size_t len)
+{
+	struct net_buf *frags = NULL, *frag;
+	size_t frag_len;
+
+	while (len > 0) {
+		frag = net_buf_alloc(&zerocopy_pool, K_NO_WAIT);
+		zassert_not_null(frag, "cannot allocate buffer");
+
+		frag_len = MIN(len, net_buf_tailroom(frag));
+		net_buf_add_mem(frag, data, frag_len);
+		data += frag_len;
+		len -= frag_len;
+
+		if (frags == NULL) {
+			frags = frag;
+		} else {
+			net_buf_frag_add(frags, frag);
+		}
+	}
+
+	return frags;
+}
+#endif
+
+ZTEST(net_socket_tcp, test_v4_zerocopy_send_recv)
+{
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	struct sockaddr_in c_saddr;
+	struct sockaddr_in s_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	struct net_buf *frags;
+	char rx_buf[sizeof(TEST_STR_SMALL) * 2] = { 0 };
+	ssize_t sent, recved, total = 0;
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &c_sock, &c_saddr);
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, SERVER_PORT, &s_sock, &s_saddr);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+	zassert_equal(addrlen, sizeof(struct sockaddr_in), "wrong addrlen");
+
+	atomic_clear(&zerocopy_released);
+
+	/* Two buffers, the stack owns them after the call */
+	frags = zerocopy_chain(TEST_STR_SMALL TEST_STR_SMALL,
+			       STRLEN(TEST_STR_SMALL) * 2);
+	zassert_not_null(frags->frags, "expected a chain");
+
+	sent = zsock_sendto_buf(c_sock, frags, 0, NULL, 0);
+	zassert_equal(sent, STRLEN(TEST_STR_SMALL) * 2, "sendto_buf failed (%d)",
+		      errno);
+
+	while (total < sent) {
+		recved = zsock_recvfrom_buf(new_sock, &frags, 0, NULL, NULL);
+		zassert_true(recved > 0, "recvfrom_buf failed (%d)", errno);
+		zassert_equal(net_buf_frags_len(frags), recved, "wrong length");
+
+		net_buf_linearize(rx_buf + total, sizeof(rx_buf) - total, frags,
+				  0, recved);
+		net_buf_unref(frags);
+		total += recved;
+	}
+
+	zassert_mem_equal(rx_buf, TEST_STR_SMALL TEST_STR_SMALL, sent,
+			  "wrong data");
+
+	/* The sent buffers are released once the data is acknowledged */
+	k_msleep(THREAD_SLEEP);
+	zassert_equal(atomic_get(&zerocopy_released), 2,
+		      "sent buffers not released");
+
+	test_close(c_sock);
+	test_close(new_sock);
+	test_close(s_sock);
+
+	test_context_cleanup();
+#else
+	ztest_test_skip();
+#endif
+}
+
+ZTEST(net_socket_tcp, test_v4_zerocopy_send_win_size)
+{
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+	int rv;
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	struct sockaddr_in c_saddr;
+	struct sockaddr_in s_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	struct net_buf *frags;
+	int buf_optval = sizeof(TEST_STR_SMALL);
+	ssize_t sent;
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &c_sock, &c_saddr);
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, SERVER_PORT, &s_sock, &s_saddr);
+
+	/* Lower client-side TX window size. */
+	rv = zsock_setsockopt(c_sock, SOL_SOCKET, SO_SNDBUF, &buf_optval,
+			      sizeof(buf_optval));
+	zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+	zassert_equal(addrlen, sizeof(struct sockaddr_in), "wrong addrlen");
+
+	/* Make sure the ACK from the server does not arrive. */
+	loopback_set_packet_drop_ratio(1.0f);
+
+	frags = zerocopy_chain(TEST_STR_SMALL, STRLEN(TEST_STR_SMALL));
+	sent = zsock_sendto_buf(c_sock, frags, ZSOCK_MSG_DONTWAIT, NULL, 0);
+	zassert_equal(sent, STRLEN(TEST_STR_SMALL), "sendto_buf failed (%d)",
+		      errno);
+
+	/* The chain does not fit in the rest of the window and is not split,
+	 * the buffers are still ours.
+	 */
+	frags = zerocopy_chain(TEST_STR_SMALL, 2);
+	sent = zsock_sendto_buf(c_sock, frags, ZSOCK_MSG_DONTWAIT, NULL, 0);
+	zassert_equal(sent, -1, "Unexpected return code %d", sent);
+	zassert_equal(errno, EAGAIN, "Unexpected errno value: %d", errno);
+	net_buf_unref(frags);
+
+	/* A chain larger than the whole window can never be sent */
+	frags = zerocopy_chain(TEST_STR_SMALL TEST_STR_SMALL,
+			       STRLEN(TEST_STR_SMALL) * 2);
+	sent = zsock_sendto_buf(c_sock, frags, ZSOCK_MSG_DONTWAIT, NULL, 0);
+	zassert_equal(sent, -1, "Unexpected return code %d", sent);
+	zassert_equal(errno, EMSGSIZE, "Unexpected errno value: %d", errno);
+	net_buf_unref(frags);
+
+	restore_packet_loss_ratio();
+
+	test_close(c_sock);
+	test_close(new_sock);
+	test_close(s_sock);
+
+	test_context_cleanup();
+#else
+	ztest_test_skip();
+#endif
+}
+
 static void after(void *arg)
 {
 	ARG_UNUSED(arg);
@@ -1814,6 +1814,74 @@ ZTEST(net_socket_tls, test_poll_dtls_pollerr)
 	k_msleep(10);
 }
 
+ZTEST(net_socket_tls, test_session_cache_resumption)
+{
+	struct tls_session_cache_stats before, after;
+	int cache = TLS_SESSION_CACHE_ENABLED;
+	struct sockaddr_in c_saddr;
+	struct sockaddr_in s_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen;
+	socklen_t optlen;
+	struct connect_data test_data;
+
+	prepare_sock_tls_v4(MY_IPV4_ADDR, ANY_PORT, &s_sock, &s_saddr,
+			    IPPROTO_TLS_1_2);
+	test_config_psk(s_sock, -1);
+	zassert_equal(zsock_setsockopt(s_sock, SOL_TLS, TLS_SESSION_CACHE,
+				       &cache, sizeof(cache)),
+		      0, "Failed to enable session cache");
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	optlen = sizeof(before);
+	zassert_equal(zsock_getsockopt(s_sock, SOL_TLS, TLS_SESSION_CACHE_STATS,
+				       &before, &optlen),
+		      0, "Failed to get session cache stats");
+
+	/* The first handshake is a full one, the second one resumes the
+	 * session on both ends.
+	 */
+	for (int i = 0; i < 2; i++) {
+		prepare_sock_tls_v4(MY_IPV4_ADDR, ANY_PORT, &c_sock, &c_saddr,
+				    IPPROTO_TLS_1_2);
+		test_config_psk(-1, c_sock);
+		zassert_equal(zsock_setsockopt(c_sock, SOL_TLS, TLS_SESSION_CACHE,
+					       &cache, sizeof(cache)),
+			      0, "Failed to enable session cache");
+
+		test_data.sock = c_sock;
+		test_data.addr = (struct sockaddr *)&s_saddr;
+		k_work_init_delayable(&test_data.work, client_connect_work_handler);
+		test_work_reschedule(&test_data.work, K_NO_WAIT);
+
+		addrlen = sizeof(addr);
+		test_accept(s_sock, &new_sock, &addr, &addrlen);
+		test_work_wait(&test_data.work);
+
+		test_close(c_sock);
+		c_sock = -1;
+		test_close(new_sock);
+		new_sock = -1;
+	}
+
+	optlen = sizeof(after);
+	zassert_equal(zsock_getsockopt(s_sock, SOL_TLS, TLS_SESSION_CACHE_STATS,
+				       &after, &optlen),
+		      0, "Failed to get session cache stats");
+	zassert_equal(after.hits - before.hits, 2, "Session not resumed");
+
+	zassert_equal(zsock_setsockopt(s_sock, SOL_TLS, TLS_SESSION_CACHE_PURGE,
+				       NULL, 0),
+		      0, "Failed to purge session cache");
+
+	test_sockets_close();
+
+	/* Small delay for the final alert exchange */
+	k_msleep(10);
+}
+
 static void *tls_tests_setup(void)
 {
 	k_work_queue_init(&tls_test_work_queue);
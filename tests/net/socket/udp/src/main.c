@@ -3108,6 +3108,79 @@ ZTEST(net_socket_udp, test_40_clamp_udp_tcp_port_range)
 #endif
 }
 
+ZTEST(net_socket_udp, test_41_v4_zerocopy_send_recv)
+{
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+	static const char part1[] = "Zero-copy ";
+	static const char part2[] = "datagram";
+	int rv;
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	struct net_buf *frags, *frag;
+	ssize_t sent, recved;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, ANY_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = zsock_bind(server_sock, (struct sockaddr *)&server_addr,
+			sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	frags = net_pkt_get_reserve_tx_data(STRLEN(part1), K_FOREVER);
+	zassert_not_null(frags, "cannot allocate buffer");
+	net_buf_add_mem(frags, part1, STRLEN(part1));
+
+	frag = net_pkt_get_reserve_tx_data(STRLEN(part2), K_FOREVER);
+	zassert_not_null(frag, "cannot allocate buffer");
+	net_buf_add_mem(frag, part2, STRLEN(part2));
+	net_buf_frag_add(frags, frag);
+
+	/* The stack owns the buffers after this call */
+	sent = zsock_sendto_buf(client_sock, frags, 0,
+				(struct sockaddr *)&server_addr,
+				sizeof(server_addr));
+	zassert_equal(sent, STRLEN(part1) + STRLEN(part2), "sendto_buf failed");
+
+	recved = zsock_recvfrom_buf(server_sock, &frags, 0, &addr, &addrlen);
+	zassert_equal(recved, sent, "recvfrom_buf failed");
+	zassert_not_null(frags, "no buffers received");
+	zassert_equal(net_buf_frags_len(frags), recved, "wrong length");
+	zassert_equal(addrlen, sizeof(struct sockaddr_in), "wrong addrlen");
+
+	clear_buf(rx_buf);
+	net_buf_linearize(rx_buf, sizeof(rx_buf), frags, 0, recved);
+	zassert_mem_equal(rx_buf, part1, STRLEN(part1), "wrong data");
+	zassert_mem_equal(rx_buf + STRLEN(part1), part2, STRLEN(part2),
+			  "wrong data");
+
+	net_buf_unref(frags);
+
+	/* Nothing more to read */
+	recved = zsock_recvfrom_buf(server_sock, &frags, ZSOCK_MSG_DONTWAIT,
+				    NULL, NULL);
+	zassert_equal(recved, -1, "unexpected data");
+	zassert_equal(errno, EAGAIN, "wrong errno");
+	zassert_is_null(frags, "unexpected buffers");
+
+	/* Peeking is not possible without copying */
+	recved = zsock_recvfrom_buf(server_sock, &frags, ZSOCK_MSG_PEEK,
+				    NULL, NULL);
+	zassert_equal(recved, -1, "peek should fail");
+	zassert_equal(errno, EOPNOTSUPP, "wrong errno");
+
+	rv = zsock_close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = zsock_close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+#else
+	ztest_test_skip();
+#endif
+}
+
 static void after(void *arg)
 {
 	ARG_UNUSED(arg);
@@ -938,4 +938,89 @@ ZTEST(test_utils_fn, test_ip_checksum)
 	}
 }
 
+ZTEST(test_utils_fn, test_ip_checksum_update)
+{
+	struct net_ipv4_hdr hdr = {
+		.vhl = 0x45,
+		.len = htons(84),
+		.id = { 0x12, 0x34 },
+		.ttl = 64,
+		.proto = IPPROTO_UDP,
+		.src = { 192, 0, 2, 1 },
+		.dst = { 198, 51, 100, 7 },
+	};
+	struct in_addr new_src = { { { 10, 1, 2, 3 } } };
+	struct in_addr old_src;
+	uint16_t chksum;
+	uint16_t old_len;
+
+	hdr.chksum = htons(~calc_chksum(0U, (uint8_t *)&hdr, sizeof(hdr)));
+	zassert_equal(calc_chksum(0U, (uint8_t *)&hdr, sizeof(hdr)), 0xffff,
+		      "Invalid initial checksum");
+
+	/* 16-bit field */
+	old_len = hdr.len;
+	hdr.len = htons(1500);
+	chksum = net_chksum_update16(hdr.chksum, old_len, hdr.len);
+
+	hdr.chksum = 0U;
+	zassert_equal(chksum, htons(~calc_chksum(0U, (uint8_t *)&hdr, sizeof(hdr))),
+		      "Mismatch after 16-bit update");
+	hdr.chksum = chksum;
+
+	/* 32-bit field */
+	net_ipv4_addr_copy_raw(old_src.s4_addr, hdr.src);
+	net_ipv4_addr_copy_raw(hdr.src, new_src.s4_addr);
+	chksum = net_chksum_update32(hdr.chksum, old_src.s_addr, new_src.s_addr);
+
+	hdr.chksum = 0U;
+	zassert_equal(chksum, htons(~calc_chksum(0U, (uint8_t *)&hdr, sizeof(hdr))),
+		      "Mismatch after 32-bit update");
+
+	/* Any size, back to the original address */
+	chksum = net_chksum_update(chksum, new_src.s4_addr, old_src.s4_addr,
+				   sizeof(struct in_addr));
+	net_ipv4_addr_copy_raw(hdr.src, old_src.s4_addr);
+
+	hdr.chksum = 0U;
+	zassert_equal(chksum, htons(~calc_chksum(0U, (uint8_t *)&hdr, sizeof(hdr))),
+		      "Mismatch after generic update");
+}
+
+/* Rough cost of the checksum over typical packet sizes, up to an Ethernet MTU */
+ZTEST(test_utils_fn, test_ip_checksum_perf)
+{
+	static const size_t sizes[] = { 64, 128, 576, 1280, 1500 };
+	const int rounds = 100;
+	uint32_t start, cycles;
+	uint64_t per_byte;
+	uint16_t sum = 0U;
+
+	for (int i = 0; i < CHECKSUM_TEST_LENGTH; i++) {
+		testdata[i] = (uint8_t)(i * 31);
+	}
+
+	ARRAY_FOR_EACH(sizes, i) {
+		for (int offset = 0; offset < 2; offset++) {
+			size_t len = sizes[i] - offset;
+
+			start = k_cycle_get_32();
+
+			for (int round = 0; round < rounds; round++) {
+				sum = calc_chksum(sum, testdata + offset, len);
+			}
+
+			cycles = k_cycle_get_32() - start;
+
+			/* In 1/100 cycles, 64-bit so that slow targets do not overflow */
+			per_byte = (uint64_t)cycles * 100U / (rounds * len);
+
+			TC_PRINT("chksum %4zu bytes, offset %d: %u cycles, %u.%02u cycles/byte\n",
+				 len, offset, cycles / rounds,
+				 (uint32_t)(per_byte / 100U),
+				 (uint32_t)(per_byte % 100U));
+		}
+	}
+}
+
 ZTEST_SUITE(test_utils_fn, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/debug/thread_analyzer.h>
+
+#define TEST_STACK_SIZE 4096
+/* Both are larger than the guard window and the stack used while the test
+ * thread waits for a command.
+ */
+#define TEST_STACK_SMALL 512
+#define TEST_STACK_LARGE 2048
+#define TEST_BUSY_MS 200
+
+enum test_cmd {
+	TEST_CMD_STACK_SMALL,
+	/* Grow the stack below the guard window without writing it */
+	TEST_CMD_STACK_SKIP_GUARD,
+	TEST_CMD_STACK_LARGE,
+	TEST_CMD_BUSY,
+};
+
+static K_SEM_DEFINE(cmd_sem, 0, 1);
+static K_SEM_DEFINE(done_sem, 0, 1);
+static enum test_cmd cmd;
+
+/* Analysis of the test thread by the periodic analysis and by the last
+ * thread_analyzer_run() call.
+ */
+static struct thread_analyzer_zbus_msg zbus_msg;
+static atomic_t zbus_msgs;
+static atomic_t zbus_test_msgs;
+static struct thread_analyzer_info test_info;
+static bool test_info_found;
+
+static __noinline void stack_small(void)
+{
+	volatile uint8_t buf[TEST_STACK_SMALL];
+
+	for (size_t i = 0; i < sizeof(buf); i++) {
+		buf[i] = 0x55;
+	}
+}
+
+static __noinline void stack_large(bool deepest_only)
+{
+	volatile uint8_t buf[TEST_STACK_LARGE];
+
+	/* The stack grows down, buf[0] is its deepest byte */
+	if (deepest_only) {
+		buf[0] = 0x55;
+		return;
+	}
+
+	for (size_t i = 0; i < sizeof(buf); i++) {
+		buf[i] = 0x55;
+	}
+}
+
+static void test_thread_entry(void *p1, void *p2, void *p3)
+{
+	while (true) {
+		k_sem_take(&cmd_sem, K_FOREVER);
+
+		switch (cmd) {
+		case TEST_CMD_STACK_SMALL:
+			stack_small();
+			break;
+		case TEST_CMD_STACK_SKIP_GUARD:
+			stack_large(true);
+			break;
+		case TEST_CMD_STACK_LARGE:
+			stack_large(false);
+			break;
+		case TEST_CMD_BUSY:
+			k_busy_wait(TEST_BUSY_MS * USEC_PER_MSEC);
+			break;
+		}
+
+		k_sem_give(&done_sem);
+	}
+}
+
+K_THREAD_DEFINE(ta_test, TEST_STACK_SIZE, test_thread_entry, NULL, NULL, NULL,
+		K_PRIO_PREEMPT(5), 0, 0);
+
+static void zbus_listener_cb(const struct zbus_channel *chan)
+{
+	const struct thread_analyzer_zbus_msg *msg = zbus_chan_const_msg(chan);
+
+	atomic_inc(&zbus_msgs);
+
+	if (strcmp(msg->name, "ta_test") == 0) {
+		zbus_msg = *msg;
+		atomic_inc(&zbus_test_msgs);
+	}
+}
+
+ZBUS_LISTENER_DEFINE(ta_test_listener, zbus_listener_cb);
+ZBUS_CHAN_ADD_OBS(thread_analyzer_chan, ta_test_listener, 3);
+
+static void test_thread_cmd(enum test_cmd test_cmd)
+{
+	cmd = test_cmd;
+	k_sem_give(&cmd_sem);
+	zassert_ok(k_sem_take(&done_sem, K_SECONDS(5)));
+}
+
+static void analyze_cb(struct thread_analyzer_info *info)
+{
+	if (strcmp(info->name, "ta_test") == 0) {
+		test_info = *info;
+		test_info.name = NULL;
+		test_info_found = true;
+	}
+}
+
+static void analyze(void)
+{
+	test_info_found = false;
+	thread_analyzer_run(analyze_cb, 0);
+	zassert_true(test_info_found, "Test thread not analyzed");
+}
+
+/* Stack usage found by a full scan */
+static size_t stack_used_scan(void)
+{
+	size_t unused;
+
+	zassert_ok(k_thread_stack_space_get(ta_test, &unused));
+
+	return ta_test->stack_info.size - unused;
+}
+
+ZTEST(thread_analyzer_incremental, test_stack_growth)
+{
+	size_t used;
+
+	analyze();
+	zassert_equal(test_info.stack_used, stack_used_scan());
+
+	/* Growth through the guard window is found by scanning again */
+	used = test_info.stack_used;
+	test_thread_cmd(TEST_CMD_STACK_SMALL);
+	analyze();
+	zassert_true(test_info.stack_used > used, "Growth not found");
+	zassert_equal(test_info.stack_used, stack_used_scan());
+
+	/* Unchanged usage is taken from the previous run */
+	used = test_info.stack_used;
+	analyze();
+	zassert_equal(test_info.stack_used, used);
+
+	/* Growth leaving the guard window unused is not noticed */
+	test_thread_cmd(TEST_CMD_STACK_SKIP_GUARD);
+	analyze();
+	zassert_equal(test_info.stack_used, used, "Stack scanned without use of the window");
+	zassert_true(stack_used_scan() > used);
+
+	/* Until the window is used */
+	test_thread_cmd(TEST_CMD_STACK_LARGE);
+	analyze();
+	zassert_true(test_info.stack_used > used, "Growth not found");
+	zassert_equal(test_info.stack_used, stack_used_scan());
+}
+
+ZTEST(thread_analyzer_incremental, test_utilization_per_run)
+{
+	analyze();
+
+	/* The test thread is busy for most of the time since the last run */
+	test_thread_cmd(TEST_CMD_BUSY);
+	analyze();
+	zassert_true(test_info.utilization >= 25, "Utilization %u %%", test_info.utilization);
+
+	/* And idle since */
+	k_msleep(TEST_BUSY_MS / 2);
+	analyze();
+	zassert_equal(test_info.utilization, 0, "Utilization %u %%", test_info.utilization);
+}
+
+ZTEST(thread_analyzer_incremental, test_zbus)
+{
+	/* One message per thread: at least main, idle, analyzer, test */
+	zassert_true(atomic_get(&zbus_msgs) >= 4, "%ld messages", atomic_get(&zbus_msgs));
+	zassert_equal(atomic_get(&zbus_test_msgs), 1);
+
+	zassert_equal(zbus_msg.stack_size, ta_test->stack_info.size);
+	zassert_true(zbus_msg.stack_used > 0);
+	zassert_true(zbus_msg.stack_used <= zbus_msg.stack_size);
+	zassert_true(zbus_msg.utilization <= 100);
+}
+
+static void *thread_analyzer_incremental_setup(void)
+{
+	/* Wait for the periodic analysis run at boot, the next one is only
+	 * due after the tests.
+	 */
+	for (int i = 0; (i < 50) && (atomic_get(&zbus_test_msgs) == 0); i++) {
+		k_msleep(100);
+	}
+
+	zassert_true(atomic_get(&zbus_test_msgs) > 0, "No analysis published");
+
+	return NULL;
+}
+
+ZTEST_SUITE(thread_analyzer_incremental, NULL, thread_analyzer_incremental_setup, NULL, NULL,
+	    NULL);
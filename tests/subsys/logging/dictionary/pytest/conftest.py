@@ -9,8 +9,14 @@ import pytest
 
 def pytest_addoption(parser):
     parser.addoption('--fpu', action="store_true")
+    parser.addoption('--compact', action="store_true")
 
 
 @pytest.fixture()
 def is_fpu_build(request):
     return request.config.getoption('--fpu')
+
+
+@pytest.fixture()
+def is_compact_build(request):
+    return request.config.getoption('--compact')
@@ -127,6 +127,48 @@ def expected_regex_fpu():
     ]
 
 
+def expected_regex_compact():
+    '''
+    Return an array of additional compiled regular expression for matching
+    the decoded log lines for compact message builds.
+    '''
+    return [
+    # [        32] <inf> hello_world: long str xxx...
+    re.compile(r'[\s]+[\[][ ]*32[\]] <inf> hello_world: long str x{160}[^x]'),
+    # [        48] <inf> hello_world: long hexdump
+    re.compile(r'[\s]+[\[][ ]*48[\]] <inf> hello_world: long hexdump'),
+    # 5a 5a 5a 5a 5a 5a 5a 5a                          |ZZZZZZZZ
+    re.compile(r'[\s]+[ ]+(5a ){8}[ ]{25}[|]ZZZZZZZZ [^Z]'),
+    # [        64] <inf> hello_world: domain message
+    re.compile(r'[\s]+[\[][ ]*64[\]] <inf> hello_world: domain message'),
+    # [        80] <inf> hello_world: compact end
+    re.compile(r'[\s]+[\[][ ]*80[\]] <inf> hello_world: compact end'),
+    ]
+
+
+def compact_timestamps_matching(decoded_logs):
+    '''
+    Check the timestamps of the compact messages, which are encoded as deltas
+    to the previous message or as absolute values, and wrap around the
+    32-bit counter. Keep in sync with compact_timestamps[] in main.c.
+    '''
+    expected = [1000, 1001, 1301, 101301,
+                0xFFFFFFF0, 0x10, 0xFFFFFFF0, 0x10, 0xFFFFFFF0, 0x10]
+
+    found = re.findall(r'[\[][ ]*([0-9]+)[\]] <inf> hello_world: compact ([0-9]+)',
+                       decoded_logs)
+    timestamps = [int(ts) for ts, _ in found]
+    indexes = [int(idx) for _, idx in found]
+
+    logger.info(f'Compact timestamps: {timestamps}')
+
+    # The hexdump of 200 bytes spans 12 full lines and one with 8 bytes
+    hexdump_lines = re.findall(r'[|]ZZZZZZZZ ZZZZZZZZ', decoded_logs)
+
+    return (indexes == list(range(len(expected))) and timestamps == expected and
+            len(hexdump_lines) == 12)
+
+
 def regex_matching(decoded_logs, expected_regex):
     '''
     Given the decoded log lines and an array of compiled regular expression,
@@ -150,7 +192,7 @@ def regex_matching(decoded_logs, expected_regex):
     return all(regex_results)
 
 
-def test_logging_dictionary(dut: DeviceAdapter, is_fpu_build):
+def test_logging_dictionary(dut: DeviceAdapter, is_fpu_build, is_compact_build):
     '''
     Main entrance to setup test result validation.
     '''
@@ -164,3 +206,7 @@ def test_logging_dictionary(dut: DeviceAdapter, is_fpu_build):
 
     if is_fpu_build:
         assert regex_matching(decoded_logs, expected_regex_fpu())
+
+    if is_compact_build:
+        assert regex_matching(decoded_logs, expected_regex_compact())
+        assert compact_timestamps_matching(decoded_logs)
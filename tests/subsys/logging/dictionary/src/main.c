@@ -11,12 +11,64 @@
 #include <stdio.h>
 #include <zephyr/sys/printk.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/logging/log_ctrl.h>
 #include <zephyr/shell/shell.h>
 
 LOG_MODULE_REGISTER(hello_world, LOG_LEVEL_DBG);
 
 static const char *hexdump_msg = "HEXDUMP! HEXDUMP@ HEXDUMP#";
 
+#ifdef CONFIG_LOG_DICTIONARY_COMPACT
+/* Timestamps of the compact messages. They need one to five byte long
+ * deltas and wrap around the 32-bit counter several times, so both relative
+ * and absolute (sync) timestamps are decoded across a wrap.
+ */
+static const log_timestamp_t compact_timestamps[] = {
+	1000, 1001, 1301, 101301,
+	0xFFFFFFF0, 0x10, 0xFFFFFFF0, 0x10, 0xFFFFFFF0, 0x10,
+};
+
+static log_timestamp_t compact_timestamp;
+
+static log_timestamp_t compact_timestamp_get(void)
+{
+	return compact_timestamp;
+}
+
+static void log_compact(void)
+{
+	static uint8_t long_data[200];
+	char long_str[161];
+	int mode;
+
+	log_set_timestamp_func(compact_timestamp_get, 1000000);
+
+	for (int i = 0; i < ARRAY_SIZE(compact_timestamps); i++) {
+		compact_timestamp = compact_timestamps[i];
+		LOG_INF("compact %d", i);
+	}
+
+	/* Package and data longer than 127 bytes need two byte lengths */
+	memset(long_str, 'x', sizeof(long_str) - 1);
+	long_str[sizeof(long_str) - 1] = '\0';
+	compact_timestamp = 0x20;
+	LOG_INF("long str %s", long_str);
+
+	memset(long_data, 'Z', sizeof(long_data));
+	compact_timestamp = 0x30;
+	LOG_HEXDUMP_INF(long_data, sizeof(long_data), "long hexdump");
+
+	/* Message from another domain carries the domain ID */
+	compact_timestamp = 0x40;
+	Z_LOG_MSG_CREATE(!IS_ENABLED(CONFIG_USERSPACE), mode, 1, Z_LOG_CURRENT_DATA(),
+			 LOG_LEVEL_INF, NULL, 0, "domain message");
+	(void)mode;
+
+	compact_timestamp = 0x50;
+	LOG_INF("compact end");
+}
+#endif
+
 int main(void)
 {
 	int8_t i8 = 1;
@@ -73,6 +125,10 @@ int main(void)
 #endif
 #endif
 
+#ifdef CONFIG_LOG_DICTIONARY_COMPACT
+	log_compact();
+#endif
+
 #if defined(CONFIG_STDOUT_CONSOLE)
 	/*
 	 * When running through twister with pytest, we need to add a newline
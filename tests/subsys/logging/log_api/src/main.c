@@ -343,6 +343,33 @@ ZTEST(test_log_api, test_log_backend_runtime_filtering)
 	process_and_validate(true, false);
 }
 
+ZTEST(test_log_api, test_log_filter_set_by_pattern)
+{
+	uint8_t d_id = Z_LOG_LOCAL_DOMAIN_ID;
+	uint32_t exp_level = dbg_enabled() ? LOG_LEVEL_DBG : LOG_LEVEL_INF;
+	int cnt;
+
+	if (!IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) || frontend_only() ||
+	    IS_ENABLED(CONFIG_LOG_FMT_SECTION_STRIP)) {
+		ztest_test_skip();
+	}
+
+	log_setup(true);
+
+	cnt = log_filter_set_by_pattern(&backend2, d_id, "te?t", LOG_LEVEL_ERR);
+	zassert_equal(cnt, 1, "Unexpected number of matches: %d", cnt);
+	zassert_equal(log_filter_get(&backend2, d_id, test_source_id, true), LOG_LEVEL_ERR);
+	zassert_equal(log_filter_get(&backend1, d_id, test_source_id, true), exp_level);
+
+	cnt = log_filter_set_by_pattern(&backend2, d_id, "test*", LOG_LEVEL_NONE);
+	zassert_true(cnt >= 2, "Unexpected number of matches: %d", cnt);
+	zassert_equal(log_filter_get(&backend2, d_id, test_source_id, true), LOG_LEVEL_NONE);
+	zassert_equal(log_filter_get(&backend2, d_id, test2_source_id, true), LOG_LEVEL_NONE);
+
+	cnt = log_filter_set_by_pattern(&backend2, d_id, "no_such_source*", LOG_LEVEL_ERR);
+	zassert_equal(cnt, 0, "Unexpected number of matches: %d", cnt);
+}
+
 static size_t get_max_hexdump(void)
 {
 	return CONFIG_LOG_BUFFER_SIZE - sizeof(struct log_msg_hdr);
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Test write-behind buffering of the file system log backend
+ *
+ */
+
+#include <stdlib.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/fs/fs.h>
+
+#define MAX_PATH_LEN (256 + 7)
+#define BLOCK_SIZE CONFIG_LOG_BACKEND_FS_WRITE_BEHIND_BLOCK_SIZE
+#define BUF_SIZE CONFIG_LOG_BACKEND_FS_WRITE_BEHIND_BUF_SIZE
+#define FILE_SIZE CONFIG_LOG_BACKEND_FS_FILE_SIZE
+/* Time for the work queue to handle a full block */
+#define WORK_TIME_MS 20
+
+BUILD_ASSERT(FILE_SIZE % BLOCK_SIZE == 0, "File size must be a multiple of the block size");
+BUILD_ASSERT(CONFIG_LOG_BACKEND_FS_SYNC_SIZE == 2 * BLOCK_SIZE,
+	     "Sync size must be two blocks");
+
+static const char *log_prefix = CONFIG_LOG_BACKEND_FS_FILE_PREFIX;
+static uint8_t pattern[FILE_SIZE];
+static uint8_t read_buf[FILE_SIZE];
+
+int write_log_behind(uint8_t *data, size_t length, void *ctx);
+void panic_log_behind(void);
+
+static void wb_write(size_t offset, size_t length)
+{
+	while (length > 0) {
+		int rc = write_log_behind(&pattern[offset % FILE_SIZE], length, NULL);
+
+		zassert_true(rc > 0, "Unexpected retval %d", rc);
+		offset += rc;
+		length -= rc;
+	}
+}
+
+/* Wait for the sync interval, after which all data is in the file */
+static void wb_settle(void)
+{
+	k_msleep(CONFIG_LOG_BACKEND_FS_SYNC_INTERVAL + WORK_TIME_MS);
+}
+
+static int newest_file_num(void)
+{
+	struct fs_dir_t dir;
+	struct fs_dirent ent;
+	int newest = -1;
+	int rc;
+
+	fs_dir_t_init(&dir);
+
+	rc = fs_opendir(&dir, CONFIG_LOG_BACKEND_FS_DIR);
+	zassert_equal(rc, 0, "Can not open directory.");
+
+	while (true) {
+		rc = fs_readdir(&dir, &ent);
+		zassert_equal(rc, 0, "Can not read directory.");
+		if (ent.name[0] == 0) {
+			break;
+		}
+
+		if (strncmp(ent.name, log_prefix, strlen(log_prefix)) == 0) {
+			newest = MAX(newest, atoi(&ent.name[strlen(log_prefix)]));
+		}
+	}
+
+	(void)fs_closedir(&dir);
+
+	return newest;
+}
+
+static void file_name(char *fname, int num)
+{
+	sprintf(fname, "%s/%s%04d", CONFIG_LOG_BACKEND_FS_DIR, log_prefix, num);
+}
+
+/* Size of a log file as last synced, -1 if it does not exist */
+static ssize_t file_size(int num)
+{
+	char fname[MAX_PATH_LEN];
+	struct fs_dirent entry;
+
+	file_name(fname, num);
+	if (fs_stat(fname, &entry) != 0) {
+		return -1;
+	}
+
+	return entry.size;
+}
+
+static void file_content_check(int num, size_t length)
+{
+	char fname[MAX_PATH_LEN];
+	struct fs_file_t file;
+
+	fs_file_t_init(&file);
+	file_name(fname, num);
+
+	zassert_equal(fs_open(&file, fname, FS_O_READ), 0, "Can not open log file.");
+	zassert_equal(fs_read(&file, read_buf, sizeof(read_buf)), length,
+		      "Unexpected size of %s", fname);
+	zassert_mem_equal(read_buf, pattern, length, "Text inside log file is not correct.");
+	zassert_equal(fs_close(&file), 0, "Can not close log file.");
+}
+
+/* Fill up the newest file, so that the next write goes to a new file at
+ * a block boundary. Returns the number of the new file.
+ */
+static int wb_fill_file(void)
+{
+	ssize_t size;
+	int num;
+
+	/* The first write initializes the backend */
+	wb_write(0, 1);
+	wb_settle();
+
+	num = newest_file_num();
+	size = file_size(num);
+	zassert_true(size > 0, "Can not get file info.");
+
+	wb_write(0, FILE_SIZE - size);
+	wb_settle();
+
+	zassert_equal(newest_file_num(), num, "Unexpected file rotation");
+	zassert_equal(file_size(num), FILE_SIZE, "File not filled");
+
+	return num + 1;
+}
+
+static void *wb_setup(void)
+{
+	for (size_t i = 0; i < sizeof(pattern); i++) {
+		pattern[i] = 'a' + (i % 26);
+	}
+
+	return NULL;
+}
+
+ZTEST(test_log_backend_fs_wb, test_wb_block_chunks)
+{
+	int num = wb_fill_file();
+
+	/* A partial block stays in RAM */
+	wb_write(0, BLOCK_SIZE / 2);
+	k_msleep(WORK_TIME_MS);
+	zassert_equal(file_size(num), -1, "Partial block written");
+
+	/* A full block is written, and the file rotated, by the work queue
+	 * rather than by the logging thread.
+	 */
+	wb_write(BLOCK_SIZE / 2, BLOCK_SIZE / 2);
+	zassert_equal(file_size(num), -1, "File rotated by the logging thread");
+	k_msleep(WORK_TIME_MS);
+	zassert_equal(newest_file_num(), num, "File not rotated");
+	zassert_equal(file_size(num), 0, "File synced before the sync size");
+
+	/* Synced once the sync size is reached */
+	wb_write(BLOCK_SIZE, BLOCK_SIZE);
+	k_msleep(WORK_TIME_MS);
+	zassert_equal(file_size(num), 2 * BLOCK_SIZE, "File not synced at the sync size");
+
+	/* A trailing partial block is written and synced after the interval */
+	wb_write(2 * BLOCK_SIZE, BLOCK_SIZE / 4);
+	k_msleep(WORK_TIME_MS);
+	zassert_equal(file_size(num), 2 * BLOCK_SIZE, "Partial block written early");
+	wb_settle();
+	zassert_equal(file_size(num), 2 * BLOCK_SIZE + BLOCK_SIZE / 4,
+		      "File not synced after the sync interval");
+
+	file_content_check(num, 2 * BLOCK_SIZE + BLOCK_SIZE / 4);
+}
+
+ZTEST(test_log_backend_fs_wb, test_wb_ring_full)
+{
+	int num = wb_fill_file();
+	int rc;
+
+	/* With the buffer full, whole blocks are written by the logging thread */
+	rc = write_log_behind(pattern, BUF_SIZE + BLOCK_SIZE / 2, NULL);
+	zassert_equal(rc, BUF_SIZE, "Unexpected retval %d", rc);
+	zassert_equal(newest_file_num(), num, "File not rotated");
+	zassert_equal(file_size(num), BUF_SIZE, "Buffer not written by the logging thread");
+
+	wb_write(BUF_SIZE, BLOCK_SIZE / 2);
+	wb_settle();
+	zassert_equal(file_size(num), BUF_SIZE + BLOCK_SIZE / 2, "Data lost");
+
+	file_content_check(num, BUF_SIZE + BLOCK_SIZE / 2);
+}
+
+ZTEST_SUITE(test_log_backend_fs_wb, NULL, wb_setup, NULL, NULL, NULL);
+
+/* Runs after the other suite, panic mode can not be left */
+ZTEST(test_log_backend_fs_wb_panic, test_wb_panic)
+{
+	int num = wb_fill_file();
+
+	wb_write(0, BLOCK_SIZE / 2);
+	zassert_equal(file_size(num), -1, "Partial block written");
+
+	/* Buffered data is flushed and new data written directly */
+	panic_log_behind();
+	zassert_equal(file_size(num), BLOCK_SIZE / 2, "Buffer not flushed on panic");
+
+	wb_write(BLOCK_SIZE / 2, BLOCK_SIZE / 4);
+	zassert_equal(file_size(num), BLOCK_SIZE / 2 + BLOCK_SIZE / 4,
+		      "Data not written directly in panic mode");
+
+	file_content_check(num, BLOCK_SIZE / 2 + BLOCK_SIZE / 4);
+}
+
+ZTEST_SUITE(test_log_backend_fs_wb_panic, NULL, NULL, NULL, NULL, NULL);
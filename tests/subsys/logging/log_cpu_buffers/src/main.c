@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/logging/log_backend.h>
+
+LOG_MODULE_REGISTER(test, LOG_LEVEL_INF);
+
+#define NUM_CPUS 2
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+/* Messages logged by each CPU in the ordering test, they fit the buffers */
+#define ORDER_MSGS 16
+/* Messages logged by one CPU in the drop test, they overflow its buffer */
+#define DROP_MSGS (CONFIG_LOG_BUFFER_SIZE / 8)
+
+static K_THREAD_STACK_ARRAY_DEFINE(tstack, NUM_CPUS, STACK_SIZE);
+static struct k_thread tthread[NUM_CPUS];
+
+struct backend_ctx {
+	uint32_t cnt;
+	uint32_t cpu_cnt[NUM_CPUS];
+	log_timestamp_t prev_timestamp;
+	bool unordered;
+	bool wrong_cpu;
+};
+
+static struct backend_ctx backend_ctx;
+
+static void process(const struct log_backend *const backend, union log_msg_generic *msg)
+{
+	struct backend_ctx *ctx = backend->cb->ctx;
+	log_timestamp_t timestamp = log_msg_get_timestamp(&msg->log);
+	size_t len;
+	uint8_t *data = log_msg_get_data(&msg->log, &len);
+
+	if (len != 1 || data[0] >= NUM_CPUS) {
+		ctx->wrong_cpu = true;
+		return;
+	}
+
+	if (ctx->cnt > 0 && timestamp < ctx->prev_timestamp) {
+		ctx->unordered = true;
+	}
+
+	ctx->prev_timestamp = timestamp;
+	ctx->cpu_cnt[data[0]]++;
+	ctx->cnt++;
+}
+
+static void panic(const struct log_backend *const backend)
+{
+	ARG_UNUSED(backend);
+}
+
+static const struct log_backend_api backend_api = {
+	.process = process,
+	.panic = panic,
+};
+
+LOG_BACKEND_DEFINE(test_backend, backend_api, false);
+
+/* Log messages carrying the CPU they are created on */
+static void log_thread(void *p1, void *p2, void *p3)
+{
+	uint8_t cpu = POINTER_TO_UINT(p1);
+	int cnt = POINTER_TO_INT(p2);
+
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < cnt; i++) {
+		zassert_equal(arch_curr_cpu()->id, cpu, "Thread not on its CPU");
+		LOG_HEXDUMP_INF(&cpu, sizeof(cpu), "cpu");
+		k_busy_wait(10);
+	}
+}
+
+static void log_on_cpus(uint32_t cpu_mask, int cnt)
+{
+	for (int i = 0; i < NUM_CPUS; i++) {
+		if (!(cpu_mask & BIT(i))) {
+			continue;
+		}
+
+		k_thread_create(&tthread[i], tstack[i], STACK_SIZE, log_thread,
+				UINT_TO_POINTER(i), INT_TO_POINTER(cnt), NULL,
+				K_PRIO_PREEMPT(1), 0, K_FOREVER);
+		k_thread_cpu_pin(&tthread[i], i);
+	}
+
+	for (int i = 0; i < NUM_CPUS; i++) {
+		if (cpu_mask & BIT(i)) {
+			k_thread_start(&tthread[i]);
+		}
+	}
+
+	for (int i = 0; i < NUM_CPUS; i++) {
+		if (cpu_mask & BIT(i)) {
+			k_thread_join(&tthread[i], K_FOREVER);
+		}
+	}
+}
+
+static void process_all(void)
+{
+	while (log_process()) {
+	}
+}
+
+ZTEST(log_cpu_buffers, test_timestamp_order)
+{
+	uint32_t dropped[NUM_CPUS];
+
+	for (int i = 0; i < NUM_CPUS; i++) {
+		dropped[i] = log_cpu_dropped_get(i);
+	}
+
+	log_on_cpus(BIT_MASK(NUM_CPUS), ORDER_MSGS);
+	process_all();
+
+	/* Messages from the buffers of both CPUs are merged in timestamp order */
+	zassert_false(backend_ctx.wrong_cpu, "Unexpected message");
+	zassert_false(backend_ctx.unordered, "Messages not in timestamp order");
+
+	for (int i = 0; i < NUM_CPUS; i++) {
+		zassert_equal(backend_ctx.cpu_cnt[i], ORDER_MSGS,
+			      "Unexpected number of messages from CPU %d", i);
+		zassert_equal(log_cpu_dropped_get(i), dropped[i],
+			      "Unexpected drops on CPU %d", i);
+	}
+}
+
+ZTEST(log_cpu_buffers, test_dropped_per_cpu)
+{
+	for (int cpu = 0; cpu < NUM_CPUS; cpu++) {
+		uint32_t dropped[NUM_CPUS];
+		uint32_t cpu_dropped;
+
+		for (int i = 0; i < NUM_CPUS; i++) {
+			dropped[i] = log_cpu_dropped_get(i);
+		}
+
+		memset(&backend_ctx, 0, sizeof(backend_ctx));
+
+		/* Only the buffer of the logging CPU overflows */
+		log_on_cpus(BIT(cpu), DROP_MSGS);
+		process_all();
+
+		cpu_dropped = log_cpu_dropped_get(cpu) - dropped[cpu];
+		zassert_true(cpu_dropped > 0, "No drops on CPU %d", cpu);
+		zassert_equal(cpu_dropped + backend_ctx.cpu_cnt[cpu], DROP_MSGS,
+			      "Messages lost on CPU %d", cpu);
+
+		for (int i = 0; i < NUM_CPUS; i++) {
+			if (i == cpu) {
+				continue;
+			}
+
+			zassert_equal(log_cpu_dropped_get(i), dropped[i],
+				      "Drops accounted to CPU %d", i);
+			zassert_equal(backend_ctx.cpu_cnt[i], 0,
+				      "Unexpected messages from CPU %d", i);
+		}
+
+		zassert_false(backend_ctx.unordered, "Messages not in timestamp order");
+	}
+}
+
+static void *log_cpu_buffers_setup(void)
+{
+	zassert_equal(arch_num_cpus(), NUM_CPUS, "Test requires %d CPUs", NUM_CPUS);
+
+	log_backend_enable(&test_backend, &backend_ctx, LOG_LEVEL_DBG);
+
+	return NULL;
+}
+
+static void log_cpu_buffers_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	process_all();
+	memset(&backend_ctx, 0, sizeof(backend_ctx));
+}
+
+ZTEST_SUITE(log_cpu_buffers, NULL, log_cpu_buffers_setup, log_cpu_buffers_before, NULL, NULL);
@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/profiling/instrument.h>
+
+/* The test is part of the application, so all of its functions are
+ * instrumented, as are the inline functions of the headers it includes. Each
+ * call of outer() makes one call of middle() and three calls of leaf(), and
+ * at least five instrumented calls in total.
+ */
+#define TEST_CALLS 3
+#define TEST_LEAF_US 100
+#define TEST_MIDDLE_US 200
+#define TEST_MIN_EVENTS_PER_CALL 5
+
+static __noinline void leaf(void)
+{
+	k_busy_wait(TEST_LEAF_US);
+}
+
+static __noinline void middle(void)
+{
+	leaf();
+	k_busy_wait(TEST_MIDDLE_US);
+	leaf();
+}
+
+static __noinline void outer(void)
+{
+	middle();
+	leaf();
+}
+
+struct test_stats {
+	struct instrument_func_stats outer;
+	struct instrument_func_stats middle;
+	struct instrument_func_stats leaf;
+	/* Of all called functions */
+	uint32_t calls;
+	uint64_t exclusive;
+};
+
+static int stats_cb(const struct instrument_func_stats *stats, void *data)
+{
+	struct test_stats *test_stats = data;
+
+	test_stats->calls += stats->calls;
+	test_stats->exclusive += stats->exclusive;
+
+	if (stats->addr == (uintptr_t)outer) {
+		test_stats->outer = *stats;
+	} else if (stats->addr == (uintptr_t)middle) {
+		test_stats->middle = *stats;
+	} else if (stats->addr == (uintptr_t)leaf) {
+		test_stats->leaf = *stats;
+	}
+
+	return 0;
+}
+
+/* An event is exported in four lines of less than 128 characters each and a
+ * closing brace, the thread names and the rest of the trace take less than
+ * the space of a few events.
+ */
+#define TEST_EXPORT_EVENT_MAX (4 * 127 + 1)
+#define TEST_EXPORT_EVENTS (CONFIG_PROFILING_INSTRUMENT_TRACE_EVENTS + 16)
+
+static char export_buf[TEST_EXPORT_EVENTS * TEST_EXPORT_EVENT_MAX];
+static size_t export_len;
+
+static int export_write(const char *data, size_t len, void *ctx)
+{
+	ARG_UNUSED(ctx);
+
+	if (export_len + len >= sizeof(export_buf)) {
+		return -ENOMEM;
+	}
+
+	memcpy(&export_buf[export_len], data, len);
+	export_len += len;
+	export_buf[export_len] = '\0';
+
+	return 0;
+}
+
+static size_t str_count(const char *str, const char *sub)
+{
+	size_t count = 0;
+
+	while ((str = strstr(str, sub)) != NULL) {
+		count++;
+		str += strlen(sub);
+	}
+
+	return count;
+}
+
+/* Calls made after recording is disabled are not recorded, so the checks
+ * only see the calls of the test functions.
+ */
+static void outer_calls(int calls)
+{
+	for (int i = 0; i < calls; i++) {
+		outer();
+	}
+
+	instrument_enable(false);
+}
+
+static void trace_export(void)
+{
+	export_len = 0;
+	zassert_ok(instrument_chrome_trace_export(export_write, NULL),
+		   "Export failed after %zu bytes", export_len);
+}
+
+ZTEST(instrument, test_func_stats)
+{
+	struct test_stats stats = {0};
+	uint32_t dropped;
+
+	outer_calls(TEST_CALLS);
+
+	dropped = instrument_func_stats_foreach(stats_cb, &stats);
+	zassert_equal(dropped, 0, "%u calls dropped", dropped);
+
+	zassert_equal(stats.outer.calls, TEST_CALLS);
+	zassert_equal(stats.middle.calls, TEST_CALLS);
+	zassert_equal(stats.leaf.calls, 3 * TEST_CALLS);
+
+	zassert_true(stats.outer.exclusive <= stats.outer.inclusive);
+	zassert_true(stats.middle.exclusive <= stats.middle.inclusive);
+	zassert_true(stats.leaf.exclusive <= stats.leaf.inclusive);
+
+	zassert_true(stats.leaf.inclusive >=
+		     3 * TEST_CALLS * k_us_to_cyc_floor64(TEST_LEAF_US));
+	zassert_true(stats.middle.exclusive >=
+		     TEST_CALLS * k_us_to_cyc_floor64(TEST_MIDDLE_US));
+	zassert_true(stats.middle.inclusive >= stats.middle.exclusive +
+		     2 * TEST_CALLS * k_us_to_cyc_floor64(TEST_LEAF_US));
+	zassert_true(stats.outer.inclusive >= stats.middle.inclusive +
+		     TEST_CALLS * k_us_to_cyc_floor64(TEST_LEAF_US));
+
+	/* The exclusive cycles of all functions of a call tree add up to the
+	 * inclusive cycles of its root.
+	 */
+	zassert_equal(stats.exclusive, stats.outer.inclusive);
+}
+
+ZTEST(instrument, test_reset)
+{
+	struct test_stats stats = {0};
+
+	outer_calls(1);
+	instrument_reset();
+
+	instrument_func_stats_foreach(stats_cb, &stats);
+	zassert_equal(stats.outer.calls, 0);
+	zassert_equal(stats.middle.calls, 0);
+	zassert_equal(stats.leaf.calls, 0);
+
+	trace_export();
+	zassert_equal(str_count(export_buf, "\"ph\":\"X\""), 0);
+}
+
+static size_t trace_calls_count(const void *fn, const char *fn_name)
+{
+	char name[32];
+
+#ifdef CONFIG_SYMTAB
+	ARG_UNUSED(fn);
+	snprintk(name, sizeof(name), "\"name\":\"%s\"", fn_name);
+#else
+	ARG_UNUSED(fn_name);
+	snprintk(name, sizeof(name), "\"name\":\"%p\"", fn);
+#endif
+
+	return str_count(export_buf, name);
+}
+
+ZTEST(instrument, test_chrome_trace_export)
+{
+	struct test_stats stats = {0};
+
+	outer_calls(TEST_CALLS);
+	trace_export();
+
+	zassert_equal(strncmp(export_buf, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[",
+			      strlen("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[")), 0,
+		      "%s", export_buf);
+	zassert_not_null(strstr(export_buf, "\"otherData\":{\"dropped_calls\":0,"
+					    "\"dropped_stats_calls\":0}}\n"),
+			 "%s", export_buf);
+	zassert_equal(str_count(export_buf, "{"), str_count(export_buf, "}"));
+	zassert_equal(str_count(export_buf, "["), str_count(export_buf, "]"));
+
+	/* One event per recorded call */
+	instrument_func_stats_foreach(stats_cb, &stats);
+	zassert_equal(str_count(export_buf, "\"ph\":\"X\""), stats.calls, "%s", export_buf);
+
+	zassert_equal(trace_calls_count(outer, "outer"), TEST_CALLS, "%s", export_buf);
+	zassert_equal(trace_calls_count(middle, "middle"), TEST_CALLS, "%s", export_buf);
+	zassert_equal(trace_calls_count(leaf, "leaf"), 3 * TEST_CALLS, "%s", export_buf);
+}
+
+ZTEST(instrument, test_chrome_trace_full)
+{
+	int calls = CONFIG_PROFILING_INSTRUMENT_TRACE_EVENTS / TEST_MIN_EVENTS_PER_CALL + 1;
+	struct test_stats stats = {0};
+	char other[64];
+
+	outer_calls(calls);
+	trace_export();
+
+	/* The statistics keep counting once the trace is full */
+	instrument_func_stats_foreach(stats_cb, &stats);
+	zassert_equal(stats.outer.calls, calls);
+
+	zassert_equal(str_count(export_buf, "\"ph\":\"X\""),
+		      CONFIG_PROFILING_INSTRUMENT_TRACE_EVENTS);
+	snprintk(other, sizeof(other), "\"dropped_calls\":%u,",
+		 stats.calls - CONFIG_PROFILING_INSTRUMENT_TRACE_EVENTS);
+	zassert_not_null(strstr(export_buf, other), "%s", export_buf);
+}
+
+static void instrument_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	instrument_reset();
+	instrument_enable(true);
+}
+
+ZTEST_SUITE(instrument, NULL, NULL, instrument_before, NULL, NULL);
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/shell/shell_dummy.h>
+
+/* Samples with a scripted stack trace, the following ones are lost */
+#define TEST_SAMPLES 40
+/* Sample n has a depth of 1 + n % TEST_STACKS */
+#define TEST_STACKS 3
+#define TEST_IP(id, frame) (0x1000UL * ((frame) + 1) + (id))
+#define TEST_THREAD_NAME "perf_test"
+
+/* Aggregated samples only differ by their depth, so there are TEST_STACKS
+ * distinct traces. Otherwise every sample has its own addresses.
+ */
+#define TEST_ID(n) (IS_ENABLED(CONFIG_PROFILING_PERF_AGGREGATE) ? (n) % TEST_STACKS : (n))
+
+static atomic_t trace_cnt;
+
+size_t arch_perf_current_stack_trace(uintptr_t *buf, size_t size)
+{
+	uint32_t n = atomic_inc(&trace_cnt);
+	size_t depth = 1 + n % TEST_STACKS;
+
+	if ((n >= TEST_SAMPLES) || (depth > size)) {
+		return 0;
+	}
+
+	for (size_t i = 0; i < depth; i++) {
+		buf[i] = TEST_IP(TEST_ID(n), i);
+	}
+
+	return depth;
+}
+
+static const char *shell_output(const char *cmd)
+{
+	const struct shell *sh = shell_backend_dummy_get_ptr();
+	size_t size;
+	int ret;
+
+	shell_backend_dummy_clear_output(sh);
+
+	ret = shell_execute_cmd(sh, cmd);
+	zassert_ok(ret, "\"%s\" failed (%d)", cmd, ret);
+
+	return shell_backend_dummy_get_output(sh, &size);
+}
+
+/* Record in continuous mode until all scripted samples are taken. The test
+ * thread keeps running, so samples are attributed to it.
+ */
+static void perf_record(void)
+{
+	atomic_set(&trace_cnt, 0);
+
+	shell_output("perf clear");
+	shell_output("perf record 0 1000");
+
+	while (atomic_get(&trace_cnt) < TEST_SAMPLES) {
+		k_busy_wait(USEC_PER_MSEC);
+	}
+
+	shell_output("perf stop");
+}
+
+static void perf_info_check(void)
+{
+	const char *out = shell_output("perf info");
+	unsigned int samples, lost;
+
+	out = strstr(out, "Samples:");
+	zassert_not_null(out, "No sample count");
+	zassert_equal(sscanf(out, "Samples: %u, lost: %u", &samples, &lost), 2,
+		      "Invalid perf info");
+	zassert_true(samples >= TEST_SAMPLES, "Samples missing");
+	zassert_equal(samples - lost, TEST_SAMPLES, "Scripted samples lost");
+}
+
+/* Expected folded line of sample n, outermost frame first */
+static void folded_line(char *line, size_t len, uint32_t n, const char *thread, uint32_t count)
+{
+	size_t depth = 1 + n % TEST_STACKS;
+	int pos = 0;
+
+	if (thread != NULL) {
+		pos += snprintf(&line[pos], len - pos, "%s;", thread);
+	}
+
+	for (size_t i = depth; i-- > 0;) {
+		pos += snprintf(&line[pos], len - pos, "0x%lx%s", TEST_IP(TEST_ID(n), i),
+				(i > 0) ? ";" : "");
+	}
+
+	snprintf(&line[pos], len - pos, " %u", count);
+}
+
+/* Position of a whole line in the output, NULL if not found */
+static const char *line_find(const char *out, const char *line)
+{
+	size_t len = strlen(line);
+
+	for (const char *pos = strstr(out, line); pos != NULL; pos = strstr(pos + 1, line)) {
+		if (((pos == out) || (pos[-1] == '\n')) &&
+		    ((pos[len] == '\r') || (pos[len] == '\n'))) {
+			return pos;
+		}
+	}
+
+	return NULL;
+}
+
+#ifdef CONFIG_PROFILING_PERF_AGGREGATE
+ZTEST(perf, test_aggregate_folded)
+{
+	const char *out;
+	char line[128];
+
+	k_thread_name_set(k_current_get(), TEST_THREAD_NAME);
+
+	perf_record();
+	perf_info_check();
+
+	out = shell_output("perf info");
+	zassert_not_null(strstr(out, "Perf stacks: 3/"), "Unexpected number of stacks");
+
+	/* Identical traces of a thread are counted once each */
+	out = shell_output("perf folded");
+	for (uint32_t s = 0; s < TEST_STACKS; s++) {
+		uint32_t count = TEST_SAMPLES / TEST_STACKS + (s < TEST_SAMPLES % TEST_STACKS);
+
+		folded_line(line, sizeof(line), s, TEST_THREAD_NAME, count);
+		zassert_not_null(line_find(out, line), "Missing: %s", line);
+	}
+}
+#else
+ZTEST(perf, test_continuous_wraparound)
+{
+	const char *out;
+	const char *prev = NULL;
+	char line[128];
+	uint32_t records = 0;
+
+	perf_record();
+	perf_info_check();
+
+	out = shell_output("perf info");
+	zassert_is_null(strstr(out, "(full)"), "Continuous mode filled the buffer");
+
+	/* The ring keeps the newest samples, printed from the oldest one */
+	out = shell_output("perf folded");
+	for (uint32_t n = TEST_SAMPLES; n-- > 0;) {
+		const char *pos;
+
+		folded_line(line, sizeof(line), n, NULL, 1);
+		pos = line_find(out, line);
+		if (pos == NULL) {
+			break;
+		}
+
+		zassert_true((prev == NULL) || (pos < prev), "Sample %u out of order", n);
+		prev = pos;
+		records++;
+	}
+
+	zassert_true(records > 0, "Newest sample missing");
+	zassert_true(records < TEST_SAMPLES, "Buffer did not wrap around");
+	zassert_true(records >= CONFIG_PROFILING_PERF_BUFFER_SIZE / (TEST_STACKS + 1),
+		     "Too few samples kept (%u)", records);
+
+	/* Nothing older than the dropped sample is kept */
+	for (uint32_t n = 0; n < TEST_SAMPLES - records; n++) {
+		folded_line(line, sizeof(line), n, NULL, 1);
+		zassert_is_null(line_find(out, line), "Dropped sample %u printed", n);
+	}
+}
+#endif
+
+ZTEST(perf, test_stop_not_running)
+{
+	const struct shell *sh = shell_backend_dummy_get_ptr();
+
+	zassert_equal(shell_execute_cmd(sh, "perf stop"), -EALREADY, "Stop should fail");
+}
+
+static void *perf_setup(void)
+{
+	const struct shell *sh = shell_backend_dummy_get_ptr();
+
+	/* Wait for the shell to be ready */
+	WAIT_FOR(shell_ready(sh), 20000, k_msleep(1));
+	zassert_true(shell_ready(sh), "Timed out waiting for the shell");
+
+	return NULL;
+}
+
+ZTEST_SUITE(perf, NULL, perf_setup, NULL, NULL, NULL);
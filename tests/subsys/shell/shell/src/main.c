@@ -344,6 +344,28 @@ ZTEST(sh, test_shell_fprintf)
 		     "Expected string to contain '%s', got '%s'", expect, buf);
 }
 
+ZTEST(sh, test_shell_write)
+{
+	static const char data[] = "raw 1\nraw 2";
+	static const char expect[] = "raw 1\r\nraw 2";
+	const struct shell *sh;
+	const char *buf;
+	size_t size;
+
+	sh = shell_backend_dummy_get_ptr();
+	zassert_not_null(sh, "Failed to get shell");
+
+	/* Clear the output buffer */
+	shell_backend_dummy_clear_output(sh);
+
+	shell_write(sh, data, strlen(data));
+	buf = shell_backend_dummy_get_output(sh, &size);
+
+	/* Line feeds are mapped as for formatted output. */
+	zassert_true(strstr(buf, expect),
+		     "Expected string to contain '%s', got '%s'", expect, buf);
+}
+
 #define RAW_ARG "aaa \"\" bbb"
 #define CMD_MAND_1_OPT_RAW_NAME cmd_mand_1_opt_raw
 
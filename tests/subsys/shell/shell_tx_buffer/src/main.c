@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file
+ *  @brief Shell output buffer with immediate logging
+ *
+ *  The shell instance of the test is a log backend, so with immediate
+ *  logging the log messages are written to the transport directly while
+ *  buffered output may still be written by the shell output thread.
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include "../../../../../subsys/shell/shell_ops.h"
+
+LOG_MODULE_REGISTER(test, LOG_LEVEL_INF);
+
+/* The transport takes this many bytes per write and sleeps in between, so
+ * writes of the output thread and of a log message overlap unless the
+ * shell serializes them.
+ */
+#define TEST_WRITE_CHUNK 16
+#define TEST_LINES 16
+#define TEST_LOGS 4
+
+static char output[2048];
+static size_t output_len;
+static struct k_spinlock output_lock;
+static atomic_t writing;
+static bool write_overlap;
+
+static int test_init(const struct shell_transport *transport, const void *config,
+		     shell_transport_handler_t evt_handler, void *context)
+{
+	return 0;
+}
+
+static int test_uninit(const struct shell_transport *transport)
+{
+	return 0;
+}
+
+static int test_enable(const struct shell_transport *transport, bool blocking)
+{
+	return 0;
+}
+
+static int test_write(const struct shell_transport *transport, const void *data,
+		      size_t length, size_t *cnt)
+{
+	size_t store_cnt = MIN(length, TEST_WRITE_CHUNK);
+	k_spinlock_key_t key;
+
+	if (atomic_set(&writing, 1) != 0) {
+		write_overlap = true;
+	}
+
+	key = k_spin_lock(&output_lock);
+	store_cnt = MIN(store_cnt, sizeof(output) - output_len - 1);
+	memcpy(&output[output_len], data, store_cnt);
+	output_len += store_cnt;
+	output[output_len] = '\0';
+	k_spin_unlock(&output_lock, key);
+
+	if (!k_is_in_isr()) {
+		k_msleep(1);
+	}
+
+	atomic_clear(&writing);
+
+	*cnt = MIN(length, TEST_WRITE_CHUNK);
+
+	return 0;
+}
+
+static int test_read(const struct shell_transport *transport, void *data, size_t length,
+		     size_t *cnt)
+{
+	*cnt = 0;
+
+	return 0;
+}
+
+static const struct shell_transport_api test_transport_api = {
+	.init = test_init,
+	.uninit = test_uninit,
+	.enable = test_enable,
+	.write = test_write,
+	.read = test_read,
+};
+
+static struct shell_transport test_transport = {
+	.api = &test_transport_api,
+};
+
+SHELL_DEFINE(test_shell, "test:~$ ", &test_transport, 256, 0, SHELL_FLAG_OLF_CRLF);
+
+static void output_reset(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&output_lock);
+
+	output_len = 0;
+	output[0] = '\0';
+	write_overlap = false;
+	k_spin_unlock(&output_lock, key);
+}
+
+/* Check that the expected strings are found in the output in this order. */
+static const char *output_expect(const char *pos, const char *expect)
+{
+	const char *found = strstr(pos, expect);
+
+	zassert_not_null(found, "'%s' not found in order, output: '%s'", expect, output);
+
+	return found + strlen(expect);
+}
+
+ZTEST(shell_tx_buffer, test_log_waits_for_buffered_output)
+{
+	const struct shell *sh = &test_shell;
+	const char *pos = output;
+	char expect[16];
+
+	/* Output buffered before the log backend took the transport over. */
+	output_reset();
+	z_flag_sync_mode_set(sh, false);
+
+	for (int i = 0; i < TEST_LINES; i++) {
+		shell_print(sh, "line %02d", i);
+	}
+
+	/* The output thread is still writing the buffer when the log messages
+	 * are written directly.
+	 */
+	z_flag_sync_mode_set(sh, true);
+
+	for (int i = 0; i < TEST_LOGS; i++) {
+		LOG_INF("log %02d", i);
+	}
+
+	z_shell_tx_buffer_flush(sh);
+
+	zassert_false(write_overlap, "Transport written from two threads at once");
+
+	for (int i = 0; i < TEST_LINES; i++) {
+		snprintk(expect, sizeof(expect), "line %02d\r\n", i);
+		pos = output_expect(pos, expect);
+	}
+
+	for (int i = 0; i < TEST_LOGS; i++) {
+		snprintk(expect, sizeof(expect), "log %02d\r\n", i);
+		pos = output_expect(pos, expect);
+	}
+}
+
+ZTEST(shell_tx_buffer, test_log_immediate)
+{
+	const struct shell *sh = &test_shell;
+	const char *pos = output;
+	char expect[16];
+
+	output_reset();
+
+	for (int i = 0; i < TEST_LOGS; i++) {
+		shell_print(sh, "line %02d", i);
+		LOG_INF("log %02d", i);
+	}
+
+	z_shell_tx_buffer_flush(sh);
+
+	zassert_false(write_overlap, "Transport written from two threads at once");
+
+	for (int i = 0; i < TEST_LOGS; i++) {
+		snprintk(expect, sizeof(expect), "line %02d\r\n", i);
+		pos = output_expect(pos, expect);
+		snprintk(expect, sizeof(expect), "log %02d\r\n", i);
+		pos = output_expect(pos, expect);
+	}
+}
+
+static void *shell_tx_buffer_setup(void)
+{
+	struct shell_backend_config_flags cfg_flags = SHELL_DEFAULT_BACKEND_CONFIG_FLAGS;
+	int err;
+
+	cfg_flags.use_colors = 0;
+	cfg_flags.use_vt100 = 0;
+
+	err = shell_init(&test_shell, NULL, cfg_flags, true, LOG_LEVEL_INF);
+	zassert_ok(err, "Failed to init shell (%d)", err);
+
+	/* Let the shell thread start the instance and enable its log backend. */
+	k_msleep(100);
+	zassert_equal(test_shell.ctx->state, SHELL_STATE_ACTIVE, "Shell not started");
+
+	return NULL;
+}
+
+ZTEST_SUITE(shell_tx_buffer, NULL, shell_tx_buffer_setup, NULL, NULL, NULL);
@@ -59,13 +59,75 @@ static uint8_t *string_tracked[] = {
 };
 #endif
 
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+#define TRACING_CPU_EVENTS 32
+
+static K_THREAD_STACK_ARRAY_DEFINE(cpu_thread_stacks, CONFIG_MP_MAX_NUM_CPUS, 1024);
+static struct k_thread cpu_threads[CONFIG_MP_MAX_NUM_CPUS];
+static uint32_t cpu_events[CONFIG_MP_MAX_NUM_CPUS];
+static bool cpu_event_mismatch;
+static bool string_found[ARRAY_SIZE(string_tracked)];
+
+/* The events written to the buffers are not null-terminated. */
+static const uint8_t *data_find(const uint8_t *data, uint32_t length, const char *str)
+{
+	size_t str_length = strlen(str);
+
+	for (uint32_t i = 0; i + str_length <= length; i++) {
+		if (memcmp(&data[i], str, str_length) == 0) {
+			return &data[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Each packet handed to the format must only hold events of its CPU. */
+void tracing_cpu_buffer_handle(uint8_t cpu, uint8_t *data, uint32_t length)
+{
+	static const char marker[] = "tracing_cpu_";
+	const uint8_t *end = data + length;
+	const uint8_t *event = data;
+
+	while ((event = data_find(event, end - event, marker)) != NULL) {
+		event += sizeof(marker) - 1;
+		if (event < end && *event - '0' == cpu) {
+			cpu_events[cpu]++;
+		} else {
+			cpu_event_mismatch = true;
+		}
+	}
+
+	tracing_buffer_handle(data, length);
+}
+#endif
+
+static void tracing_test_buffer_init(void)
+{
+	/* The per-CPU buffers are written by the other CPUs at any time */
+	if (!IS_ENABLED(CONFIG_TRACING_PER_CPU_BUFFERS)) {
+		tracing_buffer_init();
+	}
+}
+
 #if defined(CONFIG_TRACING_BACKEND_UART)
 static void tracing_backends_output(
 		const struct tracing_backend *backend,
 		uint8_t *data, uint32_t length)
 {
 	/* Check the output data. */
-#ifdef CONFIG_TRACING_ASYNC
+#if defined(CONFIG_TRACING_PER_CPU_BUFFERS)
+	if (async_tracing_api) {
+		/* Events are output in packets of each CPU, collect the
+		 * strings over all of them.
+		 */
+		for (int i = 0; string_tracked[i] != NULL; i++) {
+			if (data_find(data, length, string_tracked[i]) != NULL) {
+				string_found[i] = true;
+			}
+		}
+	}
+#elif defined(CONFIG_TRACING_ASYNC)
 	if (async_tracing_api) {
 		/* This verification should run only once, hence the static
 		 * `i`. As soon as the tracing thread has a chance to run,
@@ -129,7 +191,7 @@ ZTEST(tracing_api, test_tracing_sys_api)
 	struct k_timer timer;
 	k_timeout_t timeout = K_MSEC(1);
 
-	tracing_buffer_init();
+	tracing_test_buffer_init();
 	async_tracing_api = true;
 	/* thread api */
 	sys_trace_k_thread_switched_out();
@@ -191,8 +253,15 @@ ZTEST(tracing_api, test_tracing_sys_api)
 
 	/* wait for some actions finished */
 	k_sleep(K_MSEC(100));
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+	for (int i = 0; string_tracked[i] != NULL; i++) {
+		zassert_true(string_found[i], "%s not found in output from backend",
+			     string_tracked[i]);
+	}
+#else
 	zassert_true(tracing_api_found, "Failed to check output from backend");
 	zassert_true(tracing_api_not_found == false, "Failed to check output from backend");
+#endif
 	async_tracing_api = false;
 }
 #else
@@ -207,7 +276,7 @@ ZTEST(tracing_api, test_tracing_sys_api)
  */
 ZTEST(tracing_api, test_tracing_sys_api)
 {
-	tracing_buffer_init();
+	tracing_test_buffer_init();
 	tracing_format_string("tracing_format_string_testing");
 	k_sleep(K_MSEC(100));
 
@@ -229,7 +298,7 @@ ZTEST(tracing_api, test_tracing_data_format)
 	uint8_t data[] = "tracing_format_data_testing";
 	uint8_t raw_data[] = "tracing_format_raw_data_testing";
 
-	tracing_buffer_init();
+	tracing_test_buffer_init();
 	tracing_data.data = data;
 	tracing_data.length = sizeof(data);
 	tracing_raw_data.data = raw_data;
@@ -279,4 +348,56 @@ ZTEST(tracing_api, test_tracing_cmd_manual)
 	tracing_cmd_handle(cmd, sizeof(cmd2));
 	zassert_true(is_tracing_enabled(), "Failed to enable tracing");
 }
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+static void cpu_thread_entry(void *p1, void *p2, void *p3)
+{
+	unsigned int cpu = POINTER_TO_UINT(p1);
+
+	for (int i = 0; i < TRACING_CPU_EVENTS; i++) {
+		tracing_format_string("tracing_cpu_%u_event_%d", cpu, i);
+	}
+}
+
+/**
+ * @brief Test per-CPU buffers
+ *
+ * @details Emit events from threads pinned to each CPU and check that every
+ * packet handed to the format only holds events of the CPU it is tagged
+ * with, and that no event is lost.
+ *
+ * @ingroup tracing_api_tests
+ */
+ZTEST(tracing_api, test_tracing_per_cpu_streams)
+{
+	unsigned int num_cpus = arch_num_cpus();
+
+	zassert_true(num_cpus > 1, "Test requires more than one CPU");
+
+	for (unsigned int cpu = 0; cpu < num_cpus; cpu++) {
+		k_thread_create(&cpu_threads[cpu], cpu_thread_stacks[cpu],
+				K_THREAD_STACK_SIZEOF(cpu_thread_stacks[cpu]),
+				cpu_thread_entry, UINT_TO_POINTER(cpu), NULL, NULL,
+				K_PRIO_PREEMPT(1), 0, K_FOREVER);
+		zassert_ok(k_thread_cpu_pin(&cpu_threads[cpu], cpu));
+	}
+
+	for (unsigned int cpu = 0; cpu < num_cpus; cpu++) {
+		k_thread_start(&cpu_threads[cpu]);
+	}
+
+	for (unsigned int cpu = 0; cpu < num_cpus; cpu++) {
+		k_thread_join(&cpu_threads[cpu], K_FOREVER);
+	}
+
+	/* wait for the tracing thread to drain all buffers */
+	k_sleep(K_MSEC(100));
+
+	zassert_false(cpu_event_mismatch, "Event output in a packet of another CPU");
+	for (unsigned int cpu = 0; cpu < num_cpus; cpu++) {
+		zassert_equal(cpu_events[cpu], TRACING_CPU_EVENTS,
+			      "CPU %u: %u events output", cpu, cpu_events[cpu]);
+	}
+}
+#endif /* CONFIG_TRACING_PER_CPU_BUFFERS */
+
 ZTEST_SUITE(tracing_api, NULL, NULL, NULL, NULL, NULL);